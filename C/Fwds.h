@@ -240,8 +240,19 @@ class Scope;
 /* Compilation */
 class Compilation;
 class Assembly;
+class TypeInterner;
 class SemanticModel;
 
+/* Analysis */
+class CallGraph;
+class CallGraphBuilder;
+class ControlFlowGraph;
+class ControlFlowGraphBuilder;
+class ControlFlowPaths;
+class DominatorTree;
+class NaturalLoops;
+class PathEnumerationOptions;
+
 } // C
 } // psy
 
@@ -35,6 +35,7 @@
 #include "../common/text/TextElementTable.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <cstring>
 #include <functional>
@@ -64,6 +65,7 @@ struct SyntaxTree::SyntaxTreeImpl
         , filePath_(filePath)
         , rootNode_(nullptr)
         , parseExitedEarly_(false)
+        , nodesAdoptable_(false)
     {
         if (filePath_.empty())
             filePath_ = "<buffer>";
@@ -93,10 +95,16 @@ struct SyntaxTree::SyntaxTreeImpl
     SyntaxTree::ExpansionsTable expansions_;
 
     bool parseExitedEarly_;
+    bool nodesAdoptable_;
 
     std::vector<Diagnostic> diagnostics_;
 
     std::unordered_set<const Compilation*> attachedCompilations_;
+
+    std::vector<std::unique_ptr<MemoryPool>> auxPools_;
+    std::atomic<unsigned int> nodeCnt_{0};
+
+    SyntaxCategory syntaxCat_ = SyntaxCategory::UNSPECIFIED;
 };
 
 SyntaxTree::SyntaxTree(SourceText text,
@@ -104,10 +112,10 @@ SyntaxTree::SyntaxTree(SourceText text,
                        TextCompleteness textCompleteness,
                        ParseOptions parseOptions,
                        const std::string& filePath)
-    : P(new SyntaxTreeImpl(text,
+    : P(new SyntaxTreeImpl(std::move(text),
                            textPPState,
                            textCompleteness,
-                           parseOptions,
+                           std::move(parseOptions),
                            filePath))
 {}
 
@@ -120,6 +128,22 @@ MemoryPool* SyntaxTree::unitPool() const
     return P->pool_.get();
 }
 
+MemoryPool* SyntaxTree::makeAuxUnitPool()
+{
+    P->auxPools_.emplace_back(new MemoryPool());
+    return P->auxPools_.back().get();
+}
+
+unsigned int SyntaxTree::makeNodeId()
+{
+    return P->nodeCnt_++;
+}
+
+unsigned int SyntaxTree::nodeCount() const
+{
+    return P->nodeCnt_;
+}
+
 std::unique_ptr<SyntaxTree> SyntaxTree::parseText(SourceText text,
                                                   TextPreprocessingState textPPState,
                                                   TextCompleteness textCompleteness,
@@ -128,10 +152,10 @@ std::unique_ptr<SyntaxTree> SyntaxTree::parseText(SourceText text,
                                                   SyntaxCategory syntaxCategory)
 {
     std::unique_ptr<SyntaxTree> tree(
-                new SyntaxTree(text,
+                new SyntaxTree(std::move(text),
                                textPPState,
                                textCompleteness,
-                               parseOptions,
+                               std::move(parseOptions),
                                filePath));
     tree->buildFor(syntaxCategory);
     return tree;
@@ -181,8 +205,25 @@ bool SyntaxTree::parseExitedEarly() const
     return P->parseExitedEarly_;
 }
 
+TextPreprocessingState SyntaxTree::textPreprocessingState() const
+{
+    return P->textPPState_;
+}
+
+TextCompleteness SyntaxTree::textCompleteness() const
+{
+    return P->textCompleteness_;
+}
+
+SyntaxTree::SyntaxCategory SyntaxTree::syntaxCategory() const
+{
+    return P->syntaxCat_;
+}
+
 void SyntaxTree::buildFor(SyntaxCategory syntaxCategory)
 {
+    P->syntaxCat_ = syntaxCategory;
+
     Lexer lexer(this);
     lexer.lex();
 
@@ -218,6 +259,11 @@ void SyntaxTree::buildFor(SyntaxCategory syntaxCategory)
     std::cout << "\n\n\n";
 #endif
 
+    parseFor(syntaxCategory);
+}
+
+void SyntaxTree::parseFor(SyntaxCategory syntaxCategory)
+{
     Parser parser(this);
     switch (syntaxCategory) {
         case SyntaxCategory::Declarations: {
@@ -245,8 +291,36 @@ void SyntaxTree::buildFor(SyntaxCategory syntaxCategory)
             P->rootNode_ = parser.parse();
     }
 
+    completeParse(parser);
+}
+
+/**
+ * Parse the tokens of \c this SyntaxTree, relexed from the given \p tree, by
+ * adopting the nodes of \p tree that enclose no damaged token.
+ *
+ * \return Whether the parse could be done so.
+ */
+bool SyntaxTree::parseAdoptingFrom(const SyntaxTree* tree, const RelexedTokens& relexedTks)
+{
+    Parser parser(this);
+    P->rootNode_ = parser.parseAdoptingFrom(tree, relexedTks);
+    if (!P->rootNode_)
+        return false;
+
+    completeParse(parser);
+    return true;
+}
+
+void SyntaxTree::completeParse(Parser& parser)
+{
     P->parseExitedEarly_ = parser.peek().kind() != EndOfFile;
 
+    // Nodes aren't adopted from a SyntaxTree whose ambiguities were resolved:
+    // the resolution of an ambiguity depends on the entire SyntaxTree.
+    P->nodesAdoptable_ = P->rootNode_ && P->rootNode_->asTranslationUnit()
+            && (!parser.detectedAnyAmbiguity()
+                    || P->parseOptions_.treatmentOfAmbiguities() == ParseOptions::TreatmentOfAmbiguities::None);
+
     if (!parser.detectedAnyAmbiguity())
         return;
 
@@ -290,6 +364,293 @@ void SyntaxTree::buildFor(SyntaxCategory syntaxCategory)
     reparser.reparse(this);
 }
 
+namespace {
+
+unsigned int lineIndexOf(const std::vector<unsigned int>& startOfLineOffsets,
+                         unsigned int offset)
+{
+    auto it = std::upper_bound(startOfLineOffsets.begin(),
+                               startOfLineOffsets.end(),
+                               offset);
+    return std::distance(startOfLineOffsets.begin(), it) - 1;
+}
+
+template <class OffsetAtT>
+LexedTokens::IndexType firstTokenAtOrAfter(unsigned int offset,
+                                           LexedTokens::IndexType tkCnt,
+                                           OffsetAtT offsetAt)
+{
+    LexedTokens::IndexType lo = 1;
+    LexedTokens::IndexType hi = tkCnt;
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (offsetAt(mid) < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+} // anonymous
+
+std::unique_ptr<SyntaxTree> SyntaxTree::withChangedText(const TextChange& change) const
+{
+    const auto& rawText = P->text_.rawText();
+    const auto& span = change.span();
+    PSY_ASSERT(span.start() <= span.end() && span.end() <= rawText.size(), return nullptr);
+
+    std::string newRawText;
+    newRawText.reserve(rawText.size() - (span.end() - span.start()) + change.newText().size());
+    newRawText.append(rawText, 0, span.start());
+    newRawText.append(change.newText());
+    newRawText.append(rawText, span.end(), std::string::npos);
+
+    if (!admitsRelexFor(change)) {
+        return parseText(SourceText(std::move(newRawText)),
+                         P->textPPState_,
+                         P->textCompleteness_,
+                         P->parseOptions_,
+                         P->filePath_,
+                         P->syntaxCat_);
+    }
+
+    std::unique_ptr<SyntaxTree> tree(
+                new SyntaxTree(SourceText(std::move(newRawText)),
+                               P->textPPState_,
+                               P->textCompleteness_,
+                               P->parseOptions_,
+                               P->filePath_));
+    tree->P->syntaxCat_ = P->syntaxCat_;
+    auto relexedTks = tree->relexWith(this, change);
+
+    if (!admitsNodeAdoption()) {
+        tree->parseFor(P->syntaxCat_);
+        return tree;
+    }
+
+    if (tree->parseAdoptingFrom(this, relexedTks))
+        return tree;
+
+    // The damage couldn't be confined (and there may be diagnostics of it).
+    return parseText(SourceText(tree->P->text_.rawText()),
+                     P->textPPState_,
+                     P->textCompleteness_,
+                     P->parseOptions_,
+                     P->filePath_,
+                     P->syntaxCat_);
+}
+
+/**
+ * Whether the tokens of \c this SyntaxTree may be reused for a text with
+ * the given \p change: that isn't the case if the text is preprocessed by
+ * the parser (a change may affect the directives and expansions of the
+ * remaining text) or contains expansions, if the byte and char offsets of
+ * the tokens differ (after the change), or if there are lexer diagnostics
+ * (which aren't tied to tokens).
+ */
+bool SyntaxTree::admitsRelexFor(const TextChange& change) const
+{
+    if ((P->textPPState_ == TextPreprocessingState::Unpreprocessed
+                && P->parseOptions_.treatmentOfPreprocessing()
+                    != ParseOptions::TreatmentOfPreprocessing::None)
+            || !P->expansions_.empty())
+        return false;
+
+    const auto& eofTk = tokenAt(tokenCount() - 1);
+    if (eofTk.byteOffset_ != eofTk.charOffset_)
+        return false;
+
+    for (unsigned char c : change.newText()) {
+        if (c & 0x80)
+            return false;
+    }
+
+    for (const auto& diag : P->diagnostics_) {
+        if (diag.descriptor().id().compare(0, 6, "Lexer-") == 0)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Whether the nodes of \c this SyntaxTree may be adopted by one for a text
+ * with a change: that isn't the case if the parse exited early or if there
+ * are diagnostics (which aren't tied to nodes), besides the cases in which
+ * ambiguities were resolved.
+ */
+bool SyntaxTree::admitsNodeAdoption() const
+{
+    return P->nodesAdoptable_ && !P->parseExitedEarly_ && P->diagnostics_.empty();
+}
+
+/**
+ * Lex the text of \c this SyntaxTree, which is that of the given \p tree
+ * with the \p change applied to it, by reusing the tokens of \p tree that
+ * precede and succeed the lines damaged by the \p change.
+ */
+SyntaxTree::RelexedTokens SyntaxTree::relexWith(const SyntaxTree* tree, const TextChange& change)
+{
+    const auto& oldLines = tree->P->startOfLineOffsets_;
+    const auto& span = change.span();
+    const auto delta = static_cast<long long>(change.newText().size()) - (span.end() - span.start());
+
+    const auto oldTkCnt = tree->tokenCount();
+    auto oldTokenAt = [tree] (LexedTokens::IndexType tkIdx) -> const SyntaxToken& {
+        return tree->tokenAt(tkIdx);
+    };
+    auto oldTokenStart = [&] (LexedTokens::IndexType tkIdx) {
+        return oldTokenAt(tkIdx).charStart();
+    };
+    auto oldTokenEnd = [&] (LexedTokens::IndexType tkIdx) {
+        return oldTokenAt(tkIdx).charEnd();
+    };
+
+    // Lex from the end of the last token before the line of the change; the
+    // lexer state there is that of a token boundary.
+    const auto restartTkIdx = firstTokenAtOrAfter(oldLines[lineIndexOf(oldLines, span.start())],
+                                                  oldTkCnt,
+                                                  oldTokenEnd);
+    const auto restart = restartTkIdx > 1 ? oldTokenAt(restartTkIdx - 1).charEnd() : 0;
+
+    // Marker (invalid) token.
+    addToken(SyntaxToken(nullptr));
+
+    for (LexedTokens::IndexType tkIdx = 1; tkIdx < restartTkIdx; ++tkIdx)
+        addToken(adoptedToken(oldTokenAt(tkIdx)));
+    for (const auto& tk : tree->comments_) {
+        if (tk.charStart() >= restart)
+            break;
+        comments_.push_back(adoptedToken(tk));
+    }
+    for (const auto& lineDir : tree->P->lineDirectives_) {
+        if (lineDir.offset() >= restart && !P->lineDirectives_.empty())
+            break;
+        P->lineDirectives_.push_back(lineDir);
+    }
+    for (auto offset : oldLines) {
+        if (offset > restart)
+            break;
+        P->startOfLineOffsets_.push_back(offset);
+    }
+
+    // The tokens of the text after the change are those of the original text
+    // from the first (after the change) that is lexed identically.
+    const auto changeEnd = span.start() + change.newText().size();
+    LexedTokens::IndexType resyncTkIdx = 0;
+    auto resync = [&] (const SyntaxToken& tk) {
+        if (tk.charStart() < changeEnd)
+            return false;
+        auto tkIdx = firstTokenAtOrAfter(tk.charStart() - delta, oldTkCnt, oldTokenStart);
+        if (tkIdx == oldTkCnt)
+            return false;
+        const auto& oldTk = oldTokenAt(tkIdx);
+        if (oldTk.charStart() + delta != tk.charStart()
+                || oldTk.rawSyntaxK_ != tk.rawSyntaxK_
+                || oldTk.charSize_ != tk.charSize_
+                || oldTk.BF_all_ != tk.BF_all_) {
+            return false;
+        }
+        resyncTkIdx = tkIdx;
+        return true;
+    };
+
+    RelexedTokens relexedTks { restartTkIdx, static_cast<LexedTokens::IndexType>(oldTkCnt), 0 };
+
+    Lexer lexer(this);
+    if (lexer.relex(restart, lineIndexOf(oldLines, restart) + 1, resync)) {
+        relexedTks.oldResyncTkIdx = resyncTkIdx;
+        relexedTks.newResyncTkIdx = tokenCount();
+
+        const auto oldResync = oldTokenAt(resyncTkIdx).charStart();
+        const auto newResync = static_cast<unsigned int>(oldResync + delta);
+
+        // Discard line starts relayed past the resync token.
+        auto& lines = P->startOfLineOffsets_;
+        lines.erase(std::upper_bound(lines.begin(), lines.end(), newResync), lines.end());
+        const auto linenoDelta = static_cast<long long>(lineIndexOf(lines, newResync))
+                - lineIndexOf(oldLines, oldResync);
+        for (auto it = std::upper_bound(oldLines.begin(), oldLines.end(), oldResync);
+                it != oldLines.end();
+                ++it) {
+            lines.push_back(*it + delta);
+        }
+
+        auto shiftedToken = [&] (const SyntaxToken& oldTk) {
+            auto tk = adoptedToken(oldTk);
+            tk.byteOffset_ += delta;
+            tk.charOffset_ += delta;
+            tk.column_ += delta;
+            tk.lineno_ += linenoDelta;
+            return tk;
+        };
+        for (auto tkIdx = resyncTkIdx; tkIdx < oldTkCnt; ++tkIdx)
+            addToken(shiftedToken(oldTokenAt(tkIdx)));
+        for (const auto& tk : tree->comments_) {
+            if (tk.charStart() >= oldResync)
+                comments_.push_back(shiftedToken(tk));
+        }
+        for (const auto& lineDir : tree->P->lineDirectives_) {
+            if (lineDir.offset() > oldResync)
+                relayLineDirective(lineDir.offset() + delta, lineDir.lineno(), lineDir.fileName());
+        }
+    }
+
+    lexer.matchBraces();
+
+    if (!relexedTks.newResyncTkIdx)
+        relexedTks.newResyncTkIdx = tokenCount();
+    return relexedTks;
+}
+
+/**
+ * The SyntaxToken \p tk, of another SyntaxTree, as a SyntaxToken of \c this
+ * SyntaxTree (with its lexeme, if any, in \c this SyntaxTree).
+ */
+SyntaxToken SyntaxTree::adoptedToken(SyntaxToken tk)
+{
+    tk.tree_ = this;
+    if (!tk.lexeme_)
+        return tk;
+
+    const auto s = tk.lexeme_->c_str();
+    const auto size = tk.lexeme_->size();
+    switch (tk.lexeme_->kind()) {
+        case SyntaxLexeme::Kind::Identifier:
+            tk.identifier_ = identifier(s, size);
+            break;
+
+        case SyntaxLexeme::Kind::IntegerConstant:
+            tk.integer_ = integerConstant(s, size);
+            break;
+
+        case SyntaxLexeme::Kind::FloatingConstant:
+            tk.floating_ = floatingConstant(s, size);
+            break;
+
+        case SyntaxLexeme::Kind::CharacterConstant:
+            tk.character_ = characterConstant(s, size);
+            break;
+
+        case SyntaxLexeme::Kind::ImaginaryIntegerConstant:
+            tk.imaginaryInteger_ = imaginaryIntegerConstant(s, size);
+            break;
+
+        case SyntaxLexeme::Kind::ImaginaryFloatingConstant:
+            tk.imaginaryFloating_ = imaginaryFloatingConstant(s, size);
+            break;
+
+        case SyntaxLexeme::Kind::StringLiteral:
+            tk.string_ = stringLiteral(s, size);
+            break;
+
+        default:
+            PSY_ESCAPE_VIA_RETURN(tk);
+    }
+    return tk;
+}
+
 const ParseOptions& SyntaxTree::parseOptions() const
 {
     return P->parseOptions_;
@@ -348,6 +709,35 @@ void SyntaxTree::relayLineDirective(unsigned int offset,
     P->lineDirectives_.emplace_back(lineno, filePath, offset);
 }
 
+void SyntaxTree::relayParse(SyntaxNode* rootNode,
+                            SyntaxCategory syntaxCategory,
+                            bool parseExitedEarly)
+{
+    P->rootNode_ = rootNode;
+    P->syntaxCat_ = syntaxCategory;
+    P->parseExitedEarly_ = parseExitedEarly;
+}
+
+void SyntaxTree::relayDiagnostic(Diagnostic diagnostic)
+{
+    P->diagnostics_.push_back(std::move(diagnostic));
+}
+
+const std::vector<unsigned int>& SyntaxTree::lineStarts() const
+{
+    return P->startOfLineOffsets_;
+}
+
+const std::vector<LineDirective>& SyntaxTree::lineDirectives() const
+{
+    return P->lineDirectives_;
+}
+
+const SyntaxTree::ExpansionsTable& SyntaxTree::expansions() const
+{
+    return P->expansions_;
+}
+
 LinePosition SyntaxTree::computePosition(unsigned int offset) const
 {
     unsigned int lineno = 0;
@@ -373,7 +763,7 @@ LinePosition SyntaxTree::computePosition(unsigned int offset) const
 
 unsigned int SyntaxTree::searchForLineno(unsigned int offset) const
 {
-    auto it = std::lower_bound(P->startOfLineOffsets_.begin(),
+    auto it = std::upper_bound(P->startOfLineOffsets_.begin(),
                                P->startOfLineOffsets_.end(),
                                offset);
     if (it == P->startOfLineOffsets_.end())
@@ -417,7 +807,7 @@ void SyntaxTree::newDiagnostic(DiagnosticDescriptor descriptor,
     FileLinePositionSpan line(P->filePath_, start, end);
     std::string snippet;
 
-    auto it = std::lower_bound(P->startOfLineOffsets_.begin(), P->startOfLineOffsets_.end(), tk.charStart());
+    auto it = std::upper_bound(P->startOfLineOffsets_.begin(), P->startOfLineOffsets_.end(), tk.charStart());
     if (it != P->startOfLineOffsets_.begin()) {
         --it;
 
@@ -36,6 +36,7 @@
 #include "../common/infra/InternalAccess.h"
 #include "../common/infra/Pimpl.h"
 #include "../common/text/SourceText.h"
+#include "../common/text/TextChange.h"
 
 #include <cstdio>
 #include <iostream>
@@ -50,6 +51,8 @@
 namespace psy {
 namespace C {
 
+class Parser;
+
 /**
  * \brief The SyntaxTree class.
  *
@@ -119,23 +122,58 @@ public:
      */
     std::vector<Diagnostic> diagnostics() const;
 
+    /**
+     * Create a new SyntaxTree for the text of \c this SyntaxTree with the
+     * given \p change applied to it.
+     *
+     * Only the lines damaged by the \p change are lexed again: the tokens
+     * before and after them are reused from \c this SyntaxTree. Likewise,
+     * only the smallest compound statement (of a function definition) or
+     * the external declarations that enclose the damaged tokens are parsed
+     * again: the remaining nodes are adopted from \c this SyntaxTree.
+     */
+    std::unique_ptr<SyntaxTree> withChangedText(const TextChange& change) const;
+
 PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(SyntaxNode);
     PSY_GRANT_ACCESS(SyntaxNodeList);
     PSY_GRANT_ACCESS(Lexer);
+    PSY_GRANT_ACCESS(Preprocessor);
     PSY_GRANT_ACCESS(Parser);
     PSY_GRANT_ACCESS(Binder);
     PSY_GRANT_ACCESS(Symbol);
     PSY_GRANT_ACCESS(Compilation);
+    PSY_GRANT_ACCESS(SemanticModel);
     PSY_GRANT_ACCESS(InternalsTestSuite);
+    PSY_GRANT_ACCESS(PreprocessorTester);
     PSY_GRANT_ACCESS(SyntaxWriterDOTFormat); // TODO: Remove this grant.
+    PSY_GRANT_ACCESS(SyntaxWriterBinaryFormat);
+    PSY_GRANT_ACCESS(SyntaxReaderBinaryFormat);
 
     MemoryPool* unitPool() const;
+    MemoryPool* makeAuxUnitPool();
+
+    /* Nodes are identified densely, in the order in which they're made */
+    unsigned int makeNodeId();
+    unsigned int nodeCount() const;
 
     using TokenSequenceType = std::vector<SyntaxToken>;
     using LineColum = std::pair<unsigned int, unsigned int>;
     using ExpansionsTable = std::unordered_map<unsigned int, LineColum>;
 
+    /*
+     * The tokens of a SyntaxTree relexed from another one: those before
+     * `restartTkIdx' are at the same indices in both SyntaxTrees, and those
+     * from `oldResyncTkIdx' on, in the other one, are from `newResyncTkIdx'
+     * on.
+     */
+    struct RelexedTokens
+    {
+        LexedTokens::IndexType restartTkIdx;
+        LexedTokens::IndexType oldResyncTkIdx;
+        LexedTokens::IndexType newResyncTkIdx;
+    };
+
     /* Lexed-tokens access and manipulation */
     void addToken(SyntaxToken tk);
     SyntaxToken& tokenAt(LexedTokens::IndexType tkIdx);
@@ -145,6 +183,10 @@ PSY_INTERNAL_AND_RESTRICTED:
 
     bool parseExitedEarly() const;
 
+    TextPreprocessingState textPreprocessingState() const;
+    TextCompleteness textCompleteness() const;
+    SyntaxCategory syntaxCategory() const;
+
     const Identifier* identifier(const char* s, unsigned int size);
     const IntegerConstant* integerConstant(const char* s, unsigned int size);
     const FloatingConstant* floatingConstant(const char* s, unsigned int size);
@@ -156,6 +198,12 @@ PSY_INTERNAL_AND_RESTRICTED:
     void relayLineStart(unsigned int offset);
     void relayExpansion(unsigned int offset, std::pair<unsigned, unsigned> p);
     void relayLineDirective(unsigned int offset, unsigned int lineno, const std::string& filePath);
+    void relayParse(SyntaxNode* rootNode, SyntaxCategory syntaxCategory, bool parseExitedEarly);
+    void relayDiagnostic(Diagnostic diagnostic);
+
+    const std::vector<unsigned int>& lineStarts() const;
+    const std::vector<LineDirective>& lineDirectives() const;
+    const ExpansionsTable& expansions() const;
 
     const ParseOptions& parseOptions() const;
 
@@ -183,6 +231,14 @@ private:
     DECL_PIMPL(SyntaxTree)
 
     void buildFor(SyntaxCategory syntaxCategory);
+    void parseFor(SyntaxCategory syntaxCategory);
+    bool parseAdoptingFrom(const SyntaxTree* tree, const RelexedTokens& relexedTks);
+    void completeParse(Parser& parser);
+
+    bool admitsRelexFor(const TextChange& change) const;
+    bool admitsNodeAdoption() const;
+    RelexedTokens relexWith(const SyntaxTree* tree, const TextChange& change);
+    SyntaxToken adoptedToken(SyntaxToken tk);
 
     LinePosition computePosition(unsigned int offset) const;
     unsigned int searchForLineno(unsigned int offset) const;
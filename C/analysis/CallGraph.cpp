@@ -0,0 +1,96 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "CallGraph.h"
+
+#include "CallGraphBuilder.h"
+
+#include <algorithm>
+
+using namespace psy;
+using namespace C;
+
+CallGraph::CallGraph()
+{}
+
+CallGraph::~CallGraph()
+{}
+
+std::unique_ptr<CallGraph> CallGraph::build(const Compilation* compilation)
+{
+    if (!compilation)
+        return nullptr;
+
+    CallGraphBuilder builder(compilation);
+    return builder.build();
+}
+
+CallGraph::FunctionIndex CallGraph::indexOf(const FunctionDefinitionSyntax* funcDef) const
+{
+    auto it = funcDefIdxs_.find(funcDef);
+    return it == funcDefIdxs_.end() ? noFunction() : it->second;
+}
+
+CallGraph::FunctionIndex CallGraph::indexOf(const std::string& name) const
+{
+    auto it = externalIdxs_.find(name);
+    return it == externalIdxs_.end() ? noFunction() : it->second;
+}
+
+bool CallGraph::hasIndirectCalls(FunctionIndex func) const
+{
+    auto callSites = this->callSites(func);
+    return std::any_of(callSites.begin(), callSites.end(),
+                       [] (const CallSite& callSite) { return callSite.callee == noFunction(); });
+}
+
+bool CallGraph::isRecursive(FunctionIndex func) const
+{
+    if (componentMembers(componentOf(func)).size() > 1)
+        return true;
+
+    auto callees = this->callees(func);
+    return std::binary_search(callees.begin(), callees.end(), func);
+}
+
+namespace psy {
+namespace C {
+
+std::ostream& operator<<(std::ostream& os, const CallGraph& G)
+{
+    for (CallGraph::FunctionIndex func = 0; func < G.functionCount(); ++func) {
+        os << func << " " << G.name(func);
+        if (!G.functionDefinition(func))
+            os << " (undefined)";
+        auto callees = G.callees(func);
+        if (!callees.empty() || G.hasIndirectCalls(func)) {
+            os << " ->";
+            for (auto callee : callees)
+                os << " " << callee;
+            if (G.hasIndirectCalls(func))
+                os << " (indirect)";
+        }
+        os << std::endl;
+    }
+    return os;
+}
+
+} // C
+} // psy
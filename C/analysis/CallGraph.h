@@ -0,0 +1,237 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CALL_GRAPH_H__
+#define PSYCHE_C_CALL_GRAPH_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraph.h"
+
+#include "../common/infra/InternalAccess.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The CallGraph class.
+ *
+ * The call graph of the function definitions of a Compilation. Functions
+ * are identified by dense indexes: first, the ones defined in a SyntaxTree
+ * of the Compilation (in the order of the SyntaxTrees and, within each of
+ * them, of the definitions), and then, the ones that are only called. The
+ * call sites, callees, callers, and strongly connected components of the
+ * functions are stored in flat arrays, with the entries of a function laid
+ * out contiguously.
+ *
+ * The callee of a call whose expression is a (possibly parenthesized) name
+ * is resolved through the Scopes of the Binder: if the name designates a
+ * function, or isn't declared at all, the call is direct; otherwise (e.g.,
+ * the name designates a pointer to function), the call is indirect, and so
+ * is the call whose expression isn't a name.
+ *
+ * \note Similar to:
+ * - \c clang::CallGraph of Clang.
+ */
+class PSY_C_API CallGraph
+{
+public:
+    ~CallGraph();
+    CallGraph(const CallGraph&) = delete;
+    void operator=(const CallGraph&) = delete;
+
+    using FunctionIndex = std::uint32_t;
+    using ComponentIndex = std::uint32_t;
+
+    template <class T>
+    using Range = ControlFlowGraph::Range<T>;
+
+    /**
+     * The index that designates no function.
+     */
+    static constexpr FunctionIndex noFunction() { return std::numeric_limits<FunctionIndex>::max(); }
+
+    /**
+     * Build the CallGraph of the SyntaxTrees of the Compilation \p compilation,
+     * in a single traversal over them.
+     */
+    static std::unique_ptr<CallGraph> build(const Compilation* compilation);
+
+    /**
+     * \brief The CallSite struct.
+     *
+     * A call within the function \c caller to the function \c callee, which
+     * is \c CallGraph::noFunction() if the call is indirect.
+     */
+    struct CallSite
+    {
+        const CallExpressionSyntax* expr;
+        FunctionIndex caller;
+        FunctionIndex callee;
+    };
+
+    /**
+     * The number of functions in \c this CallGraph.
+     */
+    std::size_t functionCount() const { return names_.size(); }
+
+    /**
+     * The number of functions defined in a SyntaxTree of the Compilation;
+     * their indexes precede those of the functions that are only called.
+     */
+    std::size_t definedFunctionCount() const { return funcDefs_.size(); }
+
+    /**
+     * The name of function \p func.
+     */
+    const std::string& name(FunctionIndex func) const { return names_[func]; }
+
+    /**
+     * The FunctionDefinitionSyntax of function \p func, if it's defined in
+     * a SyntaxTree of the Compilation.
+     */
+    const FunctionDefinitionSyntax* functionDefinition(FunctionIndex func) const
+    {
+        return func < funcDefs_.size() ? funcDefs_[func] : nullptr;
+    }
+
+    /**
+     * The SyntaxTree in which function \p func is defined, if any.
+     */
+    const SyntaxTree* syntaxTree(FunctionIndex func) const
+    {
+        return func < funcDefs_.size() ? trees_[func] : nullptr;
+    }
+
+    //!@{
+    /**
+     * The index of the function defined by FunctionDefinitionSyntax \p funcDef,
+     * or of the function with external linkage named \p name; \c CallGraph::noFunction()
+     * if there's no such function.
+     */
+    FunctionIndex indexOf(const FunctionDefinitionSyntax* funcDef) const;
+    FunctionIndex indexOf(const std::string& name) const;
+    //!@}
+
+    /**
+     * The call sites within function \p func, in source order.
+     */
+    Range<CallSite> callSites(FunctionIndex func) const
+    {
+        return rangeOf(callSites_, callSiteOffsets_, func);
+    }
+
+    /**
+     * The functions directly called by function \p func, each one once, in
+     * increasing order of index.
+     */
+    Range<FunctionIndex> callees(FunctionIndex func) const
+    {
+        return rangeOf(callees_, calleeOffsets_, func);
+    }
+
+    /**
+     * The functions that directly call function \p func, each one once, in
+     * increasing order of index.
+     */
+    Range<FunctionIndex> callers(FunctionIndex func) const
+    {
+        return rangeOf(callers_, callerOffsets_, func);
+    }
+
+    /**
+     * Whether function \p func has an indirect call site.
+     */
+    bool hasIndirectCalls(FunctionIndex func) const;
+
+    /**
+     * The number of strongly connected components of \c this CallGraph.
+     *
+     * \remark The components are in reverse topological order: a component
+     * precedes the components of the functions that call into it.
+     */
+    std::size_t componentCount() const { return componentOffsets_.size() - 1; }
+
+    /**
+     * The strongly connected component of function \p func.
+     */
+    ComponentIndex componentOf(FunctionIndex func) const { return components_[func]; }
+
+    /**
+     * The functions of strongly connected component \p comp.
+     */
+    Range<FunctionIndex> componentMembers(ComponentIndex comp) const
+    {
+        return rangeOf(componentMembers_, componentOffsets_, comp);
+    }
+
+    /**
+     * Whether function \p func may call itself, either directly
+     * or through other functions.
+     */
+    bool isRecursive(FunctionIndex func) const;
+
+PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(CallGraphBuilder);
+
+    CallGraph();
+
+private:
+    std::vector<std::string> names_;
+    std::vector<const FunctionDefinitionSyntax*> funcDefs_;
+    std::vector<const SyntaxTree*> trees_;
+    std::unordered_map<const FunctionDefinitionSyntax*, FunctionIndex> funcDefIdxs_;
+    std::unordered_map<std::string, FunctionIndex> externalIdxs_;
+
+    std::vector<CallSite> callSites_;
+    std::vector<std::uint32_t> callSiteOffsets_;
+    std::vector<FunctionIndex> callees_;
+    std::vector<std::uint32_t> calleeOffsets_;
+    std::vector<FunctionIndex> callers_;
+    std::vector<std::uint32_t> callerOffsets_;
+
+    std::vector<ComponentIndex> components_;
+    std::vector<FunctionIndex> componentMembers_;
+    std::vector<std::uint32_t> componentOffsets_;
+
+    template <class T>
+    static Range<T> rangeOf(const std::vector<T>& entries,
+                            const std::vector<std::uint32_t>& offsets,
+                            std::uint32_t idx)
+    {
+        return Range<T>(entries.data() + offsets[idx], entries.data() + offsets[idx + 1]);
+    }
+};
+
+PSY_C_API std::ostream& operator<<(std::ostream& os, const CallGraph& G);
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,469 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "CallGraphBuilder.h"
+
+#include "SyntaxTree.h"
+
+#include "binder/Scope.h"
+#include "compilation/Compilation.h"
+#include "compilation/SemanticModel.h"
+#include "symbols/Symbol_ALL.h"
+#include "syntax/SyntaxLexeme_Identifier.h"
+#include "syntax/SyntaxNodes.h"
+#include "syntax/SyntaxUtilities.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+const ParameterDeclarationListSyntax* parametersOf(const FunctionDefinitionSyntax* funcDef)
+{
+    /*
+     * The parameters are those of the function declarator that immediately
+     * encloses the declarator of the function's name, as in \c int (*f(int p))(char).
+     */
+    auto decltor = SyntaxUtilities::strippedDeclaratorOrSelf(funcDef->declarator());
+    while (decltor) {
+        auto innerDecltor = SyntaxUtilities::innerDeclaratorOrSelf(decltor);
+        if (innerDecltor == decltor)
+            return nullptr;
+        innerDecltor = SyntaxUtilities::strippedDeclaratorOrSelf(innerDecltor);
+
+        auto arrOrFuncDecltor = decltor->asArrayOrFunctionDeclarator();
+        if (arrOrFuncDecltor
+                && innerDecltor->kind() == IdentifierDeclarator
+                && arrOrFuncDecltor->suffix()
+                && arrOrFuncDecltor->suffix()->asParameterSuffix()) {
+            return arrOrFuncDecltor->suffix()->asParameterSuffix()->parameters();
+        }
+        decltor = innerDecltor;
+    }
+    return nullptr;
+}
+
+bool hasInternalLinkage(const FunctionDefinitionSyntax* funcDef)
+{
+    for (auto specIt = funcDef->specifiers(); specIt; specIt = specIt->next) {
+        if (specIt->value && specIt->value->kind() == StaticStorageClass)
+            return true;
+    }
+    return false;
+}
+
+std::string nameOf(const FunctionDefinitionSyntax* funcDef)
+{
+    auto decltor = SyntaxUtilities::innermostDeclaratorOrSelf(funcDef->declarator());
+    if (decltor && decltor->kind() == IdentifierDeclarator)
+        return decltor->asIdentifierDeclarator()->identifierToken().valueText();
+    return "";
+}
+
+/*
+ * Lay out \p entries by function, keeping their relative order within a
+ * function, and record where the entries of each function start in \p offsets.
+ */
+template <class T, class FunctionOfT>
+std::vector<T> layOutGroupedBy(const std::vector<T>& entries,
+                               std::size_t funcCnt,
+                               FunctionOfT functionOf,
+                               std::vector<std::uint32_t>& offsets)
+{
+    offsets.assign(funcCnt + 1, 0);
+    for (const auto& entry : entries)
+        ++offsets[functionOf(entry) + 1];
+    for (auto func = 0U; func < funcCnt; ++func)
+        offsets[func + 1] += offsets[func];
+
+    std::vector<T> laidOut(entries.size());
+    std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+    for (const auto& entry : entries)
+        laidOut[next[functionOf(entry)]++] = entry;
+    return laidOut;
+}
+
+} // anonymous
+
+CallGraphBuilder::CallGraphBuilder(const Compilation* compilation)
+    : compilation_(compilation)
+{}
+
+std::unique_ptr<CallGraph> CallGraphBuilder::build()
+{
+    G_.reset(new CallGraph);
+
+    for (auto tree : compilation_->syntaxTrees()) {
+        TreeTraversal traversal(tree, compilation_->semanticModel(tree), this);
+        traversal.traverse();
+    }
+
+    std::vector<CallGraph::CallSite> callSites;
+    callSites.reserve(calls_.size());
+    for (const auto& call : calls_)
+        callSites.push_back({ call.expr, call.caller, resolve(call) });
+
+    layOutByFunction(callSites);
+    computeComponents();
+
+    return std::move(G_);
+}
+
+CallGraphBuilder::FunctionIndex CallGraphBuilder::addFunction(const std::string& name,
+                                                              const FunctionDefinitionSyntax* funcDef,
+                                                              const SyntaxTree* tree,
+                                                              bool isInternal)
+{
+    FunctionIndex func = G_->names_.size();
+    G_->names_.push_back(name);
+    if (funcDef) {
+        G_->funcDefs_.push_back(funcDef);
+        G_->trees_.push_back(tree);
+        G_->funcDefIdxs_.emplace(funcDef, func);
+    }
+
+    /*
+     * If a name is (erroneously) defined more than once, calls are resolved
+     * to the first definition.
+     */
+    if (isInternal)
+        internalIdxs_[tree].emplace(name, func);
+    else
+        G_->externalIdxs_.emplace(name, func);
+
+    return func;
+}
+
+CallGraphBuilder::FunctionIndex CallGraphBuilder::resolve(const CallInfo& call)
+{
+    if (call.isIndirect)
+        return CallGraph::noFunction();
+
+    auto treeIt = internalIdxs_.find(G_->trees_[call.caller]);
+    if (treeIt != internalIdxs_.end()) {
+        auto it = treeIt->second.find(call.calleeName);
+        if (it != treeIt->second.end())
+            return it->second;
+    }
+
+    auto it = G_->externalIdxs_.find(call.calleeName);
+    if (it != G_->externalIdxs_.end())
+        return it->second;
+
+    return addFunction(call.calleeName, nullptr, nullptr, false);
+}
+
+void CallGraphBuilder::layOutByFunction(const std::vector<CallGraph::CallSite>& callSites)
+{
+    auto funcCnt = G_->functionCount();
+
+    G_->callSites_ = layOutGroupedBy(
+            callSites,
+            funcCnt,
+            [] (const CallGraph::CallSite& callSite) { return callSite.caller; },
+            G_->callSiteOffsets_);
+
+    G_->calleeOffsets_.assign(1, 0);
+    std::vector<std::pair<FunctionIndex, FunctionIndex>> edges;
+    for (FunctionIndex func = 0; func < funcCnt; ++func) {
+        auto first = G_->callees_.size();
+        for (const auto& callSite : G_->callSites(func)) {
+            if (callSite.callee != CallGraph::noFunction())
+                G_->callees_.push_back(callSite.callee);
+        }
+        std::sort(G_->callees_.begin() + first, G_->callees_.end());
+        G_->callees_.erase(std::unique(G_->callees_.begin() + first, G_->callees_.end()),
+                           G_->callees_.end());
+        G_->calleeOffsets_.push_back(G_->callees_.size());
+
+        for (auto i = first; i < G_->callees_.size(); ++i)
+            edges.emplace_back(func, G_->callees_[i]);
+    }
+
+    auto callers = layOutGroupedBy(
+            edges,
+            funcCnt,
+            [] (const std::pair<FunctionIndex, FunctionIndex>& edge) { return edge.second; },
+            G_->callerOffsets_);
+    G_->callers_.reserve(callers.size());
+    for (const auto& edge : callers)
+        G_->callers_.push_back(edge.first);
+}
+
+void CallGraphBuilder::computeComponents()
+{
+    /*
+     * An iterative formulation of Tarjan's algorithm, which produces the
+     * components in reverse topological order.
+     */
+    static constexpr std::uint32_t kUnvisited = std::numeric_limits<std::uint32_t>::max();
+
+    auto funcCnt = G_->functionCount();
+    std::vector<std::uint32_t> order(funcCnt, kUnvisited);
+    std::vector<std::uint32_t> lowLink(funcCnt);
+    std::vector<bool> isOnStack(funcCnt, false);
+    std::vector<FunctionIndex> stack;
+
+    struct Frame
+    {
+        FunctionIndex func;
+        std::uint32_t nextCallee;
+    };
+    std::vector<Frame> frames;
+
+    G_->components_.assign(funcCnt, 0);
+    G_->componentMembers_.reserve(funcCnt);
+    G_->componentOffsets_.assign(1, 0);
+
+    std::uint32_t cnt = 0;
+    auto discover = [&] (FunctionIndex func) {
+        order[func] = lowLink[func] = cnt++;
+        stack.push_back(func);
+        isOnStack[func] = true;
+        frames.push_back({ func, 0 });
+    };
+
+    for (FunctionIndex root = 0; root < funcCnt; ++root) {
+        if (order[root] != kUnvisited)
+            continue;
+
+        discover(root);
+        while (!frames.empty()) {
+            auto func = frames.back().func;
+            auto callees = G_->callees(func);
+            if (frames.back().nextCallee < callees.size()) {
+                auto callee = callees[frames.back().nextCallee++];
+                if (order[callee] == kUnvisited)
+                    discover(callee);
+                else if (isOnStack[callee])
+                    lowLink[func] = std::min(lowLink[func], order[callee]);
+                continue;
+            }
+
+            frames.pop_back();
+            if (!frames.empty()) {
+                auto caller = frames.back().func;
+                lowLink[caller] = std::min(lowLink[caller], lowLink[func]);
+            }
+            if (lowLink[func] != order[func])
+                continue;
+
+            CallGraph::ComponentIndex comp = G_->componentOffsets_.size() - 1;
+            auto first = G_->componentMembers_.size();
+            FunctionIndex member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                isOnStack[member] = false;
+                G_->components_[member] = comp;
+                G_->componentMembers_.push_back(member);
+            } while (member != func);
+            std::sort(G_->componentMembers_.begin() + first, G_->componentMembers_.end());
+            G_->componentOffsets_.push_back(G_->componentMembers_.size());
+        }
+    }
+}
+
+CallGraphBuilder::TreeTraversal::TreeTraversal(const SyntaxTree* tree,
+                                               const SemanticModel* semaModel,
+                                               CallGraphBuilder* builder)
+    : SyntaxVisitor(tree)
+    , semaModel_(semaModel)
+    , builder_(builder)
+    , curFunc_(CallGraph::noFunction())
+{}
+
+void CallGraphBuilder::TreeTraversal::traverse()
+{
+    visit(tree_->translationUnitRoot());
+}
+
+void CallGraphBuilder::TreeTraversal::openBlock()
+{
+    scopes_.push_back(scopes_.empty() ? nullptr : scopes_.back());
+    blockSyms_.emplace_back();
+}
+
+void CallGraphBuilder::TreeTraversal::closeBlock()
+{
+    for (auto sym : blockSyms_.back())
+        declaredSyms_.erase(sym);
+    blockSyms_.pop_back();
+    scopes_.pop_back();
+}
+
+void CallGraphBuilder::TreeTraversal::declare(const Symbol* sym)
+{
+    if (!sym || !declaredSyms_.insert(sym).second)
+        return;
+    if (!blockSyms_.empty())
+        blockSyms_.back().push_back(sym);
+}
+
+/*
+ * Search for the declaration of \p ident that is visible at this point: one
+ * in the innermost Scope known that was already traversed, or else in an
+ * outer Scope.
+ */
+const Symbol* CallGraphBuilder::TreeTraversal::searchForDeclaration(const Identifier* ident) const
+{
+    auto scope = scopes_.empty() ? nullptr : scopes_.back();
+    for (; scope; scope = scope->outerScope()) {
+        auto sym = scope->searchForDeclarationHere(ident, NameSpaceKind::Ordinary);
+        if (sym && declaredSyms_.count(sym))
+            return sym;
+    }
+    return nullptr;
+}
+
+    //--------------//
+    // Declarations //
+    //--------------//
+
+SyntaxVisitor::Action CallGraphBuilder::TreeTraversal::visitFunctionDefinition(const FunctionDefinitionSyntax* node)
+{
+    curFunc_ = builder_->addFunction(nameOf(node), node, tree_, hasInternalLinkage(node));
+
+    const Scope* scope = nullptr;
+    std::vector<const Symbol*> parmSyms;
+    if (semaModel_) {
+        if (auto funcSym = semaModel_->declaredSymbol(node)) {
+            declare(funcSym);
+            scope = funcSym->scope();
+        }
+        for (auto parmIt = parametersOf(node); parmIt; parmIt = parmIt->next) {
+            auto parmSym = parmIt->value ? semaModel_->declaredSymbol(parmIt->value) : nullptr;
+            if (parmSym && parmSym->scope()) {
+                scope = parmSym->scope();
+                parmSyms.push_back(parmSym);
+            }
+        }
+    }
+
+    scopes_.assign(1, scope);
+    blockSyms_.emplace_back();
+    for (auto parmSym : parmSyms)
+        declare(parmSym);
+    visit(node->body());
+    closeBlock();
+    curFunc_ = CallGraph::noFunction();
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action CallGraphBuilder::TreeTraversal::visitVariableAndOrFunctionDeclaration(
+        const VariableAndOrFunctionDeclarationSyntax* node)
+{
+    if (!semaModel_)
+        return curFunc_ == CallGraph::noFunction() ? Action::Skip : Action::Visit;
+
+    for (auto sym : semaModel_->declaredSymbols(node)) {
+        if (!sym)
+            continue;
+        declare(sym);
+        if (curFunc_ != CallGraph::noFunction()
+                && sym->scope()
+                && sym->scope()->kind() == ScopeKind::Block) {
+            scopes_.back() = sym->scope();
+        }
+    }
+
+    return curFunc_ == CallGraph::noFunction() ? Action::Skip : Action::Visit;
+}
+
+    //------------//
+    // Statements //
+    //------------//
+
+SyntaxVisitor::Action CallGraphBuilder::TreeTraversal::visitCompoundStatement(const CompoundStatementSyntax* node)
+{
+    openBlock();
+
+    for (auto stmtIt = node->statements(); stmtIt; stmtIt = stmtIt->next)
+        visit(stmtIt->value);
+
+    closeBlock();
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action CallGraphBuilder::TreeTraversal::visitForStatement(const ForStatementSyntax* node)
+{
+    /*
+     * The declarations of the \c for statement are visible only within it
+     * (6.8.5-5).
+     */
+    openBlock();
+
+    visit(node->initializer());
+    visit(node->condition());
+    visit(node->expression());
+    visit(node->statement());
+
+    closeBlock();
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action CallGraphBuilder::TreeTraversal::visitAmbiguousExpressionOrDeclarationStatement(
+        const AmbiguousExpressionOrDeclarationStatementSyntax* node)
+{
+    /*
+     * An unresolved ambiguity is taken as an expression, so that no call
+     * is missed (at the expense of a spurious one).
+     */
+    visit(node->expressionStatement());
+
+    return Action::Skip;
+}
+
+    //-------------//
+    // Expressions //
+    //-------------//
+
+SyntaxVisitor::Action CallGraphBuilder::TreeTraversal::visitCallExpression(const CallExpressionSyntax* node)
+{
+    if (curFunc_ == CallGraph::noFunction())
+        return Action::Visit;
+
+    CallInfo call{ node, curFunc_, "", true };
+
+    auto expr = node->expression();
+    while (expr && expr->kind() == ParenthesizedExpression)
+        expr = expr->asParenthesizedExpression()->expression();
+
+    if (expr && expr->kind() == IdentifierName) {
+        auto identTk = expr->asIdentifierName()->identifierToken();
+        auto ident = identTk.valueLexeme() ? identTk.valueLexeme()->asIdentifier() : nullptr;
+        auto sym = ident ? searchForDeclaration(ident) : nullptr;
+        if (!sym || sym->kind() == SymbolKind::Function) {
+            call.calleeName = identTk.valueText();
+            call.isIndirect = false;
+        }
+    }
+
+    builder_->calls_.push_back(std::move(call));
+
+    return Action::Visit;
+}
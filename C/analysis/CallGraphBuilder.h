@@ -0,0 +1,149 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CALL_GRAPH_BUILDER_H__
+#define PSYCHE_C_CALL_GRAPH_BUILDER_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "CallGraph.h"
+
+#include "syntax/SyntaxVisitor.h"
+
+#include "../common/infra/InternalAccess.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The CallGraphBuilder class.
+ *
+ * Build the CallGraph of a Compilation in a single traversal over its
+ * SyntaxTrees, recording the function definitions and, within them, the
+ * call expressions. Callees are resolved once the traversal is over, since
+ * a function may be called before (or in a SyntaxTree other than the one
+ * in which) it's defined.
+ */
+class PSY_C_NON_API CallGraphBuilder final
+{
+PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(CallGraph);
+
+    CallGraphBuilder(const Compilation* compilation);
+
+    std::unique_ptr<CallGraph> build();
+
+private:
+    using FunctionIndex = CallGraph::FunctionIndex;
+
+    const Compilation* compilation_;
+    std::unique_ptr<CallGraph> G_;
+
+    struct CallInfo
+    {
+        const CallExpressionSyntax* expr;
+        FunctionIndex caller;
+        std::string calleeName;
+        bool isIndirect;
+    };
+    std::vector<CallInfo> calls_;
+
+    std::unordered_map<const SyntaxTree*, std::unordered_map<std::string, FunctionIndex>> internalIdxs_;
+
+    class TreeTraversal;
+
+    FunctionIndex addFunction(const std::string& name,
+                              const FunctionDefinitionSyntax* funcDef,
+                              const SyntaxTree* tree,
+                              bool isInternal);
+    FunctionIndex resolve(const CallInfo& call);
+    void layOutByFunction(const std::vector<CallGraph::CallSite>& callSites);
+    void computeComponents();
+};
+
+/**
+ * \brief The CallGraphBuilder::TreeTraversal class.
+ *
+ * Record, for the CallGraphBuilder, the function definitions of a SyntaxTree
+ * and the call expressions within them.
+ */
+class PSY_C_NON_API CallGraphBuilder::TreeTraversal final : protected SyntaxVisitor
+{
+public:
+    TreeTraversal(const SyntaxTree* tree, const SemanticModel* semaModel, CallGraphBuilder* builder);
+
+    void traverse();
+
+private:
+    const SemanticModel* semaModel_;
+    CallGraphBuilder* builder_;
+    FunctionIndex curFunc_;
+
+    /*
+     * The innermost Scope, known up to this point, of each compound statement
+     * being traversed: a Scope is only learned through the Symbol of a
+     * declaration within it, but a Scope without declarations is immaterial
+     * for name resolution.
+     */
+    std::vector<const Scope*> scopes_;
+
+    /*
+     * The Symbols whose declarations were traversed up to this point, and, for
+     * each block (or \c for statement) being traversed, those declared within
+     * it: a Scope also holds the declarations that follow a call.
+     */
+    std::unordered_set<const Symbol*> declaredSyms_;
+    std::vector<std::vector<const Symbol*>> blockSyms_;
+
+    void openBlock();
+    void closeBlock();
+    void declare(const Symbol* sym);
+    const Symbol* searchForDeclaration(const Identifier* ident) const;
+
+    //--------------//
+    // Declarations //
+    //--------------//
+    virtual Action visitFunctionDefinition(const FunctionDefinitionSyntax*) override;
+    virtual Action visitVariableAndOrFunctionDeclaration(const VariableAndOrFunctionDeclarationSyntax*) override;
+
+    //------------//
+    // Statements //
+    //------------//
+    virtual Action visitCompoundStatement(const CompoundStatementSyntax*) override;
+    virtual Action visitForStatement(const ForStatementSyntax*) override;
+    virtual Action visitAmbiguousExpressionOrDeclarationStatement(const AmbiguousExpressionOrDeclarationStatementSyntax*) override;
+
+    //-------------//
+    // Expressions //
+    //-------------//
+    virtual Action visitCallExpression(const CallExpressionSyntax*) override;
+};
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_EDGE_KIND_H__
+#define PSYCHE_C_CONTROL_FLOW_EDGE_KIND_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "../common/infra/Escape.h"
+
+#include <cstdint>
+#include <string>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The ControlFlowEdgeKind enum.
+ *
+ * The kind of an edge of a ControlFlowGraph, which tells why control may
+ * pass from the source block to the target block.
+ */
+enum class PSY_C_API ControlFlowEdgeKind : std::uint8_t
+{
+    UNSPECIFIED = 0,
+
+    Sequential,
+    True,
+    False,
+    Case,
+    Default,
+    Back,
+    Goto,
+    Break,
+    Continue,
+    Return
+};
+
+inline std::string PSY_C_API to_string(ControlFlowEdgeKind edgeK)
+{
+    switch (edgeK) {
+        case ControlFlowEdgeKind::Sequential:
+            return "Sequential";
+        case ControlFlowEdgeKind::True:
+            return "True";
+        case ControlFlowEdgeKind::False:
+            return "False";
+        case ControlFlowEdgeKind::Case:
+            return "Case";
+        case ControlFlowEdgeKind::Default:
+            return "Default";
+        case ControlFlowEdgeKind::Back:
+            return "Back";
+        case ControlFlowEdgeKind::Goto:
+            return "Goto";
+        case ControlFlowEdgeKind::Break:
+            return "Break";
+        case ControlFlowEdgeKind::Continue:
+            return "Continue";
+        case ControlFlowEdgeKind::Return:
+            return "Return";
+        default:
+            PSY_ESCAPE_VIA_RETURN("<INVALID or UNSPECIFIED ControlFlowEdgeKind>");
+    }
+}
+
+} // C
+} // psy
+
+#endif
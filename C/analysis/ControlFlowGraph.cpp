@@ -0,0 +1,128 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ControlFlowGraph.h"
+
+#include "ControlFlowGraphBuilder.h"
+
+#include "SyntaxTree.h"
+
+#include "syntax/SyntaxNodes.h"
+#include "syntax/SyntaxUtilities.h"
+
+#include "infra/HardwareThreads.h"
+
+#include <algorithm>
+
+using namespace psy;
+using namespace C;
+
+ControlFlowGraph::ControlFlowGraph(const FunctionDefinitionSyntax* funcDef)
+    : funcDef_(funcDef)
+{}
+
+ControlFlowGraph::~ControlFlowGraph()
+{}
+
+std::unique_ptr<ControlFlowGraph> ControlFlowGraph::build(const FunctionDefinitionSyntax* funcDef)
+{
+    if (!funcDef)
+        return nullptr;
+
+    ControlFlowGraphBuilder builder(funcDef);
+    return builder.build();
+}
+
+std::vector<std::unique_ptr<ControlFlowGraph>> ControlFlowGraph::buildAll(const TranslationUnitSyntax* TU)
+{
+    return buildAll(TU, runOnHardwareThreads);
+}
+
+std::vector<std::unique_ptr<ControlFlowGraph>> ControlFlowGraph::buildAll(const TranslationUnitSyntax* TU,
+                                                                          const Executor& executor)
+{
+    std::vector<const FunctionDefinitionSyntax*> funcDefs;
+    for (auto declIt = TU ? TU->declarations() : nullptr; declIt; declIt = declIt->next) {
+        if (declIt->value && declIt->value->asFunctionDefinition())
+            funcDefs.push_back(declIt->value->asFunctionDefinition());
+    }
+
+    /*
+     * A builder only reads the syntax of its function definition and writes
+     * to its own ControlFlowGraph, so the tasks share no mutable state.
+     */
+    std::vector<std::unique_ptr<ControlFlowGraph>> cfgs(funcDefs.size());
+    std::vector<std::function<void ()>> tasks;
+    tasks.reserve(funcDefs.size());
+    for (auto i = 0U; i < funcDefs.size(); ++i)
+        tasks.push_back([&funcDefs, &cfgs, i] () { cfgs[i] = build(funcDefs[i]); });
+
+    if (!tasks.empty())
+        executor(tasks);
+
+    return cfgs;
+}
+
+namespace psy {
+namespace C {
+
+std::ostream& operator<<(std::ostream& os, const ControlFlowGraph& cfg)
+{
+    auto funcDef = cfg.functionDefinition();
+    auto decltor = SyntaxUtilities::innermostDeclaratorOrSelf(funcDef->declarator());
+    os << "function "
+       << (decltor && decltor->kind() == IdentifierDeclarator
+                ? decltor->asIdentifierDeclarator()->identifierToken().valueText()
+                : std::string("<anonymous>"))
+       << std::endl;
+
+    const auto& text = funcDef->syntaxTree()->text().rawText();
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg.blockCount(); ++blk) {
+        os << "  B" << blk;
+        if (blk == cfg.entryBlock())
+            os << " (entry)";
+        else if (blk == cfg.exitBlock())
+            os << " (exit)";
+        if (cfg.label(blk))
+            os << " " << to_string(cfg.label(blk)->kind());
+        os << std::endl;
+
+        for (const auto& elem : cfg.elements(blk)) {
+            auto snippet = text.substr(elem.span.start(), elem.span.end() - elem.span.start());
+            std::replace_if(snippet.begin(), snippet.end(), [] (char c) { return c == '\n' || c == '\t'; }, ' ');
+            os << "    " << to_string(elem.node->kind()) << " `" << snippet << "`" << std::endl;
+        }
+
+        if (cfg.terminator(blk))
+            os << "    terminator: " << to_string(cfg.terminator(blk)->kind()) << std::endl;
+
+        if (!cfg.successors(blk).empty()) {
+            os << "    ->";
+            for (const auto& edge : cfg.successors(blk))
+                os << " B" << edge.target << " (" << to_string(edge.kind) << ")";
+            os << std::endl;
+        }
+    }
+
+    return os;
+}
+
+} // C
+} // psy
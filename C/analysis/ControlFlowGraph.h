@@ -0,0 +1,222 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_GRAPH_H__
+#define PSYCHE_C_CONTROL_FLOW_GRAPH_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowEdgeKind.h"
+
+#include "../common/infra/InternalAccess.h"
+#include "../common/text/TextSpan.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The ControlFlowGraph class.
+ *
+ * The control-flow graph of a single function definition. Blocks are
+ * identified by dense indexes, and their elements, successors, and
+ * predecessors are stored in flat arrays, with the entries of a block
+ * laid out contiguously.
+ *
+ * \note Similar to:
+ * - \c clang::CFG of Clang.
+ * - \c Microsoft.CodeAnalysis.FlowAnalysis.ControlFlowGraph of Roslyn.
+ */
+class PSY_C_API ControlFlowGraph
+{
+public:
+    ~ControlFlowGraph();
+    ControlFlowGraph(const ControlFlowGraph&) = delete;
+    void operator=(const ControlFlowGraph&) = delete;
+
+    using BlockIndex = std::uint32_t;
+
+    /**
+     * Build the ControlFlowGraph of the FunctionDefinitionSyntax \p funcDef.
+     */
+    static std::unique_ptr<ControlFlowGraph> build(const FunctionDefinitionSyntax* funcDef);
+
+    /**
+     * An executor runs a batch of tasks, possibly concurrently, and returns
+     * once all of them are finished.
+     */
+    using Executor = std::function<void (const std::vector<std::function<void ()>>&)>;
+
+    //!@{
+    /**
+     * Build the ControlFlowGraph of every function definition of the
+     * TranslationUnitSyntax \p TU, each one in a task of \p executor (by
+     * default, one that runs on all hardware threads).
+     *
+     * \remark The ControlFlowGraphs are in the order of the function definitions.
+     */
+    static std::vector<std::unique_ptr<ControlFlowGraph>> buildAll(const TranslationUnitSyntax* TU);
+    static std::vector<std::unique_ptr<ControlFlowGraph>> buildAll(const TranslationUnitSyntax* TU,
+                                                                   const Executor& executor);
+    //!@}
+
+    /**
+     * \brief The Element struct.
+     *
+     * A statement, or the controlling expression of a selection or iteration
+     * statement, evaluated within a block.
+     */
+    struct Element
+    {
+        const SyntaxNode* node;
+        TextSpan span;
+    };
+
+    /**
+     * \brief The Edge struct.
+     */
+    struct Edge
+    {
+        BlockIndex source;
+        BlockIndex target;
+        ControlFlowEdgeKind kind;
+    };
+
+    /**
+     * \brief The Range class.
+     *
+     * A view over the contiguous entries of a block.
+     */
+    template <class T>
+    class Range
+    {
+    public:
+        Range(const T* first, const T* last) : first_(first), last_(last) {}
+
+        const T* begin() const { return first_; }
+        const T* end() const { return last_; }
+        std::size_t size() const { return last_ - first_; }
+        bool empty() const { return first_ == last_; }
+        const T& operator[](std::size_t idx) const { return first_[idx]; }
+
+    private:
+        const T* first_;
+        const T* last_;
+    };
+
+    /**
+     * The FunctionDefinitionSyntax of \c this ControlFlowGraph.
+     */
+    const FunctionDefinitionSyntax* functionDefinition() const { return funcDef_; }
+
+    /**
+     * The entry block of \c this ControlFlowGraph.
+     */
+    BlockIndex entryBlock() const { return 0; }
+
+    /**
+     * The exit block of \c this ControlFlowGraph.
+     */
+    BlockIndex exitBlock() const { return 1; }
+
+    /**
+     * The number of blocks in \c this ControlFlowGraph.
+     */
+    std::size_t blockCount() const { return labels_.size(); }
+
+    /**
+     * The number of edges in \c this ControlFlowGraph.
+     */
+    std::size_t edgeCount() const { return succs_.size(); }
+
+    /**
+     * The elements of block \p blk, in evaluation order.
+     */
+    Range<Element> elements(BlockIndex blk) const
+    {
+        return rangeOf(elems_, elemOffsets_, blk);
+    }
+
+    /**
+     * The edges that leave block \p blk.
+     */
+    Range<Edge> successors(BlockIndex blk) const
+    {
+        return rangeOf(succs_, succOffsets_, blk);
+    }
+
+    /**
+     * The edges that enter block \p blk.
+     */
+    Range<Edge> predecessors(BlockIndex blk) const
+    {
+        return rangeOf(preds_, predOffsets_, blk);
+    }
+
+    /**
+     * The LabeledStatementSyntax that starts block \p blk, if any.
+     */
+    const LabeledStatementSyntax* label(BlockIndex blk) const { return labels_[blk]; }
+
+    /**
+     * The StatementSyntax that transfers control at the end of block \p blk, if any:
+     * a selection, iteration, or jump statement.
+     */
+    const StatementSyntax* terminator(BlockIndex blk) const { return terminators_[blk]; }
+
+PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(ControlFlowGraphBuilder);
+
+    ControlFlowGraph(const FunctionDefinitionSyntax* funcDef);
+
+private:
+    const FunctionDefinitionSyntax* funcDef_;
+
+    std::vector<Element> elems_;
+    std::vector<std::uint32_t> elemOffsets_;
+    std::vector<Edge> succs_;
+    std::vector<std::uint32_t> succOffsets_;
+    std::vector<Edge> preds_;
+    std::vector<std::uint32_t> predOffsets_;
+    std::vector<const LabeledStatementSyntax*> labels_;
+    std::vector<const StatementSyntax*> terminators_;
+
+    template <class T>
+    static Range<T> rangeOf(const std::vector<T>& entries,
+                            const std::vector<std::uint32_t>& offsets,
+                            BlockIndex blk)
+    {
+        return Range<T>(entries.data() + offsets[blk], entries.data() + offsets[blk + 1]);
+    }
+};
+
+PSY_C_API std::ostream& operator<<(std::ostream& os, const ControlFlowGraph& cfg);
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,445 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ControlFlowGraphBuilder.h"
+
+#include "SyntaxTree.h"
+
+#include "syntax/SyntaxNodes.h"
+#include "syntax/SyntaxToken.h"
+
+#include "../common/infra/Assertions.h"
+#include "../common/infra/Escape.h"
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+/*
+ * Lay out \p entries by block, keeping their relative order within a block,
+ * and record where the entries of each block start in \p offsets.
+ */
+template <class T, class BlockOfT>
+std::vector<T> layOutByBlock(const std::vector<T>& entries,
+                             std::size_t blkCnt,
+                             BlockOfT blockOf,
+                             std::vector<std::uint32_t>& offsets)
+{
+    offsets.assign(blkCnt + 1, 0);
+    for (auto i = 0U; i < entries.size(); ++i)
+        ++offsets[blockOf(i) + 1];
+    for (auto blk = 0U; blk < blkCnt; ++blk)
+        offsets[blk + 1] += offsets[blk];
+
+    std::vector<std::uint32_t> order(entries.size());
+    std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+    for (auto i = 0U; i < entries.size(); ++i)
+        order[next[blockOf(i)]++] = i;
+
+    std::vector<T> laidOut;
+    laidOut.reserve(entries.size());
+    for (auto i : order)
+        laidOut.push_back(entries[i]);
+    return laidOut;
+}
+
+} // anonymous
+
+ControlFlowGraphBuilder::ControlFlowGraphBuilder(const FunctionDefinitionSyntax* funcDef)
+    : SyntaxVisitor(funcDef->syntaxTree())
+    , funcDef_(funcDef)
+    , curBlk_(kNoBlock)
+{}
+
+std::unique_ptr<ControlFlowGraph> ControlFlowGraphBuilder::build()
+{
+    G_.reset(new ControlFlowGraph(funcDef_));
+
+    auto entryBlk = createBlock();
+    auto exitBlk = createBlock();
+    PSY_ASSERT(entryBlk == G_->entryBlock() && exitBlk == G_->exitBlock(), return nullptr);
+
+    curBlk_ = entryBlk;
+    visit(funcDef_->body());
+    connect(curBlk_, exitBlk, ControlFlowEdgeKind::Sequential);
+
+    finish();
+
+    return std::move(G_);
+}
+
+ControlFlowGraphBuilder::BlockIndex ControlFlowGraphBuilder::createBlock()
+{
+    G_->labels_.push_back(nullptr);
+    G_->terminators_.push_back(nullptr);
+    return static_cast<BlockIndex>(G_->labels_.size() - 1);
+}
+
+ControlFlowGraphBuilder::BlockIndex ControlFlowGraphBuilder::appendToBlock(const SyntaxNode* node)
+{
+    if (curBlk_ == kNoBlock)
+        curBlk_ = createBlock();
+
+    if (node) {
+        auto firstTk = node->firstToken();
+        auto lastTk = node->lastToken();
+        elems_.push_back(ControlFlowGraph::Element{
+                             node,
+                             TextSpan(firstTk.isValid() ? firstTk.span().start() : 0,
+                                      lastTk.isValid() ? lastTk.span().end() : 0) });
+        elemBlks_.push_back(curBlk_);
+    }
+
+    return curBlk_;
+}
+
+ControlFlowGraphBuilder::BlockIndex ControlFlowGraphBuilder::breakBlock()
+{
+    PSY_ASSERT(!breakBlks_.empty(), return kNoBlock);
+
+    auto& blk = breakBlks_.back();
+    if (blk == kNoBlock)
+        blk = createBlock();
+    return blk;
+}
+
+ControlFlowGraphBuilder::BlockIndex ControlFlowGraphBuilder::labelBlock(const SyntaxLexeme* name,
+                                                                       bool isDefinition)
+{
+    auto it = labels_.find(name);
+    if (it == labels_.end())
+        it = labels_.emplace(name, LabelInfo{ createBlock(), false }).first;
+
+    if (isDefinition) {
+        // A redefined label (an error) gets a block of its own.
+        if (it->second.isDefined)
+            return createBlock();
+        it->second.isDefined = true;
+    }
+
+    return it->second.blk;
+}
+
+void ControlFlowGraphBuilder::connect(BlockIndex sourceBlk,
+                                      BlockIndex targetBlk,
+                                      ControlFlowEdgeKind edgeK)
+{
+    if (sourceBlk == kNoBlock || targetBlk == kNoBlock)
+        return;
+
+    edges_.push_back(ControlFlowGraph::Edge{ sourceBlk, targetBlk, edgeK });
+}
+
+void ControlFlowGraphBuilder::terminate(BlockIndex blk, const StatementSyntax* stmt)
+{
+    G_->terminators_[blk] = stmt;
+}
+
+void ControlFlowGraphBuilder::finish()
+{
+    auto blkCnt = G_->labels_.size();
+
+    G_->elems_ = layOutByBlock(elems_,
+                               blkCnt,
+                               [this] (std::size_t idx) { return elemBlks_[idx]; },
+                               G_->elemOffsets_);
+    G_->succs_ = layOutByBlock(edges_,
+                               blkCnt,
+                               [this] (std::size_t idx) { return edges_[idx].source; },
+                               G_->succOffsets_);
+    G_->preds_ = layOutByBlock(edges_,
+                               blkCnt,
+                               [this] (std::size_t idx) { return edges_[idx].target; },
+                               G_->predOffsets_);
+}
+
+//------------//
+// Statements //
+//------------//
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitDeclarationStatement(
+        const DeclarationStatementSyntax* node)
+{
+    appendToBlock(node);
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitExpressionStatement(
+        const ExpressionStatementSyntax* node)
+{
+    // A null statement has no effect.
+    if (node->expression())
+        appendToBlock(node);
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitAmbiguousExpressionOrDeclarationStatement(
+        const AmbiguousExpressionOrDeclarationStatementSyntax* node)
+{
+    appendToBlock(node);
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitLabeledStatement(const LabeledStatementSyntax* node)
+{
+    BlockIndex labelBlk;
+    switch (node->kind()) {
+        case IdentifierLabelStatement:
+            labelBlk = labelBlock(node->labelToken().valueLexeme(), true);
+            break;
+
+        case CaseLabelStatement:
+        case DefaultLabelStatement:
+            labelBlk = createBlock();
+            if (!switches_.empty()) {
+                auto& switchInfo = switches_.back();
+                if (node->kind() == DefaultLabelStatement) {
+                    switchInfo.hasDefault = true;
+                    connect(switchInfo.blk, labelBlk, ControlFlowEdgeKind::Default);
+                }
+                else
+                    connect(switchInfo.blk, labelBlk, ControlFlowEdgeKind::Case);
+            }
+            break;
+
+        default:
+            PSY_ESCAPE_VIA_RETURN(Action::Quit);
+    }
+
+    G_->labels_[labelBlk] = node;
+    connect(curBlk_, labelBlk, ControlFlowEdgeKind::Sequential);
+    curBlk_ = labelBlk;
+
+    visit(node->statement());
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitIfStatement(const IfStatementSyntax* node)
+{
+    auto condBlk = appendToBlock(node->condition());
+    terminate(condBlk, node);
+
+    auto thenBlk = createBlock();
+    connect(condBlk, thenBlk, ControlFlowEdgeKind::True);
+    curBlk_ = thenBlk;
+    visit(node->statement());
+    auto thenEndBlk = curBlk_;
+
+    auto elseEndBlk = kNoBlock;
+    if (node->elseStatement()) {
+        auto elseBlk = createBlock();
+        connect(condBlk, elseBlk, ControlFlowEdgeKind::False);
+        curBlk_ = elseBlk;
+        visit(node->elseStatement());
+        elseEndBlk = curBlk_;
+
+        if (thenEndBlk == kNoBlock && elseEndBlk == kNoBlock) {
+            curBlk_ = kNoBlock;
+            return Action::Skip;
+        }
+    }
+
+    auto joinBlk = createBlock();
+    connect(thenEndBlk, joinBlk, ControlFlowEdgeKind::Sequential);
+    if (node->elseStatement())
+        connect(elseEndBlk, joinBlk, ControlFlowEdgeKind::Sequential);
+    else
+        connect(condBlk, joinBlk, ControlFlowEdgeKind::False);
+    curBlk_ = joinBlk;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitSwitchStatement(const SwitchStatementSyntax* node)
+{
+    auto condBlk = appendToBlock(node->condition());
+    terminate(condBlk, node);
+
+    switches_.push_back(SwitchInfo{ condBlk, false });
+    breakBlks_.push_back(kNoBlock);
+
+    // Code ahead of the first label is unreachable.
+    curBlk_ = kNoBlock;
+    visit(node->statement());
+
+    auto hasDefault = switches_.back().hasDefault;
+    if (curBlk_ != kNoBlock || !hasDefault)
+        breakBlock();
+    auto afterBlk = breakBlks_.back();
+    breakBlks_.pop_back();
+    switches_.pop_back();
+
+    connect(curBlk_, afterBlk, ControlFlowEdgeKind::Sequential);
+    if (!hasDefault)
+        connect(condBlk, afterBlk, ControlFlowEdgeKind::Default);
+    curBlk_ = afterBlk;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitWhileStatement(const WhileStatementSyntax* node)
+{
+    auto condBlk = createBlock();
+    connect(curBlk_, condBlk, ControlFlowEdgeKind::Sequential);
+    curBlk_ = condBlk;
+    appendToBlock(node->condition());
+    terminate(condBlk, node);
+
+    auto bodyBlk = createBlock();
+    connect(condBlk, bodyBlk, ControlFlowEdgeKind::True);
+
+    breakBlks_.push_back(kNoBlock);
+    continueBlks_.push_back(condBlk);
+    curBlk_ = bodyBlk;
+    visit(node->statement());
+    connect(curBlk_, condBlk, ControlFlowEdgeKind::Back);
+    auto afterBlk = breakBlock();
+    breakBlks_.pop_back();
+    continueBlks_.pop_back();
+
+    connect(condBlk, afterBlk, ControlFlowEdgeKind::False);
+    curBlk_ = afterBlk;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitDoStatement(const DoStatementSyntax* node)
+{
+    auto bodyBlk = createBlock();
+    connect(curBlk_, bodyBlk, ControlFlowEdgeKind::Sequential);
+    auto condBlk = createBlock();
+
+    breakBlks_.push_back(kNoBlock);
+    continueBlks_.push_back(condBlk);
+    curBlk_ = bodyBlk;
+    visit(node->statement());
+    connect(curBlk_, condBlk, ControlFlowEdgeKind::Sequential);
+
+    curBlk_ = condBlk;
+    appendToBlock(node->condition());
+    terminate(condBlk, node);
+    connect(condBlk, bodyBlk, ControlFlowEdgeKind::True);
+    auto afterBlk = breakBlock();
+    breakBlks_.pop_back();
+    continueBlks_.pop_back();
+
+    connect(condBlk, afterBlk, ControlFlowEdgeKind::False);
+    curBlk_ = afterBlk;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitForStatement(const ForStatementSyntax* node)
+{
+    visit(node->initializer());
+
+    auto condBlk = createBlock();
+    connect(curBlk_, condBlk, ControlFlowEdgeKind::Sequential);
+    curBlk_ = condBlk;
+    appendToBlock(node->condition());
+    terminate(condBlk, node);
+
+    auto bodyBlk = createBlock();
+    connect(condBlk,
+            bodyBlk,
+            node->condition() ? ControlFlowEdgeKind::True
+                              : ControlFlowEdgeKind::Sequential);
+    auto stepBlk = node->expression() ? createBlock()
+                                      : kNoBlock;
+
+    breakBlks_.push_back(kNoBlock);
+    continueBlks_.push_back(stepBlk != kNoBlock ? stepBlk : condBlk);
+    curBlk_ = bodyBlk;
+    visit(node->statement());
+    if (stepBlk != kNoBlock) {
+        connect(curBlk_, stepBlk, ControlFlowEdgeKind::Sequential);
+        curBlk_ = stepBlk;
+        appendToBlock(node->expression());
+    }
+    connect(curBlk_, condBlk, ControlFlowEdgeKind::Back);
+
+    // Without a condition, the loop is left only through a jump.
+    auto afterBlk = node->condition() ? breakBlock()
+                                      : breakBlks_.back();
+    breakBlks_.pop_back();
+    continueBlks_.pop_back();
+
+    if (node->condition())
+        connect(condBlk, afterBlk, ControlFlowEdgeKind::False);
+    curBlk_ = afterBlk;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitGotoStatement(const GotoStatementSyntax* node)
+{
+    auto blk = appendToBlock(node);
+    terminate(blk, node);
+    connect(blk,
+            labelBlock(node->identifierToken().valueLexeme(), false),
+            ControlFlowEdgeKind::Goto);
+    curBlk_ = kNoBlock;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitContinueStatement(const ContinueStatementSyntax* node)
+{
+    auto blk = appendToBlock(node);
+    terminate(blk, node);
+    if (!continueBlks_.empty())
+        connect(blk, continueBlks_.back(), ControlFlowEdgeKind::Continue);
+    curBlk_ = kNoBlock;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitBreakStatement(const BreakStatementSyntax* node)
+{
+    auto blk = appendToBlock(node);
+    terminate(blk, node);
+    if (!breakBlks_.empty())
+        connect(blk, breakBlock(), ControlFlowEdgeKind::Break);
+    curBlk_ = kNoBlock;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitReturnStatement(const ReturnStatementSyntax* node)
+{
+    auto blk = appendToBlock(node);
+    terminate(blk, node);
+    connect(blk, G_->exitBlock(), ControlFlowEdgeKind::Return);
+    curBlk_ = kNoBlock;
+
+    return Action::Skip;
+}
+
+SyntaxVisitor::Action ControlFlowGraphBuilder::visitExtGNU_AsmStatement(const ExtGNU_AsmStatementSyntax* node)
+{
+    appendToBlock(node);
+
+    return Action::Skip;
+}
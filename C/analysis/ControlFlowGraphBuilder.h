@@ -0,0 +1,126 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_GRAPH_BUILDER_H__
+#define PSYCHE_C_CONTROL_FLOW_GRAPH_BUILDER_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraph.h"
+
+#include "syntax/SyntaxVisitor.h"
+
+#include "../common/infra/InternalAccess.h"
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The ControlFlowGraphBuilder class.
+ *
+ * Build the ControlFlowGraph of a function definition in a single pass over
+ * the statements of its body. Expressions are not traversed: a statement is
+ * an element of the block in which it's evaluated, and a selection/iteration
+ * statement contributes its controlling expression and terminates its block.
+ */
+class PSY_C_NON_API ControlFlowGraphBuilder final : protected SyntaxVisitor
+{
+PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(ControlFlowGraph);
+
+    ControlFlowGraphBuilder(const FunctionDefinitionSyntax* funcDef);
+
+    std::unique_ptr<ControlFlowGraph> build();
+
+private:
+    using BlockIndex = ControlFlowGraph::BlockIndex;
+    static constexpr BlockIndex kNoBlock = std::numeric_limits<BlockIndex>::max();
+
+    const FunctionDefinitionSyntax* funcDef_;
+    std::unique_ptr<ControlFlowGraph> G_;
+
+    /*
+     * The block that receives the next element: \c kNoBlock if the code
+     * reached next is unreachable, in which case a block is only created
+     * when there's an element to hold.
+     */
+    BlockIndex curBlk_;
+
+    std::vector<ControlFlowGraph::Element> elems_;
+    std::vector<BlockIndex> elemBlks_;
+    std::vector<ControlFlowGraph::Edge> edges_;
+
+    /*
+     * The targets of \c break (created on demand) and of \c continue.
+     */
+    std::vector<BlockIndex> breakBlks_;
+    std::vector<BlockIndex> continueBlks_;
+
+    struct SwitchInfo
+    {
+        BlockIndex blk;
+        bool hasDefault;
+    };
+    std::vector<SwitchInfo> switches_;
+
+    struct LabelInfo
+    {
+        BlockIndex blk;
+        bool isDefined;
+    };
+    std::unordered_map<const SyntaxLexeme*, LabelInfo> labels_;
+
+    BlockIndex createBlock();
+    BlockIndex appendToBlock(const SyntaxNode* node);
+    BlockIndex breakBlock();
+    BlockIndex labelBlock(const SyntaxLexeme* name, bool isDefinition);
+    void connect(BlockIndex sourceBlk, BlockIndex targetBlk, ControlFlowEdgeKind edgeK);
+    void terminate(BlockIndex blk, const StatementSyntax* stmt);
+    void finish();
+
+    //------------//
+    // Statements //
+    //------------//
+    virtual Action visitDeclarationStatement(const DeclarationStatementSyntax*) override;
+    virtual Action visitExpressionStatement(const ExpressionStatementSyntax*) override;
+    virtual Action visitAmbiguousExpressionOrDeclarationStatement(const AmbiguousExpressionOrDeclarationStatementSyntax*) override;
+    virtual Action visitLabeledStatement(const LabeledStatementSyntax*) override;
+    virtual Action visitIfStatement(const IfStatementSyntax*) override;
+    virtual Action visitSwitchStatement(const SwitchStatementSyntax*) override;
+    virtual Action visitWhileStatement(const WhileStatementSyntax*) override;
+    virtual Action visitDoStatement(const DoStatementSyntax*) override;
+    virtual Action visitForStatement(const ForStatementSyntax*) override;
+    virtual Action visitGotoStatement(const GotoStatementSyntax*) override;
+    virtual Action visitContinueStatement(const ContinueStatementSyntax*) override;
+    virtual Action visitBreakStatement(const BreakStatementSyntax*) override;
+    virtual Action visitReturnStatement(const ReturnStatementSyntax*) override;
+    virtual Action visitExtGNU_AsmStatement(const ExtGNU_AsmStatementSyntax*) override;
+};
+
+} // C
+} // psy
+
+#endif
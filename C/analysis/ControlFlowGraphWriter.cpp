@@ -0,0 +1,106 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ControlFlowGraphWriter.h"
+
+#include "SyntaxTree.h"
+
+#include "infra/BufferedOutput.h"
+#include "syntax/SyntaxNodes.h"
+#include "syntax/SyntaxUtilities.h"
+#include "syntax/SyntaxVisitor.h"
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+class CallSiteFinder final : public SyntaxVisitor
+{
+public:
+    using SyntaxVisitor::SyntaxVisitor;
+
+    bool found_ = false;
+
+    virtual bool preVisit(const SyntaxNode*) override { return !found_; }
+
+    virtual Action visitCallExpression(const CallExpressionSyntax*) override
+    {
+        found_ = true;
+        return Action::Skip;
+    }
+};
+
+} // anonymous
+
+ControlFlowGraphWriter::ControlFlowGraphWriter(std::ostream& os)
+    : out_(new BufferedOutput(os))
+{}
+
+ControlFlowGraphWriter::ControlFlowGraphWriter(int fd)
+    : out_(new BufferedOutput(fd))
+{}
+
+ControlFlowGraphWriter::~ControlFlowGraphWriter()
+{}
+
+void ControlFlowGraphWriter::write(const ControlFlowGraph& cfg)
+{
+    writeGraph(cfg);
+}
+
+void ControlFlowGraphWriter::flush()
+{
+    out_->flush();
+}
+
+bool ControlFlowGraphWriter::hasError() const
+{
+    return out_->hasError();
+}
+
+void ControlFlowGraphWriter::emit(const char* data, std::size_t size)
+{
+    out_->emit(data, size);
+}
+
+std::string ControlFlowGraphWriter::functionName(const ControlFlowGraph& cfg)
+{
+    auto decltor = SyntaxUtilities::innermostDeclaratorOrSelf(cfg.functionDefinition()->declarator());
+    if (decltor && decltor->kind() == IdentifierDeclarator)
+        return decltor->asIdentifierDeclarator()->identifierToken().valueText();
+    return "";
+}
+
+TextSpan ControlFlowGraphWriter::functionSpan(const ControlFlowGraph& cfg)
+{
+    auto funcDef = cfg.functionDefinition();
+    auto firstTk = funcDef->firstToken();
+    auto lastTk = funcDef->body() ? funcDef->body()->lastToken() : funcDef->lastToken();
+    return TextSpan(firstTk.isValid() ? firstTk.span().start() : 0,
+                    lastTk.isValid() ? lastTk.span().end() : 0);
+}
+
+bool ControlFlowGraphWriter::isCallSite(const ControlFlowGraph::Element& elem)
+{
+    CallSiteFinder finder(elem.node->syntaxTree());
+    finder.visit(elem.node);
+    return finder.found_;
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_GRAPH_WRITER_H__
+#define PSYCHE_C_CONTROL_FLOW_GRAPH_WRITER_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraph.h"
+
+#include "../common/infra/InternalAccess.h"
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace psy {
+namespace C {
+
+class BufferedOutput;
+
+/**
+ * \brief The ControlFlowGraphWriter class.
+ *
+ * The base class of writers that export ControlFlowGraphs, one at a time,
+ * to a \c std::ostream or to a file descriptor. Nothing is accumulated
+ * across ControlFlowGraphs: the output is streamed record by record.
+ */
+class PSY_C_API ControlFlowGraphWriter
+{
+public:
+    virtual ~ControlFlowGraphWriter();
+    ControlFlowGraphWriter(const ControlFlowGraphWriter&) = delete;
+    void operator=(const ControlFlowGraphWriter&) = delete;
+
+    /**
+     * Write the ControlFlowGraph \p cfg.
+     */
+    void write(const ControlFlowGraph& cfg);
+
+    /**
+     * Flush the pending output (for a file descriptor, the output is
+     * buffered by \c this ControlFlowGraphWriter; it's flushed on
+     * destruction too).
+     */
+    void flush();
+
+    /**
+     * Whether an error occurred while writing.
+     */
+    bool hasError() const;
+
+PSY_INTERNAL_AND_EXTENSIBLE:
+    ControlFlowGraphWriter(std::ostream& os);
+    ControlFlowGraphWriter(int fd);
+
+    virtual void writeGraph(const ControlFlowGraph& cfg) = 0;
+
+    void emit(const char* data, std::size_t size);
+    void emit(const std::string& s) { emit(s.data(), s.size()); }
+
+    /**
+     * The name of the function of \p cfg.
+     */
+    static std::string functionName(const ControlFlowGraph& cfg);
+
+    /**
+     * The text span of the function of \p cfg.
+     */
+    static TextSpan functionSpan(const ControlFlowGraph& cfg);
+
+    /**
+     * Whether the element \p elem contains a function call.
+     */
+    static bool isCallSite(const ControlFlowGraph::Element& elem);
+
+private:
+    std::unique_ptr<BufferedOutput> out_;
+};
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ControlFlowGraphWriterBinaryFormat.h"
+
+#include "SyntaxTree.h"
+
+#include "syntax/SyntaxNodes.h"
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+const char kMagic[] = "PSYCFG";
+
+} // anonymous
+
+ControlFlowGraphWriterBinaryFormat::ControlFlowGraphWriterBinaryFormat(std::ostream& os)
+    : ControlFlowGraphWriter(os)
+    , hasHeader_(false)
+{}
+
+ControlFlowGraphWriterBinaryFormat::ControlFlowGraphWriterBinaryFormat(int fd)
+    : ControlFlowGraphWriter(fd)
+    , hasHeader_(false)
+{}
+
+void ControlFlowGraphWriterBinaryFormat::writeGraph(const ControlFlowGraph& cfg)
+{
+    if (!hasHeader_) {
+        emit(kMagic, sizeof(kMagic) - 1);
+        auto v = static_cast<char>(version());
+        emit(&v, 1);
+        hasHeader_ = true;
+    }
+
+    auto funcSpan = functionSpan(cfg);
+    beginRecord(RecordKind::Function);
+    appendString(functionName(cfg));
+    appendString(cfg.functionDefinition()->syntaxTree()->filePath());
+    appendU32(funcSpan.start());
+    appendU32(funcSpan.end());
+    appendU32(cfg.blockCount());
+    appendU32(cfg.edgeCount());
+    endRecord();
+
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg.blockCount(); ++blk) {
+        beginRecord(RecordKind::Block);
+        appendU32(blk);
+        appendU16(cfg.label(blk) ? cfg.label(blk)->kind() : noKind());
+        appendU16(cfg.terminator(blk) ? cfg.terminator(blk)->kind() : noKind());
+        auto elems = cfg.elements(blk);
+        appendU32(elems.size());
+        for (const auto& elem : elems) {
+            appendU16(elem.node->kind());
+            appendU8(isCallSite(elem) ? callSiteFlag() : 0);
+            appendU32(elem.span.start());
+            appendU32(elem.span.end());
+        }
+        endRecord();
+    }
+
+    beginRecord(RecordKind::Edges);
+    appendU32(cfg.edgeCount());
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg.blockCount(); ++blk) {
+        for (const auto& edge : cfg.successors(blk)) {
+            appendU32(edge.source);
+            appendU32(edge.target);
+            appendU8(static_cast<std::uint8_t>(edge.kind));
+        }
+    }
+    endRecord();
+}
+
+void ControlFlowGraphWriterBinaryFormat::beginRecord(RecordKind recK)
+{
+    record_.clear();
+    appendU32(0);
+    appendU8(static_cast<std::uint8_t>(recK));
+}
+
+void ControlFlowGraphWriterBinaryFormat::endRecord()
+{
+    std::uint32_t size = record_.size() - 4;
+    for (auto i = 0; i < 4; ++i)
+        record_[i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+    emit(record_);
+}
+
+void ControlFlowGraphWriterBinaryFormat::appendU8(std::uint8_t v)
+{
+    record_ += static_cast<char>(v);
+}
+
+void ControlFlowGraphWriterBinaryFormat::appendU16(std::uint16_t v)
+{
+    appendU8(v & 0xFF);
+    appendU8(v >> 8);
+}
+
+void ControlFlowGraphWriterBinaryFormat::appendU32(std::uint32_t v)
+{
+    appendU16(v & 0xFFFF);
+    appendU16(v >> 16);
+}
+
+void ControlFlowGraphWriterBinaryFormat::appendString(const std::string& s)
+{
+    appendU32(s.size());
+    record_ += s;
+}
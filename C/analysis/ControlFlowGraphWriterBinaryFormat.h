@@ -0,0 +1,94 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_GRAPH_WRITER_BINARY_FORMAT_H__
+#define PSYCHE_C_CONTROL_FLOW_GRAPH_WRITER_BINARY_FORMAT_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraphWriter.h"
+
+#include <cstdint>
+#include <string>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The ControlFlowGraphWriterBinaryFormat class.
+ *
+ * Write ControlFlowGraphs in a compact binary format. The output starts
+ * with the magic \c "PSYCFG" and a version byte, which are followed by
+ * records. Every record is a \c u32 size (of what comes after it), a \c u8
+ * RecordKind, and a payload. Integers are little-endian, and strings are
+ * a \c u32 size followed by the characters.
+ *
+ * For each ControlFlowGraph, there's a \c Function record, a \c Block
+ * record per block, and an \c Edges record:
+ *
+ *   - \c Function: name (string), file (string), span start and end (\c u32),
+ *     block count (\c u32), and edge count (\c u32).
+ *   - \c Block: block index (\c u32), SyntaxKind of the label and of the
+ *     terminator (\c u16, \c 0xFFFF if none), element count (\c u32), and,
+ *     per element, its SyntaxKind (\c u16), flags (\c u8, bit 0 tells
+ *     whether the element is a call site), and span start and end (\c u32).
+ *   - \c Edges: edge count (\c u32), and, per edge, its source and target
+ *     blocks (\c u32) and ControlFlowEdgeKind (\c u8).
+ */
+class PSY_C_API ControlFlowGraphWriterBinaryFormat final : public ControlFlowGraphWriter
+{
+public:
+    ControlFlowGraphWriterBinaryFormat(std::ostream& os);
+    ControlFlowGraphWriterBinaryFormat(int fd);
+
+    static constexpr std::uint8_t version() { return 1; }
+
+    /**
+     * \brief The RecordKind enumeration.
+     */
+    enum class RecordKind : std::uint8_t
+    {
+        Function = 1,
+        Block,
+        Edges
+    };
+
+    static constexpr std::uint16_t noKind() { return 0xFFFF; }
+    static constexpr std::uint8_t callSiteFlag() { return 1; }
+
+private:
+    virtual void writeGraph(const ControlFlowGraph& cfg) override;
+
+    bool hasHeader_;
+    std::string record_;
+
+    void beginRecord(RecordKind recK);
+    void endRecord();
+    void appendU8(std::uint8_t v);
+    void appendU16(std::uint16_t v);
+    void appendU32(std::uint32_t v);
+    void appendString(const std::string& s);
+};
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,112 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ControlFlowGraphWriterJSONFormat.h"
+
+#include "SyntaxTree.h"
+
+#include "syntax/SyntaxNodes.h"
+
+#include "../common/text/JSONString.h"
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+void appendSpan(std::string& line, const TextSpan& span)
+{
+    line += '[';
+    line += std::to_string(span.start());
+    line += ',';
+    line += std::to_string(span.end());
+    line += ']';
+}
+
+void appendKindOrNull(std::string& line, const SyntaxNode* node)
+{
+    if (node)
+        appendJSONString(line, to_string(node->kind()));
+    else
+        line += "null";
+}
+
+} // anonymous
+
+ControlFlowGraphWriterJSONFormat::ControlFlowGraphWriterJSONFormat(std::ostream& os)
+    : ControlFlowGraphWriter(os)
+{}
+
+ControlFlowGraphWriterJSONFormat::ControlFlowGraphWriterJSONFormat(int fd)
+    : ControlFlowGraphWriter(fd)
+{}
+
+void ControlFlowGraphWriterJSONFormat::writeGraph(const ControlFlowGraph& cfg)
+{
+    line_ = "{\"type\":\"function\",\"name\":";
+    appendJSONString(line_, functionName(cfg));
+    line_ += ",\"file\":";
+    appendJSONString(line_, cfg.functionDefinition()->syntaxTree()->filePath());
+    line_ += ",\"span\":";
+    appendSpan(line_, functionSpan(cfg));
+    line_ += ",\"blocks\":";
+    line_ += std::to_string(cfg.blockCount());
+    line_ += ",\"edges\":";
+    line_ += std::to_string(cfg.edgeCount());
+    line_ += "}\n";
+    emit(line_);
+
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg.blockCount(); ++blk) {
+        line_ = "{\"type\":\"block\",\"id\":";
+        line_ += std::to_string(blk);
+        line_ += ",\"label\":";
+        appendKindOrNull(line_, cfg.label(blk));
+        line_ += ",\"terminator\":";
+        appendKindOrNull(line_, cfg.terminator(blk));
+        line_ += ",\"elements\":[";
+        auto sep = "";
+        for (const auto& elem : cfg.elements(blk)) {
+            line_ += sep;
+            line_ += "{\"kind\":";
+            appendJSONString(line_, to_string(elem.node->kind()));
+            line_ += ",\"span\":";
+            appendSpan(line_, elem.span);
+            line_ += ",\"call\":";
+            line_ += isCallSite(elem) ? "true" : "false";
+            line_ += '}';
+            sep = ",";
+        }
+        line_ += "]}\n";
+        emit(line_);
+    }
+
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg.blockCount(); ++blk) {
+        for (const auto& edge : cfg.successors(blk)) {
+            line_ = "{\"type\":\"edge\",\"source\":";
+            line_ += std::to_string(edge.source);
+            line_ += ",\"target\":";
+            line_ += std::to_string(edge.target);
+            line_ += ",\"kind\":";
+            appendJSONString(line_, to_string(edge.kind));
+            line_ += "}\n";
+            emit(line_);
+        }
+    }
+}
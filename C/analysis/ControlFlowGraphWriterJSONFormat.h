@@ -0,0 +1,62 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_GRAPH_WRITER_JSON_FORMAT_H__
+#define PSYCHE_C_CONTROL_FLOW_GRAPH_WRITER_JSON_FORMAT_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraphWriter.h"
+
+#include <string>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The ControlFlowGraphWriterJSONFormat class.
+ *
+ * Write ControlFlowGraphs in the JSON Lines format: one JSON object per
+ * line, and, for each ControlFlowGraph, a \c "function" object followed by
+ * a \c "block" object per block and an \c "edge" object per edge.
+ *
+ * \code
+ * {"type":"function","name":"f","file":"f.c","span":[0,42],"blocks":4,"edges":4}
+ * {"type":"block","id":0,"label":null,"terminator":"IfStatement","elements":[{"kind":"IdentifierName","span":[18,19],"call":false}]}
+ * {"type":"edge","source":0,"target":2,"kind":"True"}
+ * \endcode
+ */
+class PSY_C_API ControlFlowGraphWriterJSONFormat final : public ControlFlowGraphWriter
+{
+public:
+    ControlFlowGraphWriterJSONFormat(std::ostream& os);
+    ControlFlowGraphWriterJSONFormat(int fd);
+
+private:
+    virtual void writeGraph(const ControlFlowGraph& cfg) override;
+
+    std::string line_;
+};
+
+} // C
+} // psy
+
+#endif
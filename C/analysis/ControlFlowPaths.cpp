@@ -0,0 +1,134 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ControlFlowPaths.h"
+
+#include <algorithm>
+
+using namespace psy;
+using namespace C;
+
+ControlFlowPaths::ControlFlowPaths(const ControlFlowGraph* cfg)
+    : cfg_(cfg)
+    , isExhaustive_(true)
+{}
+
+ControlFlowPaths::~ControlFlowPaths()
+{}
+
+std::unique_ptr<ControlFlowPaths> ControlFlowPaths::enumerate(const ControlFlowGraph* cfg,
+                                                              const PathEnumerationOptions& opts)
+{
+    if (!cfg)
+        return nullptr;
+
+    std::unique_ptr<ControlFlowPaths> paths(new ControlFlowPaths(cfg));
+    if (opts.maxPathCount() == 0) {
+        paths->isExhaustive_ = false;
+        return paths;
+    }
+
+    /*
+     * The enumeration is a depth-first search with an explicit stack. A block
+     * may be on the current path at most (loop unroll bound + 1) times. Since
+     * steps are added in preorder, the steps of a subtree that yields no path
+     * are the last ones added when the search leaves it, and are discarded.
+     */
+    struct Frame
+    {
+        StepIndex step;
+        std::uint32_t succIdx;
+        std::size_t pathCnt;
+    };
+    std::vector<Frame> frames;
+    std::vector<std::size_t> visitCnts(cfg->blockCount(), 0);
+
+    auto enter = [&] (ControlFlowGraph::BlockIndex blk, StepIndex prevStep, ControlFlowEdgeKind edgeK) {
+        auto step = paths->addStep(blk, prevStep, edgeK);
+        if (blk == cfg->exitBlock() || cfg->successors(blk).empty()) {
+            paths->lastSteps_.push_back(step);
+            paths->isComplete_.push_back(true);
+            return;
+        }
+        if (paths->stepDepths_[step] + 1 >= opts.maxPathLength()) {
+            paths->lastSteps_.push_back(step);
+            paths->isComplete_.push_back(false);
+            return;
+        }
+        ++visitCnts[blk];
+        frames.push_back(Frame{ step, 0, paths->lastSteps_.size() });
+    };
+
+    enter(cfg->entryBlock(), noStep(), ControlFlowEdgeKind::UNSPECIFIED);
+    while (!frames.empty()) {
+        if (paths->lastSteps_.size() >= opts.maxPathCount()) {
+            paths->isExhaustive_ = false;
+            paths->discardStepsFrom(paths->lastSteps_.back() + 1);
+            break;
+        }
+
+        auto& frame = frames.back();
+        auto blk = paths->stepBlks_[frame.step];
+        auto succs = cfg->successors(blk);
+        if (frame.succIdx == succs.size()) {
+            --visitCnts[blk];
+            if (paths->lastSteps_.size() == frame.pathCnt)
+                paths->discardStepsFrom(frame.step);
+            frames.pop_back();
+            continue;
+        }
+
+        const auto& edge = succs[frame.succIdx++];
+        if (visitCnts[edge.target] > opts.loopUnrollBound())
+            continue;
+        enter(edge.target, frame.step, edge.kind);
+    }
+
+    return paths;
+}
+
+ControlFlowPaths::StepIndex ControlFlowPaths::addStep(ControlFlowGraph::BlockIndex blk,
+                                                      StepIndex prevStep,
+                                                      ControlFlowEdgeKind edgeK)
+{
+    stepBlks_.push_back(blk);
+    stepPrevs_.push_back(prevStep);
+    stepDepths_.push_back(prevStep == noStep() ? 0 : stepDepths_[prevStep] + 1);
+    stepEdgeKinds_.push_back(edgeK);
+    return static_cast<StepIndex>(stepBlks_.size() - 1);
+}
+
+void ControlFlowPaths::discardStepsFrom(StepIndex step)
+{
+    stepBlks_.resize(step);
+    stepPrevs_.resize(step);
+    stepDepths_.resize(step);
+    stepEdgeKinds_.resize(step);
+}
+
+std::vector<ControlFlowGraph::BlockIndex> ControlFlowPaths::blocks(PathIndex path) const
+{
+    std::vector<ControlFlowGraph::BlockIndex> blks;
+    blks.reserve(length(path));
+    for (auto step = lastSteps_[path]; step != noStep(); step = stepPrevs_[step])
+        blks.push_back(stepBlks_[step]);
+    std::reverse(blks.begin(), blks.end());
+    return blks;
+}
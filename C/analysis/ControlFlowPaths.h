@@ -0,0 +1,148 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_PATHS_H__
+#define PSYCHE_C_CONTROL_FLOW_PATHS_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraph.h"
+#include "PathEnumerationOptions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The ControlFlowPaths class.
+ *
+ * The paths, from the entry block, through a ControlFlowGraph, enumerated
+ * within the bounds of PathEnumerationOptions.
+ *
+ * The paths are stored as a trie of steps: a step is a block reached
+ * through an edge, and it refers to the step before it, so paths that
+ * share a prefix share its steps. A path is identified by its last step.
+ */
+class PSY_C_API ControlFlowPaths
+{
+public:
+    ~ControlFlowPaths();
+    ControlFlowPaths(const ControlFlowPaths&) = delete;
+    void operator=(const ControlFlowPaths&) = delete;
+
+    using PathIndex = std::uint32_t;
+    using StepIndex = std::uint32_t;
+
+    /**
+     * The StepIndex that precedes the first step of every path.
+     */
+    static constexpr StepIndex noStep() { return std::numeric_limits<StepIndex>::max(); }
+
+    /**
+     * Enumerate the paths through the ControlFlowGraph \p cfg, depth first.
+     */
+    static std::unique_ptr<ControlFlowPaths> enumerate(const ControlFlowGraph* cfg,
+                                                       const PathEnumerationOptions& opts = PathEnumerationOptions());
+
+    /**
+     * The ControlFlowGraph of \c this ControlFlowPaths.
+     */
+    const ControlFlowGraph* controlFlowGraph() const { return cfg_; }
+
+    /**
+     * Whether the enumeration wasn't stopped by the maximum path count.
+     */
+    bool isExhaustive() const { return isExhaustive_; }
+
+    /**
+     * The number of paths.
+     */
+    std::size_t pathCount() const { return lastSteps_.size(); }
+
+    /**
+     * The last step of path \p path.
+     */
+    StepIndex lastStep(PathIndex path) const { return lastSteps_[path]; }
+
+    /**
+     * Whether path \p path ends in the exit block (or in a block without
+     * successors), as opposed to having been cut by the maximum path length.
+     */
+    bool isComplete(PathIndex path) const { return isComplete_[path]; }
+
+    /**
+     * The number of blocks in path \p path.
+     */
+    std::size_t length(PathIndex path) const { return stepDepths_[lastSteps_[path]] + 1; }
+
+    /**
+     * The blocks of path \p path, from the entry block on.
+     */
+    std::vector<ControlFlowGraph::BlockIndex> blocks(PathIndex path) const;
+
+    /**
+     * The number of steps in the trie.
+     */
+    std::size_t stepCount() const { return stepBlks_.size(); }
+
+    /**
+     * The block of step \p step.
+     */
+    ControlFlowGraph::BlockIndex block(StepIndex step) const { return stepBlks_[step]; }
+
+    /**
+     * The step before step \p step (noStep() for the first step).
+     */
+    StepIndex previousStep(StepIndex step) const { return stepPrevs_[step]; }
+
+    /**
+     * The ControlFlowEdgeKind of the edge through which step \p step is
+     * reached (\c UNSPECIFIED for the first step).
+     */
+    ControlFlowEdgeKind edgeKind(StepIndex step) const { return stepEdgeKinds_[step]; }
+
+private:
+    ControlFlowPaths(const ControlFlowGraph* cfg);
+
+    const ControlFlowGraph* cfg_;
+    bool isExhaustive_;
+
+    std::vector<ControlFlowGraph::BlockIndex> stepBlks_;
+    std::vector<StepIndex> stepPrevs_;
+    std::vector<std::uint32_t> stepDepths_;
+    std::vector<ControlFlowEdgeKind> stepEdgeKinds_;
+
+    std::vector<StepIndex> lastSteps_;
+    std::vector<bool> isComplete_;
+
+    StepIndex addStep(ControlFlowGraph::BlockIndex blk, StepIndex prevStep, ControlFlowEdgeKind edgeK);
+    void discardStepsFrom(StepIndex step);
+};
+
+} // C
+} // psy
+
+#endif
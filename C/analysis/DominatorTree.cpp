@@ -0,0 +1,205 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "DominatorTree.h"
+
+using namespace psy;
+using namespace C;
+
+DominatorTree::DominatorTree(const ControlFlowGraph* cfg, bool isPostDom)
+    : cfg_(cfg)
+    , isPostDom_(isPostDom)
+{}
+
+DominatorTree::~DominatorTree()
+{}
+
+std::unique_ptr<DominatorTree> DominatorTree::computeDominators(const ControlFlowGraph* cfg)
+{
+    if (!cfg)
+        return nullptr;
+
+    std::unique_ptr<DominatorTree> domTree(new DominatorTree(cfg, false));
+    domTree->compute();
+    domTree->layOutTree();
+    return domTree;
+}
+
+std::unique_ptr<DominatorTree> DominatorTree::computePostDominators(const ControlFlowGraph* cfg)
+{
+    if (!cfg)
+        return nullptr;
+
+    std::unique_ptr<DominatorTree> domTree(new DominatorTree(cfg, true));
+    domTree->compute();
+    domTree->layOutTree();
+    return domTree;
+}
+
+void DominatorTree::compute()
+{
+    /*
+     * For post-dominance, the edges are traversed backwards: the "successors"
+     * of a block are its predecessors in the ControlFlowGraph, and vice versa.
+     */
+    auto forwardEdges = [this] (BlockIndex blk) {
+        return isPostDom_ ? cfg_->predecessors(blk) : cfg_->successors(blk);
+    };
+    auto backwardEdges = [this] (BlockIndex blk) {
+        return isPostDom_ ? cfg_->successors(blk) : cfg_->predecessors(blk);
+    };
+    auto forwardBlock = [this] (const ControlFlowGraph::Edge& edge) {
+        return isPostDom_ ? edge.source : edge.target;
+    };
+    auto backwardBlock = [this] (const ControlFlowGraph::Edge& edge) {
+        return isPostDom_ ? edge.target : edge.source;
+    };
+
+    auto blkCnt = cfg_->blockCount();
+    std::vector<BlockIndex> postorder;
+    postorder.reserve(blkCnt);
+    std::vector<std::uint32_t> postorderNums(blkCnt, noBlock());
+    std::vector<bool> isVisited(blkCnt, false);
+
+    struct Frame
+    {
+        BlockIndex blk;
+        std::uint32_t edgeIdx;
+    };
+    std::vector<Frame> frames;
+    frames.push_back({ root(), 0 });
+    isVisited[root()] = true;
+    while (!frames.empty()) {
+        auto blk = frames.back().blk;
+        auto edges = forwardEdges(blk);
+        if (frames.back().edgeIdx < edges.size()) {
+            auto nextBlk = forwardBlock(edges[frames.back().edgeIdx++]);
+            if (!isVisited[nextBlk]) {
+                isVisited[nextBlk] = true;
+                frames.push_back({ nextBlk, 0 });
+            }
+            continue;
+        }
+        frames.pop_back();
+        postorderNums[blk] = postorder.size();
+        postorder.push_back(blk);
+    }
+
+    auto intersect = [this, &postorderNums] (BlockIndex finger1, BlockIndex finger2) {
+        while (finger1 != finger2) {
+            while (postorderNums[finger1] < postorderNums[finger2])
+                finger1 = idoms_[finger1];
+            while (postorderNums[finger2] < postorderNums[finger1])
+                finger2 = idoms_[finger2];
+        }
+        return finger1;
+    };
+
+    /*
+     * While the dominators are computed, the root is its own immediate dominator,
+     * and a block without one (yet) is either unprocessed or unreachable.
+     */
+    idoms_.assign(blkCnt, noBlock());
+    idoms_[root()] = root();
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (auto it = postorder.rbegin(); it != postorder.rend(); ++it) {
+            auto blk = *it;
+            if (blk == root())
+                continue;
+
+            auto newIdom = noBlock();
+            for (const auto& edge : backwardEdges(blk)) {
+                auto prevBlk = backwardBlock(edge);
+                if (idoms_[prevBlk] == noBlock())
+                    continue;
+                newIdom = newIdom == noBlock() ? prevBlk : intersect(prevBlk, newIdom);
+            }
+
+            if (idoms_[blk] != newIdom) {
+                idoms_[blk] = newIdom;
+                isChanged = true;
+            }
+        }
+    }
+    idoms_[root()] = noBlock();
+}
+
+void DominatorTree::layOutTree()
+{
+    auto blkCnt = cfg_->blockCount();
+
+    childOffsets_.assign(blkCnt + 1, 0);
+    for (BlockIndex blk = 0; blk < blkCnt; ++blk) {
+        if (idoms_[blk] != noBlock())
+            ++childOffsets_[idoms_[blk] + 1];
+    }
+    for (BlockIndex blk = 0; blk < blkCnt; ++blk)
+        childOffsets_[blk + 1] += childOffsets_[blk];
+
+    children_.resize(childOffsets_[blkCnt]);
+    std::vector<std::uint32_t> next(childOffsets_.begin(), childOffsets_.end() - 1);
+    for (BlockIndex blk = 0; blk < blkCnt; ++blk) {
+        if (idoms_[blk] != noBlock())
+            children_[next[idoms_[blk]]++] = blk;
+    }
+
+    depths_.assign(blkCnt, 0);
+    preorder_.assign(blkCnt, noBlock());
+    sizes_.assign(blkCnt, 1);
+
+    std::vector<BlockIndex> preorderBlks;
+    preorderBlks.reserve(blkCnt);
+    std::vector<BlockIndex> stack(1, root());
+    while (!stack.empty()) {
+        auto blk = stack.back();
+        stack.pop_back();
+        preorder_[blk] = preorderBlks.size();
+        preorderBlks.push_back(blk);
+        auto children = this->children(blk);
+        for (auto it = children.end(); it != children.begin(); ) {
+            --it;
+            depths_[*it] = depths_[blk] + 1;
+            stack.push_back(*it);
+        }
+    }
+
+    for (auto it = preorderBlks.rbegin(); it != preorderBlks.rend(); ++it) {
+        if (idoms_[*it] != noBlock())
+            sizes_[idoms_[*it]] += sizes_[*it];
+    }
+}
+
+DominatorTree::BlockIndex DominatorTree::nearestCommonDominator(BlockIndex blk1, BlockIndex blk2) const
+{
+    if (!contains(blk1) || !contains(blk2))
+        return noBlock();
+
+    while (depths_[blk1] > depths_[blk2])
+        blk1 = idoms_[blk1];
+    while (depths_[blk2] > depths_[blk1])
+        blk2 = idoms_[blk2];
+    while (blk1 != blk2) {
+        blk1 = idoms_[blk1];
+        blk2 = idoms_[blk2];
+    }
+    return blk1;
+}
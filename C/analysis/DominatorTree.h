@@ -0,0 +1,168 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_DOMINATOR_TREE_H__
+#define PSYCHE_C_DOMINATOR_TREE_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The DominatorTree class.
+ *
+ * The dominator tree (rooted at the entry block) or the post-dominator tree
+ * (rooted at the exit block) of a ControlFlowGraph, computed with the
+ * iterative algorithm of Cooper, Harvey, and Kennedy over the blocks in
+ * reverse postorder. The immediate dominators and the children of the
+ * blocks are stored in flat arrays, and each block is numbered in a
+ * preorder traversal of the tree, so that dominance is a constant-time
+ * query.
+ *
+ * \remark A block that isn't reached from the root (an unreachable block
+ * or, for post-dominance, a block from which the exit block isn't reached,
+ * as in an infinite loop) isn't in the tree.
+ *
+ * \note Similar to:
+ * - \c llvm::DominatorTree of LLVM.
+ */
+class PSY_C_API DominatorTree
+{
+public:
+    ~DominatorTree();
+    DominatorTree(const DominatorTree&) = delete;
+    void operator=(const DominatorTree&) = delete;
+
+    using BlockIndex = ControlFlowGraph::BlockIndex;
+
+    /**
+     * The BlockIndex that designates no block.
+     */
+    static constexpr BlockIndex noBlock() { return std::numeric_limits<BlockIndex>::max(); }
+
+    /**
+     * Compute the dominator tree of the ControlFlowGraph \p cfg.
+     */
+    static std::unique_ptr<DominatorTree> computeDominators(const ControlFlowGraph* cfg);
+
+    /**
+     * Compute the post-dominator tree of the ControlFlowGraph \p cfg.
+     */
+    static std::unique_ptr<DominatorTree> computePostDominators(const ControlFlowGraph* cfg);
+
+    /**
+     * The ControlFlowGraph of \c this DominatorTree.
+     */
+    const ControlFlowGraph* controlFlowGraph() const { return cfg_; }
+
+    /**
+     * Whether \c this DominatorTree is a post-dominator tree.
+     */
+    bool isPostDominatorTree() const { return isPostDom_; }
+
+    /**
+     * The root of \c this DominatorTree: the entry block or, for a post-dominator
+     * tree, the exit block.
+     */
+    BlockIndex root() const { return isPostDom_ ? cfg_->exitBlock() : cfg_->entryBlock(); }
+
+    /**
+     * Whether block \p blk is in \c this DominatorTree.
+     */
+    bool contains(BlockIndex blk) const { return preorder_[blk] != noBlock(); }
+
+    /**
+     * The immediate (post-)dominator of block \p blk; \c DominatorTree::noBlock()
+     * for the root and for the blocks not in \c this DominatorTree.
+     */
+    BlockIndex immediateDominator(BlockIndex blk) const { return idoms_[blk]; }
+
+    /**
+     * The blocks immediately (post-)dominated by block \p blk, in increasing
+     * order of index.
+     */
+    ControlFlowGraph::Range<BlockIndex> children(BlockIndex blk) const
+    {
+        return ControlFlowGraph::Range<BlockIndex>(children_.data() + childOffsets_[blk],
+                                                   children_.data() + childOffsets_[blk + 1]);
+    }
+
+    /**
+     * The depth of block \p blk in \c this DominatorTree (0 for the root).
+     */
+    std::uint32_t depth(BlockIndex blk) const { return depths_[blk]; }
+
+    /**
+     * Whether block \p blk1 (post-)dominates block \p blk2; every block
+     * (post-)dominates itself.
+     */
+    bool dominates(BlockIndex blk1, BlockIndex blk2) const
+    {
+        return contains(blk1)
+                && contains(blk2)
+                && preorder_[blk1] <= preorder_[blk2]
+                && preorder_[blk2] < preorder_[blk1] + sizes_[blk1];
+    }
+
+    /**
+     * Whether block \p blk1 strictly (post-)dominates block \p blk2.
+     */
+    bool strictlyDominates(BlockIndex blk1, BlockIndex blk2) const
+    {
+        return blk1 != blk2 && dominates(blk1, blk2);
+    }
+
+    /**
+     * The nearest common (post-)dominator of blocks \p blk1 and \p blk2;
+     * \c DominatorTree::noBlock() if either isn't in \c this DominatorTree.
+     */
+    BlockIndex nearestCommonDominator(BlockIndex blk1, BlockIndex blk2) const;
+
+private:
+    DominatorTree(const ControlFlowGraph* cfg, bool isPostDom);
+
+    const ControlFlowGraph* cfg_;
+    bool isPostDom_;
+
+    std::vector<BlockIndex> idoms_;
+    std::vector<BlockIndex> children_;
+    std::vector<std::uint32_t> childOffsets_;
+    std::vector<std::uint32_t> depths_;
+    std::vector<std::uint32_t> preorder_;
+    std::vector<std::uint32_t> sizes_;
+
+    void compute();
+    void layOutTree();
+};
+
+} // C
+} // psy
+
+#endif
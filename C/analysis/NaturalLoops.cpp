@@ -0,0 +1,144 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "NaturalLoops.h"
+
+#include "DominatorTree.h"
+
+#include <algorithm>
+
+using namespace psy;
+using namespace C;
+
+NaturalLoops::NaturalLoops()
+    : isReducible_(true)
+{}
+
+NaturalLoops::~NaturalLoops()
+{}
+
+std::unique_ptr<NaturalLoops> NaturalLoops::compute(const DominatorTree* domTree)
+{
+    if (!domTree || domTree->isPostDominatorTree())
+        return nullptr;
+
+    auto cfg = domTree->controlFlowGraph();
+    auto blkCnt = cfg->blockCount();
+
+    std::unique_ptr<NaturalLoops> loops(new NaturalLoops);
+    loops->blkLoops_.assign(blkCnt, noLoop());
+    loops->blkOffsets_.push_back(0);
+    loops->backEdgeOffsets_.push_back(0);
+
+    /*
+     * The headers are visited in preorder of the dominator tree. Since the
+     * header of a loop dominates every block of the loop, the loops that
+     * enclose a header are found before the loop of that header, and the
+     * innermost one is the last to have claimed it.
+     */
+    std::vector<LoopIndex> stamps(blkCnt, noLoop());
+    std::vector<BlockIndex> worklist;
+    std::vector<BlockIndex> stack(1, domTree->root());
+    while (!stack.empty()) {
+        auto header = stack.back();
+        stack.pop_back();
+        auto children = domTree->children(header);
+        for (auto it = children.end(); it != children.begin(); )
+            stack.push_back(*--it);
+
+        LoopIndex loop = loops->headers_.size();
+        for (const auto& edge : cfg->predecessors(header)) {
+            if (domTree->dominates(header, edge.source))
+                loops->backEdges_.push_back(edge);
+        }
+        if (loops->backEdges_.size() == loops->backEdgeOffsets_.back())
+            continue;
+        loops->backEdgeOffsets_.push_back(loops->backEdges_.size());
+
+        auto parent = loops->blkLoops_[header];
+        loops->headers_.push_back(header);
+        loops->parents_.push_back(parent);
+        loops->depths_.push_back(parent == noLoop() ? 1 : loops->depths_[parent] + 1);
+
+        auto first = loops->blks_.size();
+        stamps[header] = loop;
+        loops->blks_.push_back(header);
+        for (auto i = loops->backEdgeOffsets_[loop]; i < loops->backEdgeOffsets_[loop + 1]; ++i) {
+            auto latch = loops->backEdges_[i].source;
+            if (stamps[latch] != loop) {
+                stamps[latch] = loop;
+                loops->blks_.push_back(latch);
+                worklist.push_back(latch);
+            }
+        }
+        while (!worklist.empty()) {
+            auto blk = worklist.back();
+            worklist.pop_back();
+            for (const auto& edge : cfg->predecessors(blk)) {
+                if (stamps[edge.source] == loop || !domTree->contains(edge.source))
+                    continue;
+                stamps[edge.source] = loop;
+                loops->blks_.push_back(edge.source);
+                worklist.push_back(edge.source);
+            }
+        }
+        std::sort(loops->blks_.begin() + first, loops->blks_.end());
+        loops->blkOffsets_.push_back(loops->blks_.size());
+
+        for (auto i = first; i < loops->blks_.size(); ++i)
+            loops->blkLoops_[loops->blks_[i]] = loop;
+    }
+
+    /*
+     * A retreating edge (one whose target is an ancestor of its source in a
+     * depth-first search) that isn't a back edge enters a cycle elsewhere
+     * than at the block that dominates it.
+     */
+    struct Frame
+    {
+        BlockIndex blk;
+        std::uint32_t succIdx;
+    };
+    std::vector<Frame> frames;
+    std::vector<bool> isVisited(blkCnt, false);
+    std::vector<bool> isOnStack(blkCnt, false);
+    frames.push_back({ cfg->entryBlock(), 0 });
+    isVisited[cfg->entryBlock()] = true;
+    isOnStack[cfg->entryBlock()] = true;
+    while (!frames.empty() && loops->isReducible_) {
+        auto blk = frames.back().blk;
+        auto succs = cfg->successors(blk);
+        if (frames.back().succIdx < succs.size()) {
+            auto succ = succs[frames.back().succIdx++].target;
+            if (!isVisited[succ]) {
+                isVisited[succ] = true;
+                isOnStack[succ] = true;
+                frames.push_back({ succ, 0 });
+            } else if (isOnStack[succ] && !domTree->dominates(succ, blk)) {
+                loops->isReducible_ = false;
+            }
+            continue;
+        }
+        isOnStack[blk] = false;
+        frames.pop_back();
+    }
+
+    return loops;
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_NATURAL_LOOPS_H__
+#define PSYCHE_C_NATURAL_LOOPS_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "ControlFlowGraph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+class DominatorTree;
+
+/**
+ * \brief The NaturalLoops class.
+ *
+ * The natural loops of a ControlFlowGraph, and how they nest. A back edge
+ * is one whose target (the header of a loop) dominates its source, and the
+ * natural loop of a header comprises the blocks from which a back edge to
+ * it is reached without going through it. Loops are found from dominance
+ * alone, so those formed by \c goto count as much as those of iteration
+ * statements.
+ *
+ * Loops are identified by dense indexes, in preorder of their headers in
+ * the dominator tree: a loop precedes the loops nested in it. Their blocks
+ * and back edges are stored in flat arrays, with the entries of a loop laid
+ * out contiguously.
+ *
+ * \note Similar to:
+ * - \c llvm::LoopInfo of LLVM.
+ */
+class PSY_C_API NaturalLoops
+{
+public:
+    ~NaturalLoops();
+    NaturalLoops(const NaturalLoops&) = delete;
+    void operator=(const NaturalLoops&) = delete;
+
+    using BlockIndex = ControlFlowGraph::BlockIndex;
+    using LoopIndex = std::uint32_t;
+
+    /**
+     * The LoopIndex that designates no loop.
+     */
+    static constexpr LoopIndex noLoop() { return std::numeric_limits<LoopIndex>::max(); }
+
+    /**
+     * Compute the NaturalLoops of the ControlFlowGraph of the (non-post)
+     * DominatorTree \p domTree.
+     */
+    static std::unique_ptr<NaturalLoops> compute(const DominatorTree* domTree);
+
+    /**
+     * The number of loops.
+     */
+    std::size_t loopCount() const { return headers_.size(); }
+
+    /**
+     * The header of loop \p loop.
+     */
+    BlockIndex header(LoopIndex loop) const { return headers_[loop]; }
+
+    /**
+     * The blocks of loop \p loop (including those of the loops nested in it),
+     * in increasing order of index.
+     */
+    ControlFlowGraph::Range<BlockIndex> blocks(LoopIndex loop) const
+    {
+        return ControlFlowGraph::Range<BlockIndex>(blks_.data() + blkOffsets_[loop],
+                                                   blks_.data() + blkOffsets_[loop + 1]);
+    }
+
+    /**
+     * The back edges of loop \p loop.
+     */
+    ControlFlowGraph::Range<ControlFlowGraph::Edge> backEdges(LoopIndex loop) const
+    {
+        return ControlFlowGraph::Range<ControlFlowGraph::Edge>(backEdges_.data() + backEdgeOffsets_[loop],
+                                                               backEdges_.data() + backEdgeOffsets_[loop + 1]);
+    }
+
+    /**
+     * The loop that immediately encloses loop \p loop, if any.
+     */
+    LoopIndex parent(LoopIndex loop) const { return parents_[loop]; }
+
+    /**
+     * The nesting depth of loop \p loop (1 for an outermost loop).
+     */
+    std::uint32_t depth(LoopIndex loop) const { return depths_[loop]; }
+
+    /**
+     * The innermost loop to which block \p blk belongs, if any.
+     */
+    LoopIndex innermostLoopOf(BlockIndex blk) const { return blkLoops_[blk]; }
+
+    /**
+     * The number of loops to which block \p blk belongs.
+     */
+    std::uint32_t loopDepthOf(BlockIndex blk) const
+    {
+        return blkLoops_[blk] == noLoop() ? 0 : depths_[blkLoops_[blk]];
+    }
+
+    /**
+     * Whether the ControlFlowGraph is reducible: every cycle has a single
+     * entry (its header), which isn't the case if, e.g., a \c goto jumps
+     * into the body of a loop. Such a cycle isn't a natural loop.
+     */
+    bool isReducible() const { return isReducible_; }
+
+private:
+    NaturalLoops();
+
+    std::vector<BlockIndex> headers_;
+    std::vector<BlockIndex> blks_;
+    std::vector<std::uint32_t> blkOffsets_;
+    std::vector<ControlFlowGraph::Edge> backEdges_;
+    std::vector<std::uint32_t> backEdgeOffsets_;
+    std::vector<LoopIndex> parents_;
+    std::vector<std::uint32_t> depths_;
+    std::vector<LoopIndex> blkLoops_;
+    bool isReducible_;
+};
+
+} // C
+} // psy
+
+#endif
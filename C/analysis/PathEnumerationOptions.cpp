@@ -0,0 +1,63 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "PathEnumerationOptions.h"
+
+using namespace psy;
+using namespace C;
+
+PathEnumerationOptions::PathEnumerationOptions()
+    : loopUnrollBound_(1)
+    , maxPathCount_(1 << 20)
+    , maxPathLength_(1 << 12)
+{}
+
+PathEnumerationOptions& PathEnumerationOptions::setLoopUnrollBound(std::size_t bound)
+{
+    loopUnrollBound_ = bound;
+    return *this;
+}
+
+std::size_t PathEnumerationOptions::loopUnrollBound() const
+{
+    return loopUnrollBound_;
+}
+
+PathEnumerationOptions& PathEnumerationOptions::setMaxPathCount(std::size_t cnt)
+{
+    maxPathCount_ = cnt;
+    return *this;
+}
+
+std::size_t PathEnumerationOptions::maxPathCount() const
+{
+    return maxPathCount_;
+}
+
+PathEnumerationOptions& PathEnumerationOptions::setMaxPathLength(std::size_t len)
+{
+    maxPathLength_ = len;
+    return *this;
+}
+
+std::size_t PathEnumerationOptions::maxPathLength() const
+{
+    return maxPathLength_;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_PATH_ENUMERATION_OPTIONS_H__
+#define PSYCHE_C_PATH_ENUMERATION_OPTIONS_H__
+
+#include "API.h"
+
+#include <cstddef>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The PathEnumerationOptions class.
+ *
+ * The bounds of an enumeration of ControlFlowPaths.
+ */
+class PSY_C_API PathEnumerationOptions
+{
+public:
+    /**
+     * Create PathEnumerationOptions.
+     */
+    PathEnumerationOptions();
+
+    //!@{
+    /**
+     * The number of times that a path may revisit a block (i.e., of times
+     * that any loop, including one formed by \c goto, may be unrolled).
+     */
+    PathEnumerationOptions& setLoopUnrollBound(std::size_t bound);
+    std::size_t loopUnrollBound() const;
+    //!@}
+
+    //!@{
+    /**
+     * The maximum number of paths: once it's reached, the enumeration stops.
+     */
+    PathEnumerationOptions& setMaxPathCount(std::size_t cnt);
+    std::size_t maxPathCount() const;
+    //!@}
+
+    //!@{
+    /**
+     * The maximum number of blocks in a path: a path that reaches it is cut
+     * (and recorded as incomplete).
+     */
+    PathEnumerationOptions& setMaxPathLength(std::size_t len);
+    std::size_t maxPathLength() const;
+    //!@}
+
+private:
+    std::size_t loopUnrollBound_;
+    std::size_t maxPathCount_;
+    std::size_t maxPathLength_;
+};
+
+} // C
+} // psy
+
+#endif
@@ -28,25 +28,101 @@
 #include "symbols/Symbol_ALL.h"
 #include "symbols/SymbolName_ALL.h"
 #include "syntax/SyntaxFacts.h"
+#include "syntax/SyntaxLexeme_ALL.h"
 #include "syntax/SyntaxNodes.h"
 #include "syntax/SyntaxUtilities.h"
 
 #include "../common/infra/Assertions.h"
 
 #include <iostream>
+#include <map>
+#include <unordered_set>
 
 using namespace psy;
 using namespace C;
 
+namespace {
+
+std::string textOf(const SyntaxTree* tree, const SyntaxNode* node)
+{
+    auto start = node->firstToken().span().start();
+    auto end = node->lastToken().span().end();
+    return tree->text().rawText().substr(start, end - start);
+}
+
+class NodesInPreorder : public SyntaxVisitor
+{
+public:
+    NodesInPreorder(const SyntaxTree* tree, const SyntaxNode* node)
+        : SyntaxVisitor(tree)
+    {
+        visit(node);
+    }
+
+    std::vector<const SyntaxNode*> nodes_;
+
+    virtual bool preVisit(const SyntaxNode* node) override
+    {
+        nodes_.push_back(node);
+        return true;
+    }
+};
+
+const Identifier* identifierOf(SyntaxToken tk)
+{
+    auto lexeme = tk.valueLexeme();
+    return lexeme ? lexeme->asIdentifier() : nullptr;
+}
+
+std::vector<const TypeSymbol*> componentTySyms(const Symbol* sym)
+{
+    switch (sym->kind()) {
+        case SymbolKind::Function:
+            return { sym->asFunction()->type() };
+
+        case SymbolKind::Value:
+            return { sym->asValue()->type() };
+
+        case SymbolKind::Type: {
+            auto tySym = sym->asType();
+            switch (tySym->typeKind()) {
+                case TypeKind::Array:
+                    return { tySym->asArrayType()->elementType() };
+
+                case TypeKind::Function: {
+                    auto funcTySym = tySym->asFunctionType();
+                    auto tySyms = funcTySym->parameterTypes();
+                    tySyms.push_back(funcTySym->returnType());
+                    return tySyms;
+                }
+
+                case TypeKind::Pointer:
+                    return { tySym->asPointerType()->referencedType() };
+
+                default:
+                    return {};
+            }
+        }
+
+        default:
+            return {};
+    }
+}
+
+} // anonymous
+
 Binder::Binder(SemanticModel* semaModel, const SyntaxTree* tree)
     : SyntaxVisitor(tree)
     , semaModel_(semaModel)
+    , symPool_(semaModel->symbolPool())
     , stashedScope_(nullptr)
     , diagReporter_(this)
+    , funcDefBinding_(nullptr)
 {}
 
 Binder::~Binder()
 {
+    releaseDeclTySyms();
 }
 
 void Binder::bind()
@@ -68,11 +144,17 @@ void Binder::bind()
 
 void Binder::openScope(ScopeKind scopeK)
 {
-    std::unique_ptr<Scope> scope(new Scope(scopeK));
+    auto enclosingScope = scopes_.top();
+    std::unique_ptr<Scope> scope(new Scope(scopeK, enclosingScope));
     scopes_.push(scope.get());
 
-    auto enclosingScope = scopes_.top();
-    enclosingScope->enclose(std::move(scope));
+    if (funcDefBinding_ && enclosingScope && enclosingScope->kind() == ScopeKind::File)
+        funcDefBinding_->scopes_.push_back(scope.get());
+
+    if (enclosingScope)
+        enclosingScope->enclose(std::move(scope));
+    else
+        semaModel_->keepOutermostScope(std::move(scope));
 }
 
 void Binder::reopenStashedScope()
@@ -97,7 +179,14 @@ template <class SymT>
 SymT* Binder::pushSym(const SyntaxNode* node, std::unique_ptr<SymT> sym)
 {
     syms_.push(sym.get());
-    return static_cast<SymT*>(semaModel_->storeDeclaredSym(node, std::move(sym)));
+    auto rawSym = static_cast<SymT*>(semaModel_->storeDeclaredSym(node, std::move(sym)));
+
+    if (funcDefBinding_) {
+        funcDefBinding_->syms_.push_back(rawSym);
+        funcDefBinding_->declSyms_.emplace_back(node, rawSym);
+    }
+
+    return rawSym;
 }
 
 template FunctionSymbol* Binder::pushSym<FunctionSymbol>(const SyntaxNode*, std::unique_ptr<FunctionSymbol>);
@@ -117,8 +206,11 @@ void Binder::popSym()
 template <class TySymT>
 TySymT* Binder::pushTySym(std::unique_ptr<TySymT> tySym)
 {
-    tySyms_.push(tySym.get());
-    return static_cast<TySymT*>(semaModel_->storeUsedSym(std::move(tySym)));
+    auto rawTySym = tySym.release();
+    tySyms_.push(rawTySym);
+    declTySyms_.push_back(rawTySym);
+
+    return rawTySym;
 }
 
 template ArrayTypeSymbol* Binder::pushTySym<ArrayTypeSymbol>(std::unique_ptr<ArrayTypeSymbol>);
@@ -131,6 +223,16 @@ void Binder::popTySym()
     tySyms_.pop();
 }
 
+void Binder::releaseDeclTySyms()
+{
+    // The memory is reclaimed with the pool; only the destructors must run.
+    tySyms_ = TySymContT();
+    for (auto tySym : declTySyms_)
+        tySym->~TypeSymbol();
+    declTySyms_.clear();
+    declTySymPool_.reset();
+}
+
     //--------------//
     // Declarations //
     //--------------//
@@ -141,14 +243,298 @@ SyntaxVisitor::Action Binder::visitTranslationUnit(const TranslationUnitSyntax*
 
     openScope(ScopeKind::File);
 
-    for (auto declIt = node->declarations(); declIt; declIt = declIt->next)
+    indexPredecessorFunctionDefinitions();
+
+    for (auto declIt = node->declarations(); declIt; declIt = declIt->next) {
+        auto funcDef = declIt->value->asFunctionDefinition();
+        if (funcDef) {
+            if (adoptFunctionDefinitionBinding(funcDef))
+                continue;
+            funcDefBinding_ = semaModel_->recordFunctionDefinitionBinding(funcDef);
+        }
+
         visit(declIt->value);
+        releaseDeclTySyms();
+
+        funcDefBinding_ = nullptr;
+    }
 
     closeScope();
 
     return Action::Skip;
 }
 
+void Binder::indexPredecessorFunctionDefinitions()
+{
+    auto predSemaModel = semaModel_->predecessor();
+    if (!predSemaModel)
+        return;
+
+    for (const auto& kv : predSemaModel->functionDefinitionBindings()) {
+        if (kv.second.hasDiagnostics_)
+            continue;
+        predFuncDefs_.emplace(textOf(predSemaModel->syntaxTree(), kv.first), kv.first);
+    }
+}
+
+/*
+ * The binding of a FunctionDefinitionSyntax depends only on the definition
+ * itself, except for the tags and typedef names that it uses but that are
+ * declared outside it (at file scope). So the binding may be adopted from
+ * the predecessor SemanticModel if the definition's text is unchanged,
+ * provided that its syntax (which, in C, may depend on preceding typedef
+ * names) is also the same; the types designated by such names are remapped
+ * to the declarations of the names in the SyntaxTree.
+ */
+bool Binder::adoptFunctionDefinitionBinding(const FunctionDefinitionSyntax* node)
+{
+    auto predIt = predFuncDefs_.find(textOf(tree_, node));
+    if (predIt == predFuncDefs_.end())
+        return false;
+
+    auto predNode = predIt->second;
+    predFuncDefs_.erase(predIt);
+
+    auto predSemaModel = semaModel_->predecessor();
+    auto predTree = predSemaModel->syntaxTree();
+    auto& predBinding = predSemaModel->functionDefinitionBindings()[predNode];
+    auto predFileScope = predSemaModel->outermostScope();
+    auto fileScope = scopes_.top();
+
+    NodesInPreorder predNodes(predTree, predNode);
+    NodesInPreorder nodes(tree_, node);
+    if (predNodes.nodes_.size() != nodes.nodes_.size())
+        return false;
+
+    std::unordered_map<const SyntaxNode*, const SyntaxNode*> nodeMap;
+    std::unordered_map<const Identifier*, const Identifier*> identMap;
+    std::map<std::pair<std::string, NameSpaceKind>, const Identifier*> tyNameIdents;
+    for (std::size_t i = 0; i < nodes.nodes_.size(); ++i) {
+        auto predNode_P = predNodes.nodes_[i];
+        auto node_P = nodes.nodes_[i];
+        if (predNode_P->kind() != node_P->kind())
+            return false;
+        nodeMap[predNode_P] = node_P;
+
+        std::pair<const Identifier*, const Identifier*> idents { nullptr, nullptr };
+        switch (node_P->kind()) {
+            case IdentifierDeclarator:
+                idents = { identifierOf(predNode_P->asIdentifierDeclarator()->identifierToken()),
+                           identifierOf(node_P->asIdentifierDeclarator()->identifierToken()) };
+                break;
+
+            case EnumeratorDeclaration:
+                idents = { identifierOf(predNode_P->asEnumeratorDeclaration()->identifierToken()),
+                           identifierOf(node_P->asEnumeratorDeclaration()->identifierToken()) };
+                break;
+
+            case StructTypeSpecifier:
+            case UnionTypeSpecifier:
+            case EnumTypeSpecifier: {
+                auto tagTk = node_P->asTagTypeSpecifier()->tagToken();
+                idents = { identifierOf(predNode_P->asTagTypeSpecifier()->tagToken()),
+                           identifierOf(tagTk) };
+                if (idents.second)
+                    tyNameIdents[{ tagTk.valueText(), NameSpaceKind::Tags }] = idents.second;
+                break;
+            }
+
+            case TypedefName: {
+                auto identTk = node_P->asTypedefName()->identifierToken();
+                if (auto ident = identifierOf(identTk))
+                    tyNameIdents[{ identTk.valueText(), NameSpaceKind::Ordinary }] = ident;
+                break;
+            }
+
+            default:
+                break;
+        }
+        if (idents.first && idents.second)
+            identMap[idents.first] = idents.second;
+    }
+
+    std::unordered_set<const Scope*> ownScopes(predBinding.scopes_.begin(), predBinding.scopes_.end());
+    auto isWithinOwnScope = [&ownScopes] (const Scope* scope) {
+        while (scope && !ownScopes.count(scope))
+            scope = scope->outerScope();
+        return scope != nullptr;
+    };
+
+    /*
+     * The (canonical) types of the Symbols that belong to the SyntaxTree, but
+     * not to the definition itself, are adopted as well; except for a type
+     * designated by a tag or typedef name declared outside the definition,
+     * which is remapped.
+     */
+    std::unordered_set<const Symbol*> ownSyms(predBinding.syms_.begin(), predBinding.syms_.end());
+    std::unordered_set<const Symbol*> tySyms;
+    std::unordered_set<const NamedTypeSymbol*> outerNamedTySyms;
+    std::vector<const Symbol*> pendingSyms(predBinding.syms_.begin(), predBinding.syms_.end());
+    while (!pendingSyms.empty()) {
+        auto sym = pendingSyms.back();
+        pendingSyms.pop_back();
+        for (auto tySym : componentTySyms(sym)) {
+            if (!tySym
+                    || tySym->syntaxTree() != predTree
+                    || ownSyms.count(tySym)
+                    || tySyms.count(tySym)) {
+                continue;
+            }
+            if (tySym->typeKind() == TypeKind::Named && !isWithinOwnScope(tySym->scope())) {
+                if (tySym->scope() != predFileScope)
+                    return false;
+                outerNamedTySyms.insert(tySym->asNamedType());
+                continue;
+            }
+            tySyms.insert(tySym);
+            pendingSyms.push_back(tySym);
+        }
+    }
+
+    std::unordered_set<const Symbol*> declaredSyms;
+    for (const auto& declSym : predBinding.declSyms_)
+        declaredSyms.insert(declSym.second);
+    for (auto sym : predBinding.syms_) {
+        auto tySym = sym->kind() == SymbolKind::Type ? sym->asType() : nullptr;
+        if (!tySym
+                || tySym->typeKind() != TypeKind::Named
+                || tySym->asNamedType()->namedTypeKind() == NamedTypeKind::Builtin) {
+            continue;
+        }
+        if (!isWithinOwnScope(tySym->scope()))
+            return false;
+
+        /*
+         * 6.7.2.3-8
+         * A tag that the definition (implicitly) declares must still lack
+         * a visible declaration at file scope.
+         */
+        if (declaredSyms.count(sym))
+            continue;
+        auto tagName = tySym->asNamedType()->name()
+                ? tySym->asNamedType()->name()->asTagSymbolName()
+                : nullptr;
+        if (!tagName)
+            continue;
+        auto identIt = tyNameIdents.find({ tagName->tag(), NameSpaceKind::Tags });
+        if (identIt != tyNameIdents.end()
+                && fileScope->searchForDeclaration(identIt->second, NameSpaceKind::Tags)) {
+            return false;
+        }
+    }
+
+    std::unordered_map<const TypeSymbol*, const TypeSymbol*> tySymMap;
+    for (auto namedTySym : outerNamedTySyms) {
+        auto namedTySym_P = remapNamedTySym(namedTySym, tyNameIdents);
+        if (!namedTySym_P)
+            return false;
+        tySymMap[namedTySym] = namedTySym_P;
+    }
+
+    std::vector<std::pair<const SyntaxNode*, Symbol*>> declSyms;
+    for (const auto& declSym : predBinding.declSyms_) {
+        auto it = nodeMap.find(declSym.first);
+        PSY_ASSERT(it != nodeMap.end(), return false);
+        declSyms.emplace_back(it->second, declSym.second);
+    }
+
+    // From this point onwards, the binding is moved into the SemanticModel.
+    auto predLibSym = predSemaModel->declaredSymbol(predTree->translationUnitRoot());
+    auto libSym = syms_.top();
+
+    auto binding = semaModel_->recordFunctionDefinitionBinding(node);
+    binding->syms_ = predBinding.syms_;
+    binding->declSyms_ = std::move(declSyms);
+    binding->scopes_ = predBinding.scopes_;
+
+    for (auto scope : predBinding.scopes_) {
+        auto scope_P = predFileScope->unenclose(scope);
+        PSY_ASSERT(scope_P, continue);
+        scope_P->rekeyDeclarations(identMap);
+        fileScope->enclose(std::move(scope_P));
+    }
+
+    for (const auto& decl : predBinding.fileScopeDecls_) {
+        auto it = identMap.find(std::get<0>(decl));
+        PSY_ASSERT(it != identMap.end(), continue);
+        fileScope->addDeclaration(it->second, std::get<1>(decl), std::get<2>(decl));
+        binding->fileScopeDecls_.emplace_back(it->second, std::get<1>(decl), std::get<2>(decl));
+    }
+
+    for (auto sym : predBinding.syms_) {
+        if (sym->containingSymbol() == predLibSym)
+            sym->setContainingSymbol(libSym);
+        if (sym->scope() == predFileScope)
+            sym->setScope(fileScope);
+        if (!tySymMap.empty()) {
+            if (auto typeableSym = TypeClass_TypeableSymbol::asInstance(sym)) {
+                auto tySym = componentTySyms(sym).front();
+                typeableSym->setType(semaModel_->internTySym(tySym, tySymMap));
+            }
+        }
+        semaModel_->adoptSym(sym);
+    }
+
+    // A type that is remapped (or has a remapped component) is left behind.
+    for (auto tySym : tySyms) {
+        if (semaModel_->internTySym(tySym->asType(), tySymMap) == tySym)
+            semaModel_->adoptSym(tySym);
+    }
+
+    for (const auto& declSym : binding->declSyms_)
+        semaModel_->adoptDeclaredSym(declSym.first, declSym.second);
+
+    predBinding = SemanticModel::FunctionDefinitionBinding();
+
+    return true;
+}
+
+/*
+ * 6.2.1-4
+ * The type designated by a tag or a typedef name, declared at file scope
+ * of the predecessor SemanticModel, is that of the visible declaration of
+ * the name (at file scope).
+ */
+const TypeSymbol* Binder::remapNamedTySym(
+        const NamedTypeSymbol* namedTySym,
+        const std::map<std::pair<std::string, NameSpaceKind>, const Identifier*>& tyNameIdents)
+{
+    auto tagName = namedTySym->name() ? namedTySym->name()->asTagSymbolName() : nullptr;
+    auto nsK = tagName ? NameSpaceKind::Tags : NameSpaceKind::Ordinary;
+    auto identIt = tagName
+            ? tyNameIdents.find({ tagName->tag(), nsK })
+            : namedTySym->name()
+                ? tyNameIdents.find({ namedTySym->name()->text(), nsK })
+                : tyNameIdents.end();
+    if (identIt == tyNameIdents.end())
+        return nullptr;
+
+    auto declSym = scopes_.top()->searchForDeclaration(identIt->second, nsK);
+    if (!declSym)
+        return nullptr;
+
+    std::unique_ptr<NamedTypeSymbol> namedTySym_P;
+    if (tagName) {
+        namedTySym_P = makeSymOrTySym<NamedTypeSymbol>(&declTySymPool_,
+                                                       tagName->tagChoice(),
+                                                       tagName->tag());
+    }
+    else {
+        namedTySym_P = makeSymOrTySym<NamedTypeSymbol>(&declTySymPool_,
+                                                       namedTySym->name()->text());
+    }
+    namedTySym_P->setScope(declSym->scope());
+    if (namedTySym->isConstQualified())
+        namedTySym_P->qualifyWithConst();
+    if (namedTySym->isVolatileQualified())
+        namedTySym_P->qualifyWithVolatile();
+    if (namedTySym->isRestrictQualified())
+        namedTySym_P->qualifyWithRestrict();
+    declTySyms_.push_back(namedTySym_P.get());
+
+    return semaModel_->internTySym(namedTySym_P.release());
+}
+
 SyntaxVisitor::Action Binder::visitIncompleteDeclaration(const IncompleteDeclarationSyntax* node)
 {
     ConstraintsInDeclarations::UselessDeclaration(node->lastToken(), &diagReporter_);
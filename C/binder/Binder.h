@@ -24,7 +24,10 @@
 #include "API.h"
 #include "Fwds.h"
 
+#include "binder/NameSpaceKind.h"
 #include "binder/Scope.h"
+#include "compilation/SemanticModel.h"
+#include "infra/MemoryPool.h"
 #include "parser/LexedTokens.h"
 #include "symbols/SymbolName.h"
 #include "symbols/Symbol_ALL.h"
@@ -34,16 +37,17 @@
 #include "../common/diagnostics/DiagnosticDescriptor.h"
 #include "../common/infra/InternalAccess.h"
 
+#include <map>
 #include <memory>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace psy {
 namespace C {
 
-class SemanticModel;
-
 /**
  * \brief The Binder class.
  */
@@ -69,6 +73,7 @@ private:
     void operator=(const Binder&) = delete;
 
     SemanticModel* semaModel_;
+    MemoryPool* symPool_;
 
     void openScope(ScopeKind scopeK);
     void closeScope();
@@ -87,9 +92,18 @@ private:
     using TySymContT = std::stack<TypeSymbol*>;
     TySymContT tySyms_;
 
+    /*
+     * The TypeSymbols built for a declaration are allocated in a scratch
+     * pool, which is released after each (external) declaration: only the
+     * canonical instances (see TypeInterner) outlive it.
+     */
+    MemoryPool declTySymPool_;
+    std::vector<TypeSymbol*> declTySyms_;
+    void releaseDeclTySyms();
+
     std::stack<FunctionTypeSymbol*> pendingFunTySyms_;
 
-    template <class SymT, class... SymTArgs> std::unique_ptr<SymT> makeSymOrTySym(SymTArgs... args);
+    template <class SymT, class... SymTArgs> std::unique_ptr<SymT> makeSymOrTySym(MemoryPool* pool, SymTArgs... args);
     template <class SymT, class... SymTArgs> void makeSymAndPushIt(const SyntaxNode* node, SymTArgs... arg);
     template <class SymT, class... SymTArgs> void makeTySymAndPushIt(SymTArgs... arg);
 
@@ -104,6 +118,19 @@ private:
 
     DiagnosticsReporter diagReporter_;
 
+    /*
+     * The binding of the FunctionDefinitionSyntax being visited, recorded for
+     * adoption by a successor SemanticModel, and the (unadopted) bindings of
+     * the predecessor SemanticModel, indexed by the text of their definitions.
+     */
+    SemanticModel::FunctionDefinitionBinding* funcDefBinding_;
+    std::unordered_map<std::string, const FunctionDefinitionSyntax*> predFuncDefs_;
+    void indexPredecessorFunctionDefinitions();
+    bool adoptFunctionDefinitionBinding(const FunctionDefinitionSyntax* node);
+    const TypeSymbol* remapNamedTySym(
+            const NamedTypeSymbol* namedTySym,
+            const std::map<std::pair<std::string, NameSpaceKind>, const Identifier*>& tyNameIdents);
+
     //--------------//
     // Declarations //
     //--------------//
@@ -159,6 +186,7 @@ private:
     virtual Action visitTagTypeSpecifier(const TagTypeSpecifierSyntax*) override;
     virtual Action visitTypeDeclarationAsSpecifier(const TypeDeclarationAsSpecifierSyntax*) override;
     virtual Action visitTypedefName(const TypedefNameSyntax*) override;
+    void resolveTySymAtTop(SyntaxToken nameTk, NameSpaceKind nsK);
     virtual Action visitTypeQualifier(const TypeQualifierSyntax*) override;
     Action visitIfNotTypeQualifier(const SpecifierSyntax*);
     Action visitIfTypeQualifier(const SpecifierSyntax*);
@@ -172,6 +200,7 @@ private:
     virtual Action visitIdentifierDeclarator(const IdentifierDeclaratorSyntax*) override;
     virtual Action visitAbstractDeclarator(const AbstractDeclaratorSyntax*) override;
     Action nameSymAtTop(const char* s);
+    Action declareSymAtTop(SyntaxToken identTk, NameSpaceKind nsK);
     Action typeSymAtTopAndPopIt();
 
     template <class DecltrT> Action determineContextAndMakeSym(const DecltrT* node);
@@ -184,26 +213,27 @@ private:
 };
 
 template <class SymT, class... SymTArgs>
-std::unique_ptr<SymT> Binder::makeSymOrTySym(SymTArgs... args)
+std::unique_ptr<SymT> Binder::makeSymOrTySym(MemoryPool* pool, SymTArgs... args)
 {
-    std::unique_ptr<SymT> sym(new SymT(tree_,
-                                       scopes_.top(),
-                                       syms_.top(),
-                                       std::forward<SymTArgs>(args)...));
+    std::unique_ptr<SymT> sym(new (pool) SymT(pool,
+                                              tree_,
+                                              scopes_.top(),
+                                              syms_.top(),
+                                              std::forward<SymTArgs>(args)...));
     return sym;
 }
 
 template <class SymT, class... SymTArgs>
 void Binder::makeSymAndPushIt(const SyntaxNode* node, SymTArgs... args)
 {
-    std::unique_ptr<SymT> sym = makeSymOrTySym<SymT>(std::forward<SymTArgs>(args)...);
+    std::unique_ptr<SymT> sym = makeSymOrTySym<SymT>(symPool_, std::forward<SymTArgs>(args)...);
     pushSym(node, std::move(sym));
 }
 
 template <class SymT, class... SymTArgs>
 void Binder::makeTySymAndPushIt(SymTArgs... args)
 {
-    std::unique_ptr<SymT> sym = makeSymOrTySym<SymT>(std::forward<SymTArgs>(args)...);
+    std::unique_ptr<SymT> sym = makeSymOrTySym<SymT>(&declTySymPool_, std::forward<SymTArgs>(args)...);
     pushTySym(std::move(sym));
 }
 
@@ -28,6 +28,7 @@
 #include "symbols/Symbol_ALL.h"
 #include "symbols/SymbolName_ALL.h"
 #include "syntax/SyntaxFacts.h"
+#include "syntax/SyntaxLexeme_ALL.h"
 #include "syntax/SyntaxNodes.h"
 #include "syntax/SyntaxUtilities.h"
 
@@ -49,14 +50,31 @@ SyntaxVisitor::Action Binder::nameSymAtTop(const char* s)
 
     std::unique_ptr<SymbolName> name;
     if (s)
-        name.reset(new PlainSymbolName(s));
+        name.reset(new (symPool_) PlainSymbolName(s));
     else
-        name.reset(new EmptySymbolName);
+        name.reset(new (symPool_) EmptySymbolName);
     nameableSym->setName(std::move(name));
 
     return Action::Skip;
 }
 
+SyntaxVisitor::Action Binder::declareSymAtTop(SyntaxToken identTk, NameSpaceKind nsK)
+{
+    PSY_ASSERT(!syms_.empty(), return Action::Quit);
+    PSY_ASSERT(!scopes_.empty() && scopes_.top(), return Action::Quit);
+
+    auto lexeme = identTk.valueLexeme();
+    if (!lexeme || !lexeme->asIdentifier())
+        return Action::Skip;
+
+    scopes_.top()->addDeclaration(lexeme->asIdentifier(), nsK, syms_.top());
+
+    if (funcDefBinding_ && scopes_.top()->kind() == ScopeKind::File)
+        funcDefBinding_->fileScopeDecls_.emplace_back(lexeme->asIdentifier(), nsK, syms_.top());
+
+    return Action::Skip;
+}
+
 SyntaxVisitor::Action Binder::typeSymAtTopAndPopIt()
 {
     PSY_ASSERT(!syms_.empty(), return Action::Quit);
@@ -68,8 +86,14 @@ SyntaxVisitor::Action Binder::typeSymAtTopAndPopIt()
     PSY_ASSERT(!tySyms_.empty(), return Action::Quit);
     auto tySym = tySyms_.top();
 
+    /*
+     * The type is complete once it's given to the symbol; from then on,
+     * only its canonical instance is referenced.
+     */
+    auto canonTySym = semaModel_->internTySym(tySym);
+
     if (!pendingFunTySyms_.empty())
-        pendingFunTySyms_.top()->addParameter(tySym);
+        pendingFunTySyms_.top()->addParameter(canonTySym);
 
     switch (tySym->typeKind()) {
         case TypeKind::Array:
@@ -85,7 +109,7 @@ SyntaxVisitor::Action Binder::typeSymAtTopAndPopIt()
             PSY_ESCAPE_VIA_RETURN(Action::Quit);
     }
 
-    typeableSym->setType(tySym);
+    typeableSym->setType(canonTySym);
 
     popSym();
 
@@ -124,6 +148,7 @@ SyntaxVisitor::Action Binder::visitEnumeratorDeclaration_AtDeclarator(const Enum
 {
     determineContextAndMakeSym(node);
     nameSymAtTop(node->identifierToken().valueText_c_str());
+    declareSymAtTop(node->identifierToken(), NameSpaceKind::Ordinary);
     typeSymAtTopAndPopIt();
 
     return visitEnumeratorDeclaration_DONE(node);
@@ -147,10 +172,19 @@ SyntaxVisitor::Action Binder::visitFunctionDefinition_AtDeclarator(const Functio
     reopenStashedScope();
     scopes_.top()->morphFrom_FunctionPrototype_to_Block();
 
+    /*
+     * The declarations of the body specify their own types, independently
+     * of the (return) type specified for the function.
+     */
+    TySymContT outerTySyms;
+    std::swap(tySyms_, outerTySyms);
+
     auto body = node->body()->asCompoundStatement();
     for (auto stmtIt = body->statements(); stmtIt; stmtIt = stmtIt->next)
         visit(stmtIt->value);
 
+    std::swap(tySyms_, outerTySyms);
+
     closeScope();
 
     return Binder::visitFunctionDefinition_DONE(node);
@@ -355,6 +389,14 @@ SyntaxVisitor::Action Binder::visitIdentifierDeclarator(const IdentifierDeclarat
     determineContextAndMakeSym(node);
     nameSymAtTop(node->identifierToken().valueText_c_str());
 
+    /*
+     * 6.2.3-1
+     * Each structure or union has a separate name space for its members,
+     * so fields aren't declared in the (ordinary) scope of the declarator.
+     */
+    if (!(syms_.top()->asValue() && syms_.top()->asValue()->asField()))
+        declareSymAtTop(node->identifierToken(), NameSpaceKind::Ordinary);
+
     return Action::Skip;
 }
 
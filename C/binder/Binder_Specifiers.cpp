@@ -29,6 +29,7 @@
 #include "symbols/Symbol_ALL.h"
 #include "symbols/SymbolName_ALL.h"
 #include "syntax/SyntaxFacts.h"
+#include "syntax/SyntaxLexeme_ALL.h"
 #include "syntax/SyntaxNodes.h"
 #include "syntax/SyntaxUtilities.h"
 
@@ -73,6 +74,7 @@ SyntaxVisitor::Action Binder::visitStructOrUnionDeclaration_AtSpecifier(
     makeSymAndPushIt<NamedTypeSymbol>(node,
                                       tagChoice,
                                       tySpec->tagToken().valueText_c_str());
+    declareSymAtTop(tySpec->tagToken(), NameSpaceKind::Tags);
 
     return visitTypeDeclaration_AtInternalDeclarations_COMMON(
                 node,
@@ -84,6 +86,7 @@ SyntaxVisitor::Action Binder::visitEnumDeclaration_AtSpecifier(const EnumDeclara
     makeSymAndPushIt<NamedTypeSymbol>(node,
                                       TagSymbolName::TagChoice::Enum,
                                       node->typeSpecifier()->tagToken().valueText_c_str());
+    declareSymAtTop(node->typeSpecifier()->tagToken(), NameSpaceKind::Tags);
 
     return visitTypeDeclaration_AtInternalDeclarations_COMMON(
                 node,
@@ -242,6 +245,7 @@ SyntaxVisitor::Action Binder::visitTagTypeSpecifier(const TagTypeSpecifierSyntax
         }
 
         makeTySymAndPushIt<NamedTypeSymbol>(tagChoice, node->tagToken().valueText_c_str());
+        resolveTySymAtTop(node->tagToken(), NameSpaceKind::Tags);
     }
 
     for (auto attrIt = node->attributes(); attrIt; attrIt = attrIt->next)
@@ -286,18 +290,65 @@ SyntaxVisitor::Action Binder::visitTypeDeclarationAsSpecifier(const TypeDeclarat
     }
 
     makeTySymAndPushIt<NamedTypeSymbol>(tagChoice, tySpec->tagToken().valueText_c_str());
+    resolveTySymAtTop(tySpec->tagToken(), NameSpaceKind::Tags);
 
     return Action::Skip;
 }
 
 SyntaxVisitor::Action Binder::visitTypedefName(const TypedefNameSyntax* node)
 {
-    if (tySyms_.empty())
+    if (tySyms_.empty()) {
         makeTySymAndPushIt<NamedTypeSymbol>(node->identifierToken().valueText_c_str());
+        resolveTySymAtTop(node->identifierToken(), NameSpaceKind::Ordinary);
+    }
 
     return Action::Skip;
 }
 
+void Binder::resolveTySymAtTop(SyntaxToken nameTk, NameSpaceKind nsK)
+{
+    PSY_ASSERT(!tySyms_.empty(), return);
+    PSY_ASSERT(!scopes_.empty() && scopes_.top(), return);
+
+    auto lexeme = nameTk.valueLexeme();
+    if (!lexeme || !lexeme->asIdentifier())
+        return;
+    auto ident = lexeme->asIdentifier();
+
+    /*
+     * 6.2.1-4
+     * The type designated by a tag or a typedef name is that of the visible
+     * declaration of the name, which is in the Scope of that declaration.
+     */
+    auto declSym = scopes_.top()->searchForDeclaration(ident, nsK);
+    if (declSym) {
+        tySyms_.top()->setScope(declSym->scope());
+        return;
+    }
+
+    /*
+     * 6.7.2.3-8
+     * A tag without a visible declaration declares the tag in the current Scope.
+     */
+    if (nsK != NameSpaceKind::Tags)
+        return;
+
+    // Unlike the other TypeSymbols of the declaration, this one outlives it.
+    auto tagName = tySyms_.top()->asNamedType()->name()->asTagSymbolName();
+    PSY_ASSERT(tagName, return);
+    auto tagTySym = makeSymOrTySym<NamedTypeSymbol>(symPool_, tagName->tagChoice(), tagName->tag());
+    popTySym();
+    tySyms_.push(tagTySym.get());
+    auto rawTagTySym = semaModel_->storeUsedSym(std::move(tagTySym));
+    if (funcDefBinding_)
+        funcDefBinding_->syms_.push_back(rawTagTySym);
+
+    scopes_.top()->addDeclaration(ident, nsK, tySyms_.top());
+
+    if (funcDefBinding_ && scopes_.top()->kind() == ScopeKind::File)
+        funcDefBinding_->fileScopeDecls_.emplace_back(ident, nsK, tySyms_.top());
+}
+
 SyntaxVisitor::Action Binder::visitTypeQualifier(const TypeQualifierSyntax* node)
 {
     PSY_ASSERT(!tySyms_.empty(), return Action::Quit);
@@ -28,4 +28,7 @@ using namespace C;
 void Binder::DiagnosticsReporter::diagnose(DiagnosticDescriptor&& desc, SyntaxToken tk)
 {
     binder_->tree_->newDiagnostic(desc, tk);
+
+    if (binder_->funcDefBinding_)
+        binder_->funcDefBinding_->hasDiagnostics_ = true;
 };
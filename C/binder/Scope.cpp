@@ -21,12 +21,17 @@
 #include "Scope.h"
 
 #include "../common/infra/Assertions.h"
+#include "../common/infra/Escape.h"
+
+#include <algorithm>
 
 using namespace psy;
 using namespace C;
 
-Scope::Scope(ScopeKind kind)
+Scope::Scope(ScopeKind kind, const Scope* outerScope)
     : kind_(kind)
+    , outerScope_(outerScope)
+    , fileScope_(outerScope ? outerScope->fileScope_ : this)
 {}
 
 ScopeKind Scope::kind() const
@@ -34,11 +39,96 @@ ScopeKind Scope::kind() const
     return kind_;
 }
 
+const Scope* Scope::outerScope() const
+{
+    return outerScope_;
+}
+
+const Scope::DeclarationsTable& Scope::declarations(NameSpaceKind nsK) const
+{
+    PSY_ASSERT(nsK != NameSpaceKind::UNSPECIFIED, return decls_[0]);
+
+    return decls_[static_cast<std::size_t>(nsK) - 1];
+}
+
+const Symbol* Scope::searchForDeclarationHere(const Identifier* ident, NameSpaceKind nsK) const
+{
+    const auto& decls = declarations(nsK);
+    if (decls.empty())
+        return nullptr;
+
+    auto it = decls.find(ident);
+    return it == decls.end() ? nullptr
+                             : it->second;
+}
+
+const Symbol* Scope::searchForDeclaration(const Identifier* ident, NameSpaceKind nsK) const
+{
+    for (auto scope = this; scope != fileScope_; scope = scope->outerScope_) {
+        auto sym = scope->searchForDeclarationHere(ident, nsK);
+        if (sym)
+            return sym;
+    }
+
+    // Most lookups that leave a block end up at file scope; go there directly.
+    return fileScope_->searchForDeclarationHere(ident, nsK);
+}
+
+void Scope::addDeclaration(const Identifier* ident, NameSpaceKind nsK, const Symbol* sym)
+{
+    PSY_ASSERT(ident && nsK != NameSpaceKind::UNSPECIFIED, return);
+
+    decls_[static_cast<std::size_t>(nsK) - 1][ident] = sym;
+}
+
 void Scope::enclose(std::unique_ptr<Scope> scope)
 {
+    scope->outerScope_ = this;
+    scope->resetFileScope(fileScope_);
     enclosedScopes_.push_back(std::move(scope));
 }
 
+std::unique_ptr<Scope> Scope::unenclose(const Scope* scope)
+{
+    auto it = std::find_if(enclosedScopes_.begin(),
+                           enclosedScopes_.end(),
+                           [scope] (const auto& enclosedScope) {
+                                return enclosedScope.get() == scope;
+                           });
+    if (it == enclosedScopes_.end())
+        PSY_ESCAPE_VIA_RETURN(nullptr);
+
+    std::unique_ptr<Scope> unenclosedScope = std::move(*it);
+    enclosedScopes_.erase(it);
+    unenclosedScope->outerScope_ = nullptr;
+    unenclosedScope->resetFileScope(unenclosedScope.get());
+    return unenclosedScope;
+}
+
+void Scope::resetFileScope(const Scope* fileScope)
+{
+    fileScope_ = fileScope;
+    for (auto& enclosedScope : enclosedScopes_)
+        enclosedScope->resetFileScope(fileScope);
+}
+
+void Scope::rekeyDeclarations(const std::unordered_map<const Identifier*, const Identifier*>& idents)
+{
+    for (auto& decls : decls_) {
+        DeclarationsTable rekeyedDecls;
+        for (const auto& kv : decls) {
+            auto it = idents.find(kv.first);
+            if (it == idents.end())
+                continue;
+            rekeyedDecls[it->second] = kv.second;
+        }
+        decls = std::move(rekeyedDecls);
+    }
+
+    for (auto& enclosedScope : enclosedScopes_)
+        enclosedScope->rekeyDeclarations(idents);
+}
+
 void Scope::morphFrom_FunctionPrototype_to_Block()
 {
     PSY_ASSERT(kind_ == ScopeKind::FunctionPrototype, return);
@@ -24,10 +24,12 @@
 #include "API.h"
 #include "Fwds.h"
 
+#include "NameSpaceKind.h"
 #include "ScopeKind.h"
 
 #include "../common/infra/InternalAccess.h"
 
+#include <array>
 #include <memory>
 #include <cstdint>
 #include <unordered_map>
@@ -51,17 +53,48 @@ public:
      */
     ScopeKind kind() const;
 
+    /**
+     * The Scope that encloses \c this Scope (\c nullptr for the outermost one).
+     */
+    const Scope* outerScope() const;
+
+    /**
+     * The Symbol declared by Identifier \p ident, in the NameSpace of NameSpaceKind
+     * \p nsK, as visible from \c this Scope: the search starts in \c this Scope and
+     * proceeds through the enclosing ones, ending at the file Scope.
+     *
+     * \remark 6.2.1-4
+     * \remark 6.2.3-1
+     */
+    const Symbol* searchForDeclaration(const Identifier* ident, NameSpaceKind nsK) const;
+
+    /**
+     * The Symbol declared by Identifier \p ident, in the NameSpace of NameSpaceKind
+     * \p nsK, in \c this Scope only.
+     */
+    const Symbol* searchForDeclarationHere(const Identifier* ident, NameSpaceKind nsK) const;
+
 PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(Binder);
 
-    Scope(ScopeKind kind);
+    Scope(ScopeKind kind, const Scope* outerScope);
 
     void enclose(std::unique_ptr<Scope> scope);
+    std::unique_ptr<Scope> unenclose(const Scope* scope);
+    void rekeyDeclarations(const std::unordered_map<const Identifier*, const Identifier*>& idents);
     void morphFrom_FunctionPrototype_to_Block();
+    void addDeclaration(const Identifier* ident, NameSpaceKind nsK, const Symbol* sym);
 
 private:
     ScopeKind kind_;
+    const Scope* outerScope_;
+    const Scope* fileScope_;
     std::vector<std::unique_ptr<Scope>> enclosedScopes_;
+    void resetFileScope(const Scope* fileScope);
+
+    using DeclarationsTable = std::unordered_map<const Identifier*, const Symbol*>;
+    std::array<DeclarationsTable, 4> decls_;
+    const DeclarationsTable& declarations(NameSpaceKind nsK) const;
 };
 
 } // C
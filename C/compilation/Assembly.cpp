@@ -20,24 +20,292 @@
 
 #include "Assembly.h"
 
+#include "TypeInterner.h"
+
+#include "symbols/Symbol_ALL.h"
+#include "symbols/SymbolName_ALL.h"
+#include "symbols/TypeClass_NameableSymbol.h"
+#include "infra/MemoryPool.h"
+
+#include "../common/infra/Assertions.h"
+
 #include <algorithm>
 
 using namespace psy;
 using namespace C;
 
-std::vector<const Symbol*> Assembly::symbols() const
+namespace {
+
+const std::vector<const Symbol*> kEmptyIndex;
+
+const SymbolName* nameOf(const Symbol* sym)
+{
+    switch (sym->kind()) {
+        case SymbolKind::Function:
+            return sym->asFunction()->name();
+        case SymbolKind::Value:
+            return sym->asValue()->name();
+        case SymbolKind::Type:
+            return sym->asType()->asNamedType()
+                    ? sym->asType()->asNamedType()->name()
+                    : nullptr;
+        default:
+            return nullptr;
+    }
+}
+
+} // anonymous
+
+struct Assembly::SymbolArena
+{
+    MemoryPool pool_;
+    std::vector<Symbol*> syms_;
+};
+
+Assembly::Assembly()
+    : tyInterner_(new TypeInterner(this))
+{}
+
+Assembly::~Assembly()
+{
+    for (const auto& kv : symArenas_) {
+        for (const auto& arena : kv.second) {
+            for (auto sym : arena->syms_)
+                sym->~Symbol();
+        }
+    }
+}
+
+const std::vector<const Symbol*>& Assembly::symbols() const
+{
+    refreshFlatSymDEFs();
+
+    return allSymDEFs_;
+}
+
+Assembly::SymbolArena* Assembly::symbolArena(const SyntaxTree* tree)
+{
+    // A lookup of an existing arena must not modify the map (see Compilation::bindAll).
+    auto it = symArenas_.find(tree);
+    if (it != symArenas_.end() && !it->second.empty())
+        return it->second.front().get();
+
+    auto& arenas = symArenas_[tree];
+    if (arenas.empty())
+        arenas.emplace_back(new SymbolArena);
+    return arenas.front().get();
+}
+
+MemoryPool* Assembly::symbolPool(const SyntaxTree* tree)
+{
+    return &symbolArena(tree)->pool_;
+}
+
+Symbol* Assembly::storeSymDEF(std::unique_ptr<Symbol> sym)
+{
+    Symbol* rawSym = storeSymUSE(std::move(sym));
+    indexSymDEF(rawSym);
+
+    return rawSym;
+}
+
+Symbol* Assembly::storeSymUSE(std::unique_ptr<Symbol> sym)
+{
+    Symbol* rawSym = sym.release();
+    rawSym->setOwningAssembly(this);
+    symbolArena(rawSym->syntaxTree())->syms_.push_back(rawSym);
+
+    return rawSym;
+}
+
+void Assembly::indexSymDEF(Symbol* sym)
+{
+    auto& treeSymDEFs = symDEFsByTree_[sym->syntaxTree()];
+    if (treeSymDEFs.empty()
+            && std::find(treesOfSymDEFs_.begin(),
+                         treesOfSymDEFs_.end(),
+                         sym->syntaxTree()) == treesOfSymDEFs_.end()) {
+        treesOfSymDEFs_.push_back(sym->syntaxTree());
+    }
+    treeSymDEFs.push_back(sym);
+
+    if (!flatSymDEFsStale_) {
+        allSymDEFs_.push_back(sym);
+        symDEFsByKind_[static_cast<std::size_t>(sym->kind())].push_back(sym);
+    }
+
+    if (auto name = nameOf(sym))
+        symDEFsByName_[name->text()].push_back(sym);
+    else if (TypeClass_NameableSymbol::asInstance(sym))
+        unnamedSymDEFs_.push_back(sym);
+}
+
+void Assembly::discardSyms(const SyntaxTree* tree,
+                           const SyntaxTree* heirTree,
+                           const std::unordered_set<const Symbol*>& heirSyms)
+{
+    auto it = symArenas_.find(tree);
+    if (it == symArenas_.end())
+        return;
+
+    auto treeIt = symDEFsByTree_.find(tree);
+    if (treeIt != symDEFsByTree_.end()) {
+        auto symDEFs = std::move(treeIt->second);
+        symDEFsByTree_.erase(treeIt);
+
+        std::unordered_set<const Symbol*> discardedSymDEFs;
+        for (auto sym : symDEFs) {
+            if (!heirSyms.count(sym)) {
+                discardedSymDEFs.insert(sym);
+                continue;
+            }
+            symDEFsByTree_[heirTree].push_back(sym);
+        }
+
+        // Only the names of the discarded Symbols are looked up.
+        for (auto sym : discardedSymDEFs) {
+            auto name = nameOf(sym);
+            if (!name)
+                continue;
+            auto nameIt = symDEFsByName_.find(name->text());
+            if (nameIt == symDEFsByName_.end())
+                continue;
+            auto& namedSymDEFs = nameIt->second;
+            namedSymDEFs.erase(std::remove(namedSymDEFs.begin(), namedSymDEFs.end(), sym),
+                               namedSymDEFs.end());
+            if (namedSymDEFs.empty())
+                symDEFsByName_.erase(nameIt);
+        }
+        unnamedSymDEFs_.erase(std::remove_if(unnamedSymDEFs_.begin(),
+                                             unnamedSymDEFs_.end(),
+                                             [&discardedSymDEFs] (const Symbol* sym) {
+                                                 return discardedSymDEFs.count(sym);
+                                             }),
+                              unnamedSymDEFs_.end());
+
+        // The heir tree takes the place of the discarded tree in the order of the trees.
+        auto orderIt = std::find(treesOfSymDEFs_.begin(), treesOfSymDEFs_.end(), tree);
+        if (orderIt != treesOfSymDEFs_.end()) {
+            if (heirTree
+                    && symDEFsByTree_.count(heirTree)
+                    && std::find(treesOfSymDEFs_.begin(),
+                                 treesOfSymDEFs_.end(),
+                                 heirTree) == treesOfSymDEFs_.end()) {
+                *orderIt = heirTree;
+            }
+            else
+                treesOfSymDEFs_.erase(orderIt);
+        }
+        flatSymDEFsStale_ = true;
+    }
+
+    auto arenas = std::move(it->second);
+    symArenas_.erase(it);
+
+    // The heirs are moved to the heir tree before the canonical types are discarded.
+    for (const auto& arena : arenas) {
+        for (auto sym : arena->syms_) {
+            if (heirSyms.count(sym))
+                sym->setSyntaxTree(heirTree);
+        }
+    }
+
+    tyInterner_->discard(tree);
+
+    // The memory is reclaimed with the pool; only the destructors must run.
+    for (auto& arena : arenas) {
+        auto heirsIt = std::partition(arena->syms_.begin(),
+                                      arena->syms_.end(),
+                                      [&heirSyms] (const Symbol* sym) {
+                                          return heirSyms.count(sym);
+                                      });
+        for (auto symIt = heirsIt; symIt != arena->syms_.end(); ++symIt)
+            (*symIt)->~Symbol();
+        arena->syms_.erase(heirsIt, arena->syms_.end());
+
+        if (!arena->syms_.empty()) {
+            symbolArena(heirTree);
+            symArenas_[heirTree].push_back(std::move(arena));
+        }
+    }
+}
+
+Symbol* Assembly::findSymDEF(std::function<bool (const Symbol*)> pred) const
+{
+    refreshFlatSymDEFs();
+
+    auto it = std::find_if(allSymDEFs_.begin(), allSymDEFs_.end(), pred);
+    return it == allSymDEFs_.end() ? nullptr
+                                   : const_cast<Symbol*>(*it);
+}
+
+const Assembly::SymbolIndex& Assembly::findSymDEFs(const std::string& name) const
+{
+    indexSymDEFsByName();
+
+    auto it = symDEFsByName_.find(name);
+    return it == symDEFsByName_.end() ? kEmptyIndex
+                                      : it->second;
+}
+
+const Assembly::SymbolIndex& Assembly::findSymDEFs(SymbolKind symK) const
+{
+    PSY_ASSERT(static_cast<std::size_t>(symK) < symDEFsByKind_.size(), return kEmptyIndex);
+
+    refreshFlatSymDEFs();
+
+    return symDEFsByKind_[static_cast<std::size_t>(symK)];
+}
+
+const Assembly::SymbolIndex& Assembly::findSymDEFs(const SyntaxTree* tree) const
+{
+    auto it = symDEFsByTree_.find(tree);
+    return it == symDEFsByTree_.end() ? kEmptyIndex
+                                      : it->second;
+}
+
+void Assembly::refreshFlatSymDEFs() const
+{
+    if (!flatSymDEFsStale_)
+        return;
+
+    allSymDEFs_.clear();
+    for (auto& symDEFs : symDEFsByKind_)
+        symDEFs.clear();
+    for (auto tree : treesOfSymDEFs_) {
+        auto treeIt = symDEFsByTree_.find(tree);
+        if (treeIt == symDEFsByTree_.end())
+            continue;
+        for (auto sym : treeIt->second) {
+            allSymDEFs_.push_back(sym);
+            symDEFsByKind_[static_cast<std::size_t>(sym->kind())].push_back(sym);
+        }
+    }
+    flatSymDEFsStale_ = false;
+}
+
+void Assembly::indexSymDEFsByName() const
+{
+    auto stillUnnamedIt = std::remove_if(
+                unnamedSymDEFs_.begin(),
+                unnamedSymDEFs_.end(),
+                [this] (const Symbol* sym) {
+                    auto name = nameOf(sym);
+                    if (!name)
+                        return false;
+                    symDEFsByName_[name->text()].push_back(sym);
+                    return true;
+                });
+    unnamedSymDEFs_.erase(stillUnnamedIt, unnamedSymDEFs_.end());
+}
+
+const TypeSymbol* Assembly::internTySym(const TypeSymbol* tySym)
 {
-    std::vector<const Symbol*> syms;
-    std::transform(symDEFs_.begin(),
-                   symDEFs_.end(),
-                   std::back_inserter(syms),
-                   [] (auto& sym) { return sym.get();});
-    return syms;
+    return tyInterner_->intern(tySym);
 }
 
-Symbol* Assembly::findSymDEF(std::function<bool (const std::unique_ptr<Symbol>&)> pred) const
+const TypeSymbol* Assembly::internTySym(const TypeSymbol* tySym,
+                                        const std::unordered_map<const TypeSymbol*, const TypeSymbol*>& tySymMap)
 {
-    auto it = std::find_if(symDEFs_.begin(), symDEFs_.end(), pred);
-    return it == symDEFs_.end() ? nullptr
-                                : it->get();
+    return tyInterner_->intern(tySym, tySymMap);
 }
@@ -25,10 +25,16 @@
 #include "Fwds.h"
 
 #include "symbols/Symbol.h"
+#include "symbols/SymbolKind.h"
 
 #include "../common/infra/InternalAccess.h"
 
+#include <array>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -45,19 +51,76 @@ class PSY_C_API Assembly
     friend class InternalsTestSuite;
 
 public:
+    ~Assembly();
+
     /**
      * The Symbols defined in \c this Assembly.
      */
-    std::vector<const Symbol*> symbols() const;
+    const std::vector<const Symbol*>& symbols() const;
 
 PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(SemanticModel);
+    PSY_GRANT_ACCESS(Compilation);
+    PSY_GRANT_ACCESS(TypeInterner);
+
+    using SymbolIndex = std::vector<const Symbol*>;
+
+    Assembly();
 
-    Symbol* findSymDEF(std::function<bool (const std::unique_ptr<Symbol>&)> pred) const;
+    MemoryPool* symbolPool(const SyntaxTree* tree);
+    Symbol* storeSymDEF(std::unique_ptr<Symbol> sym);
+    Symbol* storeSymUSE(std::unique_ptr<Symbol> sym);
+    void indexSymDEF(Symbol* sym);
+    void discardSyms(const SyntaxTree* tree,
+                     const SyntaxTree* heirTree = nullptr,
+                     const std::unordered_set<const Symbol*>& heirSyms = {});
+
+    const TypeSymbol* internTySym(const TypeSymbol* tySym);
+    const TypeSymbol* internTySym(const TypeSymbol* tySym,
+                                  const std::unordered_map<const TypeSymbol*, const TypeSymbol*>& tySymMap);
+
+    Symbol* findSymDEF(std::function<bool (const Symbol*)> pred) const;
+    const SymbolIndex& findSymDEFs(const std::string& name) const;
+    const SymbolIndex& findSymDEFs(SymbolKind symK) const;
+    const SymbolIndex& findSymDEFs(const SyntaxTree* tree) const;
 
 private:
-    std::unordered_set<std::unique_ptr<Symbol>> symDEFs_;
-    std::vector<std::unique_ptr<Symbol>> symUSEs_;
+    // Unavailable
+    Assembly(const Assembly&) = delete;
+    Assembly& operator=(const Assembly&) = delete;
+
+    /*
+     * The Symbols (their implementations and names included) of a SyntaxTree
+     * are allocated in an arena of the tree, which is released in bulk. The
+     * first arena of a tree is its own; others are inherited, together with
+     * the Symbols (of a replaced tree) that were adopted by the tree.
+     */
+    struct SymbolArena;
+    SymbolArena* symbolArena(const SyntaxTree* tree);
+    std::unordered_map<const SyntaxTree*, std::vector<std::unique_ptr<SymbolArena>>> symArenas_;
+
+    std::unique_ptr<TypeInterner> tyInterner_;
+
+    /*
+     * The index by tree is the primary one: the Symbols of a discarded tree
+     * are removed from it (and from the index by name) without a scan of
+     * the other trees. The flat indices, which follow the order of the
+     * trees, are rebuilt, lazily, upon a query after a discard.
+     */
+    std::unordered_map<const SyntaxTree*, SymbolIndex> symDEFsByTree_;
+    std::vector<const SyntaxTree*> treesOfSymDEFs_;
+    mutable SymbolIndex allSymDEFs_;
+    mutable std::array<SymbolIndex, 5> symDEFsByKind_;
+    mutable bool flatSymDEFsStale_ = false;
+    void refreshFlatSymDEFs() const;
+
+    /*
+     * A Symbol may be named by the Binder only after it's indexed; such a
+     * Symbol is indexed by name, lazily, upon a query after it's named.
+     */
+    mutable std::unordered_map<std::string, SymbolIndex> symDEFsByName_;
+    mutable SymbolIndex unnamedSymDEFs_;
+    void indexSymDEFsByName() const;
 };
 
 } // C
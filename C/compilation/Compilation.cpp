@@ -25,6 +25,8 @@
 #include "SemanticModel.h"
 #include "SyntaxTree.h"
 
+#include "infra/HardwareThreads.h"
+
 #include <algorithm>
 #include <unordered_map>
 
@@ -41,6 +43,7 @@ struct Compilation::CompilationImpl
     Compilation* Q_;
     std::string id_;
     std::unique_ptr<Assembly> assembly_;
+    std::vector<const SyntaxTree*> trees_;
     std::unordered_map<const SyntaxTree*, bool> isDirty_;
     std::unordered_map<const SyntaxTree*, std::unique_ptr<SemanticModel>> semaModels_;
 };
@@ -85,6 +88,7 @@ void Compilation::addSyntaxTree(const SyntaxTree* tree)
         return;
 
     P->semaModels_.insert(it, std::make_pair(tree, nullptr));
+    P->trees_.push_back(tree);
     P->isDirty_[tree] = true;
     tree->attachCompilation(this);
 }
@@ -95,21 +99,99 @@ void Compilation::addSyntaxTrees(std::vector<const SyntaxTree*> trees)
         addSyntaxTree(tree);
 }
 
+void Compilation::removeSyntaxTree(const SyntaxTree* tree)
+{
+    auto it = P->semaModels_.find(tree);
+    if (it == P->semaModels_.end())
+        return;
+
+    P->semaModels_.erase(it);
+    P->trees_.erase(std::find(P->trees_.begin(), P->trees_.end(), tree));
+    P->isDirty_.erase(tree);
+    P->assembly_->discardSyms(tree);
+    tree->detachCompilation(this);
+}
+
+void Compilation::replaceSyntaxTree(const SyntaxTree* oldTree, const SyntaxTree* newTree)
+{
+    auto it = P->semaModels_.find(oldTree);
+    if (it == P->semaModels_.end() || !it->second || P->isDirty_[oldTree]) {
+        removeSyntaxTree(oldTree);
+        addSyntaxTree(newTree);
+        return;
+    }
+
+    std::unique_ptr<SemanticModel> oldSemaModel = std::move(it->second);
+    P->semaModels_.erase(it);
+    P->isDirty_.erase(oldTree);
+
+    *std::find(P->trees_.begin(), P->trees_.end(), oldTree) = newTree;
+    newTree->attachCompilation(this);
+    auto semaModel = new SemanticModel(newTree, this, oldSemaModel.get());
+    P->semaModels_[newTree].reset(semaModel);
+    P->isDirty_[newTree] = false;
+
+    P->assembly_->discardSyms(oldTree, newTree, semaModel->adoptedSyms());
+    oldSemaModel.reset();
+    oldTree->detachCompilation(this);
+}
+
 std::vector<const SyntaxTree*> Compilation::syntaxTrees() const
 {
-    std::vector<const SyntaxTree*> trees(P->semaModels_.size());
-    std::transform(P->semaModels_.begin(),
-                   P->semaModels_.end(),
-                   std::back_inserter(trees),
-                   [] (const auto& kv) { return kv.first; });
-    return  trees;
+    return P->trees_;
+}
+
+void Compilation::bindAll()
+{
+    bindAll(runOnHardwareThreads);
+}
+
+void Compilation::bindAll(const Executor& executor)
+{
+    std::vector<const SyntaxTree*> trees;
+    for (auto tree : P->trees_) {
+        if (!P->isDirty_[tree])
+            continue;
+
+        P->semaModels_[tree].reset();
+        P->assembly_->discardSyms(tree);
+        trees.push_back(tree);
+    }
+
+    if (trees.empty())
+        return;
+
+    /*
+     * The symbol arenas are created upfront (the shared one included) so
+     * that, during binding, the Assembly is only read; the Symbols declared
+     * by a tree are kept aside, in its SemanticModel, to be indexed below.
+     */
+    P->assembly_->symbolPool(nullptr);
+    for (auto tree : trees)
+        P->assembly_->symbolPool(tree);
+
+    std::vector<std::unique_ptr<SemanticModel>> semaModels(trees.size());
+    std::vector<std::function<void ()>> tasks;
+    for (std::size_t i = 0; i < trees.size(); ++i) {
+        tasks.emplace_back([this, &trees, &semaModels, i] () {
+            semaModels[i].reset(new SemanticModel(trees[i], this, nullptr, true));
+        });
+    }
+    executor(tasks);
+
+    // The merge follows the order in which the trees were added.
+    for (std::size_t i = 0; i < trees.size(); ++i) {
+        semaModels[i]->indexDeferredSymDEFs();
+        P->semaModels_[trees[i]] = std::move(semaModels[i]);
+        P->isDirty_[trees[i]] = false;
+    }
 }
 
 const SemanticModel* Compilation::semanticModel(const SyntaxTree* tree) const
 {
     if (P->isDirty_[tree]) {
-        // TODO: Remove from the assembly the symbols associated
-        // with the given syntax tree.
+        P->semaModels_[tree].reset();
+        P->assembly_->discardSyms(tree);
         P->semaModels_[tree].reset(new SemanticModel(tree, const_cast<Compilation*>(this)));
         P->isDirty_[tree] = false;
     }
@@ -29,6 +29,7 @@
 #include "../common/infra/InternalAccess.h"
 #include "../common/infra/Pimpl.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -71,11 +72,49 @@ public:
      */
     void addSyntaxTrees(std::vector<const SyntaxTree*> trees);
 
+    /**
+     * Remove a SyntaxTree from \c this Compilation.
+     *
+     * \remark The Symbols of the SyntaxTree \p tree are released from the Assembly.
+     */
+    void removeSyntaxTree(const SyntaxTree* tree);
+
+    /**
+     * Replace SyntaxTree \p oldTree, in \c this Compilation, by SyntaxTree
+     * \p newTree (typically, a reparse of an edited \p oldTree).
+     *
+     * \remark The SemanticModel for \p newTree is computed incrementally: the
+     * Symbols of every function definition of \p oldTree that is unchanged
+     * in \p newTree are reused; the other Symbols of \p oldTree are released
+     * from the Assembly. The SyntaxTree \p oldTree must remain alive until
+     * this method returns.
+     */
+    void replaceSyntaxTree(const SyntaxTree* oldTree, const SyntaxTree* newTree);
+
     /**
      * The SyntaxTrees in \c this Compilation.
      */
     std::vector<const SyntaxTree*> syntaxTrees() const;
 
+    /**
+     * An executor runs a batch of tasks, possibly concurrently, and returns
+     * once all of them are finished.
+     */
+    using Executor = std::function<void (const std::vector<std::function<void ()>>&)>;
+
+    //!@{
+    /**
+     * Compute the SemanticModel of every SyntaxTree in \c this Compilation,
+     * binding each SyntaxTree in a task of \p executor (by default, one that
+     * runs on all hardware threads).
+     *
+     * \remark The Symbols of the SyntaxTrees are added to the Assembly in the
+     * order in which the SyntaxTrees were added to \c this Compilation.
+     */
+    void bindAll();
+    void bindAll(const Executor& executor);
+    //!@}
+
     /**
      * The SemanticModel for the SyntaxTree \p tree in \c this Compilation.
      */
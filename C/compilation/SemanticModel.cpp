@@ -24,6 +24,7 @@
 #include "Compilation.h"
 
 #include "binder/Binder.h"
+#include "binder/Scope.h"
 #include "syntax/SyntaxNodes.h"
 #include "syntax/SyntaxUtilities.h"
 #include "symbols/Symbol_ALL.h"
@@ -40,20 +41,59 @@ using namespace C;
 
 struct SemanticModel::SemanticModelImpl
 {
-    SemanticModelImpl(const SyntaxTree* tree, Compilation* compilation)
+    SemanticModelImpl(const SyntaxTree* tree,
+                      Compilation* compilation,
+                      SemanticModel* predecessor,
+                      bool deferSymDEFsIndexing)
         : expectValidSyms_(true)
+        , deferSymDEFsIndexing_(deferSymDEFsIndexing)
         , tree_(tree)
         , compilation_(compilation)
+        , predecessor_(predecessor)
     {}
 
     bool expectValidSyms_;
+    bool deferSymDEFsIndexing_;
     const SyntaxTree* tree_;
     Compilation* compilation_;
-    std::unordered_map<const SyntaxNode*, Symbol*> declSyms_;
+    SemanticModel* predecessor_;
+
+    /*
+     * The Symbol declared by a SyntaxNode is indexed by the (dense) id
+     * of the node, so that its lookup is a bounds check plus a load.
+     */
+    std::vector<Symbol*> declSyms_;
+    Symbol* declaredSym(const SyntaxNode* node) const;
+    bool setDeclaredSym(const SyntaxNode* node, Symbol* sym);
+    std::unique_ptr<Scope> outermostScope_;
+    FunctionDefinitionBindings funcDefBindings_;
+    std::unordered_set<const Symbol*> adoptedSyms_;
+    std::vector<Symbol*> deferredSymDEFs_;
 };
 
-SemanticModel::SemanticModel(const SyntaxTree* tree, Compilation* compilation)
-    : P(new SemanticModelImpl(tree, compilation))
+Symbol* SemanticModel::SemanticModelImpl::declaredSym(const SyntaxNode* node) const
+{
+    if (node->syntaxTree() != tree_ || node->id() >= declSyms_.size())
+        return nullptr;
+    return declSyms_[node->id()];
+}
+
+bool SemanticModel::SemanticModelImpl::setDeclaredSym(const SyntaxNode* node, Symbol* sym)
+{
+    if (node->id() >= declSyms_.size())
+        declSyms_.resize(std::max(tree_->nodeCount(), node->id() + 1), nullptr);
+
+    if (declSyms_[node->id()])
+        return false;
+    declSyms_[node->id()] = sym;
+    return true;
+}
+
+SemanticModel::SemanticModel(const SyntaxTree* tree,
+                             Compilation* compilation,
+                             SemanticModel* predecessor,
+                             bool deferSymDEFsIndexing)
+    : P(new SemanticModelImpl(tree, compilation, predecessor, deferSymDEFsIndexing))
 {
     Binder binder(this, tree);
     binder.bind();
@@ -87,13 +127,13 @@ const SymCastT* SemanticModel::castSym(const SymOriT* symOri,
 
 const LibrarySymbol* SemanticModel::declaredSymbol(const TranslationUnitSyntax* node) const
 {
-    auto it = P->declSyms_.find(node);
-    if (it == P->declSyms_.end()) {
+    auto sym = P->declaredSym(node);
+    if (!sym) {
         PSY_ASSERT_NO_STMT(!P->expectValidSyms_);
         return nullptr;
     }
 
-    auto libSym = castSym(it->second, &Symbol::asLibrary);
+    auto libSym = castSym(sym, &Symbol::asLibrary);
     if (!libSym)
         return nullptr;
 
@@ -132,13 +172,13 @@ const ParameterSymbol* SemanticModel::declaredSymbol(const ParameterDeclarationS
 
 const NamedTypeSymbol* SemanticModel::declaredSymbol(const TypeDeclarationSyntax* node) const
 {
-    auto it = P->declSyms_.find(node);
-    if (it == P->declSyms_.end()) {
+    auto sym = P->declaredSym(node);
+    if (!sym) {
         PSY_ASSERT_NO_STMT(!P->expectValidSyms_);
         return nullptr;
     }
 
-    auto tySym = castSym(it->second, &Symbol::asType);
+    auto tySym = castSym(sym, &Symbol::asType);
     if (!tySym)
         return nullptr;
 
@@ -151,13 +191,13 @@ const NamedTypeSymbol* SemanticModel::declaredSymbol(const TypeDeclarationSyntax
 
 const EnumeratorSymbol* SemanticModel::declaredSymbol(const EnumeratorDeclarationSyntax* node) const
 {
-    auto it = P->declSyms_.find(node);
-    if (it == P->declSyms_.end()) {
+    auto sym = P->declaredSym(node);
+    if (!sym) {
         PSY_ASSERT_NO_STMT(!P->expectValidSyms_);
         return nullptr;
     }
 
-    auto valSym = castSym(it->second, &Symbol::asValue);
+    auto valSym = castSym(sym, &Symbol::asValue);
     if (!valSym)
         return nullptr;
 
@@ -207,33 +247,114 @@ std::vector<const Symbol*> SemanticModel::declaredSymbols(
 
 const Symbol* SemanticModel::declaredSymbol(const DeclaratorSyntax* node) const
 {
+    /*
+     * The Symbol is keyed by the identifier declarator, which may be nested
+     * in parenthesized declarators, as in \c int (*x)(int).
+     */
     auto node_P = SyntaxUtilities::strippedDeclaratorOrSelf(node);
     auto node_PP = SyntaxUtilities::innermostDeclaratorOrSelf(node_P);
+    while (node_PP && node_PP->asParenthesizedDeclarator()) {
+        node_P = SyntaxUtilities::strippedDeclaratorOrSelf(node_PP);
+        node_PP = SyntaxUtilities::innermostDeclaratorOrSelf(node_P);
+    }
 
-    auto it = P->declSyms_.find(node_PP);
-    if (it == P->declSyms_.end()) {
+    auto sym = P->declaredSym(node_PP);
+    if (!sym) {
         PSY_ASSERT_NO_STMT(!P->expectValidSyms_);
         return nullptr;
     }
 
-    return it->second;
+    return sym;
+}
+
+MemoryPool* SemanticModel::symbolPool()
+{
+    return P->compilation_->assembly()->symbolPool(P->tree_);
 }
 
 Symbol* SemanticModel::storeDeclaredSym(const SyntaxNode* node, std::unique_ptr<Symbol> sym)
 {
-    auto& allSyms = P->compilation_->assembly()->symDEFs_;
-    auto [it, _] = allSyms.insert(std::move(sym));
-    Symbol* rawSym = it->get();
+    Symbol* rawSym;
+    if (P->deferSymDEFsIndexing_) {
+        rawSym = P->compilation_->assembly()->storeSymUSE(std::move(sym));
+        P->deferredSymDEFs_.push_back(rawSym);
+    }
+    else
+        rawSym = P->compilation_->assembly()->storeSymDEF(std::move(sym));
 
-    PSY_ASSERT(P->declSyms_.count(node) == 0, return rawSym);
-    P->declSyms_[node] = rawSym;
+    if (!P->setDeclaredSym(node, rawSym))
+        PSY_ESCAPE_VIA_RETURN(rawSym);
 
     return rawSym;
 }
 
+void SemanticModel::indexDeferredSymDEFs()
+{
+    for (auto sym : P->deferredSymDEFs_)
+        P->compilation_->assembly()->indexSymDEF(sym);
+    P->deferredSymDEFs_.clear();
+    P->deferSymDEFsIndexing_ = false;
+}
+
 Symbol* SemanticModel::storeUsedSym(std::unique_ptr<Symbol> sym)
 {
-    auto& syms = P->compilation_->assembly()->symUSEs_;
-    syms.emplace_back(sym.release());
-    return syms.back().get();
+    return P->compilation_->assembly()->storeSymUSE(std::move(sym));
+}
+
+SemanticModel* SemanticModel::predecessor() const
+{
+    return P->predecessor_;
+}
+
+Scope* SemanticModel::outermostScope() const
+{
+    return P->outermostScope_.get();
+}
+
+SemanticModel::FunctionDefinitionBinding* SemanticModel::recordFunctionDefinitionBinding(
+        const FunctionDefinitionSyntax* node)
+{
+    PSY_ASSERT(P->funcDefBindings_.count(node) == 0, return &P->funcDefBindings_[node]);
+
+    return &P->funcDefBindings_[node];
+}
+
+SemanticModel::FunctionDefinitionBindings& SemanticModel::functionDefinitionBindings()
+{
+    return P->funcDefBindings_;
+}
+
+void SemanticModel::adoptDeclaredSym(const SyntaxNode* node, Symbol* sym)
+{
+    if (!P->setDeclaredSym(node, sym))
+        PSY_ESCAPE_VIA_RETURN();
+}
+
+void SemanticModel::adoptSym(const Symbol* sym)
+{
+    P->adoptedSyms_.insert(sym);
+}
+
+const std::unordered_set<const Symbol*>& SemanticModel::adoptedSyms() const
+{
+    return P->adoptedSyms_;
+}
+
+Scope* SemanticModel::keepOutermostScope(std::unique_ptr<Scope> scope)
+{
+    PSY_ASSERT(!P->outermostScope_, return P->outermostScope_.get());
+
+    P->outermostScope_ = std::move(scope);
+    return P->outermostScope_.get();
+}
+
+const TypeSymbol* SemanticModel::internTySym(const TypeSymbol* tySym)
+{
+    return P->compilation_->assembly()->internTySym(tySym);
+}
+
+const TypeSymbol* SemanticModel::internTySym(const TypeSymbol* tySym,
+                                             const std::unordered_map<const TypeSymbol*, const TypeSymbol*>& tySymMap)
+{
+    return P->compilation_->assembly()->internTySym(tySym, tySymMap);
 }
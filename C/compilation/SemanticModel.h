@@ -24,9 +24,15 @@
 #include "API.h"
 #include "Fwds.h"
 
+#include "binder/NameSpaceKind.h"
+
 #include "../common/infra/InternalAccess.h"
 #include "../common/infra/Pimpl.h"
 
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace psy {
@@ -86,10 +92,44 @@ PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(Binder);
     PSY_GRANT_ACCESS(Compilation);
 
-    SemanticModel(const SyntaxTree* tree, Compilation* compilation);
+    SemanticModel(const SyntaxTree* tree,
+                  Compilation* compilation,
+                  SemanticModel* predecessor = nullptr,
+                  bool deferSymDEFsIndexing = false);
+
+    void indexDeferredSymDEFs();
 
+    /*
+     * What the Binder produced for a FunctionDefinitionSyntax of the
+     * translation unit, kept so that a successor SemanticModel (of an
+     * edited SyntaxTree) may adopt it, if the definition is unchanged.
+     */
+    struct FunctionDefinitionBinding
+    {
+        std::vector<Symbol*> syms_;
+        std::vector<std::pair<const SyntaxNode*, Symbol*>> declSyms_;
+        std::vector<Scope*> scopes_;
+        std::vector<std::tuple<const Identifier*, NameSpaceKind, const Symbol*>> fileScopeDecls_;
+        bool hasDiagnostics_ = false;
+    };
+    using FunctionDefinitionBindings =
+        std::unordered_map<const FunctionDefinitionSyntax*, FunctionDefinitionBinding>;
+
+    SemanticModel* predecessor() const;
+    Scope* outermostScope() const;
+    FunctionDefinitionBinding* recordFunctionDefinitionBinding(const FunctionDefinitionSyntax* node);
+    FunctionDefinitionBindings& functionDefinitionBindings();
+    void adoptDeclaredSym(const SyntaxNode* node, Symbol* sym);
+    void adoptSym(const Symbol* sym);
+    const std::unordered_set<const Symbol*>& adoptedSyms() const;
+
+    MemoryPool* symbolPool();
     Symbol* storeDeclaredSym(const SyntaxNode* node, std::unique_ptr<Symbol> sym);
     Symbol* storeUsedSym(std::unique_ptr<Symbol> sym);
+    Scope* keepOutermostScope(std::unique_ptr<Scope> scope);
+    const TypeSymbol* internTySym(const TypeSymbol* tySym);
+    const TypeSymbol* internTySym(const TypeSymbol* tySym,
+                                  const std::unordered_map<const TypeSymbol*, const TypeSymbol*>& tySymMap);
 
     template <class SymCastT, class SymOriT> const SymCastT* castSym(
             const SymOriT* sym,
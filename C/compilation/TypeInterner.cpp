@@ -0,0 +1,287 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "TypeInterner.h"
+
+#include "Assembly.h"
+
+#include "symbols/Symbol_ALL.h"
+#include "symbols/SymbolName_ALL.h"
+
+#include "../common/infra/Assertions.h"
+#include "../common/infra/Escape.h"
+
+#include <functional>
+#include <memory>
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+std::uint8_t qualifiersOf(const TypeSymbol* tySym)
+{
+    return (tySym->isConstQualified() ? 1 : 0)
+            | (tySym->isVolatileQualified() ? 2 : 0)
+            | (tySym->isRestrictQualified() ? 4 : 0);
+}
+
+} // anonymous
+
+bool TypeInterner::TypeKey::operator==(const TypeKey& other) const
+{
+    return tyK_ == other.tyK_
+            && quals_ == other.quals_
+            && variety_ == other.variety_
+            && scope_ == other.scope_
+            && name_ == other.name_
+            && tySyms_ == other.tySyms_;
+}
+
+std::size_t TypeInterner::TypeKeyHash::operator()(const TypeKey& key) const
+{
+    std::size_t h = std::hash<int>()(static_cast<int>(key.tyK_));
+    auto combine = [&h] (std::size_t v) {
+        h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+    };
+    combine(key.quals_);
+    combine(std::hash<int>()(key.variety_));
+    combine(std::hash<const void*>()(key.scope_));
+    combine(std::hash<std::string>()(key.name_));
+    for (auto tySym : key.tySyms_)
+        combine(std::hash<const void*>()(tySym));
+    return h;
+}
+
+TypeInterner::TypeInterner(Assembly* assembly)
+    : assembly_(assembly)
+{}
+
+TypeInterner::~TypeInterner()
+{}
+
+const TypeSymbol* TypeInterner::intern(const TypeSymbol* tySym)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return canonicalOf(tySym, nullptr);
+}
+
+const TypeSymbol* TypeInterner::intern(const TypeSymbol* tySym, const TypeSymbolMap& tySymMap)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return canonicalOf(tySym, &tySymMap);
+}
+
+const TypeSymbol* TypeInterner::canonicalOf(const TypeSymbol* tySym, const TypeSymbolMap* tySymMap)
+{
+    if (!tySym)
+        return nullptr;
+
+    if (tySymMap) {
+        auto it = tySymMap->find(tySym);
+        if (it != tySymMap->end())
+            return it->second;
+    }
+
+    // The components of a canonical type are themselves canonical, unless they're replaced.
+    if (canonTySymsSet_.count(tySym)
+            && (!tySymMap || tySym->typeKind() == TypeKind::Named)) {
+        return tySym;
+    }
+
+    TypeKey key { tySym->typeKind(), qualifiersOf(tySym), 0, nullptr, std::string(), {} };
+    switch (tySym->typeKind()) {
+        case TypeKind::Array:
+            key.tySyms_.push_back(canonicalOf(tySym->asArrayType()->elementType(), tySymMap));
+            break;
+
+        case TypeKind::Function: {
+            auto funcTySym = tySym->asFunctionType();
+            key.tySyms_.push_back(canonicalOf(funcTySym->returnType(), tySymMap));
+            for (auto parmTySym : funcTySym->parameterTypes())
+                key.tySyms_.push_back(canonicalOf(parmTySym, tySymMap));
+            break;
+        }
+
+        case TypeKind::Named: {
+            auto namedTySym = tySym->asNamedType();
+            key.variety_ = static_cast<int>(namedTySym->namedTypeKind());
+            if (namedTySym->namedTypeKind() == NamedTypeKind::Builtin) {
+                key.variety_ |= static_cast<int>(namedTySym->builtinTypeKind()) << 8;
+            }
+            else {
+                /*
+                 * 6.2.1-4
+                 * The type designated by a tag or a typedef name depends on
+                 * the scope in which the name is declared (which the Binder
+                 * resolves as the scope of the type).
+                 */
+                key.scope_ = tySym->scope();
+                if (namedTySym->name())
+                    key.name_ = namedTySym->name()->text();
+            }
+            break;
+        }
+
+        case TypeKind::Pointer: {
+            auto ptrTySym = tySym->asPointerType();
+            key.tySyms_.push_back(canonicalOf(ptrTySym->referencedType(), tySymMap));
+            key.variety_ = (ptrTySym->arisesFromArrayDecay() ? 1 : 0)
+                    | (ptrTySym->arisesFromFunctionDecay() ? 2 : 0);
+            break;
+        }
+
+        default:
+            PSY_ESCAPE_VIA_RETURN(tySym);
+    }
+
+    auto it = canonTySyms_.find(key);
+    if (it != canonTySyms_.end())
+        return it->second;
+
+    auto canonTySym = makeCanonical(key, tySym);
+    canonTySyms_.emplace(std::move(key), canonTySym);
+    canonTySymsSet_.insert(canonTySym);
+
+    return canonTySym;
+}
+
+const TypeSymbol* TypeInterner::makeCanonical(const TypeKey& key, const TypeSymbol* tySym)
+{
+    /*
+     * A canonical type designated by a tag or a typedef name belongs to the
+     * SyntaxTree of the name; any other, to the SyntaxTree of any of its
+     * components, if one does.
+     */
+    const SyntaxTree* tree = nullptr;
+    if (key.scope_) {
+        tree = tySym->syntaxTree();
+    }
+    else {
+        for (auto compTySym : key.tySyms_) {
+            if (compTySym && compTySym->syntaxTree()) {
+                tree = compTySym->syntaxTree();
+                break;
+            }
+        }
+    }
+
+    MemoryPool* pool = assembly_->symbolPool(tree);
+    std::unique_ptr<TypeSymbol> canonTySym;
+    switch (key.tyK_) {
+        case TypeKind::Array:
+            canonTySym.reset(new (pool) ArrayTypeSymbol(pool,
+                                                        tree,
+                                                        nullptr,
+                                                        nullptr,
+                                                        key.tySyms_[0]));
+            break;
+
+        case TypeKind::Function: {
+            std::unique_ptr<FunctionTypeSymbol> funcTySym(
+                        new (pool) FunctionTypeSymbol(pool,
+                                                      tree,
+                                                      nullptr,
+                                                      nullptr,
+                                                      key.tySyms_[0]));
+            for (auto parmIt = key.tySyms_.begin() + 1; parmIt != key.tySyms_.end(); ++parmIt)
+                funcTySym->addParameter(*parmIt);
+            canonTySym = std::move(funcTySym);
+            break;
+        }
+
+        case TypeKind::Named: {
+            auto namedTySym = tySym->asNamedType();
+            switch (namedTySym->namedTypeKind()) {
+                case NamedTypeKind::Builtin:
+                    canonTySym.reset(new (pool) NamedTypeSymbol(pool,
+                                                                tree,
+                                                                nullptr,
+                                                                nullptr,
+                                                                namedTySym->builtinTypeKind()));
+                    break;
+
+                case NamedTypeKind::Synonym:
+                    canonTySym.reset(new (pool) NamedTypeSymbol(pool,
+                                                                tree,
+                                                                key.scope_,
+                                                                nullptr,
+                                                                key.name_));
+                    break;
+
+                default: {
+                    auto tagName = namedTySym->name()
+                            ? namedTySym->name()->asTagSymbolName()
+                            : nullptr;
+                    PSY_ASSERT(tagName, return tySym);
+                    canonTySym.reset(new (pool) NamedTypeSymbol(pool,
+                                                                tree,
+                                                                key.scope_,
+                                                                nullptr,
+                                                                tagName->tagChoice(),
+                                                                tagName->tag()));
+                    break;
+                }
+            }
+            break;
+        }
+
+        case TypeKind::Pointer: {
+            std::unique_ptr<PointerTypeSymbol> ptrTySym(
+                        new (pool) PointerTypeSymbol(pool,
+                                                     tree,
+                                                     nullptr,
+                                                     nullptr,
+                                                     key.tySyms_[0]));
+            if (tySym->asPointerType()->arisesFromArrayDecay())
+                ptrTySym->markAsArisingFromArrayDecay();
+            if (tySym->asPointerType()->arisesFromFunctionDecay())
+                ptrTySym->markAsArisingFromFunctionDecay();
+            canonTySym = std::move(ptrTySym);
+            break;
+        }
+
+        default:
+            PSY_ESCAPE_VIA_RETURN(tySym);
+    }
+
+    if (tySym->isConstQualified())
+        canonTySym->qualifyWithConst();
+    if (tySym->isVolatileQualified())
+        canonTySym->qualifyWithVolatile();
+    if (tySym->isRestrictQualified())
+        canonTySym->qualifyWithRestrict();
+
+    return static_cast<TypeSymbol*>(assembly_->storeSymUSE(std::move(canonTySym)));
+}
+
+void TypeInterner::discard(const SyntaxTree* tree)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = canonTySyms_.begin(); it != canonTySyms_.end(); ) {
+        if (it->second->syntaxTree() == tree) {
+            canonTySymsSet_.erase(it->second);
+            it = canonTySyms_.erase(it);
+        }
+        else
+            ++it;
+    }
+}
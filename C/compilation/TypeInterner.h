@@ -0,0 +1,117 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_TYPE_INTERNER_H__
+#define PSYCHE_C_TYPE_INTERNER_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "symbols/TypeKind.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The TypeInterner class.
+ *
+ * Keeps the canonical instances of the TypeSymbols of a Compilation: two
+ * TypeSymbols that designate the same type are interned into the same
+ * (canonical) TypeSymbol, so that type equality is a pointer comparison.
+ * A canonical TypeSymbol is always a distinct instance, so the interned
+ * TypeSymbol may be released afterwards.
+ *
+ * A canonical TypeSymbol that isn't built from a tag or a typedef name is
+ * shared across SyntaxTrees; otherwise, it belongs to the SyntaxTree of
+ * the name (and is discarded with it).
+ *
+ * Interning is thread-safe, so that SyntaxTrees may be bound concurrently.
+ *
+ * \remark 6.2.5
+ * \remark 6.2.7
+ */
+class PSY_C_NON_API TypeInterner
+{
+public:
+    TypeInterner(Assembly* assembly);
+    ~TypeInterner();
+
+    /**
+     * The canonical TypeSymbol of TypeSymbol \p tySym.
+     */
+    const TypeSymbol* intern(const TypeSymbol* tySym);
+
+    using TypeSymbolMap = std::unordered_map<const TypeSymbol*, const TypeSymbol*>;
+
+    /**
+     * The canonical TypeSymbol of TypeSymbol \p tySym in which (the canonical)
+     * TypeSymbols are replaced as in \p tySymMap.
+     */
+    const TypeSymbol* intern(const TypeSymbol* tySym, const TypeSymbolMap& tySymMap);
+
+    /**
+     * Discard the canonical TypeSymbols that belong to SyntaxTree \p tree.
+     */
+    void discard(const SyntaxTree* tree);
+
+private:
+    // Unavailable
+    TypeInterner(const TypeInterner&) = delete;
+    TypeInterner& operator=(const TypeInterner&) = delete;
+
+    Assembly* assembly_;
+    std::mutex mutex_;
+
+    struct TypeKey
+    {
+        TypeKind tyK_;
+        std::uint8_t quals_;
+        int variety_;
+        const Scope* scope_;
+        std::string name_;
+        std::vector<const TypeSymbol*> tySyms_;
+
+        bool operator==(const TypeKey& other) const;
+    };
+
+    struct TypeKeyHash
+    {
+        std::size_t operator()(const TypeKey& key) const;
+    };
+
+    std::unordered_map<TypeKey, const TypeSymbol*, TypeKeyHash> canonTySyms_;
+    std::unordered_set<const TypeSymbol*> canonTySymsSet_;
+
+    const TypeSymbol* canonicalOf(const TypeSymbol* tySym, const TypeSymbolMap* tySymMap);
+    const TypeSymbol* makeCanonical(const TypeKey& key, const TypeSymbol* tySym);
+};
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,87 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "BufferedOutput.h"
+
+#include <cerrno>
+#include <unistd.h>
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+const std::size_t kBufCapacity = 1 << 16;
+
+} // anonymous
+
+BufferedOutput::BufferedOutput(std::ostream& os)
+    : os_(&os)
+    , fd_(-1)
+    , hasError_(false)
+{}
+
+BufferedOutput::BufferedOutput(int fd)
+    : os_(nullptr)
+    , fd_(fd)
+    , hasError_(false)
+{
+    buf_.reserve(kBufCapacity);
+}
+
+BufferedOutput::~BufferedOutput()
+{
+    flush();
+}
+
+void BufferedOutput::flush()
+{
+    if (os_) {
+        os_->flush();
+        hasError_ |= !os_->good();
+        return;
+    }
+
+    const char* data = buf_.data();
+    auto size = buf_.size();
+    while (size && !hasError_) {
+        auto cnt = ::write(fd_, data, size);
+        if (cnt < 0) {
+            if (errno != EINTR)
+                hasError_ = true;
+            continue;
+        }
+        data += cnt;
+        size -= cnt;
+    }
+    buf_.clear();
+}
+
+void BufferedOutput::emit(const char* data, std::size_t size)
+{
+    if (os_) {
+        os_->write(data, size);
+        return;
+    }
+
+    if (buf_.size() + size > kBufCapacity)
+        flush();
+    buf_.insert(buf_.end(), data, data + size);
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_BUFFERED_OUTPUT_H__
+#define PSYCHE_C_BUFFERED_OUTPUT_H__
+
+#include "API.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The BufferedOutput class.
+ *
+ * An output to a \c std::ostream, or to a file descriptor; for the latter,
+ * the output is buffered here (and flushed when the buffer is full, and
+ * on destruction).
+ */
+class PSY_C_NON_API BufferedOutput final
+{
+public:
+    BufferedOutput(std::ostream& os);
+    BufferedOutput(int fd);
+    ~BufferedOutput();
+
+    // Unavailable
+    BufferedOutput(const BufferedOutput&) = delete;
+    void operator=(const BufferedOutput&) = delete;
+
+    void emit(const char* data, std::size_t size);
+    void emit(const std::string& s) { emit(s.data(), s.size()); }
+
+    void flush();
+
+    /**
+     * Whether an error occurred while writing.
+     */
+    bool hasError() const { return hasError_; }
+
+private:
+    std::ostream* os_;
+    int fd_;
+    std::vector<char> buf_;
+    bool hasError_;
+};
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "HardwareThreads.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+std::mutex spareThreadsMutex;
+unsigned maxSpareThreads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+unsigned busySpareThreads = 0;
+
+std::size_t acquireSpareThreads(std::size_t cnt)
+{
+    std::lock_guard<std::mutex> lock(spareThreadsMutex);
+    auto idleCnt = busySpareThreads < maxSpareThreads ? maxSpareThreads - busySpareThreads : 0;
+    cnt = std::min<std::size_t>(cnt, idleCnt);
+    busySpareThreads += cnt;
+    return cnt;
+}
+
+void releaseSpareThreads(std::size_t cnt)
+{
+    std::lock_guard<std::mutex> lock(spareThreadsMutex);
+    busySpareThreads -= cnt;
+}
+
+} // anonymous
+
+namespace psy {
+namespace C {
+
+void limitHardwareThreads(unsigned cnt)
+{
+    std::lock_guard<std::mutex> lock(spareThreadsMutex);
+    maxSpareThreads = std::max(1u, cnt) - 1;
+}
+
+void runOnHardwareThreads(const std::vector<std::function<void ()>>& tasks)
+{
+    std::atomic<std::size_t> nextTask(0);
+    std::exception_ptr firstExcept;
+    std::mutex exceptMutex;
+    auto work = [&] () {
+        for (auto idx = nextTask++; idx < tasks.size(); idx = nextTask++) {
+            try {
+                tasks[idx]();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(exceptMutex);
+                if (!firstExcept)
+                    firstExcept = std::current_exception();
+                nextTask = tasks.size();
+                return;
+            }
+        }
+    };
+
+    auto spareCnt = tasks.size() > 1 ? acquireSpareThreads(tasks.size() - 1) : 0;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < spareCnt; ++i)
+        threads.emplace_back(work);
+    work();
+    for (auto& thread : threads)
+        thread.join();
+    releaseSpareThreads(spareCnt);
+
+    if (firstExcept)
+        std::rethrow_exception(firstExcept);
+}
+
+} // C
+} // psy
@@ -0,0 +1,54 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_HARDWARE_THREADS_H__
+#define PSYCHE_C_HARDWARE_THREADS_H__
+
+#include "API.h"
+
+#include <functional>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * Run the \p tasks on the calling thread and on as many additional threads
+ * as are spare, and return once all of them are finished. If a task throws,
+ * no further tasks are started and, once the running ones finish, the first
+ * exception thrown is rethrown.
+ *
+ * \remark The additional threads are taken from a budget shared by all
+ * (concurrent) calls, of one thread less than the hardware supports, unless
+ * otherwise set by limitHardwareThreads.
+ */
+void PSY_C_NON_API runOnHardwareThreads(const std::vector<std::function<void ()>>& tasks);
+
+/**
+ * Limit to \p cnt (the calling thread included) the threads on which the
+ * tasks of a runOnHardwareThreads call are run; \c 1 runs them serially.
+ * This is meant for a client that already runs on its own threads.
+ */
+void PSY_C_API limitHardwareThreads(unsigned cnt);
+
+} // C
+} // psy
+
+#endif
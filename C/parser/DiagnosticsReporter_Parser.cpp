@@ -106,6 +106,8 @@ void Parser::DiagnosticsReporter::diagnose(DiagnosticDescriptor&& desc)
 
     if (IDsForDelay_.find(desc.id()) != IDsForDelay_.end())
         delayedDiags_.push_back(std::make_pair(desc, parser_->curTkIdx_));
+    else if (heldDiags_)
+        heldDiags_->push_back(std::make_pair(desc, parser_->curTkIdx_));
     else
         parser_->tree_->newDiagnostic(desc, parser_->curTkIdx_);
 }
@@ -0,0 +1,162 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Preprocessor.h"
+
+#include "SyntaxTree.h"
+
+#include "../common/diagnostics/Diagnostic.h"
+
+using namespace psy;
+using namespace C;
+
+const std::string Preprocessor::DiagnosticsReporter::ID_of_ErrorDirective = "Preprocessor-001";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_WarningDirective = "Preprocessor-002";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_InvalidDirective = "Preprocessor-003";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_ExpectedMacroName = "Preprocessor-004";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_UnterminatedConditional = "Preprocessor-005";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_UnmatchedConditional = "Preprocessor-006";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_UnterminatedMacroInvocation = "Preprocessor-007";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_MacroArgumentCountMismatch = "Preprocessor-008";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_InvalidConditionalExpression = "Preprocessor-009";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_InvalidTokenPasting = "Preprocessor-010";
+const std::string Preprocessor::DiagnosticsReporter::ID_of_InvalidMacroParameterList = "Preprocessor-011";
+
+void Preprocessor::DiagnosticsReporter::ErrorDirective(const SyntaxToken& tk, const std::string& msg)
+{
+    DiagnosticDescriptor descriptor(ID_of_ErrorDirective,
+                                    "#error directive",
+                                    "#error " + msg,
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::WarningDirective(const SyntaxToken& tk, const std::string& msg)
+{
+    DiagnosticDescriptor descriptor(ID_of_WarningDirective,
+                                    "#warning directive",
+                                    "#warning " + msg,
+                                    DiagnosticSeverity::Warning,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::InvalidDirective(const SyntaxToken& tk)
+{
+    DiagnosticDescriptor descriptor(ID_of_InvalidDirective,
+                                    "Invalid preprocessing directive",
+                                    "invalid preprocessing directive",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::ExpectedMacroName(const SyntaxToken& tk)
+{
+    DiagnosticDescriptor descriptor(ID_of_ExpectedMacroName,
+                                    "Expected macro name",
+                                    "expected macro name",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::InvalidMacroParameterList(const SyntaxToken& tk)
+{
+    DiagnosticDescriptor descriptor(ID_of_InvalidMacroParameterList,
+                                    "Invalid macro parameter list",
+                                    "invalid macro parameter list",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::UnterminatedConditional(const SyntaxToken& tk)
+{
+    DiagnosticDescriptor descriptor(ID_of_UnterminatedConditional,
+                                    "Unterminated conditional directive",
+                                    "unterminated conditional directive",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::UnmatchedConditional(const SyntaxToken& tk)
+{
+    DiagnosticDescriptor descriptor(ID_of_UnmatchedConditional,
+                                    "Unmatched conditional directive",
+                                    "conditional directive without a matching #if (or after #else)",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::UnterminatedMacroInvocation(const SyntaxToken& tk)
+{
+    DiagnosticDescriptor descriptor(ID_of_UnterminatedMacroInvocation,
+                                    "Unterminated macro invocation",
+                                    "unterminated argument list invoking macro `" + tk.valueText() + "'",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::MacroArgumentCountMismatch(const SyntaxToken& tk,
+                                                                   const std::string& name)
+{
+    DiagnosticDescriptor descriptor(ID_of_MacroArgumentCountMismatch,
+                                    "Macro argument count mismatch",
+                                    "wrong number of arguments invoking macro `" + name + "'",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::InvalidConditionalExpression(const SyntaxToken& tk)
+{
+    DiagnosticDescriptor descriptor(ID_of_InvalidConditionalExpression,
+                                    "Invalid conditional expression",
+                                    "invalid expression in conditional directive",
+                                    DiagnosticSeverity::Error,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
+
+void Preprocessor::DiagnosticsReporter::InvalidTokenPasting(const SyntaxToken& tk, const std::string& spelling)
+{
+    DiagnosticDescriptor descriptor(ID_of_InvalidTokenPasting,
+                                    "Invalid token pasting",
+                                    "pasting doesn't give a valid token: `" + spelling + "'",
+                                    DiagnosticSeverity::Warning,
+                                    DiagnosticCategory::Syntax);
+
+    pp_->tree_->newDiagnostic(descriptor, tk);
+}
@@ -21,6 +21,7 @@
 
 #include "Lexer.h"
 
+#include "Preprocessor.h"
 #include "SyntaxTree.h"
 
 #include "syntax/SyntaxLexeme_ALL.h"
@@ -113,12 +114,52 @@ void Lexer::lex()
     // Line and column...
     tree_->relayLineDirective(0, 1, tree_->filePath());
     tree_->relayLineStart(0);
+
+    if (tree_->textPreprocessingState() == TextPreprocessingState::Unpreprocessed
+            && tree_->parseOptions().treatmentOfPreprocessing()
+                != ParseOptions::TreatmentOfPreprocessing::None) {
+        Preprocessor pp(tree_, this);
+        pp.preprocess();
+    }
+    else
+        lexUntil(nullptr);
+    matchBraces();
+}
+
+/**
+ * Lex again the text of the SyntaxTree from \p offset, the end of a token
+ * already in the tree (or the start of the text), on line \p lineno.
+ *
+ * Lexing stops at the first token for which \p resync holds (the token
+ * isn't added to the tree), in which case \c true is returned, or at
+ * the end of the file.
+ */
+bool Lexer::relex(unsigned int offset,
+                  unsigned int lineno,
+                  const std::function<bool (const SyntaxToken&)>& resync)
+{
+    if (offset) {
+        yytext_ = c_strBeg_ + offset;
+        yy_ = yytext_;
+        yychar_ = *yytext_;
+        yylineno_ = lineno;
+        yycolumn_ = offset + 1;
+        offset_ = offset;
+
+        if (yychar_ == '\n') {
+            ++yylineno_;
+            tree_->relayLineStart(offset_ + 1);
+        }
+    }
+
+    return lexUntil(resync);
+}
+
+bool Lexer::lexUntil(const std::function<bool (const SyntaxToken&)>& resync)
+{
     std::vector<std::pair<unsigned int, unsigned int>> expansions;
     unsigned int curExpansionIdx = 0;
 
-    // Open/close brace tracking.
-    std::stack<unsigned> braces;
-
     SyntaxToken tk(tree_);
 
     do {
@@ -213,15 +254,6 @@ LexEntry:
             }
             goto LexEntry;
         }
-        else if (tk.kind() == OpenBraceToken) {
-            braces.push(tree_->tokenCount());
-        }
-        else if (tk.kind() == CloseBraceToken && !braces.empty()) {
-            auto idx = braces.top();
-            braces.pop();
-            if (idx < tree_->tokenCount())
-                tree_->tokenAt(idx).matchingBracket_ = tree_->tokenCount();
-        }
         else if (tk.isComment()) {
             tree_->comments_.push_back(tk);
             if (tk.kind() != Keyword_ExtPSY_omission)
@@ -242,14 +274,81 @@ LexEntry:
         tk.BF_.expanded_ = isExpanded;
         tk.BF_.generated_ = isGenerated;
 
+        if (resync && resync(tk))
+            return true;
+
         tree_->addToken(tk);
     }
     while (tk.kind());
 
-    for (; !braces.empty(); braces.pop()) {
-        auto idx = braces.top();
-        tree_->tokenAt(idx).matchingBracket_ = tree_->tokenCount();
+    return false;
+}
+
+/**
+ * Lex the \p snippet, a text that isn't part of that of the SyntaxTree (e.g.,
+ * the spelling of a token made by the Preprocessor), into \p tks. The state
+ * of the lexing of the SyntaxTree's text is preserved.
+ */
+void Lexer::lexSnippet(const std::string& snippet, std::vector<SyntaxToken>& tks)
+{
+    const auto c_strBeg = c_strBeg_;
+    const auto c_strEnd = c_strEnd_;
+    const auto yytext = yytext_;
+    const auto yy = yy_;
+    const auto yychar = yychar_;
+    const auto yylineno = yylineno_;
+    const auto yycolumn = yycolumn_;
+    const auto offset = offset_;
+    const auto withinLogicalLine = withinLogicalLine_;
+    const auto rawSyntaxK = rawSyntaxK_splitTk;
+
+    c_strBeg_ = snippet.c_str();
+    c_strEnd_ = c_strBeg_ + snippet.size();
+    yytext_ = c_strBeg_ - 1;
+    yy_ = yytext_;
+    yychar_ = ' ';
+    yycolumn_ = 0;
+    offset_ = ~0;
+    withinLogicalLine_ = false;
+    rawSyntaxK_splitTk = 0;
+
+    SyntaxToken tk(tree_);
+    for (yylex(&tk); tk.kind() != EndOfFile; yylex(&tk))
+        tks.push_back(tk);
+
+    c_strBeg_ = c_strBeg;
+    c_strEnd_ = c_strEnd;
+    yytext_ = yytext;
+    yy_ = yy;
+    yychar_ = yychar;
+    yylineno_ = yylineno;
+    yycolumn_ = yycolumn;
+    offset_ = offset;
+    withinLogicalLine_ = withinLogicalLine;
+    rawSyntaxK_splitTk = rawSyntaxK;
+}
+
+/**
+ * Match the open/close braces of the tokens in the SyntaxTree.
+ */
+void Lexer::matchBraces()
+{
+    std::stack<LexedTokens::IndexType> braces;
+
+    const auto tkCnt = tree_->tokenCount();
+    for (LexedTokens::IndexType idx = 1; idx < tkCnt; ++idx) {
+        auto& tk = tree_->tokenAt(idx);
+        if (tk.kind() == OpenBraceToken) {
+            braces.push(idx);
+        }
+        else if (tk.kind() == CloseBraceToken && !braces.empty()) {
+            tree_->tokenAt(braces.top()).matchingBracket_ = idx;
+            braces.pop();
+        }
     }
+
+    for (; !braces.empty(); braces.pop())
+        tree_->tokenAt(braces.top()).matchingBracket_ = tkCnt;
 }
 
 void Lexer::yylex_core(SyntaxToken* tk)
@@ -32,6 +32,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace psy {
 namespace C {
@@ -50,14 +51,24 @@ public:
 
 PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(SyntaxTree);
+    PSY_GRANT_ACCESS(Preprocessor);
 
     Lexer(SyntaxTree* tree);
 
+    bool relex(unsigned int offset,
+               unsigned int lineno,
+               const std::function<bool (const SyntaxToken&)>& resync);
+    void matchBraces();
+
+    void lexSnippet(const std::string& snippet, std::vector<SyntaxToken>& tks);
+
 private:
     // Unavailable
     Lexer(const Lexer&) = delete;
     void operator=(const Lexer&) = delete;
 
+    bool lexUntil(const std::function<bool (const SyntaxToken&)>& resync);
+
     void yylex(SyntaxToken* tk);
     void yylex_core(SyntaxToken* tk);
     void yyinput();
@@ -38,6 +38,8 @@ ParseOptions::ParseOptions(LanguageDialect dialect,
     setTreatmentOfIdentifiers(TreatmentOfIdentifiers::Classify);
     setTreatmentOfComments(TreatmentOfComments::None);
     setTreatmentOfAmbiguities(TreatmentOfAmbiguities::DisambiguateAlgorithmicallyOrHeuristically);
+    setTreatmentOfFunctionBodies(TreatmentOfFunctionBodies::Sequential);
+    setTreatmentOfPreprocessing(TreatmentOfPreprocessing::None);
 }
 
 const LanguageDialect& ParseOptions::dialect() const
@@ -82,3 +84,108 @@ ParseOptions::TreatmentOfAmbiguities ParseOptions::treatmentOfAmbiguities() cons
 {
     return static_cast<TreatmentOfAmbiguities>(BF_.treatmentOfAmbiguities_);
 }
+
+ParseOptions& ParseOptions::setTreatmentOfFunctionBodies(TreatmentOfFunctionBodies treatOfFuncBodies)
+{
+    BF_.treatmentOfFunctionBodies_ = static_cast<int>(treatOfFuncBodies);
+    return *this;
+}
+
+ParseOptions::TreatmentOfFunctionBodies ParseOptions::treatmentOfFunctionBodies() const
+{
+    return static_cast<TreatmentOfFunctionBodies>(BF_.treatmentOfFunctionBodies_);
+}
+
+ParseOptions& ParseOptions::setTreatmentOfPreprocessing(TreatmentOfPreprocessing treatOfPP)
+{
+    BF_.treatmentOfPreprocessing_ = static_cast<int>(treatOfPP);
+    return *this;
+}
+
+ParseOptions::TreatmentOfPreprocessing ParseOptions::treatmentOfPreprocessing() const
+{
+    return static_cast<TreatmentOfPreprocessing>(BF_.treatmentOfPreprocessing_);
+}
+
+ParseOptions& ParseOptions::setPredefinedMacros(std::vector<std::string> macros)
+{
+    predefinedMacros_ = std::move(macros);
+    return *this;
+}
+
+const std::vector<std::string>& ParseOptions::predefinedMacros() const
+{
+    return predefinedMacros_;
+}
+
+const std::vector<std::string>& ParseOptions::builtinPredefinedMacros()
+{
+    static const std::vector<std::string> macros {
+        "__GNUC__=4",
+        "__GNUC_MINOR__=2",
+        "__GNUC_PATCHLEVEL__=1",
+        "__GNUC_STDC_INLINE__",
+        "__NO_INLINE__",
+        "__ELF__",
+        "__unix__",
+        "__unix",
+        "__linux__",
+        "__linux",
+        "__gnu_linux__",
+        "__x86_64__",
+        "__x86_64",
+        "__amd64__",
+        "__amd64",
+        "__LP64__",
+        "_LP64",
+        "__CHAR_BIT__=8",
+        "__SIZEOF_SHORT__=2",
+        "__SIZEOF_INT__=4",
+        "__SIZEOF_LONG__=8",
+        "__SIZEOF_LONG_LONG__=8",
+        "__SIZEOF_FLOAT__=4",
+        "__SIZEOF_DOUBLE__=8",
+        "__SIZEOF_LONG_DOUBLE__=16",
+        "__SIZEOF_POINTER__=8",
+        "__SIZEOF_SIZE_T__=8",
+        "__SIZEOF_PTRDIFF_T__=8",
+        "__SIZEOF_WCHAR_T__=4",
+        "__SIZEOF_WINT_T__=4",
+        "__SIZE_TYPE__=long unsigned int",
+        "__PTRDIFF_TYPE__=long int",
+        "__WCHAR_TYPE__=int",
+        "__WINT_TYPE__=unsigned int",
+        "__INTMAX_TYPE__=long int",
+        "__UINTMAX_TYPE__=long unsigned int",
+        "__CHAR16_TYPE__=short unsigned int",
+        "__CHAR32_TYPE__=unsigned int",
+        "__INT8_TYPE__=signed char",
+        "__INT16_TYPE__=short int",
+        "__INT32_TYPE__=int",
+        "__INT64_TYPE__=long int",
+        "__UINT8_TYPE__=unsigned char",
+        "__UINT16_TYPE__=short unsigned int",
+        "__UINT32_TYPE__=unsigned int",
+        "__UINT64_TYPE__=long unsigned int",
+        "__INTPTR_TYPE__=long int",
+        "__UINTPTR_TYPE__=long unsigned int",
+        "__SCHAR_MAX__=0x7f",
+        "__SHRT_MAX__=0x7fff",
+        "__INT_MAX__=0x7fffffff",
+        "__LONG_MAX__=0x7fffffffffffffffL",
+        "__LONG_LONG_MAX__=0x7fffffffffffffffLL",
+        "__WCHAR_MAX__=0x7fffffff",
+        "__WCHAR_MIN__=(-__WCHAR_MAX__ - 1)",
+        "__SIZE_MAX__=0xffffffffffffffffUL",
+        "__PTRDIFF_MAX__=0x7fffffffffffffffL",
+        "__INTMAX_MAX__=0x7fffffffffffffffL",
+        "__UINTMAX_MAX__=0xffffffffffffffffUL",
+        "__ORDER_LITTLE_ENDIAN__=1234",
+        "__ORDER_BIG_ENDIAN__=4321",
+        "__ORDER_PDP_ENDIAN__=3412",
+        "__BYTE_ORDER__=__ORDER_LITTLE_ENDIAN__",
+        "__USER_LABEL_PREFIX__=",
+        "__REGISTER_PREFIX__=",
+    };
+    return macros;
+}
@@ -30,6 +30,8 @@
 #include "../common/infra/InternalAccess.h"
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace psy {
 namespace C {
@@ -113,15 +115,78 @@ public:
     TreatmentOfAmbiguities treatmentOfAmbiguities() const;
     //!@}
 
+    //!@{
+    /**
+     * \brief The alternatives for TreatmentOfFunctionBodies during parse.
+     */
+    enum class TreatmentOfFunctionBodies : std::uint8_t
+    {
+        Sequential, /**< Parse function bodies along with the remaining declarations. */
+        Parallel    /**< Skip function bodies (by their braces) and parse them in parallel. */
+    };
+    /**
+     * The TreatmentOfFunctionBodies of \c this ParserOptions.
+     *
+     * \note
+     * When function bodies are parsed in parallel, the diagnostics of the
+     * bodies are reported after those of the remaining declarations.
+     */
+    ParseOptions& setTreatmentOfFunctionBodies(TreatmentOfFunctionBodies treatOfFuncBodies);
+    TreatmentOfFunctionBodies treatmentOfFunctionBodies() const;
+    //!@}
+
+    //!@{
+    /**
+     * \brief The alternatives for TreatmentOfPreprocessing during parse.
+     */
+    enum class TreatmentOfPreprocessing : std::uint8_t
+    {
+        None,                          /**< No special treatment (the text is lexed as is). */
+        Preprocess,                    /**< Preprocess, with the builtinPredefinedMacros() and the predefinedMacros(). */
+        PreprocessWithoutBuiltinMacros /**< Preprocess, with the predefinedMacros() only. */
+    };
+    /**
+     * The TreatmentOfPreprocessing of \c this ParserOptions.
+     *
+     * \note
+     * Only a text whose TextPreprocessingState is
+     * TextPreprocessingState::Unpreprocessed is preprocessed, and its
+     * \c #include directives are ignored: headers aren't read.
+     */
+    ParseOptions& setTreatmentOfPreprocessing(TreatmentOfPreprocessing treatOfPP);
+    TreatmentOfPreprocessing treatmentOfPreprocessing() const;
+    //!@}
+
+    //!@{
+    /**
+     * The macros predefined for the preprocessing of a text (in addition to
+     * \c __STDC__, \c __STDC_HOSTED__, and \c __STDC_VERSION__), each one as
+     * in a \c -D option of a compiler: \c name (defined as \c 1) or
+     * \c name=definition. These are defined after the built-in ones.
+     */
+    ParseOptions& setPredefinedMacros(std::vector<std::string> macros);
+    const std::vector<std::string>& predefinedMacros() const;
+    //!@}
+
+    /**
+     * The built-in predefined macros: a subset of those of GCC targeting
+     * x86-64 Linux (e.g., \c __GNUC__, \c __x86_64__, \c __SIZE_TYPE__),
+     * in the format of predefinedMacros().
+     */
+    static const std::vector<std::string>& builtinPredefinedMacros();
+
 private:
     LanguageDialect dialect_;
     LanguageExtensions extensions_;
+    std::vector<std::string> predefinedMacros_;
 
     struct BitFields
     {
         std::uint16_t treatmentOfIdentifiers_ : 2;
         std::uint16_t treatmentOfComments_ : 2;
         std::uint16_t treatmentOfAmbiguities_ : 2;
+        std::uint16_t treatmentOfFunctionBodies_ : 1;
+        std::uint16_t treatmentOfPreprocessing_ : 2;
     };
     union
     {
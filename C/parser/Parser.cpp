@@ -24,8 +24,6 @@
 using namespace psy;
 using namespace C;
 
-int depth_ = 0;
-
 /* Backtracker */
 
 Parser::Backtracker::Backtracker(Parser* parser, LexedTokens::IndexType tkIdx)
@@ -104,16 +102,20 @@ Parser::DepthControl::~DepthControl()
 /* Parser */
 
 Parser::Parser(SyntaxTree* tree)
-    : pool_(tree->unitPool())
+    : Parser(tree, tree->unitPool())
+{}
+
+Parser::Parser(SyntaxTree* tree, MemoryPool* pool)
+    : pool_(pool)
     , tree_(tree)
     , backtracker_(nullptr)
     , diagReporter_(this)
     , curTkIdx_(1)
     , DEPTH_OF_EXPRS_(0)
     , DEPTH_OF_STMTS_(0)
-{
-    depth_ = 0;
-}
+    , defersFuncBodies_(tree->parseOptions().treatmentOfFunctionBodies()
+                            == ParseOptions::TreatmentOfFunctionBodies::Parallel)
+{}
 
 Parser::~Parser()
 {}
@@ -191,9 +193,284 @@ TranslationUnitSyntax* Parser::parse()
 {
     auto unit = makeNode<TranslationUnitSyntax>();
     parseTranslationUnit(unit);
+    parseDeferredFunctionBodies();
+    return unit;
+}
+
+/**
+ * Parse the tokens of the SyntaxTree, relexed from the given \p tree (see
+ * \p relexedTks), by adopting the nodes of \p tree that enclose no damaged
+ * token: only the smallest compound statement, of a function definition,
+ * that encloses the damaged tokens, or else the external declarations that
+ * contain them, are parsed.
+ *
+ * \return The translation unit, or \c nullptr if the damage isn't confined
+ * to the compound statement that enclosed it.
+ */
+TranslationUnitSyntax* Parser::parseAdoptingFrom(const SyntaxTree* tree,
+                                                 const SyntaxTree::RelexedTokens& relexedTks)
+{
+    const auto restartTkIdx = relexedTks.restartTkIdx;
+    const auto oldResyncTkIdx = relexedTks.oldResyncTkIdx;
+    const auto newResyncTkIdx = relexedTks.newResyncTkIdx;
+    auto adoptedTkIdx = [=] (LexedTokens::IndexType tkIdx) {
+        return tkIdx < restartTkIdx ? tkIdx : tkIdx - oldResyncTkIdx + newResyncTkIdx;
+    };
+    SyntaxAdopter adopter(tree_, pool_, adoptedTkIdx);
+
+    struct DeclarationExtent
+    {
+        const DeclarationSyntax* decl_;
+        LexedTokens::IndexType firstTkIdx_;
+        LexedTokens::IndexType lastTkIdx_;
+    };
+    // A declaration extends up to the next one: without diagnostics in
+    // \p tree, the declarations are contiguous.
+    std::vector<DeclarationExtent> declExts;
+    const auto oldUnit = tree->translationUnitRoot();
+    for (auto it = oldUnit->decls_; it; it = it->next) {
+        auto firstTkIdx = indexOfToken(tree, it->value->firstToken());
+        if (!declExts.empty())
+            declExts.back().lastTkIdx_ = firstTkIdx - 1;
+        declExts.push_back({ it->value, firstTkIdx, 0 });
+    }
+    if (!declExts.empty())
+        declExts.back().lastTkIdx_ = tree->tokenCount() - 2;
+
+    for (const auto& declExt : declExts) {
+        if (declExt.firstTkIdx_ >= restartTkIdx || declExt.lastTkIdx_ < oldResyncTkIdx)
+            continue;
+
+        auto funcDef = declExt.decl_->asFunctionDefinition();
+        if (!funcDef)
+            break;
+
+        std::pair<const CompoundStatementSyntax*, StatementContext> enclosing(nullptr, StatementContext::None);
+        searchForEnclosingCompoundStatement(funcDef->body_,
+                                            StatementContext::None,
+                                            restartTkIdx,
+                                            oldResyncTkIdx,
+                                            enclosing);
+        if (!enclosing.first)
+            break;
+
+        const auto openBraceTkIdx = enclosing.first->openBraceTkIdx_;
+        const auto closeBraceTkIdx = adoptedTkIdx(enclosing.first->closeBraceTkIdx_);
+        if (tree_->tokenAt(openBraceTkIdx).matchingBracket_ != closeBraceTkIdx)
+            break;
+
+        StatementSyntax* stmt = nullptr;
+        curTkIdx_ = openBraceTkIdx;
+        parseCompoundStatement_AtFirst(stmt, enclosing.second);
+        if (curTkIdx_ != closeBraceTkIdx + 1)
+            return nullptr;
+
+        adopter.substitute(enclosing.first, stmt);
+        curTkIdx_ = tree_->tokenCount() - 1;
+        return adopter.adopt(oldUnit);
+    }
+
+    // The external declarations that precede the damaged tokens are adopted.
+    auto unit = makeNode<TranslationUnitSyntax>();
+    DeclarationListSyntax** declList_cur = &unit->decls_;
+    std::size_t declIdx = 0;
+    for (; declIdx < declExts.size() && declExts[declIdx].lastTkIdx_ < restartTkIdx; ++declIdx) {
+        *declList_cur = makeNode<DeclarationListSyntax>(adopter.adopt(declExts[declIdx].decl_));
+        declList_cur = &(*declList_cur)->next;
+    }
+    curTkIdx_ = declIdx ? declExts[declIdx - 1].lastTkIdx_ + 1 : 1;
+
+    // The parse stops at an external declaration, after the damaged tokens,
+    // from which the remaining ones are adopted.
+    auto resumeDeclIdx = declIdx;
+    parseExternalDeclarations(declList_cur, [&] () {
+        if (curTkIdx_ < newResyncTkIdx)
+            return false;
+        while (resumeDeclIdx < declExts.size()
+                   && (declExts[resumeDeclIdx].firstTkIdx_ < oldResyncTkIdx
+                        || adoptedTkIdx(declExts[resumeDeclIdx].firstTkIdx_) < curTkIdx_)) {
+            ++resumeDeclIdx;
+        }
+        return resumeDeclIdx < declExts.size()
+                && adoptedTkIdx(declExts[resumeDeclIdx].firstTkIdx_) == curTkIdx_;
+    });
+    if (resumeDeclIdx < declExts.size()) {
+        for (; resumeDeclIdx < declExts.size(); ++resumeDeclIdx) {
+            *declList_cur = makeNode<DeclarationListSyntax>(adopter.adopt(declExts[resumeDeclIdx].decl_));
+            declList_cur = &(*declList_cur)->next;
+        }
+        curTkIdx_ = tree_->tokenCount() - 1;
+    }
+
+    parseDeferredFunctionBodies();
+
     return unit;
 }
 
+/**
+ * The index of the token \p tk in the given \p tree.
+ */
+LexedTokens::IndexType Parser::indexOfToken(const SyntaxTree* tree, const SyntaxToken& tk)
+{
+    LexedTokens::IndexType lo = 1;
+    LexedTokens::IndexType hi = tree->tokenCount() - 1;
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (tree->tokenAt(mid).charStart() < tk.charStart())
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Search, within the statement \p stmt (in the context \p stmtCtx), for the
+ * innermost compound statement whose braces enclose the tokens from
+ * \p firstTkIdx to (but excluding) \p endTkIdx; update \p enclosing with it
+ * and its statement context.
+ */
+void Parser::searchForEnclosingCompoundStatement(
+        const StatementSyntax* stmt,
+        StatementContext stmtCtx,
+        LexedTokens::IndexType firstTkIdx,
+        LexedTokens::IndexType endTkIdx,
+        std::pair<const CompoundStatementSyntax*, StatementContext>& enclosing)
+{
+    if (!stmt)
+        return;
+
+    if (auto compoundStmt = stmt->asCompoundStatement()) {
+        if (compoundStmt->openBraceTkIdx_ >= firstTkIdx
+                || compoundStmt->closeBraceTkIdx_ < endTkIdx) {
+            return;
+        }
+        enclosing = std::make_pair(compoundStmt, stmtCtx);
+        for (auto it = compoundStmt->stmts_; it; it = it->next)
+            searchForEnclosingCompoundStatement(it->value, stmtCtx, firstTkIdx, endTkIdx, enclosing);
+    }
+    else if (auto labeledStmt = stmt->asLabeledStatement()) {
+        searchForEnclosingCompoundStatement(labeledStmt->stmt_, stmtCtx, firstTkIdx, endTkIdx, enclosing);
+    }
+    else if (auto ifStmt = stmt->asIfStatement()) {
+        searchForEnclosingCompoundStatement(ifStmt->stmt_, stmtCtx, firstTkIdx, endTkIdx, enclosing);
+        searchForEnclosingCompoundStatement(ifStmt->elseStmt_, stmtCtx, firstTkIdx, endTkIdx, enclosing);
+    }
+    else if (auto switchStmt = stmt->asSwitchStatement()) {
+        searchForEnclosingCompoundStatement(switchStmt->stmt_,
+                                            stmtCtx + StatementContext::Switch,
+                                            firstTkIdx,
+                                            endTkIdx,
+                                            enclosing);
+    }
+    else if (auto whileStmt = stmt->asWhileStatement()) {
+        searchForEnclosingCompoundStatement(whileStmt->stmt_,
+                                            stmtCtx + StatementContext::Loop,
+                                            firstTkIdx,
+                                            endTkIdx,
+                                            enclosing);
+    }
+    else if (auto doStmt = stmt->asDoStatement()) {
+        searchForEnclosingCompoundStatement(doStmt->stmt_,
+                                            stmtCtx + StatementContext::Loop,
+                                            firstTkIdx,
+                                            endTkIdx,
+                                            enclosing);
+    }
+    else if (auto forStmt = stmt->asForStatement()) {
+        searchForEnclosingCompoundStatement(forStmt->stmt_,
+                                            stmtCtx + StatementContext::Loop,
+                                            firstTkIdx,
+                                            endTkIdx,
+                                            enclosing);
+    }
+}
+
+/**
+ * Whether to defer the parse of a function body, which is then parsed, in
+ * parallel, after the remaining declarations.
+ */
+bool Parser::defersFunctionBody() const
+{
+    if (!defersFuncBodies_
+            || mightBacktrack()
+            || !diagReporter_.IDsForDelay_.empty()) {
+        return false;
+    }
+
+    return peek().matchingBracket_ < tree_->tokenCount();
+}
+
+/**
+ * Parse the deferred function bodies, each with a Parser of its own (on a
+ * hardware thread), whose nodes are allocated in a separate pool.
+ *
+ * The diagnostics of a function body are held until all bodies are parsed,
+ * and then reported in the order of the function bodies.
+ */
+void Parser::parseDeferredFunctionBodies()
+{
+    if (deferredFuncBodies_.empty())
+        return;
+
+    /*
+     * A Parser is taken from the idle ones, or made, per function body; so
+     * there are no more of them than threads in which bodies are parsed.
+     */
+    std::vector<std::unique_ptr<Parser>> parsers;
+    std::vector<Parser*> idleParsers;
+    std::mutex parsersMutex;
+    auto acquireParser = [this, &parsers, &idleParsers, &parsersMutex] () {
+        std::lock_guard<std::mutex> lock(parsersMutex);
+        if (!idleParsers.empty()) {
+            auto parser = idleParsers.back();
+            idleParsers.pop_back();
+            return parser;
+        }
+        parsers.emplace_back(new Parser(tree_, tree_->makeAuxUnitPool()));
+        parsers.back()->defersFuncBodies_ = false;
+        return parsers.back().get();
+    };
+    auto releaseParser = [&idleParsers, &parsersMutex] (Parser* parser) {
+        std::lock_guard<std::mutex> lock(parsersMutex);
+        idleParsers.push_back(parser);
+    };
+
+    struct BodyParse
+    {
+        std::vector<std::pair<DiagnosticDescriptor, LexedTokens::IndexType>> diags_;
+        std::vector<std::pair<DiagnosticDescriptor, LexedTokens::IndexType>> ambiguityDiags_;
+    };
+    std::vector<BodyParse> bodyParses(deferredFuncBodies_.size());
+
+    std::vector<std::function<void ()>> tasks;
+    tasks.reserve(bodyParses.size());
+    for (std::size_t idx = 0; idx < bodyParses.size(); ++idx) {
+        tasks.emplace_back([this, idx, &bodyParses, &acquireParser, &releaseParser] () {
+            auto& bodyParse = bodyParses[idx];
+            auto parser = acquireParser();
+            parser->curTkIdx_ = deferredFuncBodies_[idx].second;
+            parser->diagReporter_.heldDiags_ = &bodyParse.diags_;
+            parser->parseCompoundStatement_AtFirst(deferredFuncBodies_[idx].first->body_,
+                                                   StatementContext::None);
+            std::swap(bodyParse.ambiguityDiags_, parser->diagReporter_.retainedAmbiguityDiags_);
+            releaseParser(parser);
+        });
+    }
+    runOnHardwareThreads(tasks);
+
+    deferredFuncBodies_.clear();
+
+    for (auto& bodyParse : bodyParses) {
+        for (const auto& diag : bodyParse.diags_)
+            tree_->newDiagnostic(diag.first, diag.second);
+        diagReporter_.retainedAmbiguityDiags_.insert(
+                    diagReporter_.retainedAmbiguityDiags_.end(),
+                    bodyParse.ambiguityDiags_.begin(),
+                    bodyParse.ambiguityDiags_.end());
+    }
+}
+
 bool Parser::detectedAnyAmbiguity() const
 {
     return !diagReporter_.retainedAmbiguityDiags_.empty();
@@ -62,6 +62,8 @@ PSY_INTERNAL_AND_RESTRICTED:
     Parser(SyntaxTree* tree);
 
     TranslationUnitSyntax* parse();
+    TranslationUnitSyntax* parseAdoptingFrom(const SyntaxTree* tree,
+                                             const SyntaxTree::RelexedTokens& relexedTks);
 
     bool detectedAnyAmbiguity() const;
 
@@ -70,6 +72,8 @@ private:
     Parser(const Parser&) = delete;
     void operator=(const Parser&) = delete;
 
+    Parser(SyntaxTree* tree, MemoryPool* pool);
+
     MemoryPool* pool_;
     SyntaxTree* tree_;
 
@@ -107,6 +111,7 @@ private:
         std::unordered_set<std::string> IDsForDelay_;
         std::vector<std::pair<DiagnosticDescriptor, LexedTokens::IndexType>> delayedDiags_;
         std::vector<std::pair<DiagnosticDescriptor, LexedTokens::IndexType>> retainedAmbiguityDiags_;
+        std::vector<std::pair<DiagnosticDescriptor, LexedTokens::IndexType>>* heldDiags_ = nullptr;
 
         void diagnose(DiagnosticDescriptor&& desc);
         void diagnoseDelayed();
@@ -280,6 +285,19 @@ private:
     // Declarations //
     //--------------//
     void parseTranslationUnit(TranslationUnitSyntax*& unit);
+    void parseExternalDeclarations(DeclarationListSyntax**& declList_cur,
+                                   const std::function<bool ()>& stops);
+    static LexedTokens::IndexType indexOfToken(const SyntaxTree* tree, const SyntaxToken& tk);
+    static void searchForEnclosingCompoundStatement(
+            const StatementSyntax* stmt,
+            StatementContext stmtCtx,
+            LexedTokens::IndexType firstTkIdx,
+            LexedTokens::IndexType endTkIdx,
+            std::pair<const CompoundStatementSyntax*, StatementContext>& enclosing);
+    bool defersFunctionBody() const;
+    void parseDeferredFunctionBodies();
+    bool defersFuncBodies_;
+    std::vector<std::pair<FunctionDefinitionSyntax*, LexedTokens::IndexType>> deferredFuncBodies_;
     bool parseExternalDeclaration(DeclarationSyntax*& decl);
     void parseIncompleteDeclaration_AtFirst(DeclarationSyntax*& decl,
                                             const SpecifierListSyntax* specList = nullptr);
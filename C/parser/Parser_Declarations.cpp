@@ -35,8 +35,19 @@ void Parser::parseTranslationUnit(TranslationUnitSyntax*& unit)
     DEBUG_THIS_RULE();
 
     DeclarationListSyntax** declList_cur = &unit->decls_;
+    parseExternalDeclarations(declList_cur, [] () { return false; });
+}
 
-    while (true) {
+/**
+ * Parse \a external-declarations, appending them to the list at
+ * \p declList_cur, until the end of the file or until \p stops.
+ */
+void Parser::parseExternalDeclarations(DeclarationListSyntax**& declList_cur,
+                                       const std::function<bool ()>& stops)
+{
+    DEBUG_THIS_RULE();
+
+    while (!stops()) {
         DeclarationSyntax* decl = nullptr;
         switch (peek().kind()) {
             case EndOfFile:
@@ -61,8 +72,6 @@ void Parser::parseTranslationUnit(TranslationUnitSyntax*& unit)
         *declList_cur = makeNode<DeclarationListSyntax>(decl);
         declList_cur = &(*declList_cur)->next;
     }
-
-    diagReporter_.diagnoseDelayed();
 }
 
 /**
@@ -388,6 +397,11 @@ bool Parser::parseFunctionDefinition_AtOpenBrace(
         funcDef->specs_ = const_cast<SpecifierListSyntax*>(specList);
         funcDef->decltor_ = decltor;
         funcDef->extKR_params_ = paramKRList;
+        if (defersFunctionBody()) {
+            deferredFuncBodies_.push_back(std::make_pair(funcDef, curTkIdx_));
+            curTkIdx_ = peek().matchingBracket_ + 1;
+            return true;
+        }
         parseCompoundStatement_AtFirst(funcDef->body_, StatementContext::None);
         return true;
     }
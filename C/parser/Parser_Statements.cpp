@@ -451,7 +451,7 @@ bool Parser::parseLabeledStatement_AtFirst(StatementSyntax*& stmt,
             break;
 
         case Keyword_case:
-            labelStmt = makeNode<LabeledStatementSyntax>(DefaultLabelStatement);
+            labelStmt = makeNode<LabeledStatementSyntax>(CaseLabelStatement);
             stmt = labelStmt;
             labelStmt->labelTkIdx_ = consume();
             if (!(parseExpressionWithPrecedenceConditional(labelStmt->expr_)
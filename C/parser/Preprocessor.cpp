@@ -0,0 +1,1231 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Preprocessor.h"
+
+#include "Lexer.h"
+#include "SyntaxTree.h"
+
+#include "syntax/SyntaxLexeme_ALL.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+/*
+ * A value of the controlling expression of a conditional directive, which
+ * is of type intmax_t or uintmax_t (6.10.1-4).
+ */
+struct Value
+{
+    std::uintmax_t v;
+    bool isUnsigned;
+};
+
+/*
+ * An evaluator, by precedence climbing, of the controlling expression of a
+ * conditional directive (after macro replacement and after the evaluation of
+ * the \c defined operator).
+ */
+class ExpressionEvaluator
+{
+public:
+    ExpressionEvaluator(const std::vector<SyntaxToken>& tks)
+        : tks_(tks)
+        , pos_(0)
+        , isValid_(true)
+        , unevaluatedCnt_(0)
+    {}
+
+    bool evaluate(Value& val)
+    {
+        val = conditional();
+        return isValid_ && pos_ == tks_.size();
+    }
+
+private:
+    SyntaxKind peek() const
+    {
+        return pos_ < tks_.size() ? tks_[pos_].kind() : EndOfFile;
+    }
+
+    static Value boolean(bool b)
+    {
+        return Value{ b ? 1u : 0u, false };
+    }
+
+    static int precedence(SyntaxKind k)
+    {
+        switch (k) {
+            case BarBarToken:
+                return 1;
+            case AmpersandAmpersandToken:
+                return 2;
+            case BarToken:
+                return 3;
+            case CaretToken:
+                return 4;
+            case AmpersandToken:
+                return 5;
+            case EqualsEqualsToken:
+            case ExclamationEqualsToken:
+                return 6;
+            case LessThanToken:
+            case LessThanEqualsToken:
+            case GreaterThanToken:
+            case GreaterThanEqualsToken:
+                return 7;
+            case LessThanLessThanToken:
+            case GreaterThanGreaterThanToken:
+                return 8;
+            case PlusToken:
+            case MinusToken:
+                return 9;
+            case AsteriskToken:
+            case SlashToken:
+            case PercentToken:
+                return 10;
+            default:
+                return 0;
+        }
+    }
+
+    Value conditional()
+    {
+        auto cond = binary(1);
+        if (peek() != QuestionToken)
+            return cond;
+        ++pos_;
+
+        unevaluatedCnt_ += !cond.v;
+        auto lhs = conditional();
+        unevaluatedCnt_ -= !cond.v;
+        if (peek() != ColonToken) {
+            isValid_ = false;
+            return cond;
+        }
+        ++pos_;
+
+        unevaluatedCnt_ += !!cond.v;
+        auto rhs = conditional();
+        unevaluatedCnt_ -= !!cond.v;
+
+        return Value{ cond.v ? lhs.v : rhs.v, lhs.isUnsigned || rhs.isUnsigned };
+    }
+
+    Value binary(int minPrec)
+    {
+        auto lhs = unary();
+        while (true) {
+            auto op = peek();
+            auto prec = precedence(op);
+            if (!prec || prec < minPrec)
+                return lhs;
+            ++pos_;
+
+            // The right operand of a short-circuit operator may be unevaluated.
+            bool isShortCircuited = (op == AmpersandAmpersandToken && !lhs.v)
+                    || (op == BarBarToken && lhs.v);
+            unevaluatedCnt_ += isShortCircuited;
+            auto rhs = binary(prec + 1);
+            unevaluatedCnt_ -= isShortCircuited;
+
+            lhs = apply(op, lhs, rhs);
+        }
+    }
+
+    Value apply(SyntaxKind op, Value lhs, Value rhs)
+    {
+        auto isUnsigned = lhs.isUnsigned || rhs.isUnsigned;
+        auto a = lhs.v;
+        auto b = rhs.v;
+        auto sa = static_cast<std::intmax_t>(a);
+        auto sb = static_cast<std::intmax_t>(b);
+
+        switch (op) {
+            case BarBarToken:
+                return boolean(a || b);
+            case AmpersandAmpersandToken:
+                return boolean(a && b);
+            case BarToken:
+                return Value{ a | b, isUnsigned };
+            case CaretToken:
+                return Value{ a ^ b, isUnsigned };
+            case AmpersandToken:
+                return Value{ a & b, isUnsigned };
+            case EqualsEqualsToken:
+                return boolean(a == b);
+            case ExclamationEqualsToken:
+                return boolean(a != b);
+            case LessThanToken:
+                return boolean(isUnsigned ? a < b : sa < sb);
+            case LessThanEqualsToken:
+                return boolean(isUnsigned ? a <= b : sa <= sb);
+            case GreaterThanToken:
+                return boolean(isUnsigned ? a > b : sa > sb);
+            case GreaterThanEqualsToken:
+                return boolean(isUnsigned ? a >= b : sa >= sb);
+            case LessThanLessThanToken:
+                return Value{ b >= 64 ? 0 : a << b, lhs.isUnsigned };
+            case GreaterThanGreaterThanToken:
+                if (lhs.isUnsigned)
+                    return Value{ b >= 64 ? 0 : a >> b, true };
+                return Value{ static_cast<std::uintmax_t>(b >= 64 ? (sa < 0 ? -1 : 0) : sa >> b), false };
+            case PlusToken:
+                return Value{ a + b, isUnsigned };
+            case MinusToken:
+                return Value{ a - b, isUnsigned };
+            case AsteriskToken:
+                return Value{ a * b, isUnsigned };
+            case SlashToken:
+            case PercentToken:
+                if (!b) {
+                    if (!unevaluatedCnt_)
+                        isValid_ = false;
+                    return Value{ 0, isUnsigned };
+                }
+                if (isUnsigned)
+                    return Value{ op == SlashToken ? a / b : a % b, true };
+                if (sa == INTMAX_MIN && sb == -1)
+                    return Value{ op == SlashToken ? a : 0, false };
+                return Value{ static_cast<std::uintmax_t>(op == SlashToken ? sa / sb : sa % sb), false };
+            default:
+                isValid_ = false;
+                return lhs;
+        }
+    }
+
+    Value unary()
+    {
+        switch (peek()) {
+            case PlusToken:
+                ++pos_;
+                return unary();
+
+            case MinusToken: {
+                ++pos_;
+                auto val = unary();
+                val.v = 0 - val.v;
+                return val;
+            }
+
+            case TildeToken: {
+                ++pos_;
+                auto val = unary();
+                val.v = ~val.v;
+                return val;
+            }
+
+            case ExclamationToken:
+                ++pos_;
+                return boolean(!unary().v);
+
+            case OpenParenToken: {
+                ++pos_;
+                auto val = conditional();
+                if (peek() != CloseParenToken)
+                    isValid_ = false;
+                else
+                    ++pos_;
+                return val;
+            }
+
+            case IntegerConstantToken:
+                return integer(tks_[pos_++]);
+
+            case CharacterConstantToken:
+            case CharacterConstant_L_Token:
+            case CharacterConstant_u_Token:
+            case CharacterConstant_U_Token:
+                return character(tks_[pos_++]);
+
+            case Keyword_Ext_true:
+                ++pos_;
+                return boolean(true);
+
+            default:
+                // An identifier (or keyword) remaining after macro replacement is 0.
+                if (pos_ < tks_.size()
+                        && (tks_[pos_].kind() == IdentifierToken
+                                || tks_[pos_].category() == SyntaxToken::Category::Keywords)) {
+                    ++pos_;
+                    return boolean(false);
+                }
+                isValid_ = false;
+                return boolean(false);
+        }
+    }
+
+    static Value integer(const SyntaxToken& tk)
+    {
+        const char* s = tk.valueText_c_str();
+        unsigned int base = 10;
+        if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+            base = 16;
+            s += 2;
+        }
+        else if (s[0] == '0' && (s[1] == 'b' || s[1] == 'B')) {
+            base = 2;
+            s += 2;
+        }
+        else if (s[0] == '0') {
+            base = 8;
+        }
+
+        std::uintmax_t v = 0;
+        for (; *s; ++s) {
+            unsigned int d;
+            if (std::isdigit(static_cast<unsigned char>(*s)))
+                d = *s - '0';
+            else if (base == 16 && std::isxdigit(static_cast<unsigned char>(*s)))
+                d = std::tolower(static_cast<unsigned char>(*s)) - 'a' + 10;
+            else if (*s == '\'')
+                continue;
+            else
+                break;
+            v = v * base + d;
+        }
+
+        auto isUnsigned = v > static_cast<std::uintmax_t>(INTMAX_MAX);
+        for (; *s; ++s) {
+            if (*s == 'u' || *s == 'U')
+                isUnsigned = true;
+        }
+
+        return Value{ v, isUnsigned };
+    }
+
+    static Value character(const SyntaxToken& tk)
+    {
+        const char* s = std::strchr(tk.valueText_c_str(), '\'');
+        if (!s)
+            return boolean(false);
+        ++s;
+
+        std::uintmax_t v = static_cast<unsigned char>(*s);
+        if (*s == '\\') {
+            ++s;
+            switch (*s) {
+                case 'n': v = '\n'; break;
+                case 't': v = '\t'; break;
+                case 'r': v = '\r'; break;
+                case 'a': v = '\a'; break;
+                case 'b': v = '\b'; break;
+                case 'f': v = '\f'; break;
+                case 'v': v = '\v'; break;
+                case 'x':
+                    v = std::strtoull(s + 1, nullptr, 16);
+                    break;
+                default:
+                    if (*s >= '0' && *s <= '7') {
+                        v = 0;
+                        for (auto i = 0; i < 3 && *s >= '0' && *s <= '7'; ++i, ++s)
+                            v = v * 8 + (*s - '0');
+                    }
+                    else {
+                        v = static_cast<unsigned char>(*s);
+                    }
+            }
+        }
+
+        // A plain character constant has the value of a (signed) char.
+        if (tk.kind() == CharacterConstantToken && v >= 0x80 && v <= 0xFF)
+            v = static_cast<std::uintmax_t>(static_cast<std::intmax_t>(static_cast<signed char>(v)));
+
+        return Value{ v, false };
+    }
+
+    const std::vector<SyntaxToken>& tks_;
+    std::size_t pos_;
+    bool isValid_;
+    int unevaluatedCnt_;
+};
+
+const char* const kLINE = "__LINE__";
+const char* const kFILE = "__FILE__";
+
+} // anonymous
+
+Preprocessor::Preprocessor(SyntaxTree* tree, Lexer* lexer)
+    : tree_(tree)
+    , lexer_(lexer)
+    , text_(lexer->text_)
+    , fileName_(tree->filePath())
+    , lineDelta_(0)
+    , pendingTk_(tree)
+    , hasPendingTk_(false)
+    , reachedEOF_(false)
+    , expansionTk_(tree)
+    , isFirstOfExpansion_(false)
+    , diagReporter_(this)
+{}
+
+Preprocessor::~Preprocessor()
+{}
+
+void Preprocessor::preprocess()
+{
+    define("__STDC__", "1");
+    define("__STDC_HOSTED__", "1");
+    switch (tree_->parseOptions().dialect().std()) {
+        case LanguageDialect::Std::C99:
+            define("__STDC_VERSION__", "199901L");
+            break;
+        case LanguageDialect::Std::C11:
+            define("__STDC_VERSION__", "201112L");
+            break;
+        case LanguageDialect::Std::C17_18:
+            define("__STDC_VERSION__", "201710L");
+            break;
+        default:
+            break;
+    }
+
+    const auto& parseOpts = tree_->parseOptions();
+    if (parseOpts.treatmentOfPreprocessing() == ParseOptions::TreatmentOfPreprocessing::Preprocess) {
+        for (const auto& macro : ParseOptions::builtinPredefinedMacros())
+            predefine(macro);
+    }
+    for (const auto& macro : parseOpts.predefinedMacros())
+        predefine(macro);
+
+    Stream s;
+    scan(s, nullptr);
+}
+
+//----------//
+// The text //
+//----------//
+
+/**
+ * Lex a token of the text, keeping the comments aside (as the Lexer does).
+ */
+SyntaxToken Preprocessor::lexRaw()
+{
+    if (hasPendingTk_) {
+        hasPendingTk_ = false;
+        return pendingTk_;
+    }
+
+    SyntaxToken tk(tree_);
+    while (true) {
+        lexer_->yylex(&tk);
+        if (!tk.isComment())
+            return tk;
+
+        tree_->comments_.push_back(tk);
+        if (tk.kind() == Keyword_ExtPSY_omission)
+            return tk;
+    }
+}
+
+/**
+ * Read a token of the text, executing the directives along the way and
+ * skipping the groups that are excluded by conditional directives.
+ */
+bool Preprocessor::readText(PPToken& t)
+{
+    if (!pendingTextTks_.empty()) {
+        t = pendingTextTks_.back();
+        pendingTextTks_.pop_back();
+        return true;
+    }
+
+    while (true) {
+        auto tk = lexRaw();
+        if (tk.kind() == EndOfFile) {
+            if (!reachedEOF_) {
+                reachedEOF_ = true;
+                for (const auto& cond : conds_)
+                    diagReporter_.UnterminatedConditional(cond.hashTk);
+                conds_.clear();
+            }
+            t = PPToken(tk, true, false);
+            return true;
+        }
+
+        if (tk.isAtStartOfLine() && tk.kind() == HashToken) {
+            handleDirective(tk);
+            continue;
+        }
+
+        if (isSkipping())
+            continue;
+
+        t = PPToken(tk, true, false);
+        return true;
+    }
+}
+
+/**
+ * Read the tokens of a directive, after the \c #, up to the end of the line.
+ */
+Preprocessor::PPTokens Preprocessor::readDirectiveLine()
+{
+    PPTokens line;
+    while (true) {
+        auto tk = lexRaw();
+        if (tk.isAtStartOfLine() || tk.kind() == EndOfFile) {
+            pendingTk_ = tk;
+            hasPendingTk_ = true;
+            return line;
+        }
+        line.push_back(PPToken(tk, false, false));
+    }
+}
+
+bool Preprocessor::isSkipping() const
+{
+    return !conds_.empty() && !conds_.back().isActive;
+}
+
+//------------//
+// Directives //
+//------------//
+
+void Preprocessor::handleDirective(const SyntaxToken& hashTk)
+{
+    auto line = readDirectiveLine();
+
+    // The null directive (6.10.7).
+    if (line.empty())
+        return;
+
+    // A line marker, as in the output of GCC's preprocessor.
+    if (line[0].tk.kind() == IntegerConstantToken) {
+        if (!isSkipping())
+            handleLine(hashTk, line, 0);
+        return;
+    }
+
+    auto name = spell(line[0]);
+    if (name == "if"
+            || name == "ifdef"
+            || name == "ifndef"
+            || name == "elif"
+            || name == "elifdef"
+            || name == "elifndef"
+            || name == "else"
+            || name == "endif") {
+        handleConditional(name, hashTk, line);
+        return;
+    }
+
+    if (isSkipping())
+        return;
+
+    if (name == "define")
+        handleDefine(line, 1);
+    else if (name == "undef")
+        handleUndef(line);
+    else if (name == "line")
+        handleLine(hashTk, line, 1);
+    else if (name == "error" || name == "warning")
+        handleDiagnostic(name, line);
+    else if (name != "include"
+                && name != "include_next"
+                && name != "import"
+                && name != "pragma"
+                && name != "ident"
+                && name != "sccs")
+        diagReporter_.InvalidDirective(line[0].tk);
+}
+
+/**
+ * Handle a conditional directive.
+ *
+ * \remark 6.10.1
+ */
+void Preprocessor::handleConditional(const std::string& name, const SyntaxToken& hashTk, const PPTokens& line)
+{
+    auto isNameDefined = [this, &line] () {
+        if (line.size() < 2 || !isIdentifierLike(line[1].tk)) {
+            diagReporter_.ExpectedMacroName(line.back().tk);
+            return false;
+        }
+        return isDefined(spell(line[1]));
+    };
+
+    if (name == "if" || name == "ifdef" || name == "ifndef") {
+        auto isParentActive = !isSkipping();
+        auto isActive = false;
+        if (isParentActive) {
+            if (name == "if")
+                isActive = evaluate(hashTk, line);
+            else
+                isActive = isNameDefined() == (name == "ifdef");
+        }
+        conds_.push_back(Conditional{ hashTk, isParentActive, isActive, isActive, false });
+        return;
+    }
+
+    if (conds_.empty() || (conds_.back().seenElse && name != "endif")) {
+        diagReporter_.UnmatchedConditional(line[0].tk);
+        return;
+    }
+
+    auto& cond = conds_.back();
+    if (name == "endif") {
+        conds_.pop_back();
+        return;
+    }
+
+    if (name == "else") {
+        cond.isActive = cond.isParentActive && !cond.wasTaken;
+        cond.wasTaken = true;
+        cond.seenElse = true;
+        return;
+    }
+
+    if (!cond.isParentActive || cond.wasTaken) {
+        cond.isActive = false;
+        return;
+    }
+    if (name == "elif")
+        cond.isActive = evaluate(hashTk, line);
+    else
+        cond.isActive = isNameDefined() == (name == "elifdef");
+    cond.wasTaken = cond.isActive;
+}
+
+/**
+ * Handle a \c #define directive, whose macro name is at \p pos of the \p line.
+ *
+ * \remark 6.10.3
+ */
+void Preprocessor::handleDefine(const PPTokens& line, std::size_t pos)
+{
+    if (pos >= line.size() || !isIdentifierLike(line[pos].tk)) {
+        if (!line.empty())
+            diagReporter_.ExpectedMacroName(line[std::min(pos, line.size() - 1)].tk);
+        return;
+    }
+
+    auto macro = std::make_shared<Macro>();
+    auto name = spell(line[pos++]);
+
+    // A function-like macro has a `(' immediately after its name.
+    if (pos < line.size()
+            && line[pos].tk.kind() == OpenParenToken
+            && !line[pos].tk.hasLeadingTrivia()) {
+        macro->isFunctionLike = true;
+        const auto& parenTk = line[pos++].tk;
+        if (pos < line.size() && line[pos].tk.kind() == CloseParenToken) {
+            ++pos;
+        }
+        else {
+            while (true) {
+                if (pos < line.size() && line[pos].tk.kind() == EllipsisToken) {
+                    macro->isVariadic = true;
+                    macro->params.push_back("__VA_ARGS__");
+                    if (++pos >= line.size() || line[pos].tk.kind() != CloseParenToken) {
+                        diagReporter_.InvalidMacroParameterList(parenTk);
+                        return;
+                    }
+                    ++pos;
+                    break;
+                }
+
+                if (pos >= line.size() || !isIdentifierLike(line[pos].tk)) {
+                    diagReporter_.InvalidMacroParameterList(parenTk);
+                    return;
+                }
+                macro->params.push_back(spell(line[pos++]));
+
+                if (pos < line.size() && line[pos].tk.kind() == CommaToken) {
+                    ++pos;
+                    continue;
+                }
+                if (pos < line.size() && line[pos].tk.kind() == CloseParenToken) {
+                    ++pos;
+                    break;
+                }
+                diagReporter_.InvalidMacroParameterList(parenTk);
+                return;
+            }
+        }
+    }
+
+    macro->replacement.assign(line.begin() + pos, line.end());
+    for (const auto& t : macro->replacement) {
+        auto paramIdx = -1;
+        if (macro->isFunctionLike && isIdentifierLike(t.tk)) {
+            auto it = std::find(macro->params.begin(), macro->params.end(), spell(t));
+            if (it != macro->params.end())
+                paramIdx = static_cast<int>(it - macro->params.begin());
+        }
+        macro->paramIdxs.push_back(paramIdx);
+    }
+
+    macros_[name] = std::move(macro);
+}
+
+void Preprocessor::handleUndef(const PPTokens& line)
+{
+    if (line.size() < 2 || !isIdentifierLike(line[1].tk)) {
+        diagReporter_.ExpectedMacroName(line.back().tk);
+        return;
+    }
+    macros_.erase(spell(line[1]));
+}
+
+/**
+ * Handle a \c #line directive (or a line marker), whose line number is at
+ * \p pos of the \p line.
+ *
+ * \remark 6.10.4
+ */
+void Preprocessor::handleLine(const SyntaxToken& hashTk, const PPTokens& line, std::size_t pos)
+{
+    PPTokens tks(line.begin() + pos, line.end());
+    Stream s;
+    s.tks = &tks;
+    PPTokens expandedTks;
+    scan(s, &expandedTks);
+
+    if (expandedTks.empty() || expandedTks[0].tk.kind() != IntegerConstantToken) {
+        diagReporter_.InvalidDirective(line[0].tk);
+        return;
+    }
+
+    auto lineno = std::strtoul(expandedTks[0].tk.valueText_c_str(), nullptr, 10);
+    if (expandedTks.size() > 1 && expandedTks[1].tk.kind() == StringLiteralToken) {
+        auto fileName = spell(expandedTks[1]);
+        fileName_ = fileName.substr(1, fileName.size() - 2);
+    }
+
+    lineDelta_ = static_cast<int>(lineno) - static_cast<int>(hashTk.lineno_ + 1);
+    tree_->relayLineDirective(hashTk.charStart(), lineno, fileName_);
+}
+
+/**
+ * Handle an \c #error or a \c #warning directive.
+ *
+ * \remark 6.10.5
+ */
+void Preprocessor::handleDiagnostic(const std::string& name, const PPTokens& line)
+{
+    std::string msg;
+    for (auto i = 1U; i < line.size(); ++i) {
+        if (i > 1 && line[i].tk.hasLeadingTrivia())
+            msg += ' ';
+        msg += spell(line[i]);
+    }
+
+    if (name == "error")
+        diagReporter_.ErrorDirective(line[0].tk, msg);
+    else
+        diagReporter_.WarningDirective(line[0].tk, msg);
+}
+
+/**
+ * Define a macro as in a \c -D option of a compiler.
+ */
+void Preprocessor::define(const std::string& name, const std::string& definition)
+{
+    handleDefine(makeTokens(name + " " + definition), 0);
+}
+
+/**
+ * Define the \p macro given as in ParseOptions::predefinedMacros.
+ */
+void Preprocessor::predefine(const std::string& macro)
+{
+    auto eqPos = macro.find('=');
+    if (eqPos == std::string::npos)
+        define(macro, "1");
+    else
+        define(macro.substr(0, eqPos), macro.substr(eqPos + 1));
+}
+
+bool Preprocessor::isDefined(const std::string& name) const
+{
+    return macros_.count(name) || name == kLINE || name == kFILE;
+}
+
+/**
+ * Evaluate the controlling expression of an \c #if or an \c #elif directive.
+ *
+ * \remark 6.10.1
+ */
+bool Preprocessor::evaluate(const SyntaxToken& hashTk, const PPTokens& line)
+{
+    // The `defined' operator is evaluated before macro replacement.
+    PPTokens tks;
+    for (std::size_t i = 1; i < line.size(); ++i) {
+        if (line[i].tk.kind() != IdentifierToken || spell(line[i]) != "defined") {
+            tks.push_back(line[i]);
+            continue;
+        }
+
+        auto j = i + 1;
+        auto hasParen = j < line.size() && line[j].tk.kind() == OpenParenToken;
+        if (hasParen)
+            ++j;
+        if (j >= line.size() || !isIdentifierLike(line[j].tk)) {
+            diagReporter_.InvalidConditionalExpression(line[i].tk);
+            return false;
+        }
+        auto isNameDefined = isDefined(spell(line[j]));
+        if (hasParen && (++j >= line.size() || line[j].tk.kind() != CloseParenToken)) {
+            diagReporter_.InvalidConditionalExpression(line[i].tk);
+            return false;
+        }
+        auto madeTks = makeTokens(isNameDefined ? "1" : "0");
+        tks.push_back(madeTks[0]);
+        i = j;
+    }
+
+    Stream s;
+    s.tks = &tks;
+    PPTokens expandedTks;
+    scan(s, &expandedTks);
+
+    std::vector<SyntaxToken> exprTks;
+    exprTks.reserve(expandedTks.size());
+    for (const auto& t : expandedTks)
+        exprTks.push_back(t.tk);
+
+    Value val;
+    ExpressionEvaluator evaluator(exprTks);
+    if (!evaluator.evaluate(val)) {
+        diagReporter_.InvalidConditionalExpression(line.size() > 1 ? line[1].tk : hashTk);
+        return false;
+    }
+    return val.v != 0;
+}
+
+//-------------------//
+// Macro replacement //
+//-------------------//
+
+/**
+ * Take the next token of the Stream \p s: from the innermost macro under
+ * expansion, if any, whose expansion ends when its tokens are exhausted.
+ */
+bool Preprocessor::next(Stream& s, PPToken& t, bool& isFromContext)
+{
+    while (!s.contexts.empty()) {
+        auto& ctx = s.contexts.back();
+        if (ctx.pos < ctx.tks.size()) {
+            t = ctx.tks[ctx.pos++];
+            isFromContext = true;
+            return true;
+        }
+        if (ctx.macro)
+            --ctx.macro->disabledCnt;
+        s.contexts.pop_back();
+    }
+
+    isFromContext = false;
+    if (s.tks) {
+        if (s.pos == s.tks->size())
+            return false;
+        t = (*s.tks)[s.pos++];
+        return true;
+    }
+    return readText(t);
+}
+
+/**
+ * Whether the next token of the Stream \p s is a \c (, without taking it.
+ */
+bool Preprocessor::peekOpenParen(Stream& s)
+{
+    for (auto it = s.contexts.rbegin(); it != s.contexts.rend(); ++it) {
+        if (it->pos < it->tks.size())
+            return it->tks[it->pos].tk.kind() == OpenParenToken;
+    }
+
+    if (s.tks)
+        return s.pos < s.tks->size() && (*s.tks)[s.pos].tk.kind() == OpenParenToken;
+
+    PPToken t(SyntaxToken::invalid(), false, false);
+    readText(t);
+    pendingTextTks_.push_back(t);
+    return t.tk.kind() == OpenParenToken;
+}
+
+/**
+ * Scan the Stream \p s, expanding macros, into \p out or, if it's null, into
+ * the SyntaxTree.
+ *
+ * \remark 6.10.3.4
+ */
+void Preprocessor::scan(Stream& s, PPTokens* out)
+{
+    PPToken t(SyntaxToken::invalid(), false, false);
+    bool isFromContext;
+    while (next(s, t, isFromContext)) {
+        if (expand(s, t, isFromContext))
+            continue;
+
+        if (out) {
+            out->push_back(t);
+            continue;
+        }
+
+        emit(t, isFromContext);
+        if (t.tk.kind() == EndOfFile)
+            return;
+    }
+}
+
+/**
+ * Expand the macro named by the token \p t, if any, by pushing the result of
+ * its replacement onto the Stream \p s.
+ */
+bool Preprocessor::expand(Stream& s, PPToken& t, bool isFromContext)
+{
+    if (t.isPainted || !isIdentifierLike(t.tk))
+        return false;
+
+    auto name = spell(t);
+    std::shared_ptr<Macro> macro;
+    PPTokens tks;
+    if (name == kLINE || name == kFILE) {
+        if (!s.tks && !isFromContext)
+            startExpansion(t.tk);
+
+        if (name == kLINE) {
+            const auto& tk = t.isFromText ? t.tk : expansionTk_;
+            tks = makeTokens(std::to_string(static_cast<int>(tk.lineno_) + lineDelta_));
+        }
+        else {
+            tks = makeTokens("\"" + fileName_ + "\"");
+        }
+    }
+    else {
+        auto it = macros_.find(name);
+        if (it == macros_.end())
+            return false;
+
+        macro = it->second;
+        if (macro->disabledCnt) {
+            t.isPainted = true;
+            return false;
+        }
+
+        if (macro->isFunctionLike && !peekOpenParen(s))
+            return false;
+
+        if (!s.tks && !isFromContext)
+            startExpansion(t.tk);
+
+        std::vector<PPTokens> args;
+        if (macro->isFunctionLike && !collectArgs(s, *macro, t.tk, args))
+            return true;
+
+        tks = substitute(*macro, args);
+        ++macro->disabledCnt;
+    }
+
+    s.contexts.push_back(Context{ std::move(macro), std::move(tks), 0 });
+    return true;
+}
+
+/**
+ * Collect the arguments of an invocation of the function-like \p macro.
+ */
+bool Preprocessor::collectArgs(Stream& s,
+                               const Macro& macro,
+                               const SyntaxToken& nameTk,
+                               std::vector<PPTokens>& args)
+{
+    PPToken t(SyntaxToken::invalid(), false, false);
+    bool isFromContext;
+    next(s, t, isFromContext); // The `('.
+
+    args.emplace_back();
+    auto depth = 0;
+    while (true) {
+        if (!next(s, t, isFromContext)) {
+            diagReporter_.UnterminatedMacroInvocation(nameTk);
+            return false;
+        }
+
+        auto tkK = t.tk.kind();
+        if (tkK == EndOfFile) {
+            pendingTextTks_.push_back(t);
+            diagReporter_.UnterminatedMacroInvocation(nameTk);
+            return false;
+        }
+
+        if (tkK == OpenParenToken) {
+            ++depth;
+        }
+        else if (tkK == CloseParenToken) {
+            if (!depth)
+                break;
+            --depth;
+        }
+        else if (tkK == CommaToken
+                    && !depth
+                    && !(macro.isVariadic && args.size() == macro.params.size())) {
+            args.emplace_back();
+            continue;
+        }
+        args.back().push_back(t);
+    }
+
+    if (macro.params.empty() && args.size() == 1 && args[0].empty())
+        args.clear();
+    else if (macro.isVariadic && args.size() + 1 == macro.params.size())
+        args.emplace_back();
+
+    if (args.size() != macro.params.size()) {
+        diagReporter_.MacroArgumentCountMismatch(nameTk, nameTk.valueText());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Substitute the \p args for the parameters in the replacement list of the
+ * \p macro, applying the \c # and \c ## operators.
+ *
+ * \remark 6.10.3.1, 6.10.3.2, and 6.10.3.3
+ */
+Preprocessor::PPTokens Preprocessor::substitute(const Macro& macro, const std::vector<PPTokens>& args)
+{
+    const auto& repl = macro.replacement;
+    auto isHashHashAt = [&repl] (std::size_t i) {
+        return i < repl.size() && repl[i].tk.kind() == HashHashToken;
+    };
+
+    // An argument is fully expanded (only) if needed, and at most once.
+    std::vector<std::unique_ptr<PPTokens>> expandedArgs(args.size());
+
+    PPTokens tks;
+    for (std::size_t i = 0; i < repl.size(); ++i) {
+        const auto& t = repl[i];
+        if (macro.isFunctionLike
+                && t.tk.kind() == HashToken
+                && i + 1 < repl.size()
+                && macro.paramIdxs[i + 1] >= 0) {
+            tks.push_back(stringize(args[macro.paramIdxs[i + 1]]));
+            ++i;
+            continue;
+        }
+
+        if (t.tk.kind() == HashHashToken && i > 0 && i + 1 < repl.size()) {
+            auto rhsIdx = macro.paramIdxs[++i];
+            if (rhsIdx < 0) {
+                paste(tks, PPTokens{ repl[i] }, t);
+                continue;
+            }
+
+            // GNU's `, ## __VA_ARGS__' removes the comma if the variable argument is empty.
+            const auto& arg = args[rhsIdx];
+            if (macro.isVariadic
+                    && rhsIdx + 1 == static_cast<int>(macro.params.size())
+                    && !tks.empty()
+                    && tks.back().tk.kind() == CommaToken) {
+                if (arg.empty())
+                    tks.pop_back();
+                else
+                    tks.insert(tks.end(), arg.begin(), arg.end());
+                continue;
+            }
+            paste(tks, arg, t);
+            continue;
+        }
+
+        auto paramIdx = macro.paramIdxs[i];
+        if (paramIdx < 0) {
+            tks.push_back(t);
+            continue;
+        }
+
+        const auto& arg = args[paramIdx];
+        if (isHashHashAt(i + 1)) {
+            if (arg.empty()) {
+                PPToken placemarker(t.tk, false, true);
+                placemarker.isPlacemarker = true;
+                tks.push_back(placemarker);
+            }
+            else {
+                tks.insert(tks.end(), arg.begin(), arg.end());
+            }
+            continue;
+        }
+
+        if (!expandedArgs[paramIdx])
+            expandedArgs[paramIdx].reset(new PPTokens(expandArg(arg)));
+        tks.insert(tks.end(), expandedArgs[paramIdx]->begin(), expandedArgs[paramIdx]->end());
+    }
+
+    tks.erase(std::remove_if(tks.begin(),
+                             tks.end(),
+                             [] (const PPToken& t) { return t.isPlacemarker; }),
+              tks.end());
+    return tks;
+}
+
+/**
+ * Make a string literal of the spelling of the \p arg.
+ *
+ * \remark 6.10.3.2
+ */
+Preprocessor::PPToken Preprocessor::stringize(const PPTokens& arg)
+{
+    std::string s = "\"";
+    for (std::size_t i = 0; i < arg.size(); ++i) {
+        const auto& tk = arg[i].tk;
+        if (i && (tk.hasLeadingTrivia() || tk.isAtStartOfLine()))
+            s += ' ';
+
+        auto spelling = spell(arg[i]);
+        if (tk.category() == SyntaxToken::Category::StringLiterals
+                || (tk.kind() >= CharacterConstantToken && tk.kind() <= CharacterConstant_U_Token)) {
+            for (auto c : spelling) {
+                if (c == '"' || c == '\\')
+                    s += '\\';
+                s += c;
+            }
+        }
+        else {
+            s += spelling;
+        }
+    }
+    s += '"';
+
+    return makeTokens(s).front();
+}
+
+/**
+ * Paste the last token of \p tks with the first of \p rhs, and append the
+ * remaining tokens of \p rhs.
+ *
+ * \remark 6.10.3.3
+ */
+void Preprocessor::paste(PPTokens& tks, const PPTokens& rhs, const PPToken& hashHashTk)
+{
+    if (rhs.empty())
+        return;
+
+    if (tks.empty() || tks.back().isPlacemarker) {
+        if (!tks.empty())
+            tks.pop_back();
+        tks.insert(tks.end(), rhs.begin(), rhs.end());
+        return;
+    }
+
+    auto spelling = spell(tks.back()) + spell(rhs.front());
+    auto madeTks = makeTokens(spelling);
+    if (madeTks.size() == 1) {
+        madeTks[0].tk.BF_.hasLeadingWS_ = tks.back().tk.BF_.hasLeadingWS_;
+        tks.back() = madeTks[0];
+    }
+    else {
+        diagReporter_.InvalidTokenPasting(hashHashTk.tk, spelling);
+        tks.push_back(rhs.front());
+    }
+    tks.insert(tks.end(), rhs.begin() + 1, rhs.end());
+}
+
+/**
+ * Fully expand the argument \p arg (in isolation).
+ *
+ * \remark 6.10.3.1
+ */
+Preprocessor::PPTokens Preprocessor::expandArg(const PPTokens& arg)
+{
+    Stream s;
+    s.tks = &arg;
+    PPTokens tks;
+    scan(s, &tks);
+    return tks;
+}
+
+Preprocessor::PPTokens Preprocessor::makeTokens(const std::string& spelling)
+{
+    std::vector<SyntaxToken> tks;
+    lexer_->lexSnippet(spelling, tks);
+
+    PPTokens madeTks;
+    madeTks.reserve(tks.size());
+    for (const auto& tk : tks)
+        madeTks.push_back(PPToken(tk, false, true));
+    return madeTks;
+}
+
+/**
+ * Start an expansion of a macro invoked, in the text, by the token \p nameTk.
+ */
+void Preprocessor::startExpansion(const SyntaxToken& nameTk)
+{
+    expansionTk_ = nameTk;
+    isFirstOfExpansion_ = true;
+
+    auto pos = tree_->computePosition(nameTk.charStart());
+    tree_->relayExpansion(nameTk.charStart(), std::make_pair(pos.line(), pos.character() - 1));
+}
+
+/**
+ * Add the token \p t to the SyntaxTree; a generated token is placed at the
+ * invocation of the macro being expanded.
+ */
+void Preprocessor::emit(PPToken& t, bool isExpanded)
+{
+    auto& tk = t.tk;
+    if (isExpanded) {
+        tk.BF_.expanded_ = true;
+        if (!t.isFromText) {
+            tk.BF_.generated_ = true;
+            tk.BF_.atStartOfLine_ = isFirstOfExpansion_ && expansionTk_.BF_.atStartOfLine_;
+            if (isFirstOfExpansion_)
+                tk.BF_.hasLeadingWS_ = expansionTk_.BF_.hasLeadingWS_;
+            tk.byteOffset_ = expansionTk_.byteOffset_;
+            tk.byteSize_ = expansionTk_.byteSize_;
+            tk.charOffset_ = expansionTk_.charOffset_;
+            tk.charSize_ = expansionTk_.charSize_;
+            tk.lineno_ = expansionTk_.lineno_;
+            tk.column_ = expansionTk_.column_;
+        }
+        isFirstOfExpansion_ = false;
+    }
+
+    tree_->addToken(tk);
+}
+
+/**
+ * The spelling of the token \p t.
+ */
+std::string Preprocessor::spell(const PPToken& t) const
+{
+    // A keyword may be spelled alternatively (e.g., `__inline__' for `inline').
+    if (!t.isMade && t.tk.category() == SyntaxToken::Category::Keywords)
+        return text_.substr(t.tk.byteStart(), t.tk.byteSize_);
+    return t.tk.valueText();
+}
+
+bool Preprocessor::isIdentifierLike(const SyntaxToken& tk)
+{
+    return tk.kind() == IdentifierToken
+            || tk.category() == SyntaxToken::Category::Keywords;
+}
@@ -0,0 +1,224 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_PREPROCESSOR_H__
+#define PSYCHE_C_PREPROCESSOR_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "syntax/SyntaxToken.h"
+
+#include "../common/infra/InternalAccess.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+class Lexer;
+
+/**
+ * \brief The C Preprocessor class.
+ *
+ * The Preprocessor runs within the Lexer, for a SyntaxTree whose text is
+ * TextPreprocessingState::Unpreprocessed and whose ParseOptions request it
+ * (see ParseOptions::TreatmentOfPreprocessing): it executes the directives and
+ * expands the macros of the text as it's lexed, adding the resulting tokens
+ * to the SyntaxTree directly.
+ *
+ * A token that results from an expansion is SyntaxToken::isPPExpanded; if,
+ * in addition, it doesn't appear in the text (e.g., it comes from the
+ * replacement list of a macro, as opposed to from an argument), it's also
+ * SyntaxToken::isPPGenerated and it's placed at the macro invocation.
+ *
+ * \note
+ * An \c #include directive is ignored: headers aren't read.
+ *
+ * \remark 6.10
+ */
+class PSY_C_NON_API Preprocessor
+{
+    friend class PreprocessorTester;
+
+PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(Lexer);
+
+    Preprocessor(SyntaxTree* tree, Lexer* lexer);
+    ~Preprocessor();
+
+    void preprocess();
+
+private:
+    // Unavailable
+    Preprocessor(const Preprocessor&) = delete;
+    void operator=(const Preprocessor&) = delete;
+
+    struct PPToken
+    {
+        PPToken(const SyntaxToken& tk, bool isFromText, bool isMade)
+            : tk(tk)
+            , isFromText(isFromText)
+            , isMade(isMade)
+            , isPainted(false)
+            , isPlacemarker(false)
+        {}
+
+        SyntaxToken tk;
+        bool isFromText;    // Lexed from the text (outside of a directive).
+        bool isMade;        // Made by the preprocessor (e.g., by a token pasting).
+        bool isPainted;     // Not eligible for expansion (6.10.3.4-2).
+        bool isPlacemarker; // Standing for an empty argument (6.10.3.3-2).
+    };
+    using PPTokens = std::vector<PPToken>;
+
+    struct Macro
+    {
+        bool isFunctionLike = false;
+        bool isVariadic = false;
+        std::vector<std::string> params;
+        PPTokens replacement;
+        std::vector<int> paramIdxs; // Of the replacement tokens (-1 if not a parameter).
+        unsigned int disabledCnt = 0;
+    };
+
+    struct Context
+    {
+        std::shared_ptr<Macro> macro;
+        PPTokens tks;
+        std::size_t pos;
+    };
+
+    /*
+     * The tokens under expansion: the contexts of the macros being expanded
+     * sit on top of either the text or a token list (e.g., an argument).
+     */
+    struct Stream
+    {
+        std::vector<Context> contexts;
+        const PPTokens* tks = nullptr;
+        std::size_t pos = 0;
+    };
+
+    struct Conditional
+    {
+        SyntaxToken hashTk;
+        bool isParentActive;
+        bool isActive;
+        bool wasTaken;
+        bool seenElse;
+    };
+
+    /* Text */
+    SyntaxToken lexRaw();
+    bool readText(PPToken& t);
+    PPTokens readDirectiveLine();
+    bool isSkipping() const;
+
+    /* 6.10 Directives */
+    void handleDirective(const SyntaxToken& hashTk);
+    void handleConditional(const std::string& name, const SyntaxToken& hashTk, const PPTokens& line);
+    void handleDefine(const PPTokens& line, std::size_t pos);
+    void handleUndef(const PPTokens& line);
+    void handleLine(const SyntaxToken& hashTk, const PPTokens& line, std::size_t pos);
+    void handleDiagnostic(const std::string& name, const PPTokens& line);
+    void define(const std::string& name, const std::string& definition);
+    void predefine(const std::string& macro);
+    bool isDefined(const std::string& name) const;
+
+    /* 6.10.1 Conditional inclusion */
+    bool evaluate(const SyntaxToken& hashTk, const PPTokens& line);
+
+    /* 6.10.3 Macro replacement */
+    bool next(Stream& s, PPToken& t, bool& isFromContext);
+    bool peekOpenParen(Stream& s);
+    void scan(Stream& s, PPTokens* out);
+    bool expand(Stream& s, PPToken& t, bool isFromContext);
+    bool collectArgs(Stream& s, const Macro& macro, const SyntaxToken& nameTk, std::vector<PPTokens>& args);
+    PPTokens substitute(const Macro& macro, const std::vector<PPTokens>& args);
+    PPToken stringize(const PPTokens& arg);
+    void paste(PPTokens& tks, const PPTokens& rhs, const PPToken& hashHashTk);
+    PPTokens expandArg(const PPTokens& arg);
+    PPTokens makeTokens(const std::string& spelling);
+    void startExpansion(const SyntaxToken& nameTk);
+    void emit(PPToken& t, bool isExpanded);
+
+    std::string spell(const PPToken& t) const;
+    static bool isIdentifierLike(const SyntaxToken& tk);
+
+    SyntaxTree* tree_;
+    Lexer* lexer_;
+    const std::string& text_;
+
+    std::unordered_map<std::string, std::shared_ptr<Macro>> macros_;
+    std::vector<Conditional> conds_;
+    std::string fileName_;
+    int lineDelta_;
+
+    SyntaxToken pendingTk_;
+    bool hasPendingTk_;
+    PPTokens pendingTextTks_;
+    bool reachedEOF_;
+
+    SyntaxToken expansionTk_;
+    bool isFirstOfExpansion_;
+
+    struct DiagnosticsReporter
+    {
+        DiagnosticsReporter(Preprocessor* pp) : pp_(pp) {}
+        Preprocessor* pp_;
+
+        void ErrorDirective(const SyntaxToken& tk, const std::string& msg);
+        void WarningDirective(const SyntaxToken& tk, const std::string& msg);
+        void InvalidDirective(const SyntaxToken& tk);
+        void ExpectedMacroName(const SyntaxToken& tk);
+        void InvalidMacroParameterList(const SyntaxToken& tk);
+        void UnterminatedConditional(const SyntaxToken& tk);
+        void UnmatchedConditional(const SyntaxToken& tk);
+        void UnterminatedMacroInvocation(const SyntaxToken& tk);
+        void MacroArgumentCountMismatch(const SyntaxToken& tk, const std::string& name);
+        void InvalidConditionalExpression(const SyntaxToken& tk);
+        void InvalidTokenPasting(const SyntaxToken& tk, const std::string& spelling);
+
+        static const std::string ID_of_ErrorDirective;
+        static const std::string ID_of_WarningDirective;
+        static const std::string ID_of_InvalidDirective;
+        static const std::string ID_of_ExpectedMacroName;
+        static const std::string ID_of_UnterminatedConditional;
+        static const std::string ID_of_UnmatchedConditional;
+        static const std::string ID_of_UnterminatedMacroInvocation;
+        static const std::string ID_of_MacroArgumentCountMismatch;
+        static const std::string ID_of_InvalidConditionalExpression;
+        static const std::string ID_of_InvalidTokenPasting;
+        static const std::string ID_of_InvalidMacroParameterList;
+    };
+    friend struct DiagnosticsReporter;
+
+    DiagnosticsReporter diagReporter_;
+};
+
+} // C
+} // psy
+
+#endif
@@ -46,6 +46,9 @@ unsigned int Disambiguator::disambiguate()
 template <class ExprT>
 SyntaxVisitor::Action Disambiguator::visitMaybeAmbiguousExpression(ExprT* const& node)
 {
+    if (!node)
+        return Action::Skip;
+
     ExprT*& node_P = const_cast<ExprT*&>(node);
     switch (node->kind()) {
         case AmbiguousCastOrBinaryExpression: {
@@ -83,6 +86,9 @@ SyntaxVisitor::Action Disambiguator::visitMaybeAmbiguousExpression(ExprT* const&
 template <class StmtT>
 SyntaxVisitor::Action Disambiguator::visitMaybeAmbiguousStatement(StmtT* const& node)
 {
+    if (!node)
+        return Action::Skip;
+
     StmtT*& node_P = const_cast<StmtT*&>(node);
     switch (node->kind()) {
         case AmbiguousMultiplicationOrPointerDeclaration:
@@ -121,6 +127,9 @@ SyntaxVisitor::Action Disambiguator::visitMaybeAmbiguousStatement(StmtT* const&
 template <class TypeRefT>
 SyntaxVisitor::Action Disambiguator::visitMaybeAmbiguousTypeReference(TypeRefT* const& node)
 {
+    if (!node)
+        return Action::Skip;
+
     TypeRefT*& node_P = const_cast<TypeRefT*&>(node);
     switch (node->kind()) {
         case AmbiguousTypeNameOrExpressionAsTypeReference: {
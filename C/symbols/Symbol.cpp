@@ -40,14 +40,24 @@ Symbol::~Symbol()
 
 const Assembly* Symbol::owningAssembly() const
 {
-    for (auto compilation : P->tree_->linkedCompilations()) {
-        const auto&& syms = compilation->assembly()->symbols();
-        auto it = std::find(syms.begin(), syms.end(), this);
-        if (it != syms.end())
-            return compilation->assembly();
-    }
+    PSY_ASSERT(P->assembly_, return nullptr);
+
+    return P->assembly_;
+}
+
+void Symbol::setOwningAssembly(const Assembly* assembly)
+{
+    P->assembly_ = assembly;
+}
 
-    PSY_ESCAPE_VIA_RETURN(nullptr);
+const SyntaxTree* Symbol::syntaxTree() const
+{
+    return P->tree_;
+}
+
+void Symbol::setSyntaxTree(const SyntaxTree* tree)
+{
+    P->tree_ = tree;
 }
 
 const Scope *Symbol::scope() const
@@ -55,6 +65,21 @@ const Scope *Symbol::scope() const
     return P->scope_;
 }
 
+const Symbol* Symbol::containingSymbol() const
+{
+    return P->containingSym_;
+}
+
+void Symbol::setContainingSymbol(const Symbol* containingSym)
+{
+    P->containingSym_ = containingSym;
+}
+
+void Symbol::setScope(const Scope* scope)
+{
+    P->scope_ = scope;
+}
+
 Accessibility Symbol::declaredAccessibility() const
 {
     return P->access_;
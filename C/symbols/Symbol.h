@@ -29,9 +29,11 @@
 #include "SymbolName.h"
 
 #include "binder/NameSpace.h"
+#include "infra/Managed.h"
 #include "syntax/SyntaxReference.h"
 
 #include "../common/location/Location.h"
+#include "../common/infra/InternalAccess.h"
 #include "../common/infra/Pimpl.h"
 
 #include <memory>
@@ -47,7 +49,7 @@ namespace C {
  * This API is inspired by that of \c Microsoft.CodeAnalysis.ISymbol
  * from Roslyn, the .NET Compiler Platform.
  */
-class PSY_C_API Symbol
+class PSY_C_API Symbol : public Managed
 {
 public:
     virtual ~Symbol();
@@ -103,6 +105,17 @@ public:
      */
     std::vector<SyntaxReference> declaringSyntaxReferences() const;
 
+PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(Assembly);
+    PSY_GRANT_ACCESS(TypeInterner);
+    PSY_GRANT_ACCESS(Binder);
+
+    const SyntaxTree* syntaxTree() const;
+    void setSyntaxTree(const SyntaxTree* tree);
+    void setOwningAssembly(const Assembly* assembly);
+    void setScope(const Scope* scope);
+    void setContainingSymbol(const Symbol* containingSym);
+
 protected:
     DECL_PIMPL(Symbol);
 
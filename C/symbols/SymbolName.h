@@ -26,6 +26,8 @@
 
 #include "SymbolNameKind.h"
 
+#include "infra/Managed.h"
+
 #include "../common/infra/InternalAccess.h"
 
 #include <cstdint>
@@ -37,7 +39,7 @@ namespace C {
 /**
  * \brief The SymbolName class.
  */
-class PSY_C_API SymbolName
+class PSY_C_API SymbolName : public Managed
 {
 public:
     virtual ~SymbolName();
@@ -35,6 +35,11 @@ TagSymbolName::TagChoice TagSymbolName::tagChoice() const
     return tagChoice_;
 }
 
+const std::string& TagSymbolName::tag() const
+{
+    return tag_;
+}
+
 std::string TagSymbolName::text() const
 {
     std::string prefix;
@@ -67,6 +67,11 @@ public:
      */
     TagChoice tagChoice() const;
 
+    /**
+     * The tag of \c this TagSymbolName.
+     */
+    const std::string& tag() const;
+
     /**
      * The text of \c this TagSymbolName.
      */
@@ -32,10 +32,11 @@ using namespace C;
 
 struct FunctionSymbol::FunctionSymbolImpl : SymbolImpl
 {
-    FunctionSymbolImpl(const SyntaxTree* tree,
+    FunctionSymbolImpl(MemoryPool* pool,
+                       const SyntaxTree* tree,
                        const Scope* scope,
                        const Symbol* containingSym)
-        : SymbolImpl(tree, scope, containingSym, SymbolKind::Function)
+        : SymbolImpl(pool, tree, scope, containingSym, SymbolKind::Function)
         , name_(nullptr)
         , tySym_(nullptr)
     {}
@@ -44,12 +45,14 @@ struct FunctionSymbol::FunctionSymbolImpl : SymbolImpl
     const TypeSymbol* tySym_;
 };
 
-FunctionSymbol::FunctionSymbol(const SyntaxTree* tree,
+FunctionSymbol::FunctionSymbol(MemoryPool* pool,
+                               const SyntaxTree* tree,
                                const Scope* scope,
                                const Symbol* containingSym)
-    : Symbol(new FunctionSymbolImpl(tree,
-                                    scope,
-                                    containingSym))
+    : Symbol(new (pool) FunctionSymbolImpl(pool,
+                                           tree,
+                                           scope,
+                                           containingSym))
 {}
 
 const SymbolName* FunctionSymbol::name() const
@@ -26,13 +26,15 @@
 using namespace psy;
 using namespace C;
 
-LibrarySymbol::LibrarySymbol(const SyntaxTree* tree,
+LibrarySymbol::LibrarySymbol(MemoryPool* pool,
+                             const SyntaxTree* tree,
                                const Scope* scope,
                                const Symbol* containingSym)
-    : Symbol(new SymbolImpl(tree,
-                            scope,
-                            containingSym,
-                            SymbolKind::Library))
+    : Symbol(new (pool) SymbolImpl(pool,
+                                   tree,
+                                   scope,
+                                   containingSym,
+                                   SymbolKind::Library))
 {}
 
 namespace psy {
@@ -93,7 +93,9 @@ public:
     bool isRestrictQualified() const;
 
 PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(Binder);
     PSY_GRANT_ACCESS(SemanticsOfTypeQualifiers);
+    PSY_GRANT_ACCESS(TypeInterner);
 
     void qualifyWithConst();
     void qualifyWithVolatile();
@@ -30,11 +30,12 @@ using namespace C;
 
 struct ValueSymbol::ValueSymbolImpl : SymbolImpl
 {
-    ValueSymbolImpl(const SyntaxTree* tree,
+    ValueSymbolImpl(MemoryPool* pool,
+                    const SyntaxTree* tree,
                     const Scope* scope,
                     const Symbol* containingSym,
                     ValueKind valKind)
-        : SymbolImpl(tree, scope, containingSym, SymbolKind::Value)
+        : SymbolImpl(pool, tree, scope, containingSym, SymbolKind::Value)
         , valKind_(valKind)
         , name_(nullptr)
         , tySym_(nullptr)
@@ -45,14 +46,16 @@ struct ValueSymbol::ValueSymbolImpl : SymbolImpl
     const TypeSymbol* tySym_;
 };
 
-ValueSymbol::ValueSymbol(const SyntaxTree* tree,
+ValueSymbol::ValueSymbol(MemoryPool* pool,
+                         const SyntaxTree* tree,
                           const Scope* scope,
                           const Symbol* containingSym,
                           ValueKind valKind)
-    : Symbol(new ValueSymbolImpl(tree,
-                                 scope,
-                                 containingSym,
-                                 valKind))
+    : Symbol(new (pool) ValueSymbolImpl(pool,
+                                        tree,
+                                        scope,
+                                        containingSym,
+                                        valKind))
 {}
 
 ValueSymbol::~ValueSymbol()
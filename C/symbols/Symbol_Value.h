@@ -91,7 +91,8 @@ PSY_INTERNAL_AND_RESTRICTED:
 protected:
     DECL_PIMPL_SUB(ValueSymbol);
 
-    ValueSymbol(const SyntaxTree* tree,
+    ValueSymbol(MemoryPool* pool,
+                const SyntaxTree* tree,
                 const Scope* scope,
                 const Symbol* containingSym,
                 ValueKind valKind);
@@ -28,11 +28,13 @@ using namespace C;
 
 struct ArrayTypeSymbol::ArrayTypeSymbolImpl : TypeSymbolImpl
 {
-    ArrayTypeSymbolImpl(const SyntaxTree* tree,
+    ArrayTypeSymbolImpl(MemoryPool* pool,
+                        const SyntaxTree* tree,
                           const Scope* scope,
                           const Symbol* containingSym,
                           const TypeSymbol* elemTySym)
-        : TypeSymbolImpl(tree,
+        : TypeSymbolImpl(pool,
+                         tree,
                          scope,
                          containingSym,
                          TypeKind::Array)
@@ -42,14 +44,16 @@ struct ArrayTypeSymbol::ArrayTypeSymbolImpl : TypeSymbolImpl
     const TypeSymbol* elemTySym_;
 };
 
-ArrayTypeSymbol::ArrayTypeSymbol(const SyntaxTree* tree,
+ArrayTypeSymbol::ArrayTypeSymbol(MemoryPool* pool,
+                                 const SyntaxTree* tree,
                                  const Scope* scope,
                                  const Symbol* containingSym,
                                  const TypeSymbol* elemTySym)
-    : TypeSymbol(new ArrayTypeSymbolImpl(tree,
-                                         scope,
-                                         containingSym,
-                                         elemTySym))
+    : TypeSymbol(new (pool) ArrayTypeSymbolImpl(pool,
+                                                tree,
+                                                scope,
+                                                containingSym,
+                                                elemTySym))
 {}
 
 const TypeSymbol* ArrayTypeSymbol::elementType() const
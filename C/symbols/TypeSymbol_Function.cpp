@@ -28,11 +28,13 @@ using namespace C;
 
 struct FunctionTypeSymbol::FunctionTypeSymbolImpl : TypeSymbolImpl
 {
-    FunctionTypeSymbolImpl(const SyntaxTree* tree,
+    FunctionTypeSymbolImpl(MemoryPool* pool,
+                           const SyntaxTree* tree,
                            const Scope* scope,
                            const Symbol* containingSym,
                            const TypeSymbol* retTySym)
-        : TypeSymbolImpl(tree,
+        : TypeSymbolImpl(pool,
+                         tree,
                          scope,
                          containingSym,
                          TypeKind::Function)
@@ -43,14 +45,16 @@ struct FunctionTypeSymbol::FunctionTypeSymbolImpl : TypeSymbolImpl
     std::vector<const TypeSymbol*> parmTySyms_;
 };
 
-FunctionTypeSymbol::FunctionTypeSymbol(const SyntaxTree* tree,
+FunctionTypeSymbol::FunctionTypeSymbol(MemoryPool* pool,
+                                       const SyntaxTree* tree,
                                        const Scope* scope,
                                        const Symbol* containingSym,
                                        const TypeSymbol* retTySym)
-    : TypeSymbol(new FunctionTypeSymbolImpl(tree,
-                                            scope,
-                                            containingSym,
-                                            retTySym))
+    : TypeSymbol(new (pool) FunctionTypeSymbolImpl(pool,
+                                                   tree,
+                                                   scope,
+                                                   containingSym,
+                                                   retTySym))
 {}
 
 const TypeSymbol* FunctionTypeSymbol::returnType() const
@@ -29,11 +29,13 @@ using namespace C;
 
 struct NamedTypeSymbol::NamedTypeSymbolImpl : TypeSymbolImpl
 {
-    NamedTypeSymbolImpl(const SyntaxTree* tree,
+    NamedTypeSymbolImpl(MemoryPool* pool,
+                        const SyntaxTree* tree,
                         const Scope* scope,
                         const Symbol* containingSym,
                         NamedTypeKind namedTypeKind)
-        : TypeSymbolImpl(tree,
+        : TypeSymbolImpl(pool,
+                         tree,
                          scope,
                          containingSym,
                          TypeKind::Named)
@@ -46,36 +48,42 @@ struct NamedTypeSymbol::NamedTypeSymbolImpl : TypeSymbolImpl
     BuiltinTypeKind builtTyKind_;
 };
 
-NamedTypeSymbol::NamedTypeSymbol(const SyntaxTree* tree,
+NamedTypeSymbol::NamedTypeSymbol(MemoryPool* pool,
+                                 const SyntaxTree* tree,
                                  const Scope* scope,
                                  const Symbol* containingSym,
                                  BuiltinTypeKind builtTyKind)
-    : TypeSymbol(new NamedTypeSymbolImpl(tree,
-                                         scope,
-                                         containingSym,
-                                         NamedTypeKind::Builtin))
+    : TypeSymbol(new (pool) NamedTypeSymbolImpl(pool,
+                                                tree,
+                                                scope,
+                                                containingSym,
+                                                NamedTypeKind::Builtin))
 {
     patchBuiltinTypeKind(builtTyKind);
 }
 
-NamedTypeSymbol::NamedTypeSymbol(const SyntaxTree* tree,
+NamedTypeSymbol::NamedTypeSymbol(MemoryPool* pool,
+                                 const SyntaxTree* tree,
                                  const Scope* scope,
                                  const Symbol* containingSym,
                                  const std::string& name)
-    : TypeSymbol(new NamedTypeSymbolImpl(tree,
-                                         scope,
-                                         containingSym,
-                                         NamedTypeKind::Synonym))
+    : TypeSymbol(new (pool) NamedTypeSymbolImpl(pool,
+                                                tree,
+                                                scope,
+                                                containingSym,
+                                                NamedTypeKind::Synonym))
 {
-    P_CAST->name_.reset(new PlainSymbolName(name));
+    P_CAST->name_.reset(new (P->pool_) PlainSymbolName(name));
 }
 
-NamedTypeSymbol::NamedTypeSymbol(const SyntaxTree* tree,
+NamedTypeSymbol::NamedTypeSymbol(MemoryPool* pool,
+                                 const SyntaxTree* tree,
                                  const Scope* scope,
                                  const Symbol* containingSym,
                                  TagSymbolName::TagChoice tagChoice,
                                  const std::string& tag)
-    : TypeSymbol(new NamedTypeSymbolImpl(
+    : TypeSymbol(new (pool) NamedTypeSymbolImpl(
+                        pool,
                         tree,
                         scope,
                         containingSym,
@@ -87,7 +95,7 @@ NamedTypeSymbol::NamedTypeSymbol(const SyntaxTree* tree,
                                     ? NamedTypeKind::Enumeration
                                     : NamedTypeKind::UNSPECIFIED))
 {
-    P_CAST->name_.reset(new TagSymbolName(tagChoice, tag));
+    P_CAST->name_.reset(new (P->pool_) TagSymbolName(tagChoice, tag));
 }
 
 const SymbolName* NamedTypeSymbol::name() const
@@ -107,7 +115,7 @@ BuiltinTypeKind NamedTypeSymbol::builtinTypeKind() const
 
 void NamedTypeSymbol::patchBuiltinTypeKind(BuiltinTypeKind builtTyKind)
 {
-    P_CAST->name_.reset(new PlainSymbolName(canonicalText(builtTyKind)));
+    P_CAST->name_.reset(new (P->pool_) PlainSymbolName(canonicalText(builtTyKind)));
     P_CAST->builtTyKind_ = builtTyKind;
 }
 
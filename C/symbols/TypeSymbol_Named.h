@@ -68,18 +68,22 @@ public:
 PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(Binder);
     PSY_GRANT_ACCESS(ConstraintsInTypeSpecifiers);
+    PSY_GRANT_ACCESS(TypeInterner);
 
-    NamedTypeSymbol(const SyntaxTree* tree,
+    NamedTypeSymbol(MemoryPool* pool,
+                    const SyntaxTree* tree,
                     const Scope* scope,
                     const Symbol* containingSym,
                     BuiltinTypeKind builtTyK);
 
-    NamedTypeSymbol(const SyntaxTree* tree,
+    NamedTypeSymbol(MemoryPool* pool,
+                    const SyntaxTree* tree,
                     const Scope* scope,
                     const Symbol* containingSym,
                     const std::string& name);
 
-    NamedTypeSymbol(const SyntaxTree* tree,
+    NamedTypeSymbol(MemoryPool* pool,
+                    const SyntaxTree* tree,
                     const Scope* scope,
                     const Symbol* containingSym,
                     TagSymbolName::TagChoice tagChoice,
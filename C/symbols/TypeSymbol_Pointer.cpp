@@ -28,11 +28,13 @@ using namespace C;
 
 struct PointerTypeSymbol::PointerTypeSymbolImpl : TypeSymbolImpl
 {
-    PointerTypeSymbolImpl(const SyntaxTree* tree,
+    PointerTypeSymbolImpl(MemoryPool* pool,
+                          const SyntaxTree* tree,
                           const Scope* scope,
                           const Symbol* containingSym,
                           const TypeSymbol* refedTySym)
-        : TypeSymbolImpl(tree,
+        : TypeSymbolImpl(pool,
+                         tree,
                          scope,
                          containingSym,
                          TypeKind::Pointer)
@@ -46,14 +48,16 @@ struct PointerTypeSymbol::PointerTypeSymbolImpl : TypeSymbolImpl
     bool functionDecay_;
 };
 
-PointerTypeSymbol::PointerTypeSymbol(const SyntaxTree* tree,
+PointerTypeSymbol::PointerTypeSymbol(MemoryPool* pool,
+                                     const SyntaxTree* tree,
                                      const Scope* scope,
                                      const Symbol* containingSym,
                                      const TypeSymbol* refedTySym)
-    : TypeSymbol(new PointerTypeSymbolImpl(tree,
-                                           scope,
-                                           containingSym,
-                                           refedTySym))
+    : TypeSymbol(new (pool) PointerTypeSymbolImpl(pool,
+                                                  tree,
+                                                  scope,
+                                                  containingSym,
+                                                  refedTySym))
 {}
 
 const TypeSymbol* PointerTypeSymbol::referencedType() const
@@ -28,10 +28,12 @@
 using namespace psy;
 using namespace C;
 
-EnumeratorSymbol::EnumeratorSymbol(const SyntaxTree* tree,
+EnumeratorSymbol::EnumeratorSymbol(MemoryPool* pool,
+                                   const SyntaxTree* tree,
                                    const Scope* scope,
                                    const Symbol* containingSym)
-    : ValueSymbol(tree,
+    : ValueSymbol(pool,
+                  tree,
                   scope,
                   containingSym,
                   ValueKind::Enumerator)
@@ -43,7 +43,8 @@ public:
 PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(Binder);
 
-    EnumeratorSymbol(const SyntaxTree* tree,
+    EnumeratorSymbol(MemoryPool* pool,
+                     const SyntaxTree* tree,
                      const Scope* scope,
                      const Symbol* containingSym);
 };
@@ -28,10 +28,12 @@
 using namespace psy;
 using namespace C;
 
-FieldSymbol::FieldSymbol(const SyntaxTree* tree,
+FieldSymbol::FieldSymbol(MemoryPool* pool,
+                         const SyntaxTree* tree,
                          const Scope* scope,
                          const Symbol* containingSym)
-    : ValueSymbol(tree,
+    : ValueSymbol(pool,
+                  tree,
                   scope,
                   containingSym,
                   ValueKind::Field)
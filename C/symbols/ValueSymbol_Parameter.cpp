@@ -28,10 +28,12 @@
 using namespace psy;
 using namespace C;
 
-ParameterSymbol::ParameterSymbol(const SyntaxTree* tree,
+ParameterSymbol::ParameterSymbol(MemoryPool* pool,
+                                 const SyntaxTree* tree,
                                  const Scope* scope,
                                  const Symbol* containingSym)
-    : ValueSymbol(tree,
+    : ValueSymbol(pool,
+                  tree,
                   scope,
                   containingSym,
                   ValueKind::Parameter)
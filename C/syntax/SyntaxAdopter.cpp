@@ -0,0 +1,158 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SyntaxAdopter.h"
+#include "SyntaxWriterBinaryFormat.h"
+
+#include "syntax/SyntaxNodes.h"
+#include "syntax/SyntaxVisitor.h"
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+/**
+ * \brief The SlotAdopter class.
+ *
+ * Fill the slots of an adopted node from those of the original node.
+ */
+class SlotAdopter final : public SyntaxVisitor
+{
+public:
+    using NodeAdopter = std::function<SyntaxNode* (const SyntaxNode*)>;
+
+    SlotAdopter(const SyntaxTree* origTree,
+                SyntaxTree* tree,
+                MemoryPool* pool,
+                const SyntaxAdopter::TokenIndexMap& tkIdxMap,
+                NodeAdopter adoptNode)
+        : SyntaxVisitor(origTree)
+        , tree_(tree)
+        , pool_(pool)
+        , tkIdxMap_(tkIdxMap)
+        , adoptNode_(std::move(adoptNode))
+        , adoptedNode_(nullptr)
+        , slotIdx_(0)
+    {}
+
+    SyntaxNode* adoptedNode() const { return adoptedNode_; }
+
+    template <class SlotT>
+    void operator()(SlotT& slot)
+    {
+        const auto& origSlot = *static_cast<const SlotT*>(origSlots_[slotIdx_++]);
+        if constexpr (std::is_integral_v<SlotT>) {
+            slot = origSlot == LexedTokens::invalidIndex()
+                    ? LexedTokens::invalidIndex()
+                    : tkIdxMap_(origSlot);
+        }
+        else if constexpr (std::is_base_of_v<SyntaxNode, std::remove_pointer_t<SlotT>>) {
+            slot = static_cast<SlotT>(adoptNode_(origSlot));
+        }
+        else {
+            using ListT = std::remove_cv_t<std::remove_pointer_t<SlotT>>;
+            ListT* head = nullptr;
+            ListT** cur = &head;
+            for (auto it = origSlot; it; it = it->next) {
+                *cur = new (pool_) ListT(tree_, static_cast<typename ListT::NodeType>(
+                                                       adoptNode_(it->value)));
+                if constexpr (std::is_same_v<ListT, SyntaxNodeSeparatedList<typename ListT::NodeType>>) {
+                    (*cur)->delimTkIdx_ = it->delimTkIdx_ == LexedTokens::invalidIndex()
+                            ? LexedTokens::invalidIndex()
+                            : tkIdxMap_(it->delimTkIdx_);
+                }
+                cur = &(*cur)->next;
+            }
+            slot = head;
+        }
+    }
+
+private:
+    SyntaxTree* tree_;
+    MemoryPool* pool_;
+    const SyntaxAdopter::TokenIndexMap& tkIdxMap_;
+    NodeAdopter adoptNode_;
+    SyntaxNode* adoptedNode_;
+    std::vector<const void*> origSlots_;
+    std::size_t slotIdx_;
+
+    template <class NodeT>
+    Action adopt(const NodeT* node)
+    {
+        NodeT* adoptedNode;
+        if constexpr (std::is_constructible_v<NodeT, SyntaxTree*, SyntaxKind>)
+            adoptedNode = new (pool_) NodeT(tree_, node->kind());
+        else
+            adoptedNode = new (pool_) NodeT(tree_);
+
+        // The slots of both nodes are accessed in the same order.
+        auto collect = [this] (const auto& slot) { origSlots_.push_back(&slot); };
+        node->accessSlots(collect);
+        node->accessUnlistedSlots(collect);
+        adoptedNode->accessSlots(*this);
+        adoptedNode->accessUnlistedSlots(*this);
+
+        adoptedNode_ = adoptedNode;
+        return Action::Skip;
+    }
+
+#define NODE(NAME) \
+    Action visit##NAME(const NAME##Syntax* node) override { return adopt(node); }
+    SYNTAX_NODE_CLASSES(NODE)
+#undef NODE
+};
+
+} // anonymous
+
+SyntaxAdopter::SyntaxAdopter(SyntaxTree* tree, MemoryPool* pool, TokenIndexMap tkIdxMap)
+    : tree_(tree)
+    , pool_(pool)
+    , tkIdxMap_(std::move(tkIdxMap))
+{}
+
+void SyntaxAdopter::substitute(const SyntaxNode* node, SyntaxNode* subst)
+{
+    adopted_[node] = subst;
+}
+
+SyntaxNode* SyntaxAdopter::adoptNode(const SyntaxNode* node)
+{
+    if (!node)
+        return nullptr;
+
+    auto it = adopted_.find(node);
+    if (it != adopted_.end())
+        return it->second;
+
+    SlotAdopter slotAdopter(node->syntaxTree(),
+                            tree_,
+                            pool_,
+                            tkIdxMap_,
+                            [this] (const SyntaxNode* node) { return adoptNode(node); });
+    node->acceptVisitor(&slotAdopter);
+    auto adoptedNode = slotAdopter.adoptedNode();
+    adopted_[node] = adoptedNode;
+    return adoptedNode;
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_SYNTAX_ADOPTER_H__
+#define PSYCHE_C_SYNTAX_ADOPTER_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "parser/LexedTokens.h"
+
+#include <functional>
+#include <unordered_map>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The SyntaxAdopter class.
+ *
+ * Adopt nodes of a SyntaxTree into another one, whose tokens are, in part,
+ * those of the former: a node is copied (in the pool of the other SyntaxTree)
+ * with its token indices mapped and its child nodes adopted as well.
+ *
+ * \remark A node that is shared (e.g., by the alternatives of an ambiguity)
+ * is adopted only once.
+ */
+class PSY_C_NON_API SyntaxAdopter final
+{
+public:
+    using TokenIndexMap = std::function<LexedTokens::IndexType (LexedTokens::IndexType)>;
+
+    SyntaxAdopter(SyntaxTree* tree, MemoryPool* pool, TokenIndexMap tkIdxMap);
+
+    /**
+     * The adoption of \p node.
+     */
+    template <class NodeT> NodeT* adopt(const NodeT* node)
+    {
+        return static_cast<NodeT*>(adoptNode(node));
+    }
+
+    /**
+     * Adopt \p subst in place of \p node.
+     */
+    void substitute(const SyntaxNode* node, SyntaxNode* subst);
+
+private:
+    SyntaxTree* tree_;
+    MemoryPool* pool_;
+    TokenIndexMap tkIdxMap_;
+    std::unordered_map<const SyntaxNode*, SyntaxNode*> adopted_;
+
+    SyntaxNode* adoptNode(const SyntaxNode* node);
+};
+
+} // C
+} // psy
+
+#endif
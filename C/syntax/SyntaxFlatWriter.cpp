@@ -0,0 +1,138 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SyntaxFlatWriter.h"
+
+#include "SyntaxTree.h"
+
+#include "infra/BufferedOutput.h"
+
+using namespace psy;
+using namespace C;
+
+SyntaxFlatWriter::SyntaxFlatWriter(SyntaxTree* tree, std::ostream& os)
+    : SyntaxDumper(tree)
+    , lastTk_{0, 0, 0, 0, 0}
+    , tkCnt_(0)
+    , nodeCnt_(0)
+    , out_(new BufferedOutput(os))
+{}
+
+SyntaxFlatWriter::SyntaxFlatWriter(SyntaxTree* tree, int fd)
+    : SyntaxDumper(tree)
+    , lastTk_{0, 0, 0, 0, 0}
+    , tkCnt_(0)
+    , nodeCnt_(0)
+    , out_(new BufferedOutput(fd))
+{}
+
+SyntaxFlatWriter::~SyntaxFlatWriter()
+{}
+
+void SyntaxFlatWriter::write(const SyntaxNode* node)
+{
+    path_.clear();
+    children_.clear();
+    tkCnt_ = 0;
+    nodeCnt_ = 0;
+
+    writeTree(tree_);
+    if (node)
+        visit(node);
+    writeEnd(nodeCnt_);
+}
+
+void SyntaxFlatWriter::flush()
+{
+    out_->flush();
+}
+
+bool SyntaxFlatWriter::hasError() const
+{
+    return out_->hasError();
+}
+
+void SyntaxFlatWriter::emit(const char* data, std::size_t size)
+{
+    out_->emit(data, size);
+}
+
+bool SyntaxFlatWriter::preVisit(const SyntaxNode*)
+{
+    path_.push_back(Frame{ false, lastTk_, tkCnt_, children_.size() });
+    return true;
+}
+
+void SyntaxFlatWriter::terminal(const SyntaxToken& tk, const SyntaxNode*)
+{
+    if (!tk.isValid())
+        return;
+
+    auto span = tk.span();
+    lastTk_ = TokenPosition{ span.start(),
+                             span.end(),
+                             tk.lineno_,
+                             tk.column_,
+                             tk.column_ + tk.byteSize_ - 1 };
+    ++tkCnt_;
+
+    auto& frame = path_.back();
+    if (!frame.hasFirstTk) {
+        frame.hasFirstTk = true;
+        frame.firstTk = lastTk_;
+    }
+}
+
+void SyntaxFlatWriter::postVisit(const SyntaxNode* node)
+{
+    auto frame = path_.back();
+    path_.pop_back();
+
+    auto hasTokens = tkCnt_ > frame.tkCntAtEntry;
+    Node rec {
+        nodeCnt_++,
+        node->kind(),
+        children_.data() + frame.childrenStart,
+        static_cast<std::uint32_t>(children_.size() - frame.childrenStart),
+        noNode(),
+        hasTokens,
+        hasTokens ? TextSpan(frame.firstTk.start, lastTk_.end) : TextSpan(0, 0),
+        hasTokens ? frame.firstTk.line : 0,
+        hasTokens ? frame.firstTk.startColumn : 0,
+        hasTokens ? lastTk_.line : 0,
+        hasTokens ? lastTk_.endColumn : 0
+    };
+
+    if (!path_.empty()) {
+        auto& parent = path_.back();
+        if (frame.childrenStart > parent.childrenStart)
+            rec.prevSibling = children_[frame.childrenStart - 1];
+        if (hasTokens && !parent.hasFirstTk) {
+            parent.hasFirstTk = true;
+            parent.firstTk = frame.firstTk;
+        }
+    }
+
+    writeNode(rec);
+
+    children_.resize(frame.childrenStart);
+    if (!path_.empty())
+        children_.push_back(rec.id);
+}
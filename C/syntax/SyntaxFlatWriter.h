@@ -0,0 +1,161 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_SYNTAX_FLAT_WRITER_H__
+#define PSYCHE_C_SYNTAX_FLAT_WRITER_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "SyntaxDumper.h"
+
+#include "../common/infra/InternalAccess.h"
+#include "../common/text/TextSpan.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+class BufferedOutput;
+
+/**
+ * \brief The SyntaxFlatWriter class.
+ *
+ * The base class of writers that export the nodes of a SyntaxTree as a flat
+ * sequence of records, meant for consumption by other tools, to a
+ * \c std::ostream or to a file descriptor.
+ *
+ * The nodes are written in a single traversal, in postorder: a node is
+ * written once its subtree is, and it's numbered by its position in the
+ * output (so the children of a node precede it, and the root is the last
+ * node). Only the nodes of the path being traversed are kept; the output
+ * is streamed record by record.
+ *
+ * \remark A node shared by more than one parent (e.g., between the
+ * alternatives of an ambiguity) is written once for each parent.
+ */
+class PSY_C_API SyntaxFlatWriter : public SyntaxDumper
+{
+public:
+    virtual ~SyntaxFlatWriter();
+    SyntaxFlatWriter(const SyntaxFlatWriter&) = delete;
+    void operator=(const SyntaxFlatWriter&) = delete;
+
+    /**
+     * Write the SyntaxNode \p node and its descendants.
+     */
+    void write(const SyntaxNode* node);
+
+    /**
+     * Flush the pending output (for a file descriptor, the output is
+     * buffered by \c this SyntaxFlatWriter; it's flushed on destruction
+     * too).
+     */
+    void flush();
+
+    /**
+     * Whether an error occurred while writing.
+     */
+    bool hasError() const;
+
+    /**
+     * The number of a node that doesn't exist.
+     */
+    static constexpr std::uint32_t noNode() { return 0xFFFFFFFF; }
+
+    /**
+     * \brief The Node struct.
+     *
+     * The record of a node. The span and the positions (as in the Location
+     * of a SyntaxToken) are those of the node's first and last tokens;
+     * they're zero if the node has no tokens.
+     */
+    struct Node
+    {
+        std::uint32_t id;
+        SyntaxKind kind;
+        const std::uint32_t* children;
+        std::uint32_t childCount;
+        std::uint32_t prevSibling;
+        bool hasTokens;
+        TextSpan span;
+        unsigned int startLine;
+        unsigned int startColumn;
+        unsigned int endLine;
+        unsigned int endColumn;
+    };
+
+PSY_INTERNAL_AND_EXTENSIBLE:
+    SyntaxFlatWriter(SyntaxTree* tree, std::ostream& os);
+    SyntaxFlatWriter(SyntaxTree* tree, int fd);
+
+    virtual void writeTree(const SyntaxTree* tree) = 0;
+    virtual void writeNode(const Node& node) = 0;
+    virtual void writeEnd(std::uint32_t nodeCnt) = 0;
+
+    void emit(const char* data, std::size_t size);
+    void emit(const std::string& s) { emit(s.data(), s.size()); }
+
+private:
+    virtual bool preVisit(const SyntaxNode* node) override;
+    virtual void postVisit(const SyntaxNode* node) override;
+    virtual void terminal(const SyntaxToken& tk, const SyntaxNode* node) override;
+
+    struct TokenPosition
+    {
+        unsigned int start;
+        unsigned int end;
+        unsigned int line;
+        unsigned int startColumn;
+        unsigned int endColumn;
+    };
+
+    /*
+     * Per node of the path being traversed: the position of its first token
+     * (if already seen), the count of tokens seen before it, and where its
+     * children start in the stack of children.
+     */
+    struct Frame
+    {
+        bool hasFirstTk;
+        TokenPosition firstTk;
+        std::uint64_t tkCntAtEntry;
+        std::size_t childrenStart;
+    };
+
+    std::vector<Frame> path_;
+    std::vector<std::uint32_t> children_;
+    TokenPosition lastTk_;
+    std::uint64_t tkCnt_;
+    std::uint32_t nodeCnt_;
+
+    std::unique_ptr<BufferedOutput> out_;
+};
+
+} // C
+} // psy
+
+#endif
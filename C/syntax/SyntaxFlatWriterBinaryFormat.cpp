@@ -0,0 +1,96 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SyntaxFlatWriterBinaryFormat.h"
+
+#include "SyntaxTree.h"
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+const char kMagic[] = "PSYFLT";
+
+} // anonymous
+
+SyntaxFlatWriterBinaryFormat::SyntaxFlatWriterBinaryFormat(SyntaxTree* tree, std::ostream& os)
+    : SyntaxFlatWriter(tree, os)
+    , hasHeader_(false)
+{}
+
+SyntaxFlatWriterBinaryFormat::SyntaxFlatWriterBinaryFormat(SyntaxTree* tree, int fd)
+    : SyntaxFlatWriter(tree, fd)
+    , hasHeader_(false)
+{}
+
+void SyntaxFlatWriterBinaryFormat::writeTree(const SyntaxTree* tree)
+{
+    if (!hasHeader_) {
+        emit(kMagic, sizeof(kMagic) - 1);
+        auto v = static_cast<char>(version());
+        emit(&v, 1);
+        hasHeader_ = true;
+    }
+
+    record_.clear();
+    appendU32(tree->filePath().size());
+    record_ += tree->filePath();
+    emit(record_);
+}
+
+void SyntaxFlatWriterBinaryFormat::writeNode(const Node& node)
+{
+    record_.clear();
+    appendU16(node.kind);
+    appendU16(node.hasTokens ? hasTokensFlag() : 0);
+    appendU32(node.childCount);
+    appendU32(node.childCount ? node.children[node.childCount - 1] : noNode());
+    appendU32(node.prevSibling);
+    appendU32(node.span.start());
+    appendU32(node.span.end());
+    appendU32(node.startLine);
+    appendU32(node.startColumn);
+    appendU32(node.endLine);
+    appendU32(node.endColumn);
+    emit(record_);
+}
+
+void SyntaxFlatWriterBinaryFormat::writeEnd(std::uint32_t nodeCnt)
+{
+    record_.clear();
+    appendU16(noKind());
+    appendU16(0);
+    appendU32(nodeCnt);
+    record_.resize(recordSize(), '\0');
+    emit(record_);
+}
+
+void SyntaxFlatWriterBinaryFormat::appendU16(std::uint16_t v)
+{
+    record_ += static_cast<char>(v & 0xFF);
+    record_ += static_cast<char>(v >> 8);
+}
+
+void SyntaxFlatWriterBinaryFormat::appendU32(std::uint32_t v)
+{
+    appendU16(v & 0xFFFF);
+    appendU16(v >> 16);
+}
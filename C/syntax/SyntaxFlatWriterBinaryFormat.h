@@ -0,0 +1,82 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_SYNTAX_FLAT_WRITER_BINARY_FORMAT_H__
+#define PSYCHE_C_SYNTAX_FLAT_WRITER_BINARY_FORMAT_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "SyntaxFlatWriter.h"
+
+#include <cstdint>
+#include <string>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The SyntaxFlatWriterBinaryFormat class.
+ *
+ * Write the nodes of a SyntaxTree as a flat array of fixed-size records.
+ * The output starts with the magic \c "PSYFLT" and a version byte.
+ * Integers are little-endian. Then, per SyntaxTree:
+ *
+ *   - The file path: a \c u32 size followed by the characters.
+ *   - A record of recordSize() bytes per node (see SyntaxFlatWriter about
+ *     their order and numbering): the SyntaxKind (\c u16), flags (\c u16,
+ *     bit 0 tells whether the node has tokens), the child count, the last
+ *     child and the previous sibling (\c u32, noNode() if none), the span
+ *     start and end, the start line and column, and the end line and
+ *     column (\c u32, zero if the node has no tokens).
+ *   - A record that ends the array: its SyntaxKind is noKind(), its child
+ *     count is the number of nodes, and its remaining bytes are zero.
+ *
+ * The children of a node are found from its last child, by following the
+ * previous siblings.
+ */
+class PSY_C_API SyntaxFlatWriterBinaryFormat final : public SyntaxFlatWriter
+{
+public:
+    SyntaxFlatWriterBinaryFormat(SyntaxTree* tree, std::ostream& os);
+    SyntaxFlatWriterBinaryFormat(SyntaxTree* tree, int fd);
+
+    static constexpr std::uint8_t version() { return 1; }
+    static constexpr std::size_t recordSize() { return 40; }
+
+    static constexpr std::uint16_t noKind() { return 0xFFFF; }
+    static constexpr std::uint16_t hasTokensFlag() { return 1; }
+
+private:
+    virtual void writeTree(const SyntaxTree* tree) override;
+    virtual void writeNode(const Node& node) override;
+    virtual void writeEnd(std::uint32_t nodeCnt) override;
+
+    bool hasHeader_;
+    std::string record_;
+
+    void appendU16(std::uint16_t v);
+    void appendU32(std::uint32_t v);
+};
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,92 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SyntaxFlatWriterJSONFormat.h"
+
+#include "SyntaxTree.h"
+
+#include "../common/text/JSONString.h"
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+void appendPair(std::string& line, unsigned int a, unsigned int b)
+{
+    line += '[';
+    line += std::to_string(a);
+    line += ',';
+    line += std::to_string(b);
+    line += ']';
+}
+
+} // anonymous
+
+SyntaxFlatWriterJSONFormat::SyntaxFlatWriterJSONFormat(SyntaxTree* tree, std::ostream& os)
+    : SyntaxFlatWriter(tree, os)
+{}
+
+SyntaxFlatWriterJSONFormat::SyntaxFlatWriterJSONFormat(SyntaxTree* tree, int fd)
+    : SyntaxFlatWriter(tree, fd)
+{}
+
+void SyntaxFlatWriterJSONFormat::writeTree(const SyntaxTree* tree)
+{
+    line_ = "{\"type\":\"tree\",\"file\":";
+    appendJSONString(line_, tree->filePath());
+    line_ += "}\n";
+    emit(line_);
+}
+
+void SyntaxFlatWriterJSONFormat::writeNode(const Node& node)
+{
+    line_ = "{\"type\":\"node\",\"id\":";
+    line_ += std::to_string(node.id);
+    line_ += ",\"kind\":";
+    appendJSONString(line_, to_string(node.kind));
+    line_ += ",\"children\":[";
+    for (auto i = 0U; i < node.childCount; ++i) {
+        if (i)
+            line_ += ',';
+        line_ += std::to_string(node.children[i]);
+    }
+    line_ += ']';
+    if (node.hasTokens) {
+        line_ += ",\"span\":";
+        appendPair(line_, node.span.start(), node.span.end());
+        line_ += ",\"start\":";
+        appendPair(line_, node.startLine, node.startColumn);
+        line_ += ",\"end\":";
+        appendPair(line_, node.endLine, node.endColumn);
+    }
+    else
+        line_ += ",\"span\":null,\"start\":null,\"end\":null";
+    line_ += "}\n";
+    emit(line_);
+}
+
+void SyntaxFlatWriterJSONFormat::writeEnd(std::uint32_t nodeCnt)
+{
+    line_ = "{\"type\":\"end\",\"nodes\":";
+    line_ += std::to_string(nodeCnt);
+    line_ += "}\n";
+    emit(line_);
+}
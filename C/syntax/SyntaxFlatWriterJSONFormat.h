@@ -0,0 +1,68 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_SYNTAX_FLAT_WRITER_JSON_FORMAT_H__
+#define PSYCHE_C_SYNTAX_FLAT_WRITER_JSON_FORMAT_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "SyntaxFlatWriter.h"
+
+#include <string>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The SyntaxFlatWriterJSONFormat class.
+ *
+ * Write the nodes of a SyntaxTree in the JSON Lines format: one JSON object
+ * per line, a \c "tree" object, followed by a \c "node" object per node
+ * (see SyntaxFlatWriter about their order and numbering), and an \c "end"
+ * object. The children of a node are listed by their numbers; the span and
+ * the start and end positions (line and column) are \c null if the node
+ * has no tokens.
+ *
+ * \code
+ * {"type":"tree","file":"f.c"}
+ * {"type":"node","id":0,"kind":"IdentifierName","children":[],"span":[11,12],"start":[1,11],"end":[1,11]}
+ * {"type":"node","id":1,"kind":"ReturnStatement","children":[0],"span":[4,13],"start":[1,4],"end":[1,12]}
+ * {"type":"end","nodes":2}
+ * \endcode
+ */
+class PSY_C_API SyntaxFlatWriterJSONFormat final : public SyntaxFlatWriter
+{
+public:
+    SyntaxFlatWriterJSONFormat(SyntaxTree* tree, std::ostream& os);
+    SyntaxFlatWriterJSONFormat(SyntaxTree* tree, int fd);
+
+private:
+    virtual void writeTree(const SyntaxTree* tree) override;
+    virtual void writeNode(const Node& node) override;
+    virtual void writeEnd(std::uint32_t nodeCnt) override;
+
+    std::string line_;
+};
+
+} // C
+} // psy
+
+#endif
@@ -302,7 +302,7 @@ enum PSY_C_API SyntaxKind : std::uint16_t
     KeywordAlias___signed__ = Keyword_signed,
     KeywordAlias___volatile__ = Keyword_volatile,
 
-    ENDof_KeywordOrPunctuatorToken = KeywordAlias___volatile__,
+    ENDof_KeywordOrPunctuatorToken = Keyword_ExtPSY_omission,
 
 //=================================================================== Nodes
 
@@ -22,7 +22,7 @@
 #define PSYCHE_C_SYNTAX_NAME_PRINTER_H__
 
 #include <ostream>
-#include <tuple>
+#include <string>
 #include <vector>
 
 #include "API.h"
@@ -31,43 +31,6 @@
 namespace psy {
 namespace C {
 
-class CFGNode {
-   public:
-    bool isCondition;  // 标识 If 和 While(For) 语句
-    bool isLoop;       // 标识循环语句 while 和 for
-    bool isFuncDef;    // 标识函数定义语句
-    bool hasCallExpr;  // 标识存在函数调用
-    int nodeLevel;     // 标识当前语句层级
-
-    CFGNode()
-        : isCondition(false),
-          isLoop(false),
-          isFuncDef(false),
-          hasCallExpr(false),
-          nodeLevel(-1),
-          cfgCode_(""),
-          nextNode_(nullptr),
-          nextFalseNode_(nullptr),
-          syntaxNode_(nullptr) {}
-
-    void setCode(std::string codeSnippet);
-    std::string getCode();
-
-    void setNextNode(std::shared_ptr<CFGNode> nextNode);
-    std::shared_ptr<CFGNode> getNextNode();
-
-    void setNextFalseNode(std::shared_ptr<CFGNode> nextFalseNode);
-    std::shared_ptr<CFGNode> getNextFalseNode();
-
-    void setSyntaxNode(const SyntaxNode* syntaxNode);
-    const SyntaxNode* getSyntaxNode();
-
-   private:
-    std::string cfgCode_;                     // 存放当前cfgNode对应的代码字符串
-    std::shared_ptr<CFGNode> nextNode_;       // 下一个cfgNode，也是true跳转
-    std::shared_ptr<CFGNode> nextFalseNode_;  // False跳转，包括if和while(for)
-    const SyntaxNode* syntaxNode_;
-};
 class PSY_C_API SyntaxNamePrinter final : public SyntaxDumper {
    public:
     using SyntaxDumper::SyntaxDumper;
@@ -76,20 +39,24 @@ class PSY_C_API SyntaxNamePrinter final : public SyntaxDumper {
 
     void print(const SyntaxNode* node, Style style);
     void print(const SyntaxNode* node, Style style, std::ostream& os);
-    void getCFG(const SyntaxNode* node);
-    void printCFG();
 
    private:
     virtual void nonterminal(const SyntaxNode* node) override;
 
-    std::vector<std::tuple<const SyntaxNode*, int>> dump_;  // psychec原来就有，存放所有抽象语法树结点
-    std::vector<std::shared_ptr<CFGNode>> funcDefStack_;    // 存放所有函数定义，也是出书CFGNode的入口
-    std::vector<std::pair<std::shared_ptr<CFGNode>, int>> ifPairStack_;  // 存放if语句及其层级计数，添加flase跳转
-    std::vector<std::shared_ptr<CFGNode>> ifEndStmtStack_;  // 存放if语句段else之前的最后一个命令，添加跳出if语句的跳转
-    std::vector<std::pair<std::shared_ptr<CFGNode>, bool>> loopPairStack_;  // 存放while/for语句和hasBreak判断
-    std::vector<std::vector<std::shared_ptr<CFGNode>>> breakStmtsStack_;    // 存放break语句的栈
+    void printNode(const SyntaxNode* node, int level, bool isLastChild);
+    void printSnippet(const SyntaxNode* node);
+
+    std::ostream* os_ = nullptr;
+    Style style_ = Style::Plain;
+    const std::string* source_ = nullptr;
 
-    std::shared_ptr<CFGNode> lastNode = std::make_shared<CFGNode>();  // 上一条语句，添加顺序跳转
+    /*
+     * The nodes are printed as they're visited; only the children of the
+     * node being printed are collected, so that it's known whether a child
+     * is the last one (for the decoration of its descendants).
+     */
+    std::vector<const SyntaxNode*>* children_ = nullptr;
+    std::string decoration_;
 };
 
 }  // namespace C
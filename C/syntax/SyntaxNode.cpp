@@ -23,6 +23,8 @@
 #include "SyntaxNodes.h"
 #include "SyntaxVisitor.h"
 
+#include "SyntaxTree.h"
+
 #include <algorithm>
 #include <cstddef>
 
@@ -32,6 +34,7 @@ using namespace C;
 SyntaxNode::SyntaxNode(SyntaxTree* tree, SyntaxKind kind)
     : tree_(tree)
     , kind_(kind)
+    , id_(tree->makeNodeId())
 {}
 
 SyntaxNode::~SyntaxNode()
@@ -34,6 +34,8 @@
 #include "infra/Managed.h"
 #include "parser/LexedTokens.h"
 
+#include "../common/infra/InternalAccess.h"
+
 #include <iostream>
 #include <memory>
 #include <variant>
@@ -346,6 +348,28 @@ public:
     virtual AmbiguousExpressionOrDeclarationStatementSyntax* asAmbiguousExpressionOrDeclarationStatement() { return nullptr; }
     virtual const AmbiguousExpressionOrDeclarationStatementSyntax* asAmbiguousExpressionOrDeclarationStatement() const { return nullptr; }
 
+    /**
+     * Give access to the slots (the fields of tokens, nodes, or node lists)
+     * of \c this SyntaxNode, in the order of its children, to \p slot.
+     */
+    template <class SlotT> void accessSlots(SlotT&&) {}
+    template <class SlotT> void accessSlots(SlotT&&) const {}
+
+    /**
+     * Give access to the slots of \c this SyntaxNode that aren't among its
+     * children to \p slot.
+     */
+    template <class SlotT> void accessUnlistedSlots(SlotT&&) {}
+    template <class SlotT> void accessUnlistedSlots(SlotT&&) const {}
+
+PSY_INTERNAL_AND_RESTRICTED:
+    PSY_GRANT_ACCESS(SemanticModel);
+
+    /**
+     * The identifier of \c this SyntaxNode, unique and dense in its SyntaxTree.
+     */
+    unsigned int id() const { return id_; }
+
 protected:
     SyntaxNode(SyntaxTree* tree, SyntaxKind kind = Error);
 
@@ -362,6 +386,7 @@ protected:
 
     SyntaxTree* tree_;
     SyntaxKind kind_;
+    unsigned int id_;
 };
 
 /**
@@ -27,6 +27,8 @@
 #include "SyntaxToken.h"
 #include "SyntaxTree.h"
 
+#include <tuple>
+
 #define AST__COMMON__(NODE, BASE_NODE) \
     friend class Parser; \
     friend class Disambiguator; \
@@ -91,23 +93,32 @@
  * The children, either nodes or tokens, of an AST node.
  */
 #define AST_CHILD_LST1(NAME1) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_1(NAME1))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_1(NAME1)) \
+    CHILD_SLOTS(NAME1)
 #define AST_CHILD_LST2(NAME1, NAME2) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_2(NAME1, NAME2))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_2(NAME1, NAME2)) \
+    CHILD_SLOTS(NAME1, NAME2)
 #define AST_CHILD_LST3(NAME1, NAME2, NAME3) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_3(NAME1, NAME2, NAME3))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_3(NAME1, NAME2, NAME3)) \
+    CHILD_SLOTS(NAME1, NAME2, NAME3)
 #define AST_CHILD_LST4(NAME1, NAME2, NAME3, NAME4) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_4(NAME1, NAME2, NAME3, NAME4))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_4(NAME1, NAME2, NAME3, NAME4)) \
+    CHILD_SLOTS(NAME1, NAME2, NAME3, NAME4)
 #define AST_CHILD_LST5(NAME1, NAME2, NAME3, NAME4, NAME5) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_5(NAME1, NAME2, NAME3, NAME4, NAME5))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_5(NAME1, NAME2, NAME3, NAME4, NAME5)) \
+    CHILD_SLOTS(NAME1, NAME2, NAME3, NAME4, NAME5)
 #define AST_CHILD_LST6(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_6(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_6(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6)) \
+    CHILD_SLOTS(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6)
 #define AST_CHILD_LST7(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_7(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_7(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7)) \
+    CHILD_SLOTS(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7)
 #define AST_CHILD_LST8(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_8(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_8(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8)) \
+    CHILD_SLOTS(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8)
 #define AST_CHILD_LST9(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8, NAME9) \
-    CHILD_NODES_AND_TOKENS(CHILD_NAME_9(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8, NAME9))
+    CHILD_NODES_AND_TOKENS(CHILD_NAME_9(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8, NAME9)) \
+    CHILD_SLOTS(NAME1, NAME2, NAME3, NAME4, NAME5, NAME6, NAME7, NAME8, NAME9)
 
 #define CHILD_NAME_1(NAME1) \
     SyntaxHolder(NAME1)
@@ -155,6 +166,31 @@
             { auto self = { CHILDREN_SYNTAX }; \
               return merge(BaseSyntax::childNodesAndTokens(), self); }
 
+/*
+ * The function that gives access to the slots (the fields of tokens, nodes,
+ * or node lists) of the children of the `this' node, in the order of the
+ * children, to a \p slot function; e.g., for serialization.
+ */
+#define CHILD_SLOTS(...) \
+    public: \
+        template <class SlotT> void accessSlots(SlotT&& slot) \
+            { BaseSyntax::accessSlots(slot); \
+              std::apply([&slot] (auto&... s) { (slot(s), ...); }, std::tie(__VA_ARGS__)); } \
+        template <class SlotT> void accessSlots(SlotT&& slot) const \
+            { BaseSyntax::accessSlots(slot); \
+              std::apply([&slot] (auto&... s) { (slot(s), ...); }, std::tie(__VA_ARGS__)); }
+
+/*
+ * The slots of an AST node that aren't among its children (which happens only
+ * in concrete nodes).
+ */
+#define AST_UNLISTED_SLOTS(...) \
+    public: \
+        template <class SlotT> void accessUnlistedSlots(SlotT&& slot) \
+            { std::apply([&slot] (auto&... s) { (slot(s), ...); }, std::tie(__VA_ARGS__)); } \
+        template <class SlotT> void accessUnlistedSlots(SlotT&& slot) const \
+            { std::apply([&slot] (auto&... s) { (slot(s), ...); }, std::tie(__VA_ARGS__)); }
+
 using namespace psy;
 using namespace C;
 
@@ -322,6 +358,8 @@ class PSY_C_API TypeReferenceSyntax : public SyntaxNode
 #undef AST_CHILD_LST6
 #undef AST_CHILD_LST7
 #undef AST_CHILD_LST8
+#undef AST_CHILD_LST9
+#undef AST_UNLISTED_SLOTS
 #undef CHILD_NAME_1
 #undef CHILD_NAME_2
 #undef CHILD_NAME_3
@@ -330,8 +368,10 @@ class PSY_C_API TypeReferenceSyntax : public SyntaxNode
 #undef CHILD_NAME_6
 #undef CHILD_NAME_7
 #undef CHILD_NAME_8
+#undef CHILD_NAME_9
 
 #undef DISPATCH_VISIT
 #undef CHILD_NODES_AND_TOKENS
+#undef CHILD_SLOTS
 
 #endif
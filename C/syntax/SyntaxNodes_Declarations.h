@@ -551,6 +551,7 @@ private:
                    decls_,
                    ellipsisTkIdx_,
                    closeParenTkIdx_)
+    AST_UNLISTED_SLOTS(psyOmitTkIdx_)
 };
 
 /**
@@ -577,6 +578,7 @@ private:
                    colonTkIdx_,
                    expr_,
                    expr_);
+    AST_UNLISTED_SLOTS(attrs_)
 };
 
 //--------------//
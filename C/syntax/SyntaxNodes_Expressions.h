@@ -116,6 +116,7 @@ private:
     AST_CHILD_LST1(litTkIdx_)
 
     StringLiteralExpressionSyntax* adjacent_ = nullptr;
+    AST_UNLISTED_SLOTS(adjacent_)
 };
 
 /**
@@ -561,6 +562,7 @@ private:
     TypeNameSyntax* typeName_ = nullptr;
     LexedTokens::IndexType closeParenTkIdx_ = LexedTokens::invalidIndex();;
     ExpressionSyntax* expr_ = nullptr;
+    AST_UNLISTED_SLOTS(openParenTkIdx_, typeName_, closeParenTkIdx_, expr_)
 };
 
 /**
@@ -625,6 +627,11 @@ private:
     ExpressionSyntax* whenTrueExpr_ = nullptr;
     LexedTokens::IndexType colonTkIdx_ = LexedTokens::invalidIndex();
     ExpressionSyntax* whenFalseExpr_ = nullptr;
+    AST_UNLISTED_SLOTS(condExpr_,
+                       questionTkIdx_,
+                       whenTrueExpr_,
+                       colonTkIdx_,
+                       whenFalseExpr_)
 };
 
 /**
@@ -708,6 +715,7 @@ public:
 private:
     CastExpressionSyntax* castExpr_ = nullptr;
     BinaryExpressionSyntax* binExpr_ = nullptr;
+    AST_UNLISTED_SLOTS(castExpr_, binExpr_)
 };
 
 /**
@@ -739,6 +747,7 @@ private:
     LexedTokens::IndexType closeParenTkIdx_ = LexedTokens::invalidIndex();
 
     AST_CHILD_LST2(expr_, typeName_)
+    AST_UNLISTED_SLOTS(kwTkIdx_, openParenTkIdx_, commaTkIdx_, closeParenTkIdx_)
 };
 
 /**
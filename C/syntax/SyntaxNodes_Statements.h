@@ -385,6 +385,7 @@ private:
     LexedTokens::IndexType gotoKwTkIdx_ = LexedTokens::invalidIndex();
     LexedTokens::IndexType identTkIdx_ = LexedTokens::invalidIndex();
     LexedTokens::IndexType semicolonTkIdx_ = LexedTokens::invalidIndex();
+    AST_UNLISTED_SLOTS(gotoKwTkIdx_, identTkIdx_, semicolonTkIdx_)
 };
 
 /**
@@ -489,6 +490,13 @@ private:
     LexedTokens::IndexType openParenTkIdx_ = LexedTokens::invalidIndex();
     ExpressionSyntax* expr_ = nullptr;
     LexedTokens::IndexType closeParenTkIdx_ = LexedTokens::invalidIndex();
+    AST_UNLISTED_SLOTS(openBracketTkIdx_,
+                       identExpr_,
+                       closeBracketTkIdx_,
+                       strLit_,
+                       openParenTkIdx_,
+                       expr_,
+                       closeParenTkIdx_)
 };
 
 /**
@@ -536,7 +544,20 @@ private:
     ExpressionListSyntax* labels_ = nullptr;
     LexedTokens::IndexType closeParenTkIdx_ = LexedTokens::invalidIndex();
     LexedTokens::IndexType semicolonTkIdx_ = LexedTokens::invalidIndex();
-
+    AST_UNLISTED_SLOTS(asmKwTkIdx_,
+                       asmQuals_,
+                       openParenTkIdx_,
+                       strLit_,
+                       colon1TkIdx_,
+                       outOprds_,
+                       colon2TkIdx_,
+                       inOprds_,
+                       colon3TkIdx_,
+                       clobs_,
+                       colon4TkIdx_,
+                       labels_,
+                       closeParenTkIdx_,
+                       semicolonTkIdx_)
 };
 
 class PSY_C_API ExtGNU_AsmQualifierSyntax final : public TrivialSpecifierSyntax
@@ -0,0 +1,474 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SyntaxReaderBinaryFormat.h"
+#include "SyntaxWriterBinaryFormat.h"
+
+#include "SyntaxTree.h"
+
+#include "syntax/SyntaxLexeme_ALL.h"
+#include "syntax/SyntaxNodes.h"
+
+#include "../common/diagnostics/Diagnostic.h"
+#include "../common/location/Location.h"
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The SlotReader class.
+ *
+ * Read the slots of a node.
+ */
+class SlotReader final
+{
+public:
+    SlotReader(SyntaxReaderBinaryFormat* reader, std::uint32_t nodeIdx)
+        : reader_(reader)
+        , nodeIdx_(nodeIdx)
+    {}
+
+    template <class SlotT>
+    void operator()(SlotT& slot)
+    {
+        if constexpr (std::is_integral_v<SlotT>) {
+            slot = readToken();
+        }
+        else if constexpr (std::is_base_of_v<SyntaxNode, std::remove_pointer_t<SlotT>>) {
+            slot = readNode<SlotT>();
+        }
+        else {
+            using ListT = std::remove_cv_t<std::remove_pointer_t<SlotT>>;
+            auto cnt = reader_->readU32();
+            if (!reader_->fits(std::size_t(cnt) * 4))
+                return;
+
+            ListT* head = nullptr;
+            ListT** cur = &head;
+            for (std::uint32_t i = 0; i < cnt && reader_->ok_; ++i) {
+                *cur = new (reader_->pool_) ListT(reader_->tree_, readNode<typename ListT::NodeType>());
+                if constexpr (std::is_same_v<ListT, SyntaxNodeSeparatedList<typename ListT::NodeType>>)
+                    (*cur)->delimTkIdx_ = readToken();
+                cur = &(*cur)->next;
+            }
+            slot = head;
+        }
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges_;
+
+private:
+    SyntaxReaderBinaryFormat* reader_;
+    std::uint32_t nodeIdx_;
+
+    LexedTokens::IndexType readToken()
+    {
+        auto tkIdx = reader_->readU32();
+        if (tkIdx >= reader_->tkCnt_) {
+            reader_->ok_ = false;
+            return LexedTokens::invalidIndex();
+        }
+        return tkIdx;
+    }
+
+    template <class NodeT>
+    NodeT readNode()
+    {
+        auto ref = reader_->readU32();
+        if (!ref)
+            return nullptr;
+
+        if (ref > reader_->nodes_.size()) {
+            reader_->ok_ = false;
+            return nullptr;
+        }
+        auto node = dynamic_cast<NodeT>(reader_->nodes_[ref - 1]);
+        if (!node) {
+            reader_->ok_ = false;
+            return nullptr;
+        }
+        edges_.emplace_back(nodeIdx_, ref - 1);
+        return node;
+    }
+};
+
+} // C
+} // psy
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+const char kMagic[] = "PSYAST";
+
+} // anonymous
+
+SyntaxReaderBinaryFormat::SyntaxReaderBinaryFormat(const char* data, std::size_t size)
+    : data_(data)
+    , size_(size)
+    , pos_(0)
+    , ok_(true)
+    , tree_(nullptr)
+    , pool_(nullptr)
+    , tkCnt_(0)
+{}
+
+SyntaxReaderBinaryFormat::SyntaxReaderBinaryFormat(const std::string& data)
+    : SyntaxReaderBinaryFormat(data.data(), data.size())
+{}
+
+std::unique_ptr<SyntaxTree> SyntaxReaderBinaryFormat::read(ParseOptions parseOptions)
+{
+    pos_ = 0;
+    ok_ = true;
+    nodes_.clear();
+
+    if (!fits(sizeof(kMagic) - 1)
+            || std::memcmp(data_, kMagic, sizeof(kMagic) - 1)) {
+        return nullptr;
+    }
+    pos_ += sizeof(kMagic) - 1;
+    if (readU8() != SyntaxWriterBinaryFormat::version())
+        return nullptr;
+
+    auto filePath = readString();
+    auto text = readString();
+    auto textPPState = readU8();
+    auto textCompleteness = readU8();
+    auto syntaxCat = readU8();
+    auto parseExitedEarly = readU8();
+    if (!ok_
+            || textPPState > static_cast<std::uint8_t>(TextPreprocessingState::Unpreprocessed)
+            || textCompleteness > static_cast<std::uint8_t>(TextCompleteness::Fragment)
+            || syntaxCat > static_cast<std::uint8_t>(SyntaxTree::SyntaxCategory::Statements)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SyntaxTree> tree(
+            new SyntaxTree(SourceText(std::move(text)),
+                           static_cast<TextPreprocessingState>(textPPState),
+                           static_cast<TextCompleteness>(textCompleteness),
+                           std::move(parseOptions),
+                           filePath));
+    tree_ = tree.get();
+    pool_ = tree_->unitPool();
+
+    auto lexemeCnt = readU32();
+    if (!fits(std::size_t(lexemeCnt) * 5))
+        return nullptr;
+    std::vector<const SyntaxLexeme*> lexemes;
+    lexemes.reserve(lexemeCnt);
+    for (std::uint32_t i = 0; i < lexemeCnt && ok_; ++i) {
+        auto kind = static_cast<SyntaxLexeme::Kind>(readU8());
+        auto s = readString();
+        switch (kind) {
+            case SyntaxLexeme::Kind::Identifier:
+                lexemes.push_back(tree_->identifier(s.c_str(), s.size()));
+                break;
+
+            case SyntaxLexeme::Kind::IntegerConstant:
+                lexemes.push_back(tree_->integerConstant(s.c_str(), s.size()));
+                break;
+
+            case SyntaxLexeme::Kind::FloatingConstant:
+                lexemes.push_back(tree_->floatingConstant(s.c_str(), s.size()));
+                break;
+
+            case SyntaxLexeme::Kind::CharacterConstant:
+                lexemes.push_back(tree_->characterConstant(s.c_str(), s.size()));
+                break;
+
+            case SyntaxLexeme::Kind::ImaginaryIntegerConstant:
+                lexemes.push_back(tree_->imaginaryIntegerConstant(s.c_str(), s.size()));
+                break;
+
+            case SyntaxLexeme::Kind::ImaginaryFloatingConstant:
+                lexemes.push_back(tree_->imaginaryFloatingConstant(s.c_str(), s.size()));
+                break;
+
+            case SyntaxLexeme::Kind::StringLiteral:
+                lexemes.push_back(tree_->stringLiteral(s.c_str(), s.size()));
+                break;
+
+            default:
+                return nullptr;
+        }
+    }
+
+    std::vector<SyntaxToken> tks;
+    if (!readTokens(tks, lexemes) || tks.empty())
+        return nullptr;
+    tks[0].tree_ = nullptr;
+    for (auto& tk : tks)
+        tree_->addToken(tk);
+    tkCnt_ = tks.size();
+    if (!readTokens(tree_->comments_, lexemes))
+        return nullptr;
+
+    auto lineStartCnt = readU32();
+    if (!fits(std::size_t(lineStartCnt) * 4))
+        return nullptr;
+    for (std::uint32_t i = 0; i < lineStartCnt; ++i)
+        tree_->relayLineStart(readU32());
+
+    auto lineDirCnt = readU32();
+    if (!fits(std::size_t(lineDirCnt) * 12))
+        return nullptr;
+    for (std::uint32_t i = 0; i < lineDirCnt && ok_; ++i) {
+        auto offset = readU32();
+        auto lineno = readU32();
+        tree_->relayLineDirective(offset, lineno, readString());
+    }
+
+    auto expansionCnt = readU32();
+    if (!fits(std::size_t(expansionCnt) * 12))
+        return nullptr;
+    for (std::uint32_t i = 0; i < expansionCnt; ++i) {
+        auto offset = readU32();
+        auto lineno = readU32();
+        auto column = readU32();
+        tree_->relayExpansion(offset, std::make_pair(lineno, column));
+    }
+
+    auto diagCnt = readU32();
+    if (!fits(std::size_t(diagCnt) * 38))
+        return nullptr;
+    for (std::uint32_t i = 0; i < diagCnt && ok_; ++i) {
+        auto id = readString();
+        auto title = readString();
+        auto description = readString();
+        auto severity = static_cast<DiagnosticSeverity>(readU8());
+        auto category = static_cast<DiagnosticCategory>(readU8());
+        auto path = readString();
+        auto startLine = static_cast<int>(readU32());
+        auto startChar = static_cast<int>(readU32());
+        auto endLine = static_cast<int>(readU32());
+        auto endChar = static_cast<int>(readU32());
+        auto snippet = readString();
+        tree_->relayDiagnostic(
+                Diagnostic(DiagnosticDescriptor(std::move(id),
+                                                std::move(title),
+                                                std::move(description),
+                                                severity,
+                                                category),
+                           Location::create(
+                                FileLinePositionSpan(std::move(path),
+                                                     LinePositionSpan(LinePosition(startLine, startChar),
+                                                                      LinePosition(endLine, endChar)))),
+                           std::move(snippet)));
+    }
+
+    if (!ok_ || !readNodes() || pos_ != size_)
+        return nullptr;
+
+    tree_->relayParse(nodes_.empty() ? nullptr : nodes_[0],
+                      static_cast<SyntaxTree::SyntaxCategory>(syntaxCat),
+                      parseExitedEarly);
+    tree_ = nullptr;
+    pool_ = nullptr;
+    nodes_.clear();
+
+    return tree;
+}
+
+bool SyntaxReaderBinaryFormat::readTokens(std::vector<SyntaxToken>& tks,
+                                          const std::vector<const SyntaxLexeme*>& lexemes)
+{
+    // The sizes of the arrays, per token.
+    const std::size_t kRowSize = 2 + 2 + 2 + 4 + 4 + 4 + 2 + 4 + 4 + 4;
+
+    auto cnt = readU32();
+    if (!fits(cnt * kRowSize))
+        return false;
+
+    tks.assign(cnt, SyntaxToken(tree_));
+    for (auto& tk : tks)
+        tk.rawSyntaxK_ = readU16();
+    for (auto& tk : tks)
+        tk.byteSize_ = readU16();
+    for (auto& tk : tks)
+        tk.charSize_ = readU16();
+    for (auto& tk : tks)
+        tk.byteOffset_ = readU32();
+    for (auto& tk : tks)
+        tk.charOffset_ = readU32();
+    for (auto& tk : tks) {
+        tk.matchingBracket_ = readU32();
+        if (tk.matchingBracket_ >= cnt)
+            ok_ = false;
+    }
+    for (auto& tk : tks)
+        tk.BF_all_ = readU16();
+    for (auto& tk : tks)
+        tk.lineno_ = readU32();
+    for (auto& tk : tks)
+        tk.column_ = readU32();
+    for (auto& tk : tks) {
+        auto lexemeIdx = readU32();
+        if (lexemeIdx > lexemes.size()) {
+            ok_ = false;
+            break;
+        }
+        tk.lexeme_ = lexemeIdx ? const_cast<SyntaxLexeme*>(lexemes[lexemeIdx - 1]) : nullptr;
+    }
+
+    return ok_;
+}
+
+bool SyntaxReaderBinaryFormat::readNodes()
+{
+    auto cnt = readU32();
+    auto root = readU32();
+    if (!fits(std::size_t(cnt) * 4) || root > cnt || (cnt && root != 1))
+        return false;
+
+    // Allocate all nodes, so that the slots may refer to any of them.
+    std::vector<std::uint16_t> nodeClasses(cnt);
+    for (auto& nodeClass : nodeClasses)
+        nodeClass = readU16();
+    nodes_.reserve(cnt);
+    for (auto nodeClass : nodeClasses) {
+        auto node = makeNode(nodeClass, readU16());
+        if (!node)
+            return false;
+        nodes_.push_back(node);
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    for (std::uint32_t i = 0; i < cnt && ok_; ++i) {
+        SlotReader slotReader(this, i);
+        switch (static_cast<SyntaxWriterBinaryFormat::NodeClass>(nodeClasses[i])) {
+#define NODE(NAME) \
+            case SyntaxWriterBinaryFormat::NodeClass::NAME: { \
+                auto node = static_cast<NAME##Syntax*>(nodes_[i]); \
+                node->accessSlots(slotReader); \
+                node->accessUnlistedSlots(slotReader); \
+                break; \
+            }
+            SYNTAX_NODE_CLASSES(NODE)
+#undef NODE
+
+            default:
+                return false;
+        }
+        edges.insert(edges.end(), slotReader.edges_.begin(), slotReader.edges_.end());
+    }
+    if (!ok_)
+        return false;
+
+    // A node may be shared (e.g., by the alternatives of an ambiguity), but
+    // the nodes must not form a cycle.
+    std::vector<std::uint32_t> inDegree(cnt, 0);
+    std::vector<std::uint32_t> outStart(cnt + 1, 0);
+    for (const auto& edge : edges) {
+        ++inDegree[edge.second];
+        ++outStart[edge.first + 1];
+    }
+    for (std::uint32_t i = 0; i < cnt; ++i)
+        outStart[i + 1] += outStart[i];
+    std::vector<std::uint32_t> outs(edges.size());
+    auto outPos = outStart;
+    for (const auto& edge : edges)
+        outs[outPos[edge.first]++] = edge.second;
+
+    std::vector<std::uint32_t> ready;
+    for (std::uint32_t i = 0; i < cnt; ++i) {
+        if (!inDegree[i])
+            ready.push_back(i);
+    }
+    std::uint32_t doneCnt = 0;
+    while (!ready.empty()) {
+        auto i = ready.back();
+        ready.pop_back();
+        ++doneCnt;
+        for (auto o = outStart[i]; o < outStart[i + 1]; ++o) {
+            if (!--inDegree[outs[o]])
+                ready.push_back(outs[o]);
+        }
+    }
+
+    return doneCnt == cnt;
+}
+
+SyntaxNode* SyntaxReaderBinaryFormat::makeNode(std::uint16_t nodeClass, std::uint16_t kind)
+{
+    auto make = [this, kind] (auto* type) -> SyntaxNode* {
+        using NodeT = std::remove_pointer_t<decltype(type)>;
+        NodeT* node;
+        if constexpr (std::is_constructible_v<NodeT, SyntaxTree*, SyntaxKind>)
+            node = new (pool_) NodeT(tree_, static_cast<SyntaxKind>(kind));
+        else
+            node = new (pool_) NodeT(tree_);
+        return node->kind() == kind ? node : nullptr;
+    };
+
+    switch (static_cast<SyntaxWriterBinaryFormat::NodeClass>(nodeClass)) {
+#define NODE(NAME) \
+        case SyntaxWriterBinaryFormat::NodeClass::NAME: \
+            return make(static_cast<NAME##Syntax*>(nullptr));
+        SYNTAX_NODE_CLASSES(NODE)
+#undef NODE
+
+        default:
+            return nullptr;
+    }
+}
+
+std::uint8_t SyntaxReaderBinaryFormat::readU8()
+{
+    if (!fits(1))
+        return 0;
+    return static_cast<std::uint8_t>(data_[pos_++]);
+}
+
+std::uint16_t SyntaxReaderBinaryFormat::readU16()
+{
+    std::uint16_t v = readU8();
+    return v | (readU8() << 8);
+}
+
+std::uint32_t SyntaxReaderBinaryFormat::readU32()
+{
+    std::uint32_t v = readU16();
+    return v | (static_cast<std::uint32_t>(readU16()) << 16);
+}
+
+std::string SyntaxReaderBinaryFormat::readString()
+{
+    auto size = readU32();
+    if (!fits(size))
+        return std::string();
+    std::string s(data_ + pos_, size);
+    pos_ += size;
+    return s;
+}
+
+bool SyntaxReaderBinaryFormat::fits(std::size_t n)
+{
+    if (ok_ && n <= size_ - pos_)
+        return true;
+    ok_ = false;
+    return false;
+}
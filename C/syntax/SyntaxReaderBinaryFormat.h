@@ -0,0 +1,91 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_SYNTAX_READER_BINARY_FORMAT_H__
+#define PSYCHE_C_SYNTAX_READER_BINARY_FORMAT_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include "parser/ParseOptions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The SyntaxReaderBinaryFormat class.
+ *
+ * Read a SyntaxTree written by a SyntaxWriterBinaryFormat (see the format
+ * there). The nodes are allocated, in bulk, in the pool of the SyntaxTree,
+ * and then their slots are filled.
+ *
+ * \remark The data isn't copied, so it may be a memory-mapped file; it must
+ * outlive only the reading.
+ */
+class PSY_C_API SyntaxReaderBinaryFormat final
+{
+public:
+    SyntaxReaderBinaryFormat(const char* data, std::size_t size);
+    SyntaxReaderBinaryFormat(const std::string& data);
+
+    /**
+     * Read the SyntaxTree, which is given the ParseOptions \p parseOptions
+     * (they aren't part of the format).
+     *
+     * \return The SyntaxTree, or \c nullptr if the data is malformed or of
+     * another version.
+     */
+    std::unique_ptr<SyntaxTree> read(ParseOptions parseOptions = ParseOptions());
+
+private:
+    friend class SlotReader;
+
+    const char* data_;
+    std::size_t size_;
+    std::size_t pos_;
+    bool ok_;
+
+    SyntaxTree* tree_;
+    MemoryPool* pool_;
+    std::size_t tkCnt_;
+    std::vector<SyntaxNode*> nodes_;
+
+    bool readTokens(std::vector<SyntaxToken>& tks,
+                    const std::vector<const SyntaxLexeme*>& lexemes);
+    bool readNodes();
+    SyntaxNode* makeNode(std::uint16_t nodeClass, std::uint16_t kind);
+
+    std::uint8_t readU8();
+    std::uint16_t readU16();
+    std::uint32_t readU32();
+    std::string readString();
+    bool fits(std::size_t n);
+};
+
+} // C
+} // psy
+
+#endif
@@ -205,7 +205,11 @@ PSY_INTERNAL_AND_RESTRICTED:
     PSY_GRANT_ACCESS(SyntaxTree);
     PSY_GRANT_ACCESS(SyntaxNode);
     PSY_GRANT_ACCESS(Lexer);
+    PSY_GRANT_ACCESS(Preprocessor);
     PSY_GRANT_ACCESS(Parser);
+    PSY_GRANT_ACCESS(SyntaxFlatWriter);
+    PSY_GRANT_ACCESS(SyntaxWriterBinaryFormat);
+    PSY_GRANT_ACCESS(SyntaxReaderBinaryFormat);
 
     SyntaxToken(SyntaxTree* tree);
 
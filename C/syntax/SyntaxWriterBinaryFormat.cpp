@@ -0,0 +1,283 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SyntaxWriterBinaryFormat.h"
+
+#include "SyntaxTree.h"
+
+#include "syntax/SyntaxLexeme.h"
+#include "syntax/SyntaxNodes.h"
+#include "syntax/SyntaxVisitor.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The SlotWriter class.
+ *
+ * Write the class and kind of a node, and its slots.
+ */
+class SlotWriter final : public SyntaxVisitor
+{
+public:
+    SlotWriter(const SyntaxTree* tree,
+               SyntaxWriterBinaryFormat* writer,
+               std::string& classesAndKinds)
+        : SyntaxVisitor(tree)
+        , writer_(writer)
+        , classesAndKinds_(classesAndKinds)
+    {}
+
+    template <class SlotT>
+    void operator()(const SlotT& slot)
+    {
+        if constexpr (std::is_integral_v<SlotT>) {
+            writer_->appendU32(slot);
+        }
+        else if constexpr (std::is_base_of_v<SyntaxNode, std::remove_pointer_t<SlotT>>) {
+            writer_->appendU32(writer_->nodeRef(slot));
+        }
+        else {
+            using ListT = std::remove_cv_t<std::remove_pointer_t<SlotT>>;
+            std::uint32_t cnt = 0;
+            for (auto it = slot; it; it = it->next)
+                ++cnt;
+            writer_->appendU32(cnt);
+            for (auto it = slot; it; it = it->next) {
+                writer_->appendU32(writer_->nodeRef(it->value));
+                if constexpr (std::is_same_v<ListT, SyntaxNodeSeparatedList<typename ListT::NodeType>>)
+                    writer_->appendU32(it->delimTkIdx_);
+            }
+        }
+    }
+
+private:
+    SyntaxWriterBinaryFormat* writer_;
+    std::string& classesAndKinds_;
+
+    template <class NodeT>
+    Action write(const NodeT* node, SyntaxWriterBinaryFormat::NodeClass nodeClass)
+    {
+        auto v = static_cast<std::uint16_t>(nodeClass);
+        classesAndKinds_ += static_cast<char>(v & 0xFF);
+        classesAndKinds_ += static_cast<char>(v >> 8);
+        v = node->kind();
+        classesAndKinds_ += static_cast<char>(v & 0xFF);
+        classesAndKinds_ += static_cast<char>(v >> 8);
+
+        node->accessSlots(*this);
+        node->accessUnlistedSlots(*this);
+        return Action::Skip;
+    }
+
+#define NODE(NAME) \
+    Action visit##NAME(const NAME##Syntax* node) override \
+        { return write(node, SyntaxWriterBinaryFormat::NodeClass::NAME); }
+    SYNTAX_NODE_CLASSES(NODE)
+#undef NODE
+};
+
+} // C
+} // psy
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+const char kMagic[] = "PSYAST";
+
+} // anonymous
+
+SyntaxWriterBinaryFormat::SyntaxWriterBinaryFormat(std::ostream& os)
+    : os_(os)
+{}
+
+void SyntaxWriterBinaryFormat::write(const SyntaxTree* tree)
+{
+    buf_.assign(kMagic, sizeof(kMagic) - 1);
+    appendU8(version());
+
+    appendString(tree->filePath());
+    appendString(tree->text().rawText());
+    appendU8(static_cast<std::uint8_t>(tree->textPreprocessingState()));
+    appendU8(static_cast<std::uint8_t>(tree->textCompleteness()));
+    appendU8(static_cast<std::uint8_t>(tree->syntaxCategory()));
+    appendU8(tree->parseExitedEarly());
+
+    std::vector<SyntaxToken> tks;
+    tks.reserve(tree->tokenCount());
+    for (LexedTokens::IndexType tkIdx = 0; tkIdx < tree->tokenCount(); ++tkIdx)
+        tks.push_back(tree->tokenAt(tkIdx));
+
+    std::vector<const SyntaxLexeme*> lexemes;
+    std::unordered_map<const SyntaxLexeme*, std::uint32_t> lexemeIdx;
+    auto collectLexemes = [&] (const std::vector<SyntaxToken>& tks) {
+        for (const auto& tk : tks) {
+            if (tk.lexeme_ && lexemeIdx.emplace(tk.lexeme_, lexemes.size() + 1).second)
+                lexemes.push_back(tk.lexeme_);
+        }
+    };
+    collectLexemes(tks);
+    collectLexemes(tree->comments_);
+
+    appendU32(lexemes.size());
+    for (auto lexeme : lexemes) {
+        appendU8(static_cast<std::uint8_t>(lexeme->kind()));
+        appendU32(lexeme->size());
+        buf_.append(lexeme->c_str(), lexeme->size());
+    }
+
+    writeTokens(tks, lexemeIdx);
+    writeTokens(tree->comments_, lexemeIdx);
+
+    appendU32(tree->lineStarts().size());
+    for (auto offset : tree->lineStarts())
+        appendU32(offset);
+
+    appendU32(tree->lineDirectives().size());
+    for (const auto& lineDir : tree->lineDirectives()) {
+        appendU32(lineDir.offset());
+        appendU32(lineDir.lineno());
+        appendString(lineDir.fileName());
+    }
+
+    std::vector<std::pair<unsigned int, SyntaxTree::LineColum>> expansions(tree->expansions().begin(),
+                                                                           tree->expansions().end());
+    std::sort(expansions.begin(), expansions.end());
+    appendU32(expansions.size());
+    for (const auto& expansion : expansions) {
+        appendU32(expansion.first);
+        appendU32(expansion.second.first);
+        appendU32(expansion.second.second);
+    }
+
+    auto diags = tree->diagnostics();
+    appendU32(diags.size());
+    for (const auto& diag : diags) {
+        const auto& desc = diag.descriptor();
+        appendString(desc.id());
+        appendString(desc.title());
+        appendString(desc.description());
+        appendU8(static_cast<std::uint8_t>(desc.defaultSeverity()));
+        appendU8(static_cast<std::uint8_t>(desc.category()));
+        const auto& lineSpan = diag.location().lineSpan();
+        appendString(lineSpan.path());
+        appendU32(lineSpan.span().start().line());
+        appendU32(lineSpan.span().start().character());
+        appendU32(lineSpan.span().end().line());
+        appendU32(lineSpan.span().end().character());
+        appendString(diag.snippet());
+    }
+
+    writeNodes(tree);
+
+    os_.write(buf_.data(), buf_.size());
+    buf_.clear();
+    buf_.shrink_to_fit();
+}
+
+void SyntaxWriterBinaryFormat::writeTokens(const std::vector<SyntaxToken>& tks,
+                                           std::unordered_map<const SyntaxLexeme*, std::uint32_t>& lexemeIdx)
+{
+    appendU32(tks.size());
+    for (const auto& tk : tks)
+        appendU16(tk.rawSyntaxK_);
+    for (const auto& tk : tks)
+        appendU16(tk.byteSize_);
+    for (const auto& tk : tks)
+        appendU16(tk.charSize_);
+    for (const auto& tk : tks)
+        appendU32(tk.byteOffset_);
+    for (const auto& tk : tks)
+        appendU32(tk.charOffset_);
+    for (const auto& tk : tks)
+        appendU32(tk.matchingBracket_);
+    for (const auto& tk : tks)
+        appendU16(tk.BF_all_);
+    for (const auto& tk : tks)
+        appendU32(tk.lineno_);
+    for (const auto& tk : tks)
+        appendU32(tk.column_);
+    for (const auto& tk : tks)
+        appendU32(tk.lexeme_ ? lexemeIdx[tk.lexeme_] : 0);
+}
+
+void SyntaxWriterBinaryFormat::writeNodes(const SyntaxTree* tree)
+{
+    nodes_.clear();
+    nodeIdx_.clear();
+
+    std::string slots;
+    std::swap(buf_, slots);
+    auto root = nodeRef(tree->root());
+
+    // The slots of a node make the nodes in them known, in breadth-first order.
+    std::string classesAndKinds;
+    SlotWriter slotWriter(tree, this, classesAndKinds);
+    for (std::size_t i = 0; i < nodes_.size(); ++i)
+        nodes_[i]->acceptVisitor(&slotWriter);
+
+    std::swap(buf_, slots);
+    appendU32(nodes_.size());
+    appendU32(root);
+    for (std::size_t i = 0; i < nodes_.size(); ++i)
+        buf_.append(classesAndKinds, 4 * i, 2);
+    for (std::size_t i = 0; i < nodes_.size(); ++i)
+        buf_.append(classesAndKinds, 4 * i + 2, 2);
+    buf_ += slots;
+}
+
+std::uint32_t SyntaxWriterBinaryFormat::nodeRef(const SyntaxNode* node)
+{
+    if (!node)
+        return 0;
+
+    auto p = nodeIdx_.emplace(node, nodes_.size() + 1);
+    if (p.second)
+        nodes_.push_back(node);
+    return p.first->second;
+}
+
+void SyntaxWriterBinaryFormat::appendU8(std::uint8_t v)
+{
+    buf_ += static_cast<char>(v);
+}
+
+void SyntaxWriterBinaryFormat::appendU16(std::uint16_t v)
+{
+    appendU8(v & 0xFF);
+    appendU8(v >> 8);
+}
+
+void SyntaxWriterBinaryFormat::appendU32(std::uint32_t v)
+{
+    appendU16(v & 0xFFFF);
+    appendU16(v >> 16);
+}
+
+void SyntaxWriterBinaryFormat::appendString(const std::string& s)
+{
+    appendU32(s.size());
+    buf_ += s;
+}
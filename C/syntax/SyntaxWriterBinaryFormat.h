@@ -0,0 +1,211 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_SYNTAX_WRITER_BINARY_FORMAT_H__
+#define PSYCHE_C_SYNTAX_WRITER_BINARY_FORMAT_H__
+
+#include "API.h"
+#include "Fwds.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * The concrete node classes, in the order of their identifiers in the binary
+ * format (new classes must be appended, or the version must be bumped).
+ */
+#define SYNTAX_NODE_CLASSES(NODE) \
+    NODE(TranslationUnit) \
+    NODE(IncompleteDeclaration) \
+    NODE(StructOrUnionDeclaration) \
+    NODE(EnumDeclaration) \
+    NODE(EnumeratorDeclaration) \
+    NODE(VariableAndOrFunctionDeclaration) \
+    NODE(FieldDeclaration) \
+    NODE(ParameterDeclaration) \
+    NODE(StaticAssertDeclaration) \
+    NODE(FunctionDefinition) \
+    NODE(ExtPSY_TemplateDeclaration) \
+    NODE(ExtGNU_AsmStatementDeclaration) \
+    NODE(ExtKR_ParameterDeclaration) \
+    NODE(StorageClass) \
+    NODE(BuiltinTypeSpecifier) \
+    NODE(TagTypeSpecifier) \
+    NODE(AtomicTypeSpecifier) \
+    NODE(TypeDeclarationAsSpecifier) \
+    NODE(TypedefName) \
+    NODE(TypeQualifier) \
+    NODE(FunctionSpecifier) \
+    NODE(AlignmentSpecifier) \
+    NODE(ExtGNU_Typeof) \
+    NODE(ExtGNU_AttributeSpecifier) \
+    NODE(ExtGNU_Attribute) \
+    NODE(ExtGNU_AsmLabel) \
+    NODE(ExtPSY_QuantifiedTypeSpecifier) \
+    NODE(ArrayOrFunctionDeclarator) \
+    NODE(PointerDeclarator) \
+    NODE(ParenthesizedDeclarator) \
+    NODE(IdentifierDeclarator) \
+    NODE(AbstractDeclarator) \
+    NODE(SubscriptSuffix) \
+    NODE(ParameterSuffix) \
+    NODE(BitfieldDeclarator) \
+    NODE(ExpressionInitializer) \
+    NODE(BraceEnclosedInitializer) \
+    NODE(DesignatedInitializer) \
+    NODE(FieldDesignator) \
+    NODE(ArrayDesignator) \
+    NODE(OffsetOfDesignator) \
+    NODE(IdentifierName) \
+    NODE(PredefinedName) \
+    NODE(ConstantExpression) \
+    NODE(StringLiteralExpression) \
+    NODE(ParenthesizedExpression) \
+    NODE(GenericSelectionExpression) \
+    NODE(GenericAssociation) \
+    NODE(ExtGNU_EnclosedCompoundStatementExpression) \
+    NODE(ExtGNU_ComplexValuedExpression) \
+    NODE(PrefixUnaryExpression) \
+    NODE(PostfixUnaryExpression) \
+    NODE(MemberAccessExpression) \
+    NODE(ArraySubscriptExpression) \
+    NODE(TypeTraitExpression) \
+    NODE(CastExpression) \
+    NODE(CallExpression) \
+    NODE(VAArgumentExpression) \
+    NODE(OffsetOfExpression) \
+    NODE(CompoundLiteralExpression) \
+    NODE(BinaryExpression) \
+    NODE(ConditionalExpression) \
+    NODE(AssignmentExpression) \
+    NODE(SequencingExpression) \
+    NODE(ExtGNU_ChooseExpression) \
+    NODE(CompoundStatement) \
+    NODE(DeclarationStatement) \
+    NODE(ExpressionStatement) \
+    NODE(LabeledStatement) \
+    NODE(IfStatement) \
+    NODE(SwitchStatement) \
+    NODE(WhileStatement) \
+    NODE(DoStatement) \
+    NODE(ForStatement) \
+    NODE(GotoStatement) \
+    NODE(ContinueStatement) \
+    NODE(BreakStatement) \
+    NODE(ReturnStatement) \
+    NODE(ExtGNU_AsmStatement) \
+    NODE(ExtGNU_AsmQualifier) \
+    NODE(ExtGNU_AsmOperand) \
+    NODE(TypeName) \
+    NODE(ExpressionAsTypeReference) \
+    NODE(TypeNameAsTypeReference) \
+    NODE(AmbiguousTypeNameOrExpressionAsTypeReference) \
+    NODE(AmbiguousCastOrBinaryExpression) \
+    NODE(AmbiguousExpressionOrDeclarationStatement)
+
+namespace psy {
+namespace C {
+
+/**
+ * \brief The SyntaxWriterBinaryFormat class.
+ *
+ * Write a SyntaxTree in a compact binary format, from which it's read back
+ * by a SyntaxReaderBinaryFormat. The output starts with the magic
+ * \c "PSYAST" and a version byte. Integers are little-endian, and strings
+ * are a \c u32 size followed by the characters. Then, in sequence:
+ *
+ *   - The file path and the text (strings), and the TextPreprocessingState,
+ *     TextCompleteness, SyntaxTree::SyntaxCategory, and whether the parse
+ *     exited early (\c u8 each).
+ *   - The lexemes: a count (\c u32) and, per lexeme, its kind (\c u8) and
+ *     characters (string); every lexeme is written once.
+ *   - The tokens, and then the comments, as structures of arrays: a count
+ *     (\c u32), and the arrays of kinds (\c u16), byte sizes (\c u16), char
+ *     sizes (\c u16), byte offsets (\c u32), char offsets (\c u32), matching
+ *     brackets (\c u32), flags (\c u16), lines (\c u32), columns (\c u32),
+ *     and lexemes (\c u32, a 1-based index, or 0 if none).
+ *   - The line starts (a count and \c u32 offsets), the line directives
+ *     (a count and, per directive, its offset and line, \c u32, and file,
+ *     string), and the expansions (a count and, per expansion, its offset,
+ *     line, and column, \c u32).
+ *   - The diagnostics: a count (\c u32) and, per diagnostic, its id, title,
+ *     and description (strings), severity and category (\c u8), file path
+ *     (string), start line and character and end line and character
+ *     (\c u32), and snippet (string).
+ *   - The nodes: a count (\c u32), the root (\c u32, a 1-based index, or 0
+ *     if none), and the arrays of node classes (\c u16, see
+ *     SYNTAX_NODE_CLASSES) and SyntaxKinds (\c u16); followed by, per node,
+ *     its slots, in the order of the children: a token is its index (\c u32),
+ *     a node is a 1-based index (\c u32, 0 if none), and a node list is a
+ *     count of items (\c u32) and, per item, a node and, if the list is
+ *     separated, its delimiter token.
+ *
+ * \remark The nodes are numbered in breadth-first order; nodes unreachable
+ * from the root (e.g., discarded ambiguities) aren't written.
+ */
+class PSY_C_API SyntaxWriterBinaryFormat final
+{
+public:
+    SyntaxWriterBinaryFormat(std::ostream& os);
+
+    static constexpr std::uint8_t version() { return 1; }
+
+    /**
+     * \brief The NodeClass enumeration.
+     */
+    enum class NodeClass : std::uint16_t
+    {
+#define NODE(NAME) NAME,
+        SYNTAX_NODE_CLASSES(NODE)
+#undef NODE
+        COUNT
+    };
+
+    /**
+     * Write the SyntaxTree \p tree.
+     */
+    void write(const SyntaxTree* tree);
+
+private:
+    friend class SlotWriter;
+
+    std::ostream& os_;
+    std::string buf_;
+    std::vector<const SyntaxNode*> nodes_;
+    std::unordered_map<const SyntaxNode*, std::uint32_t> nodeIdx_;
+
+    void writeTokens(const std::vector<SyntaxToken>& tks,
+                     std::unordered_map<const SyntaxLexeme*, std::uint32_t>& lexemeIdx);
+    void writeNodes(const SyntaxTree* tree);
+    std::uint32_t nodeRef(const SyntaxNode* node);
+
+    void appendU8(std::uint8_t v);
+    void appendU16(std::uint16_t v);
+    void appendU32(std::uint32_t v);
+    void appendString(const std::string& s);
+};
+
+} // C
+} // psy
+
+#endif
@@ -0,0 +1,313 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "CallGraphTester.h"
+
+#include "TestSuite_API.h"
+
+#include "C/syntax/SyntaxNodes.h"
+
+#include <sstream>
+
+using namespace psy;
+using namespace C;
+
+const std::string CallGraphTester::Name = "CALL GRAPH";
+
+APITestSuite* CallGraphTester::suite()
+{
+    return static_cast<APITestSuite*>(suite_);
+}
+
+void CallGraphTester::setUp()
+{
+}
+
+void CallGraphTester::tearDown()
+{
+    compilation_.reset(nullptr);
+    trees_.clear();
+}
+
+std::unique_ptr<CallGraph> CallGraphTester::build(const std::vector<std::string>& ss)
+{
+    compilation_ = Compilation::create("<test>");
+    for (auto i = 0U; i < ss.size(); ++i) {
+        trees_.push_back(SyntaxTree::parseText(SourceText(ss[i]),
+                                               TextPreprocessingState::Preprocessed,
+                                               TextCompleteness::Fragment,
+                                               ParseOptions(),
+                                               "<test" + std::to_string(i) + ">"));
+        compilation_->addSyntaxTree(trees_.back().get());
+    }
+
+    auto G = CallGraph::build(compilation_.get());
+    PSY_EXPECT_TRUE(G);
+
+    return G;
+}
+
+std::string CallGraphTester::describe(const CallGraph* G)
+{
+    std::ostringstream oss;
+    oss << *G;
+    return oss.str();
+}
+
+void CallGraphTester::check(const std::vector<std::string>& ss, const std::string& expected)
+{
+    auto G = build(ss);
+    PSY_EXPECT_EQ_STR(describe(G.get()), expected);
+}
+
+void CallGraphTester::testCallGraph()
+{
+    return run<CallGraphTester>(tests_);
+}
+
+void CallGraphTester::case0000()
+{
+    check({ "void f ( ) { }" },
+          "0 f\n");
+}
+
+void CallGraphTester::case0001()
+{
+    check({ "void g ( ) { } void f ( ) { g ( ) ; }" },
+          "0 g\n"
+          "1 f -> 0\n");
+}
+
+void CallGraphTester::case0002()
+{
+    check({ "void f ( ) { g ( ) ; } void g ( ) { }" },
+          "0 f -> 1\n"
+          "1 g\n");
+}
+
+void CallGraphTester::case0003()
+{
+    auto G = build({ "void f ( ) { g ( ) ; h ( ) ; g ( ) ; }" });
+    PSY_EXPECT_EQ_STR(describe(G.get()),
+                      "0 f -> 1 2\n"
+                      "1 g (undefined)\n"
+                      "2 h (undefined)\n");
+    PSY_EXPECT_EQ_INT(G->definedFunctionCount(), 1);
+
+    auto callSites = G->callSites(0);
+    PSY_EXPECT_EQ_INT(callSites.size(), 3);
+    PSY_EXPECT_EQ_INT(callSites[0].callee, 1);
+    PSY_EXPECT_EQ_INT(callSites[1].callee, 2);
+    PSY_EXPECT_EQ_INT(callSites[2].callee, 1);
+    PSY_EXPECT_TRUE(callSites[0].expr->firstToken().span().start()
+                        < callSites[1].expr->firstToken().span().start());
+    PSY_EXPECT_FALSE(G->functionDefinition(1));
+    PSY_EXPECT_FALSE(G->syntaxTree(1));
+}
+
+void CallGraphTester::case0004()
+{
+    auto G = build({ "int f ( int ( * cb ) ( int ) ) { return cb ( 1 ) ; }" });
+    PSY_EXPECT_EQ_STR(describe(G.get()),
+                      "0 f -> (indirect)\n");
+    PSY_EXPECT_TRUE(G->hasIndirectCalls(0));
+    PSY_EXPECT_EQ_INT(G->callSites(0).size(), 1);
+    PSY_EXPECT_EQ_INT(G->callSites(0)[0].callee, CallGraph::noFunction());
+}
+
+void CallGraphTester::case0005()
+{
+    check({ "int g ( int p ) { return p ; }"
+            "int f ( ) { int ( * fp ) ( int ) = g ; return fp ( 1 ) ; }" },
+          "0 g\n"
+          "1 f -> (indirect)\n");
+}
+
+void CallGraphTester::case0006()
+{
+    check({ "int g ( int p ) { return p ; }"
+            "int f ( ) { { int g ; } return g ( 1 ) ; }" },
+          "0 g\n"
+          "1 f -> 0\n");
+}
+
+void CallGraphTester::case0007()
+{
+    auto G = build({ "void g ( ) { } void f ( ) { ( g ) ( ) ; ( * g ) ( ) ; }" });
+    PSY_EXPECT_EQ_STR(describe(G.get()),
+                      "0 g\n"
+                      "1 f -> 0 (indirect)\n");
+    PSY_EXPECT_EQ_INT(G->callSites(1).size(), 2);
+}
+
+void CallGraphTester::case0008()
+{
+    check({ "struct S { void ( * h ) ( ) ; } ;"
+            "void f ( struct S s ) { s . h ( ) ; }" },
+          "0 f -> (indirect)\n");
+}
+
+void CallGraphTester::case0009()
+{
+    auto G = build({ "int g ( int p ) { return p ; }"
+                     "int f ( int p ) { return g ( g ( p ) ) ; }" });
+    PSY_EXPECT_EQ_STR(describe(G.get()),
+                      "0 g\n"
+                      "1 f -> 0\n");
+    PSY_EXPECT_EQ_INT(G->callSites(1).size(), 2);
+    PSY_EXPECT_EQ_INT(G->callees(1).size(), 1);
+}
+
+void CallGraphTester::case0010()
+{
+    auto G = build({ "static void h ( ) { } void f ( ) { h ( ) ; }",
+                     "static void h ( ) { } void g ( ) { h ( ) ; f ( ) ; }" });
+    PSY_EXPECT_EQ_STR(describe(G.get()),
+                      "0 h\n"
+                      "1 f -> 0\n"
+                      "2 h\n"
+                      "3 g -> 1 2\n");
+    PSY_EXPECT_EQ_PTR(G->syntaxTree(0), trees_[0].get());
+    PSY_EXPECT_EQ_PTR(G->syntaxTree(2), trees_[1].get());
+    PSY_EXPECT_EQ_INT(G->indexOf("f"), 1);
+    PSY_EXPECT_EQ_INT(G->indexOf("h"), CallGraph::noFunction());
+}
+
+void CallGraphTester::case0011()
+{
+    auto G = build({ "void g ( ) { } void f ( ) { g ( ) ; } void e ( ) { g ( ) ; f ( ) ; }" });
+
+    auto callers = G->callers(0);
+    PSY_EXPECT_EQ_INT(callers.size(), 2);
+    PSY_EXPECT_EQ_INT(callers[0], 1);
+    PSY_EXPECT_EQ_INT(callers[1], 2);
+    PSY_EXPECT_EQ_INT(G->callers(1).size(), 1);
+    PSY_EXPECT_EQ_INT(G->callers(1)[0], 2);
+    PSY_EXPECT_TRUE(G->callers(2).empty());
+
+    auto TU = trees_[0]->translationUnitRoot();
+    auto funcDef = TU->declarations()->next->next->value->asFunctionDefinition();
+    PSY_EXPECT_TRUE(funcDef);
+    PSY_EXPECT_EQ_INT(G->indexOf(funcDef), 2);
+    PSY_EXPECT_EQ_PTR(G->functionDefinition(2), funcDef);
+    PSY_EXPECT_EQ_INT(G->indexOf("g"), 0);
+    PSY_EXPECT_EQ_INT(G->indexOf("x"), CallGraph::noFunction());
+}
+
+void CallGraphTester::case0012()
+{
+    auto G = build({ "int g ( ) { return 1 ; }"
+                     "void f ( ) { int x = g ( ) ; if ( g ( ) ) x = 2 ; while ( g ( ) ) { } }" });
+    PSY_EXPECT_EQ_STR(describe(G.get()),
+                      "0 g\n"
+                      "1 f -> 0\n");
+    PSY_EXPECT_EQ_INT(G->callSites(1).size(), 3);
+}
+
+void CallGraphTester::case0013()
+{
+    check({ "int g ( ) { return 1 ; }"
+            "void f ( ) { int a ; g ( ) ; int ( * g ) ( ) ; g ( ) ; }" },
+          "0 g\n"
+          "1 f -> 0 (indirect)\n");
+}
+
+void CallGraphTester::case0014()
+{
+    check({ "int g ( ) { return 1 ; }"
+            "void f ( ) { for ( int g = 0 ; ; ) ; g ( ) ; }" },
+          "0 g\n"
+          "1 f -> 0\n");
+}
+
+void CallGraphTester::case0015()
+{
+    check({ "void f ( ) { g ( ) ; } int ( * g ) ( ) ;" },
+          "0 f -> 1\n"
+          "1 g (undefined)\n");
+}
+
+void CallGraphTester::case0050()
+{
+    auto G = build({ "void h ( ) { } void g ( ) { h ( ) ; } void f ( ) { g ( ) ; h ( ) ; }" });
+    PSY_EXPECT_EQ_INT(G->componentCount(), 3);
+    PSY_EXPECT_TRUE(G->componentOf(0) < G->componentOf(1));
+    PSY_EXPECT_TRUE(G->componentOf(1) < G->componentOf(2));
+    for (CallGraph::FunctionIndex func = 0; func < G->functionCount(); ++func) {
+        PSY_EXPECT_FALSE(G->isRecursive(func));
+        PSY_EXPECT_EQ_INT(G->componentMembers(G->componentOf(func)).size(), 1);
+        PSY_EXPECT_EQ_INT(G->componentMembers(G->componentOf(func))[0], func);
+    }
+}
+
+void CallGraphTester::case0051()
+{
+    auto G = build({ "int f ( int p ) { return f ( p ) ; }" });
+    PSY_EXPECT_EQ_INT(G->componentCount(), 1);
+    PSY_EXPECT_TRUE(G->isRecursive(0));
+}
+
+void CallGraphTester::case0052()
+{
+    auto G = build({ "int g ( int p ) ;"
+                     "int f ( int p ) { return g ( p ) ; }"
+                     "int g ( int p ) { return f ( p ) ; }"
+                     "int h ( ) { return f ( 1 ) ; }" });
+    PSY_EXPECT_EQ_STR(describe(G.get()),
+                      "0 f -> 1\n"
+                      "1 g -> 0\n"
+                      "2 h -> 0\n");
+    PSY_EXPECT_EQ_INT(G->componentCount(), 2);
+    PSY_EXPECT_EQ_INT(G->componentOf(0), G->componentOf(1));
+    PSY_EXPECT_TRUE(G->componentOf(0) < G->componentOf(2));
+    PSY_EXPECT_TRUE(G->isRecursive(0));
+    PSY_EXPECT_TRUE(G->isRecursive(1));
+    PSY_EXPECT_FALSE(G->isRecursive(2));
+
+    auto members = G->componentMembers(G->componentOf(0));
+    PSY_EXPECT_EQ_INT(members.size(), 2);
+    PSY_EXPECT_EQ_INT(members[0], 0);
+    PSY_EXPECT_EQ_INT(members[1], 1);
+}
+
+void CallGraphTester::case0053()
+{
+    // A long chain of calls, closed into a ring by the last function.
+    const auto kCnt = 5000;
+    std::string s;
+    for (auto i = 0; i < kCnt; ++i) {
+        s += "void f" + std::to_string(i) + " ( ) { ";
+        s += "f" + std::to_string((i + 1) % kCnt) + " ( ) ; }";
+    }
+
+    auto G = build({ s });
+    PSY_EXPECT_EQ_INT(G->functionCount(), kCnt);
+    PSY_EXPECT_EQ_INT(G->componentCount(), 1);
+    PSY_EXPECT_EQ_INT(G->componentMembers(0).size(), kCnt);
+    PSY_EXPECT_TRUE(G->isRecursive(kCnt - 1));
+
+    s.resize(s.rfind("f0"));
+    s += "}";
+    G = build({ s });
+    PSY_EXPECT_EQ_INT(G->componentCount(), kCnt);
+    PSY_EXPECT_EQ_INT(G->componentOf(kCnt - 1), 0);
+    PSY_EXPECT_EQ_INT(G->componentOf(0), kCnt - 1);
+    PSY_EXPECT_FALSE(G->isRecursive(0));
+}
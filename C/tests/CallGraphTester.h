@@ -0,0 +1,123 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CALL_GRAPH_TESTER_H__
+#define PSYCHE_C_CALL_GRAPH_TESTER_H__
+
+#include "Fwds.h"
+#include "tests/Tester.h"
+
+#include "C/SyntaxTree.h"
+#include "C/analysis/CallGraph.h"
+#include "C/compilation/Compilation.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define TEST_CALL_GRAPH(Function) TestFunction { &CallGraphTester::Function, #Function }
+
+namespace psy {
+namespace C {
+
+class APITestSuite;
+
+class CallGraphTester final : public Tester
+{
+public:
+    CallGraphTester(TestSuite* suite) : Tester(suite) {}
+
+    APITestSuite* suite();
+
+    static const std::string Name;
+    virtual std::string name() const override { return Name; }
+    virtual void setUp() override;
+    virtual void tearDown() override;
+
+    std::vector<std::unique_ptr<SyntaxTree>> trees_;
+    std::unique_ptr<Compilation> compilation_;
+
+    std::unique_ptr<CallGraph> build(const std::vector<std::string>& ss);
+    static std::string describe(const CallGraph* G);
+    void check(const std::vector<std::string>& ss, const std::string& expected);
+
+    void testCallGraph();
+
+    using TestFunction = std::pair<std::function<void(CallGraphTester*)>, const char*>;
+
+    /*
+        + 0000-0049 -> construction
+        + 0050-0099 -> strongly connected components
+     */
+
+    void case0000();
+    void case0001();
+    void case0002();
+    void case0003();
+    void case0004();
+    void case0005();
+    void case0006();
+    void case0007();
+    void case0008();
+    void case0009();
+    void case0010();
+    void case0011();
+    void case0012();
+    void case0013();
+    void case0014();
+    void case0015();
+
+    void case0050();
+    void case0051();
+    void case0052();
+    void case0053();
+
+    std::vector<TestFunction> tests_
+    {
+        TEST_CALL_GRAPH(case0000),
+        TEST_CALL_GRAPH(case0001),
+        TEST_CALL_GRAPH(case0002),
+        TEST_CALL_GRAPH(case0003),
+        TEST_CALL_GRAPH(case0004),
+        TEST_CALL_GRAPH(case0005),
+        TEST_CALL_GRAPH(case0006),
+        TEST_CALL_GRAPH(case0007),
+        TEST_CALL_GRAPH(case0008),
+        TEST_CALL_GRAPH(case0009),
+        TEST_CALL_GRAPH(case0010),
+        TEST_CALL_GRAPH(case0011),
+        TEST_CALL_GRAPH(case0012),
+        TEST_CALL_GRAPH(case0013),
+        TEST_CALL_GRAPH(case0014),
+        TEST_CALL_GRAPH(case0015),
+
+        TEST_CALL_GRAPH(case0050),
+        TEST_CALL_GRAPH(case0051),
+        TEST_CALL_GRAPH(case0052),
+        TEST_CALL_GRAPH(case0053),
+    };
+};
+
+} // C
+} // psy
+
+#endif
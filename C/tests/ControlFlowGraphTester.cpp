@@ -0,0 +1,925 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ControlFlowGraphTester.h"
+
+#include "TestSuite_API.h"
+
+#include "C/analysis/ControlFlowGraphWriterBinaryFormat.h"
+#include "C/analysis/ControlFlowGraphWriterJSONFormat.h"
+#include "C/analysis/ControlFlowPaths.h"
+
+#include "C/syntax/SyntaxLexeme_ALL.h"
+
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+
+using namespace psy;
+using namespace C;
+
+const std::string ControlFlowGraphTester::Name = "CONTROL-FLOW GRAPH";
+
+APITestSuite* ControlFlowGraphTester::suite()
+{
+    return static_cast<APITestSuite*>(suite_);
+}
+
+void ControlFlowGraphTester::setUp()
+{
+}
+
+void ControlFlowGraphTester::tearDown()
+{
+    tree_.reset(nullptr);
+}
+
+const TranslationUnitSyntax* ControlFlowGraphTester::parse(const std::string& s)
+{
+    tree_ = SyntaxTree::parseText(SourceText(s),
+                                  TextPreprocessingState::Preprocessed,
+                                  TextCompleteness::Fragment,
+                                  ParseOptions(),
+                                  "<test>");
+
+    auto TU = tree_->translationUnitRoot();
+    PSY_EXPECT_TRUE(TU);
+
+    return TU;
+}
+
+std::unique_ptr<ControlFlowGraph> ControlFlowGraphTester::buildCFG(const std::string& s)
+{
+    auto TU = parse(s);
+    PSY_EXPECT_TRUE(TU->declarations());
+
+    auto funcDef = TU->declarations()->value->asFunctionDefinition();
+    PSY_EXPECT_TRUE(funcDef);
+
+    auto cfg = ControlFlowGraph::build(funcDef);
+    PSY_EXPECT_TRUE(cfg);
+
+    return cfg;
+}
+
+std::string ControlFlowGraphTester::edgesOf(const ControlFlowGraph* cfg)
+{
+    std::ostringstream oss;
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg->blockCount(); ++blk) {
+        for (const auto& edge : cfg->successors(blk)) {
+            if (oss.tellp())
+                oss << ' ';
+            oss << edge.source << '>' << edge.target;
+            if (edge.kind != ControlFlowEdgeKind::Sequential)
+                oss << ':' << to_string(edge.kind);
+        }
+    }
+    return oss.str();
+}
+
+std::string ControlFlowGraphTester::pathsOf(const ControlFlowPaths* paths)
+{
+    std::ostringstream oss;
+    for (ControlFlowPaths::PathIndex path = 0; path < paths->pathCount(); ++path) {
+        if (path)
+            oss << " | ";
+        auto blks = paths->blocks(path);
+        PSY_EXPECT_EQ_INT(blks.size(), paths->length(path));
+        for (auto i = 0U; i < blks.size(); ++i)
+            oss << (i ? " " : "") << blks[i];
+        if (!paths->isComplete(path))
+            oss << " ...";
+    }
+    return oss.str();
+}
+
+void ControlFlowGraphTester::checkPaths(const std::string& s,
+                                        const PathEnumerationOptions& opts,
+                                        const std::string& expected)
+{
+    auto cfg = buildCFG(s);
+    auto paths = ControlFlowPaths::enumerate(cfg.get(), opts);
+    PSY_EXPECT_EQ_STR(pathsOf(paths.get()), expected);
+}
+
+void ControlFlowGraphTester::checkEdges(const std::string& s, const std::string& expected)
+{
+    auto cfg = buildCFG(s);
+    PSY_EXPECT_EQ_STR(edgesOf(cfg.get()), expected);
+
+    auto predCnt = 0U;
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg->blockCount(); ++blk) {
+        for (const auto& edge : cfg->predecessors(blk)) {
+            PSY_EXPECT_EQ_INT(edge.target, blk);
+            ++predCnt;
+        }
+    }
+    PSY_EXPECT_EQ_INT(predCnt, cfg->edgeCount());
+}
+
+std::string ControlFlowGraphTester::idomsOf(const DominatorTree* domTree)
+{
+    std::ostringstream oss;
+    auto cfg = domTree->controlFlowGraph();
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg->blockCount(); ++blk) {
+        if (blk == domTree->root())
+            continue;
+        if (oss.tellp())
+            oss << ' ';
+        oss << blk << '>';
+        if (domTree->contains(blk))
+            oss << domTree->immediateDominator(blk);
+        else
+            oss << '-';
+    }
+    return oss.str();
+}
+
+std::string ControlFlowGraphTester::loopsOf(const NaturalLoops* loops)
+{
+    std::ostringstream oss;
+    for (NaturalLoops::LoopIndex loop = 0; loop < loops->loopCount(); ++loop) {
+        if (loop)
+            oss << " | ";
+        oss << loops->header(loop) << ':';
+        for (auto blk : loops->blocks(loop))
+            oss << ' ' << blk;
+        if (loops->parent(loop) != NaturalLoops::noLoop())
+            oss << " <" << loops->parent(loop);
+    }
+    return oss.str();
+}
+
+void ControlFlowGraphTester::checkDominance(const std::string& s,
+                                            const std::string& expectedIdoms,
+                                            const std::string& expectedPostIdoms,
+                                            const std::string& expectedLoops)
+{
+    auto cfg = buildCFG(s);
+    auto domTree = DominatorTree::computeDominators(cfg.get());
+    PSY_EXPECT_EQ_STR(idomsOf(domTree.get()), expectedIdoms);
+
+    auto postDomTree = DominatorTree::computePostDominators(cfg.get());
+    PSY_EXPECT_TRUE(postDomTree->isPostDominatorTree());
+    PSY_EXPECT_EQ_STR(idomsOf(postDomTree.get()), expectedPostIdoms);
+
+    auto loops = NaturalLoops::compute(domTree.get());
+    PSY_EXPECT_TRUE(loops);
+    PSY_EXPECT_EQ_STR(loopsOf(loops.get()), expectedLoops);
+}
+
+void ControlFlowGraphTester::testControlFlowGraph()
+{
+    return run<ControlFlowGraphTester>(tests_);
+}
+
+void ControlFlowGraphTester::case0000()
+{
+    checkEdges("void f ( ) { }",
+               "0>1");
+}
+
+void ControlFlowGraphTester::case0001()
+{
+    auto s = "void f ( ) { x = 1 ; y = 2 ; }";
+    checkEdges(s, "0>1");
+
+    auto cfg = buildCFG(s);
+    PSY_EXPECT_EQ_INT(cfg->blockCount(), 2);
+    PSY_EXPECT_EQ_INT(cfg->elements(cfg->entryBlock()).size(), 2);
+    PSY_EXPECT_EQ_INT(cfg->elements(cfg->exitBlock()).size(), 0);
+}
+
+void ControlFlowGraphTester::case0002()
+{
+    checkEdges("void f ( int p ) { if ( p ) p = 1 ; p = 2 ; }",
+               "0>2:True 0>3:False 2>3 3>1");
+}
+
+void ControlFlowGraphTester::case0003()
+{
+    checkEdges("void f ( int p ) { if ( p ) p = 1 ; else p = 2 ; }",
+               "0>2:True 0>3:False 2>4 3>4 4>1");
+}
+
+void ControlFlowGraphTester::case0004()
+{
+    checkEdges("int f ( int p ) { if ( p ) return 1 ; else return 2 ; }",
+               "0>2:True 0>3:False 2>1:Return 3>1:Return");
+}
+
+void ControlFlowGraphTester::case0005()
+{
+    checkEdges("int f ( int p ) { while ( p ) p -- ; return p ; }",
+               "0>2 2>3:True 2>4:False 3>2:Back 4>1:Return");
+}
+
+void ControlFlowGraphTester::case0006()
+{
+    checkEdges("int f ( int p ) { do p -- ; while ( p ) ; return p ; }",
+               "0>2 2>3 3>2:True 3>4:False 4>1:Return");
+}
+
+void ControlFlowGraphTester::case0007()
+{
+    auto s = "int f ( int p ) { int x ; for ( int i = 0 ; i < 10 ; i ++ ) p ++ ; return p ; }";
+    checkEdges(s, "0>2 2>3:True 2>5:False 3>4 4>2:Back 5>1:Return");
+
+    auto cfg = buildCFG(s);
+    PSY_EXPECT_EQ_INT(cfg->elements(0).size(), 2);
+    PSY_EXPECT_EQ_ENU(cfg->elements(0)[1].node->kind(), DeclarationStatement, SyntaxKind);
+    PSY_EXPECT_EQ_ENU(cfg->terminator(2)->kind(), ForStatement, SyntaxKind);
+    PSY_EXPECT_EQ_INT(cfg->elements(4).size(), 1);
+    PSY_EXPECT_EQ_ENU(cfg->elements(4)[0].node->kind(), PostIncrementExpression, SyntaxKind);
+}
+
+void ControlFlowGraphTester::case0008()
+{
+    checkEdges("int f ( int p ) { for ( ; ; ) { if ( p ) break ; p ++ ; } return p ; }",
+               "0>2 2>3 3>4:True 3>6:False 4>5:Break 5>1:Return 6>2:Back");
+}
+
+void ControlFlowGraphTester::case0009()
+{
+    auto s = "int f ( int p ) { for ( ; ; ) p ++ ; return p ; }";
+    checkEdges(s, "0>2 2>3 3>2:Back 4>1:Return");
+
+    auto cfg = buildCFG(s);
+    PSY_EXPECT_TRUE(cfg->predecessors(4).empty());
+    PSY_EXPECT_EQ_INT(cfg->predecessors(cfg->exitBlock()).size(), 1);
+}
+
+void ControlFlowGraphTester::case0010()
+{
+    auto s = "int f ( int p ) {"
+             "  switch ( p ) {"
+             "    case 1 : p = 2 ;"
+             "    case 2 : p = 3 ; break ;"
+             "    default : p = 4 ;"
+             "  }"
+             "  return p ;"
+             "}";
+    checkEdges(s, "0>2:Case 0>3:Case 0>5:Default 2>3 3>4:Break 4>1:Return 5>4");
+
+    auto cfg = buildCFG(s);
+    PSY_EXPECT_EQ_ENU(cfg->terminator(0)->kind(), SwitchStatement, SyntaxKind);
+    PSY_EXPECT_EQ_ENU(cfg->label(2)->kind(), CaseLabelStatement, SyntaxKind);
+    PSY_EXPECT_EQ_ENU(cfg->label(5)->kind(), DefaultLabelStatement, SyntaxKind);
+    PSY_EXPECT_TRUE(!cfg->label(4));
+}
+
+void ControlFlowGraphTester::case0011()
+{
+    checkEdges("int f ( int p ) { switch ( p ) { case 1 : p = 2 ; } return p ; }",
+               "0>2:Case 0>3:Default 2>3 3>1:Return");
+}
+
+void ControlFlowGraphTester::case0012()
+{
+    auto s = "int f ( int p ) { l : p -- ; if ( p ) goto l ; return p ; }";
+    checkEdges(s, "0>2 2>3:True 2>4:False 3>2:Goto 4>1:Return");
+
+    auto cfg = buildCFG(s);
+    PSY_EXPECT_EQ_ENU(cfg->label(2)->kind(), IdentifierLabelStatement, SyntaxKind);
+    PSY_EXPECT_EQ_ENU(cfg->terminator(3)->kind(), GotoStatement, SyntaxKind);
+}
+
+void ControlFlowGraphTester::case0013()
+{
+    checkEdges("int f ( int p ) { if ( p ) goto out ; p = 1 ; out : return p ; }",
+               "0>2:True 0>4:False 2>3:Goto 3>1:Return 4>3");
+}
+
+void ControlFlowGraphTester::case0014()
+{
+    checkEdges("void f ( int p , int q ) {"
+               "  while ( p ) {"
+               "    while ( q ) {"
+               "      if ( q == 2 ) continue ;"
+               "      if ( q == 3 ) break ;"
+               "      q -- ;"
+               "    }"
+               "    p -- ;"
+               "  }"
+               "}",
+               "0>2 2>3:True 2>11:False 3>4 4>5:True 4>9:False 5>6:True 5>7:False 6>4:Continue "
+               "7>8:True 7>10:False 8>9:Break 9>2:Back 10>4:Back 11>1");
+}
+
+void ControlFlowGraphTester::case0015()
+{
+    checkEdges("void f ( int p ) { do { if ( p ) continue ; p ++ ; } while ( p < 10 ) ; }",
+               "0>2 2>4:True 2>5:False 3>2:True 3>6:False 4>3:Continue 5>3 6>1");
+}
+
+void ControlFlowGraphTester::case0016()
+{
+    auto s = "void f ( ) { x = 1 ; }";
+    auto cfg = buildCFG(s);
+
+    auto elems = cfg->elements(cfg->entryBlock());
+    PSY_EXPECT_EQ_INT(elems.size(), 1);
+    PSY_EXPECT_EQ_ENU(elems[0].node->kind(), ExpressionStatement, SyntaxKind);
+    PSY_EXPECT_EQ_STR(std::string(s).substr(elems[0].span.start(),
+                                            elems[0].span.end() - elems[0].span.start()),
+                      "x = 1 ;");
+}
+
+void ControlFlowGraphTester::case0017()
+{
+    auto cfg = buildCFG("void f ( int p ) { if ( p ) p = 1 ; else p = 2 ; }");
+
+    auto preds = cfg->predecessors(4);
+    PSY_EXPECT_EQ_INT(preds.size(), 2);
+    PSY_EXPECT_EQ_INT(preds[0].source, 2);
+    PSY_EXPECT_EQ_INT(preds[1].source, 3);
+    PSY_EXPECT_EQ_ENU(cfg->elements(0)[0].node->kind(), IdentifierName, SyntaxKind);
+}
+
+void ControlFlowGraphTester::case0018()
+{
+    checkEdges("void f ( int p ) { switch ( p ) { p = 0 ; case 1 : p = 1 ; } }",
+               "0>3:Case 0>4:Default 2>3 3>4 4>1");
+}
+
+void ControlFlowGraphTester::case0019()
+{
+    auto s = "int f ( void ) { return 0 ; }";
+    checkEdges(s, "0>1:Return");
+
+    auto cfg = buildCFG(s);
+    PSY_EXPECT_EQ_INT(cfg->blockCount(), 2);
+    PSY_EXPECT_EQ_ENU(cfg->terminator(0)->kind(), ReturnStatement, SyntaxKind);
+}
+
+void ControlFlowGraphTester::case0100()
+{
+    auto TU = parse("int x ;"
+                    "void f ( ) { }"
+                    "int g ( int p ) ;"
+                    "int g ( int p ) { if ( p ) return 1 ; return 0 ; }"
+                    "struct s { int y ; } ;"
+                    "void h ( int p ) { while ( p ) p -- ; }");
+
+    auto cfgs = ControlFlowGraph::buildAll(TU);
+    PSY_EXPECT_EQ_INT(cfgs.size(), 3);
+    PSY_EXPECT_EQ_PTR(cfgs[0]->functionDefinition(),
+                      TU->declarations()->next->value->asFunctionDefinition());
+    PSY_EXPECT_EQ_STR(edgesOf(cfgs[0].get()), "0>1");
+    PSY_EXPECT_EQ_STR(edgesOf(cfgs[1].get()), "0>2:True 0>3:False 2>1:Return 3>1:Return");
+    PSY_EXPECT_EQ_STR(edgesOf(cfgs[2].get()), "0>2 2>3:True 2>4:False 3>2:Back 4>1");
+}
+
+void ControlFlowGraphTester::case0101()
+{
+    auto TU = parse("void f ( ) { }"
+                    "void g ( ) { }");
+
+    auto taskCnt = 0U;
+    auto cfgs = ControlFlowGraph::buildAll(
+                TU,
+                [&taskCnt] (const std::vector<std::function<void ()>>& tasks) {
+                    for (const auto& task : tasks) {
+                        task();
+                        ++taskCnt;
+                    }
+                });
+    PSY_EXPECT_EQ_INT(taskCnt, 2);
+    PSY_EXPECT_EQ_INT(cfgs.size(), 2);
+    PSY_EXPECT_TRUE(cfgs[0]);
+    PSY_EXPECT_TRUE(cfgs[1]);
+}
+
+void ControlFlowGraphTester::case0102()
+{
+    auto TU = parse("int x ; int f ( int p ) ;");
+
+    auto cfgs = ControlFlowGraph::buildAll(TU);
+    PSY_EXPECT_TRUE(cfgs.empty());
+}
+
+void ControlFlowGraphTester::case0103()
+{
+    std::string s;
+    for (auto i = 0; i < 200; ++i) {
+        s += "int f" + std::to_string(i) + " ( int p ) {"
+             "  switch ( p ) { case 1 : p ++ ; break ; default : p -- ; }"
+             "  for ( int i = 0 ; i < " + std::to_string(i) + " ; i ++ ) {"
+             "    if ( i == p ) continue ;"
+             "    do { p -- ; } while ( p ) ;"
+             "  }"
+             "  return p ;"
+             "}";
+    }
+    auto TU = parse(s);
+
+    auto cfgs = ControlFlowGraph::buildAll(TU);
+    PSY_EXPECT_EQ_INT(cfgs.size(), 200);
+
+    auto declIt = TU->declarations();
+    for (const auto& cfg : cfgs) {
+        PSY_EXPECT_EQ_PTR(cfg->functionDefinition(), declIt->value->asFunctionDefinition());
+        auto cfg_S = ControlFlowGraph::build(declIt->value->asFunctionDefinition());
+        PSY_EXPECT_EQ_STR(edgesOf(cfg.get()), edgesOf(cfg_S.get()));
+        declIt = declIt->next;
+    }
+}
+
+void ControlFlowGraphTester::case0150()
+{
+    checkPaths("void f ( ) { x = 1 ; }",
+               PathEnumerationOptions(),
+               "0 1");
+}
+
+void ControlFlowGraphTester::case0151()
+{
+    auto s = "void f ( int p ) { if ( p ) p = 1 ; else p = 2 ; }";
+    checkPaths(s, PathEnumerationOptions(), "0 2 4 1 | 0 3 4 1");
+
+    auto cfg = buildCFG(s);
+    auto paths = ControlFlowPaths::enumerate(cfg.get());
+    PSY_EXPECT_TRUE(paths->isExhaustive());
+    PSY_EXPECT_EQ_INT(paths->stepCount(), 7);
+    auto step = paths->lastStep(1);
+    PSY_EXPECT_EQ_ENU(paths->edgeKind(step), ControlFlowEdgeKind::Sequential, ControlFlowEdgeKind);
+    step = paths->previousStep(paths->previousStep(step));
+    PSY_EXPECT_EQ_INT(paths->block(step), 3);
+    PSY_EXPECT_EQ_ENU(paths->edgeKind(step), ControlFlowEdgeKind::False, ControlFlowEdgeKind);
+    step = paths->previousStep(step);
+    PSY_EXPECT_EQ_INT(step, 0);
+    PSY_EXPECT_EQ_INT(paths->previousStep(step), ControlFlowPaths::noStep());
+}
+
+void ControlFlowGraphTester::case0152()
+{
+    checkPaths("int f ( int p ) { while ( p ) p -- ; return p ; }",
+               PathEnumerationOptions().setLoopUnrollBound(0),
+               "0 2 4 1");
+}
+
+void ControlFlowGraphTester::case0153()
+{
+    checkPaths("int f ( int p ) { while ( p ) p -- ; return p ; }",
+               PathEnumerationOptions().setLoopUnrollBound(1),
+               "0 2 3 2 4 1 | 0 2 4 1");
+}
+
+void ControlFlowGraphTester::case0154()
+{
+    checkPaths("int f ( int p ) { while ( p ) p -- ; return p ; }",
+               PathEnumerationOptions().setLoopUnrollBound(2),
+               "0 2 3 2 3 2 4 1 | 0 2 3 2 4 1 | 0 2 4 1");
+}
+
+void ControlFlowGraphTester::case0155()
+{
+    checkPaths("int f ( int p ) { l : p -- ; if ( p ) goto l ; return p ; }",
+               PathEnumerationOptions().setLoopUnrollBound(1),
+               "0 2 3 2 4 1 | 0 2 4 1");
+}
+
+void ControlFlowGraphTester::case0156()
+{
+    auto s = "void f ( int p ) {"
+             "  if ( p == 1 ) p ++ ;"
+             "  if ( p == 2 ) p ++ ;"
+             "  if ( p == 3 ) p ++ ;"
+             "}";
+    auto cfg = buildCFG(s);
+
+    auto paths = ControlFlowPaths::enumerate(cfg.get());
+    PSY_EXPECT_EQ_INT(paths->pathCount(), 8);
+    PSY_EXPECT_TRUE(paths->isExhaustive());
+
+    paths = ControlFlowPaths::enumerate(cfg.get(), PathEnumerationOptions().setMaxPathCount(5));
+    PSY_EXPECT_EQ_INT(paths->pathCount(), 5);
+    PSY_EXPECT_FALSE(paths->isExhaustive());
+    PSY_EXPECT_EQ_INT(paths->lastStep(4) + 1, paths->stepCount());
+}
+
+void ControlFlowGraphTester::case0157()
+{
+    checkPaths("int f ( int p ) { while ( p ) p -- ; return p ; }",
+               PathEnumerationOptions().setLoopUnrollBound(5).setMaxPathLength(4),
+               "0 2 3 2 ... | 0 2 4 1");
+}
+
+void ControlFlowGraphTester::case0158()
+{
+    checkPaths("void f ( int p ) { for ( ; ; ) p ++ ; }",
+               PathEnumerationOptions().setLoopUnrollBound(3),
+               "");
+
+    auto cfg = buildCFG("void f ( int p ) { for ( ; ; ) p ++ ; }");
+    auto paths = ControlFlowPaths::enumerate(cfg.get());
+    PSY_EXPECT_TRUE(paths->isExhaustive());
+    PSY_EXPECT_EQ_INT(paths->stepCount(), 0);
+}
+
+void ControlFlowGraphTester::case0159()
+{
+    std::string s = "void f ( int p ) {";
+    for (auto i = 0; i < 10; ++i)
+        s += " if ( p == " + std::to_string(i) + " ) p ++ ;";
+    s += " }";
+    auto cfg = buildCFG(s);
+
+    auto paths = ControlFlowPaths::enumerate(cfg.get());
+    PSY_EXPECT_EQ_INT(paths->pathCount(), 1024);
+
+    std::size_t totalLen = 0;
+    for (ControlFlowPaths::PathIndex path = 0; path < paths->pathCount(); ++path)
+        totalLen += paths->length(path);
+    PSY_EXPECT_TRUE(paths->stepCount() * 4 < totalLen);
+}
+
+namespace {
+
+std::uint32_t readU32(const std::string& s, std::size_t pos)
+{
+    std::uint32_t v = 0;
+    for (auto i = 0; i < 4; ++i)
+        v |= static_cast<std::uint32_t>(static_cast<unsigned char>(s[pos + i])) << (8 * i);
+    return v;
+}
+
+std::uint16_t readU16(const std::string& s, std::size_t pos)
+{
+    return static_cast<unsigned char>(s[pos])
+            | (static_cast<unsigned char>(s[pos + 1]) << 8);
+}
+
+} // anonymous
+
+void ControlFlowGraphTester::case0200()
+{
+    auto cfg = buildCFG("int f ( int p ) { if ( p ) return g ( p ) ; return 0 ; }");
+
+    std::ostringstream oss;
+    {
+        ControlFlowGraphWriterJSONFormat writer(oss);
+        writer.write(*cfg);
+        PSY_EXPECT_FALSE(writer.hasError());
+    }
+
+    PSY_EXPECT_EQ_STR(oss.str(),
+R"({"type":"function","name":"f","file":"<test>","span":[0,56],"blocks":4,"edges":4}
+{"type":"block","id":0,"label":null,"terminator":"IfStatement","elements":[{"kind":"IdentifierName","span":[23,24],"call":false}]}
+{"type":"block","id":1,"label":null,"terminator":null,"elements":[]}
+{"type":"block","id":2,"label":null,"terminator":"ReturnStatement","elements":[{"kind":"ReturnStatement","span":[27,43],"call":true}]}
+{"type":"block","id":3,"label":null,"terminator":"ReturnStatement","elements":[{"kind":"ReturnStatement","span":[44,54],"call":false}]}
+{"type":"edge","source":0,"target":2,"kind":"True"}
+{"type":"edge","source":0,"target":3,"kind":"False"}
+{"type":"edge","source":2,"target":1,"kind":"Return"}
+{"type":"edge","source":3,"target":1,"kind":"Return"}
+)");
+}
+
+void ControlFlowGraphTester::case0201()
+{
+    auto TU = parse("void f ( ) { }"
+                    "void g ( int p ) { switch ( p ) { case 1 : h ( ) ; } }");
+    auto cfgs = ControlFlowGraph::buildAll(TU);
+
+    std::ostringstream oss;
+    ControlFlowGraphWriterJSONFormat writer(oss);
+    for (const auto& cfg : cfgs)
+        writer.write(*cfg);
+    writer.flush();
+
+    auto out = oss.str();
+    auto lineCnt = 0U;
+    auto funcCnt = 0U;
+    for (std::size_t pos = 0; (pos = out.find('\n', pos)) != std::string::npos; ++pos)
+        ++lineCnt;
+    for (std::size_t pos = 0; (pos = out.find("\"type\":\"function\"", pos)) != std::string::npos; ++pos)
+        ++funcCnt;
+    PSY_EXPECT_EQ_INT(funcCnt, 2);
+    PSY_EXPECT_EQ_INT(lineCnt, (1 + cfgs[0]->blockCount() + cfgs[0]->edgeCount())
+                                    + (1 + cfgs[1]->blockCount() + cfgs[1]->edgeCount()));
+    PSY_EXPECT_TRUE(out.find("\"label\":\"CaseLabelStatement\"") != std::string::npos);
+    PSY_EXPECT_TRUE(out.find("{\"kind\":\"ExpressionStatement\",\"span\":[57,64],\"call\":true}") != std::string::npos);
+}
+
+void ControlFlowGraphTester::case0202()
+{
+    auto cfg = buildCFG("int f ( int p ) { if ( p ) return g ( p ) ; return 0 ; }");
+
+    std::ostringstream oss;
+    {
+        ControlFlowGraphWriterBinaryFormat writer(oss);
+        writer.write(*cfg);
+    }
+    auto out = oss.str();
+
+    PSY_EXPECT_EQ_STR(out.substr(0, 6), "PSYCFG");
+    PSY_EXPECT_EQ_INT(out[6], ControlFlowGraphWriterBinaryFormat::version());
+
+    std::size_t pos = 7;
+    auto recSize = readU32(out, pos);
+    PSY_EXPECT_EQ_INT(out[pos + 4], static_cast<char>(ControlFlowGraphWriterBinaryFormat::RecordKind::Function));
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 5), 1);
+    PSY_EXPECT_EQ_STR(out.substr(pos + 9, 1), "f");
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 10), 6);
+    PSY_EXPECT_EQ_STR(out.substr(pos + 14, 6), "<test>");
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 20), 0);
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 24), 56);
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 28), 4);
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 32), 4);
+    PSY_EXPECT_EQ_INT(recSize, 32);
+    pos += 4 + recSize;
+
+    auto blkCnt = 0U;
+    auto callSiteCnt = 0U;
+    while (out[pos + 4] == static_cast<char>(ControlFlowGraphWriterBinaryFormat::RecordKind::Block)) {
+        recSize = readU32(out, pos);
+        PSY_EXPECT_EQ_INT(readU32(out, pos + 5), blkCnt);
+        auto elemCnt = readU32(out, pos + 13);
+        PSY_EXPECT_EQ_INT(recSize, 13 + elemCnt * 11);
+        for (auto i = 0U; i < elemCnt; ++i) {
+            if (out[pos + 17 + i * 11 + 2] & ControlFlowGraphWriterBinaryFormat::callSiteFlag())
+                ++callSiteCnt;
+        }
+        if (blkCnt == 1) {
+            PSY_EXPECT_EQ_INT(readU16(out, pos + 9), ControlFlowGraphWriterBinaryFormat::noKind());
+        }
+        if (blkCnt == 2) {
+            PSY_EXPECT_EQ_INT(readU16(out, pos + 11), ReturnStatement);
+            PSY_EXPECT_EQ_INT(readU16(out, pos + 17), ReturnStatement);
+        }
+        ++blkCnt;
+        pos += 4 + recSize;
+    }
+    PSY_EXPECT_EQ_INT(blkCnt, 4);
+    PSY_EXPECT_EQ_INT(callSiteCnt, 1);
+
+    recSize = readU32(out, pos);
+    PSY_EXPECT_EQ_INT(out[pos + 4], static_cast<char>(ControlFlowGraphWriterBinaryFormat::RecordKind::Edges));
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 5), 4);
+    PSY_EXPECT_EQ_INT(recSize, 5 + 4 * 9);
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 9), 0);
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 13), 2);
+    PSY_EXPECT_EQ_INT(out[pos + 17], static_cast<char>(ControlFlowEdgeKind::True));
+    pos += 4 + recSize;
+    PSY_EXPECT_EQ_INT(pos, out.size());
+}
+
+void ControlFlowGraphTester::case0203()
+{
+    auto cfg = buildCFG("int f ( int p ) { while ( p ) { if ( p == 5 ) break ; p -- ; } return p ; }");
+
+    std::ostringstream oss;
+    {
+        ControlFlowGraphWriterBinaryFormat writer(oss);
+        writer.write(*cfg);
+        writer.write(*cfg);
+    }
+
+    std::string file;
+    auto f = std::tmpfile();
+    PSY_EXPECT_TRUE(f);
+    {
+        ControlFlowGraphWriterBinaryFormat writer(fileno(f));
+        writer.write(*cfg);
+        writer.write(*cfg);
+        writer.flush();
+        PSY_EXPECT_FALSE(writer.hasError());
+    }
+    std::rewind(f);
+    char buf[4096];
+    std::size_t cnt;
+    while ((cnt = std::fread(buf, 1, sizeof(buf), f)) > 0)
+        file.append(buf, cnt);
+    std::fclose(f);
+
+    PSY_EXPECT_EQ_INT(file.size(), oss.str().size());
+    PSY_EXPECT_TRUE(file == oss.str());
+}
+
+void ControlFlowGraphTester::case0204()
+{
+    std::string s = "void f ( int p ) {";
+    for (auto i = 0; i < 3000; ++i)
+        s += " if ( p == " + std::to_string(i) + " ) p = g ( p ) ;";
+    s += " }";
+    auto cfg = buildCFG(s);
+
+    std::ostringstream oss;
+    {
+        ControlFlowGraphWriterJSONFormat writer(oss);
+        writer.write(*cfg);
+    }
+
+    std::string file;
+    auto f = std::tmpfile();
+    PSY_EXPECT_TRUE(f);
+    {
+        ControlFlowGraphWriterJSONFormat writer(fileno(f));
+        writer.write(*cfg);
+    }
+    std::rewind(f);
+    char buf[4096];
+    std::size_t cnt;
+    while ((cnt = std::fread(buf, 1, sizeof(buf), f)) > 0)
+        file.append(buf, cnt);
+    std::fclose(f);
+
+    PSY_EXPECT_TRUE(oss.str().size() > (1 << 16));
+    PSY_EXPECT_TRUE(file == oss.str());
+}
+
+void ControlFlowGraphTester::case0250()
+{
+    checkDominance("void f ( int p ) { if ( p ) p = 1 ; p = 2 ; }",
+                   "1>3 2>0 3>0",
+                   "0>3 2>3 3>1",
+                   "");
+}
+
+void ControlFlowGraphTester::case0251()
+{
+    auto s = "void f ( int p ) { if ( p ) p = 1 ; else p = 2 ; }";
+    checkDominance(s,
+                   "1>4 2>0 3>0 4>0",
+                   "0>4 2>4 3>4 4>1",
+                   "");
+
+    auto cfg = buildCFG(s);
+    auto domTree = DominatorTree::computeDominators(cfg.get());
+    PSY_EXPECT_EQ_INT(domTree->root(), 0);
+    PSY_EXPECT_EQ_INT(domTree->immediateDominator(0), DominatorTree::noBlock());
+    PSY_EXPECT_TRUE(domTree->dominates(0, 4));
+    PSY_EXPECT_TRUE(domTree->dominates(4, 4));
+    PSY_EXPECT_FALSE(domTree->strictlyDominates(4, 4));
+    PSY_EXPECT_FALSE(domTree->dominates(2, 4));
+    PSY_EXPECT_TRUE(domTree->dominates(4, 1));
+    PSY_EXPECT_EQ_INT(domTree->nearestCommonDominator(2, 3), 0);
+    PSY_EXPECT_EQ_INT(domTree->nearestCommonDominator(1, 4), 4);
+    PSY_EXPECT_EQ_INT(domTree->depth(0), 0);
+    PSY_EXPECT_EQ_INT(domTree->depth(1), 2);
+
+    auto children = domTree->children(0);
+    PSY_EXPECT_EQ_INT(children.size(), 3);
+    PSY_EXPECT_EQ_INT(children[0], 2);
+    PSY_EXPECT_EQ_INT(children[1], 3);
+    PSY_EXPECT_EQ_INT(children[2], 4);
+
+    auto postDomTree = DominatorTree::computePostDominators(cfg.get());
+    PSY_EXPECT_EQ_INT(postDomTree->root(), 1);
+    PSY_EXPECT_TRUE(postDomTree->dominates(4, 2));
+    PSY_EXPECT_FALSE(postDomTree->dominates(2, 0));
+}
+
+void ControlFlowGraphTester::case0252()
+{
+    checkDominance("int f ( int p ) { if ( p ) return 1 ; else return 2 ; }",
+                   "1>0 2>0 3>0",
+                   "0>1 2>1 3>1",
+                   "");
+}
+
+void ControlFlowGraphTester::case0253()
+{
+    auto s = "int f ( int p ) { while ( p ) p -- ; return p ; }";
+    checkDominance(s,
+                   "1>4 2>0 3>2 4>2",
+                   "0>2 2>4 3>2 4>1",
+                   "2: 2 3");
+
+    auto cfg = buildCFG(s);
+    auto domTree = DominatorTree::computeDominators(cfg.get());
+    auto loops = NaturalLoops::compute(domTree.get());
+    PSY_EXPECT_TRUE(loops->isReducible());
+    PSY_EXPECT_EQ_INT(loops->backEdges(0).size(), 1);
+    PSY_EXPECT_EQ_INT(loops->backEdges(0)[0].source, 3);
+    PSY_EXPECT_EQ_ENU(loops->backEdges(0)[0].kind, ControlFlowEdgeKind::Back, ControlFlowEdgeKind);
+    PSY_EXPECT_EQ_INT(loops->depth(0), 1);
+    PSY_EXPECT_EQ_INT(loops->innermostLoopOf(3), 0);
+    PSY_EXPECT_EQ_INT(loops->innermostLoopOf(4), NaturalLoops::noLoop());
+    PSY_EXPECT_EQ_INT(loops->loopDepthOf(3), 1);
+    PSY_EXPECT_EQ_INT(loops->loopDepthOf(4), 0);
+
+    PSY_EXPECT_FALSE(NaturalLoops::compute(DominatorTree::computePostDominators(cfg.get()).get()));
+}
+
+void ControlFlowGraphTester::case0254()
+{
+    auto s = "int f ( int p ) { do p -- ; while ( p ) ; return p ; }";
+    checkDominance(s,
+                   "1>4 2>0 3>2 4>3",
+                   "0>2 2>3 3>4 4>1",
+                   "2: 2 3");
+
+    auto cfg = buildCFG(s);
+    auto loops = NaturalLoops::compute(DominatorTree::computeDominators(cfg.get()).get());
+    PSY_EXPECT_EQ_ENU(loops->backEdges(0)[0].kind, ControlFlowEdgeKind::True, ControlFlowEdgeKind);
+}
+
+void ControlFlowGraphTester::case0255()
+{
+    auto s = "int f ( int p ) { l : p -- ; if ( p ) goto l ; return p ; }";
+    checkDominance(s,
+                   "1>4 2>0 3>2 4>2",
+                   "0>2 2>4 3>2 4>1",
+                   "2: 2 3");
+
+    auto cfg = buildCFG(s);
+    auto loops = NaturalLoops::compute(DominatorTree::computeDominators(cfg.get()).get());
+    PSY_EXPECT_TRUE(loops->isReducible());
+    PSY_EXPECT_EQ_ENU(loops->backEdges(0)[0].kind, ControlFlowEdgeKind::Goto, ControlFlowEdgeKind);
+}
+
+void ControlFlowGraphTester::case0256()
+{
+    auto s = "void f ( int p , int q ) {"
+             "  while ( p ) {"
+             "    while ( q ) {"
+             "      if ( q == 2 ) continue ;"
+             "      if ( q == 3 ) break ;"
+             "      q -- ;"
+             "    }"
+             "    p -- ;"
+             "  }"
+             "}";
+    checkDominance(s,
+                   "1>11 2>0 3>2 4>3 5>4 6>5 7>5 8>7 9>4 10>7 11>2",
+                   "0>2 2>11 3>4 4>9 5>9 6>4 7>9 8>9 9>2 10>4 11>1",
+                   "2: 2 3 4 5 6 7 8 9 10 | 4: 4 5 6 7 10 <0");
+
+    auto cfg = buildCFG(s);
+    auto loops = NaturalLoops::compute(DominatorTree::computeDominators(cfg.get()).get());
+    PSY_EXPECT_EQ_INT(loops->depth(0), 1);
+    PSY_EXPECT_EQ_INT(loops->depth(1), 2);
+    PSY_EXPECT_EQ_INT(loops->backEdges(1).size(), 2);
+    PSY_EXPECT_EQ_INT(loops->innermostLoopOf(8), 0);
+    PSY_EXPECT_EQ_INT(loops->innermostLoopOf(10), 1);
+    PSY_EXPECT_EQ_INT(loops->loopDepthOf(10), 2);
+    PSY_EXPECT_EQ_INT(loops->loopDepthOf(11), 0);
+}
+
+void ControlFlowGraphTester::case0257()
+{
+    auto s = "void f ( int p ) { if ( p ) goto in ; while ( p ) { p -- ; in : p ++ ; } }";
+    auto cfg = buildCFG(s);
+    auto loops = NaturalLoops::compute(DominatorTree::computeDominators(cfg.get()).get());
+    PSY_EXPECT_FALSE(loops->isReducible());
+    PSY_EXPECT_EQ_INT(loops->loopCount(), 0);
+}
+
+void ControlFlowGraphTester::case0258()
+{
+    auto s = "int f ( int p ) { for ( ; ; ) p ++ ; return p ; }";
+    checkDominance(s,
+                   "1>- 2>0 3>2 4>-",
+                   "0>- 2>- 3>- 4>1",
+                   "2: 2 3");
+
+    auto cfg = buildCFG(s);
+    auto domTree = DominatorTree::computeDominators(cfg.get());
+    PSY_EXPECT_FALSE(domTree->contains(4));
+    PSY_EXPECT_FALSE(domTree->dominates(0, 4));
+    PSY_EXPECT_EQ_INT(domTree->nearestCommonDominator(3, 4), DominatorTree::noBlock());
+}
+
+void ControlFlowGraphTester::case0259()
+{
+    std::string s = "void f ( int p ) { while ( p ) {";
+    for (auto i = 0; i < 5000; ++i)
+        s += " if ( p == " + std::to_string(i) + " ) p = " + std::to_string(i) + " ;";
+    s += " } }";
+
+    auto cfg = buildCFG(s);
+    auto domTree = DominatorTree::computeDominators(cfg.get());
+    auto postDomTree = DominatorTree::computePostDominators(cfg.get());
+    auto loops = NaturalLoops::compute(domTree.get());
+    PSY_EXPECT_EQ_INT(loops->loopCount(), 1);
+    PSY_EXPECT_EQ_INT(loops->blocks(0).size(), cfg->blockCount() - 3);
+    PSY_EXPECT_EQ_INT(loops->backEdges(0).size(), 1);
+
+    auto latch = loops->backEdges(0)[0].source;
+    PSY_EXPECT_TRUE(domTree->depth(latch) > 5000);
+    PSY_EXPECT_TRUE(domTree->dominates(loops->header(0), latch));
+    PSY_EXPECT_TRUE(postDomTree->dominates(loops->header(0), latch));
+    for (ControlFlowGraph::BlockIndex blk = 0; blk < cfg->blockCount(); ++blk) {
+        PSY_EXPECT_TRUE(domTree->contains(blk));
+        PSY_EXPECT_TRUE(postDomTree->contains(blk));
+    }
+}
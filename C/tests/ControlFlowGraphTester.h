@@ -0,0 +1,203 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_CONTROL_FLOW_GRAPH_TESTER_H__
+#define PSYCHE_C_CONTROL_FLOW_GRAPH_TESTER_H__
+
+#include "Fwds.h"
+#include "tests/Tester.h"
+
+#include "C/SyntaxTree.h"
+#include "C/analysis/ControlFlowGraph.h"
+#include "C/analysis/DominatorTree.h"
+#include "C/analysis/NaturalLoops.h"
+#include "C/analysis/PathEnumerationOptions.h"
+#include "C/syntax/SyntaxNodes.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define TEST_CONTROL_FLOW_GRAPH(Function) TestFunction { &ControlFlowGraphTester::Function, #Function }
+
+namespace psy {
+namespace C {
+
+class APITestSuite;
+
+class ControlFlowGraphTester final : public Tester
+{
+public:
+    ControlFlowGraphTester(TestSuite* suite) : Tester(suite) {}
+
+    APITestSuite* suite();
+
+    static const std::string Name;
+    virtual std::string name() const override { return Name; }
+    virtual void setUp() override;
+    virtual void tearDown() override;
+
+    std::unique_ptr<SyntaxTree> tree_;
+
+    const TranslationUnitSyntax* parse(const std::string& s);
+    std::unique_ptr<ControlFlowGraph> buildCFG(const std::string& s);
+    static std::string edgesOf(const ControlFlowGraph* cfg);
+    static std::string pathsOf(const ControlFlowPaths* paths);
+    static std::string idomsOf(const DominatorTree* domTree);
+    static std::string loopsOf(const NaturalLoops* loops);
+    void checkEdges(const std::string& s, const std::string& expected);
+    void checkPaths(const std::string& s,
+                    const PathEnumerationOptions& opts,
+                    const std::string& expected);
+    void checkDominance(const std::string& s,
+                        const std::string& expectedIdoms,
+                        const std::string& expectedPostIdoms,
+                        const std::string& expectedLoops);
+
+    void testControlFlowGraph();
+
+    using TestFunction = std::pair<std::function<void(ControlFlowGraphTester*)>, const char*>;
+
+    /*
+        + 0000-0099 -> construction
+        + 0100-0149 -> construction for a translation unit
+        + 0150-0199 -> path enumeration
+        + 0200-0249 -> export
+        + 0250-0299 -> dominance and loops
+     */
+
+    void case0000();
+    void case0001();
+    void case0002();
+    void case0003();
+    void case0004();
+    void case0005();
+    void case0006();
+    void case0007();
+    void case0008();
+    void case0009();
+    void case0010();
+    void case0011();
+    void case0012();
+    void case0013();
+    void case0014();
+    void case0015();
+    void case0016();
+    void case0017();
+    void case0018();
+    void case0019();
+
+    void case0100();
+    void case0101();
+    void case0102();
+    void case0103();
+
+    void case0150();
+    void case0151();
+    void case0152();
+    void case0153();
+    void case0154();
+    void case0155();
+    void case0156();
+    void case0157();
+    void case0158();
+    void case0159();
+
+    void case0200();
+    void case0201();
+    void case0202();
+    void case0203();
+    void case0204();
+
+    void case0250();
+    void case0251();
+    void case0252();
+    void case0253();
+    void case0254();
+    void case0255();
+    void case0256();
+    void case0257();
+    void case0258();
+    void case0259();
+
+    std::vector<TestFunction> tests_
+    {
+        TEST_CONTROL_FLOW_GRAPH(case0000),
+        TEST_CONTROL_FLOW_GRAPH(case0001),
+        TEST_CONTROL_FLOW_GRAPH(case0002),
+        TEST_CONTROL_FLOW_GRAPH(case0003),
+        TEST_CONTROL_FLOW_GRAPH(case0004),
+        TEST_CONTROL_FLOW_GRAPH(case0005),
+        TEST_CONTROL_FLOW_GRAPH(case0006),
+        TEST_CONTROL_FLOW_GRAPH(case0007),
+        TEST_CONTROL_FLOW_GRAPH(case0008),
+        TEST_CONTROL_FLOW_GRAPH(case0009),
+        TEST_CONTROL_FLOW_GRAPH(case0010),
+        TEST_CONTROL_FLOW_GRAPH(case0011),
+        TEST_CONTROL_FLOW_GRAPH(case0012),
+        TEST_CONTROL_FLOW_GRAPH(case0013),
+        TEST_CONTROL_FLOW_GRAPH(case0014),
+        TEST_CONTROL_FLOW_GRAPH(case0015),
+        TEST_CONTROL_FLOW_GRAPH(case0016),
+        TEST_CONTROL_FLOW_GRAPH(case0017),
+        TEST_CONTROL_FLOW_GRAPH(case0018),
+        TEST_CONTROL_FLOW_GRAPH(case0019),
+
+        TEST_CONTROL_FLOW_GRAPH(case0100),
+        TEST_CONTROL_FLOW_GRAPH(case0101),
+        TEST_CONTROL_FLOW_GRAPH(case0102),
+        TEST_CONTROL_FLOW_GRAPH(case0103),
+
+        TEST_CONTROL_FLOW_GRAPH(case0150),
+        TEST_CONTROL_FLOW_GRAPH(case0151),
+        TEST_CONTROL_FLOW_GRAPH(case0152),
+        TEST_CONTROL_FLOW_GRAPH(case0153),
+        TEST_CONTROL_FLOW_GRAPH(case0154),
+        TEST_CONTROL_FLOW_GRAPH(case0155),
+        TEST_CONTROL_FLOW_GRAPH(case0156),
+        TEST_CONTROL_FLOW_GRAPH(case0157),
+        TEST_CONTROL_FLOW_GRAPH(case0158),
+        TEST_CONTROL_FLOW_GRAPH(case0159),
+
+        TEST_CONTROL_FLOW_GRAPH(case0200),
+        TEST_CONTROL_FLOW_GRAPH(case0201),
+        TEST_CONTROL_FLOW_GRAPH(case0202),
+        TEST_CONTROL_FLOW_GRAPH(case0203),
+        TEST_CONTROL_FLOW_GRAPH(case0204),
+
+        TEST_CONTROL_FLOW_GRAPH(case0250),
+        TEST_CONTROL_FLOW_GRAPH(case0251),
+        TEST_CONTROL_FLOW_GRAPH(case0252),
+        TEST_CONTROL_FLOW_GRAPH(case0253),
+        TEST_CONTROL_FLOW_GRAPH(case0254),
+        TEST_CONTROL_FLOW_GRAPH(case0255),
+        TEST_CONTROL_FLOW_GRAPH(case0256),
+        TEST_CONTROL_FLOW_GRAPH(case0257),
+        TEST_CONTROL_FLOW_GRAPH(case0258),
+        TEST_CONTROL_FLOW_GRAPH(case0259),
+    };
+};
+
+} // C
+} // psy
+
+#endif
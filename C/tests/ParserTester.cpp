@@ -50,6 +50,21 @@ void ParserTester::parse(std::string text, Expectation X, SyntaxTree::SyntaxCate
     (static_cast<InternalsTestSuite*>(suite_)->parse(text, X, synCat));
 }
 
+void ParserTester::changeText(std::string text, TextChange change)
+{
+    (static_cast<InternalsTestSuite*>(suite_)->changeText(text, change));
+}
+
+void ParserTester::parseFunctionBodiesInParallel(std::string text)
+{
+    (static_cast<InternalsTestSuite*>(suite_)->parseFunctionBodiesInParallel(text));
+}
+
+void ParserTester::locateDiagnostic(std::string text, unsigned line, unsigned character, std::string snippet)
+{
+    (static_cast<InternalsTestSuite*>(suite_)->locateDiagnostic(text, line, character, snippet));
+}
+
 void ParserTester::setUp()
 {}
 
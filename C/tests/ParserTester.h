@@ -50,6 +50,9 @@ public:
     void parse(std::string text,
                Expectation X = Expectation(),
                SyntaxTree::SyntaxCategory synCat = SyntaxTree::SyntaxCategory::UNSPECIFIED);
+    void changeText(std::string text, TextChange change);
+    void parseFunctionBodiesInParallel(std::string text);
+    void locateDiagnostic(std::string text, unsigned line, unsigned character, std::string snippet);
 
     using TestFunction = std::pair<std::function<void(ParserTester*)>, const char*>;
 
@@ -120,6 +123,10 @@ public:
             + 3300-3399 ->
             + 3400-3499 ->
             + 3500-3599 ->
+
+        Text changes:
+            + 3900-3949 -> incremental relexing and reparsing
+            + 3950-3999 -> parallel parse of function bodies
      */
 
     void case0001();
@@ -1364,33 +1364,164 @@ void ParserTester::case3897() {}
 void ParserTester::case3898() {}
 void ParserTester::case3899() {}
 
-void ParserTester::case3900() {}
-void ParserTester::case3901() {}
-void ParserTester::case3902() {}
-void ParserTester::case3903() {}
-void ParserTester::case3904() {}
-void ParserTester::case3905() {}
-void ParserTester::case3906() {}
-void ParserTester::case3907() {}
-void ParserTester::case3908() {}
-void ParserTester::case3909() {}
-void ParserTester::case3910() {}
-void ParserTester::case3911() {}
-void ParserTester::case3912() {}
-void ParserTester::case3913() {}
-void ParserTester::case3914() {}
-void ParserTester::case3915() {}
-void ParserTester::case3916() {}
-void ParserTester::case3917() {}
-void ParserTester::case3918() {}
-void ParserTester::case3919() {}
-void ParserTester::case3920() {}
-void ParserTester::case3921() {}
-void ParserTester::case3922() {}
-void ParserTester::case3923() {}
-void ParserTester::case3924() {}
-void ParserTester::case3925() {}
-void ParserTester::case3926() {}
+void ParserTester::case3900()
+{
+    changeText("int x ;\nint y ;\nint z ;\n",
+               TextChange(TextSpan(12, 13), "yy"));
+}
+
+void ParserTester::case3901()
+{
+    changeText("int x ;\nint z ;\n",
+               TextChange(TextSpan(8, 8), "int y ;\n"));
+}
+
+void ParserTester::case3902()
+{
+    changeText("int x ;\nint y ;\nint z ;\n",
+               TextChange(TextSpan(8, 16), ""));
+}
+
+void ParserTester::case3903()
+{
+    changeText("void f ( ) {\n  int x ;\n}\nvoid g ( ) { }\n",
+               TextChange(TextSpan(15, 15), "{ } "));
+}
+
+void ParserTester::case3904()
+{
+    changeText("/* a\n b */ int x ;\nint y ;\n",
+               TextChange(TextSpan(15, 16), "w"));
+}
+
+void ParserTester::case3905()
+{
+    changeText("int x ;\nint y ;\n",
+               TextChange(TextSpan(7, 8), ""));
+}
+
+void ParserTester::case3906()
+{
+    changeText("int \\\nx ;\nint y ;\n",
+               TextChange(TextSpan(6, 7), "w"));
+}
+
+void ParserTester::case3907()
+{
+    changeText("int x ;\n",
+               TextChange(TextSpan(8, 8), "int y ;\n"));
+}
+
+void ParserTester::case3908()
+{
+    changeText("int x ;\nint y ;\n",
+               TextChange(TextSpan(0, 3), "long"));
+}
+
+void ParserTester::case3909()
+{
+    changeText("int x ;\n# 10 \"a.c\"\nint y ;\n",
+               TextChange(TextSpan(4, 5), "xx"));
+}
+
+void ParserTester::case3910()
+{
+    changeText("int x ;\nint y = 1 ;\nint z ;\n",
+               TextChange(TextSpan(16, 17), "\"a\""));
+}
+
+void ParserTester::case3911()
+{
+    changeText("int x ;\nint y ;\n",
+               TextChange(TextSpan(4, 5), "/* c */ x"));
+}
+
+void ParserTester::case3912()
+{
+    changeText("void f ( ) {\n  int x ;\n  x = 1 ;\n}\nint y ;\n",
+               TextChange(TextSpan(25, 30), "x = 2"));
+}
+
+void ParserTester::case3913()
+{
+    changeText("void f ( ) {\n  while ( 1 ) {\n    break ;\n  }\n}\n",
+               TextChange(TextSpan(29, 41), "    break ;\n    continue ;\n"));
+}
+
+void ParserTester::case3914()
+{
+    changeText("void f ( int a ) {\n  switch ( a ) {\n    case 1 : { a ; }\n  }\n}\n",
+               TextChange(TextSpan(49, 56), "{ break ; }"));
+}
+
+void ParserTester::case3915()
+{
+    changeText("void f ( ) {\n  while ( 1 ) ;\n  { }\n}\n",
+               TextChange(TextSpan(31, 34), "{ continue ; }"));
+}
+
+void ParserTester::case3916()
+{
+    changeText("void f ( ) {\n  int x ;\n}\nvoid g ( ) { }\n",
+               TextChange(TextSpan(13, 23), "  { int x ;\n"));
+}
+
+void ParserTester::case3917()
+{
+    changeText("int f ( ) { return 0 ; }\nint g ( ) { return 1 ; }\nint h ( ) { return 2 ; }\n",
+               TextChange(TextSpan(25, 30), "long g"));
+}
+
+void ParserTester::case3918()
+{
+    changeText("int x ;\nint y ;\nint z ;\n",
+               TextChange(TextSpan(8, 15), "int y"));
+}
+
+void ParserTester::case3919()
+{
+    changeText("void f ( ) {\n  x * y ;\n}\nint z ;\n",
+               TextChange(TextSpan(25, 30), "int w"));
+}
+
+void ParserTester::case3920()
+{
+    changeText("void f ( ) {\n  int y ;\n}\nint z ;\n",
+               TextChange(TextSpan(13, 23), "  x * y ;\n"));
+}
+
+void ParserTester::case3921()
+{
+    changeText("int x ;\n__extension__ int y ;\nint z ;\n",
+               TextChange(TextSpan(30, 35), "int w"));
+}
+
+void ParserTester::case3922()
+{
+    changeText("void f ( ) { }\nvoid h ( ) { }\n",
+               TextChange(TextSpan(15, 21), "void g ( ) { }\nvoid h"));
+}
+
+void ParserTester::case3923()
+{
+    changeText("void f ( ) {\n  if ( 1 ) {\n    { int x ; }\n  } else { }\n}\n",
+               TextChange(TextSpan(32, 37), "int x , y"));
+}
+
+void ParserTester::case3924()
+{
+    locateDiagnostic("int x\nint y ;\n", 1, 0, "int y ;");
+}
+
+void ParserTester::case3925()
+{
+    locateDiagnostic("int x ;\nint y\n\nint z ;\n", 3, 0, "int z ;");
+}
+
+void ParserTester::case3926()
+{
+    locateDiagnostic("int x ;\nint y = ;\n", 1, 8, "int y = ;");
+}
 void ParserTester::case3927() {}
 void ParserTester::case3928() {}
 void ParserTester::case3929() {}
@@ -1414,13 +1545,58 @@ void ParserTester::case3946() {}
 void ParserTester::case3947() {}
 void ParserTester::case3948() {}
 void ParserTester::case3949() {}
-void ParserTester::case3950() {}
-void ParserTester::case3951() {}
-void ParserTester::case3952() {}
-void ParserTester::case3953() {}
-void ParserTester::case3954() {}
-void ParserTester::case3955() {}
-void ParserTester::case3956() {}
+void ParserTester::case3950()
+{
+    parseFunctionBodiesInParallel("void f ( ) { int x ; x = 1 ; }\n"
+                                  "int g ( int y ) { return y + 1 ; }\n");
+}
+
+void ParserTester::case3951()
+{
+    parseFunctionBodiesInParallel("typedef int T ;\n"
+                                  "struct s { int m ; } ;\n"
+                                  "void f ( ) { T t ; }\n"
+                                  "int x ;\n"
+                                  "void g ( ) { struct s v ; v . m = 0 ; }\n");
+}
+
+void ParserTester::case3952()
+{
+    parseFunctionBodiesInParallel("void f ( ) { if ( 1 ) { { } } else { while ( 0 ) { } } }\n"
+                                  "void g ( ) { { { } } }\n");
+}
+
+void ParserTester::case3953()
+{
+    parseFunctionBodiesInParallel("void f ( ) { x * y ; }\n"
+                                  "void g ( ) { a ( b ) ; }\n");
+}
+
+void ParserTester::case3954()
+{
+    parseFunctionBodiesInParallel("void f ( ) { int x = ; }\n"
+                                  "int y ;\n"
+                                  "void g ( ) { return 1 + ; }\n");
+}
+
+void ParserTester::case3955()
+{
+    parseFunctionBodiesInParallel("int f ( x ) int x ; { return x ; }\n"
+                                  "int ( * g ( ) ) ( ) { return 0 ; }\n");
+}
+
+void ParserTester::case3956()
+{
+    std::string text;
+    for (int i = 0; i < 500; ++i) {
+        text += "int f" + std::to_string(i) + " ( int x ) { "
+                "int y = x * " + std::to_string(i) + " ; "
+                "for ( int i = 0 ; i < y ; ++ i ) { y -= i ; } "
+                "return y ; }\n";
+    }
+    parseFunctionBodiesInParallel(text);
+}
+
 void ParserTester::case3957() {}
 void ParserTester::case3958() {}
 void ParserTester::case3959() {}
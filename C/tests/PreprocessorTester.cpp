@@ -0,0 +1,653 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "PreprocessorTester.h"
+
+#include "parser/Preprocessor.h"
+
+using namespace psy;
+using namespace C;
+
+const std::string PreprocessorTester::Name = "PREPROCESSOR";
+
+void PreprocessorTester::testPreprocessor()
+{
+    return run<PreprocessorTester>(tests_);
+}
+
+void PreprocessorTester::preprocess(std::string text,
+                                    std::string expectedText,
+                                    Expectation X,
+                                    ParseOptions parseOpts)
+{
+    (static_cast<InternalsTestSuite*>(suite_)->preprocess(text, expectedText, X, parseOpts));
+}
+
+void PreprocessorTester::case0000()
+{
+    preprocess(R"(
+#define N 10
+int x [ N ] ;
+)",
+               "int x [ 10 ] ;");
+}
+
+void PreprocessorTester::case0001()
+{
+    preprocess(R"(
+#define A B + 1
+#define B 2
+int x = A ;
+)",
+               "int x = 2 + 1 ;");
+}
+
+void PreprocessorTester::case0002()
+{
+    preprocess(R"(
+#define x x + 1
+int y = x ;
+)",
+               "int y = x + 1 ;");
+}
+
+void PreprocessorTester::case0003()
+{
+    preprocess(R"(
+#define SQ(a) ((a) * (a))
+int y = SQ(2 + 3) ;
+)",
+               "int y = ( ( 2 + 3 ) * ( 2 + 3 ) ) ;");
+}
+
+void PreprocessorTester::case0004()
+{
+    preprocess(R"(
+#define f(a) a
+int f ;
+)",
+               "int f ;");
+}
+
+void PreprocessorTester::case0005()
+{
+    preprocess(R"(
+#define ADD(a, b) a + b
+int x = ADD((1, 2), 3) ;
+)",
+               "int x = ( 1 , 2 ) + 3 ;");
+}
+
+void PreprocessorTester::case0006()
+{
+    preprocess(R"(
+#define V(f, ...) f(__VA_ARGS__)
+int x = V(g, 1, 2) + V(g) ;
+)",
+               "int x = g ( 1 , 2 ) + g ( ) ;");
+}
+
+void PreprocessorTester::case0007()
+{
+    preprocess(R"(
+#define N 1
+#undef N
+int x = N ;
+)",
+               "int x = N ;");
+}
+
+void PreprocessorTester::case0008()
+{
+    preprocess(R"(
+#define N 3
+#define ID(a) a
+int x = ID(N) ;
+)",
+               "int x = 3 ;");
+}
+
+void PreprocessorTester::case0009()
+{
+    preprocess(R"(
+#define ADD(a, b) \
+    a + b
+int x = ADD(1,
+            2) ;
+)",
+               "int x = 1 + 2 ;");
+}
+
+void PreprocessorTester::case0010()
+{
+    // 6.10.3.4-4 (EXAMPLE)
+
+    preprocess(R"(
+#define f(a) a * g
+#define g(a) f(a)
+int x = f(2)(9) ;
+)",
+               "int x = 2 * 9 * g ;");
+}
+
+void PreprocessorTester::case0011()
+{
+    preprocess(R"(
+#define a b
+#define b a
+int x = a + b ;
+)",
+               "int x = a + b ;");
+}
+
+void PreprocessorTester::case0012()
+{
+    preprocess(R"(
+#define ADD(a, b) a + b
+int x ADD(1) ;
+)",
+               "int x ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_MacroArgumentCountMismatch));
+}
+
+void PreprocessorTester::case0013()
+{
+    preprocess(R"(
+#define F(a) a
+int x ; F(1
+)",
+               "int x ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_UnterminatedMacroInvocation));
+}
+
+void PreprocessorTester::case0014()
+{
+    preprocess(R"(
+#define E() 1
+#define F(a) a 0
+int x = E() + F() ;
+)",
+               "int x = 1 + 0 ;");
+}
+
+void PreprocessorTester::case0015()
+{
+    ParseOptions parseOpts;
+    parseOpts.setPredefinedMacros({ "N=4", "M", "P(a)=a" });
+
+    preprocess(R"(
+int x = N + M + P(5) ;
+)",
+               "int x = 4 + 1 + 5 ;",
+               Expectation(),
+               parseOpts);
+}
+
+void PreprocessorTester::case0016()
+{
+    preprocess(R"(
+#if defined(__GNUC__) && __SIZEOF_POINTER__ == 8
+__SIZE_TYPE__ n ;
+#endif
+)",
+               "long unsigned int n ;");
+}
+
+void PreprocessorTester::case0017()
+{
+    ParseOptions parseOpts;
+    parseOpts.setTreatmentOfPreprocessing(ParseOptions::TreatmentOfPreprocessing::PreprocessWithoutBuiltinMacros);
+    parseOpts.setPredefinedMacros({ "__SIZE_TYPE__=unsigned" });
+
+    preprocess(R"(
+#ifdef __GNUC__
+int x ;
+#endif
+__SIZE_TYPE__ n ;
+)",
+               "unsigned n ;",
+               Expectation(),
+               parseOpts);
+}
+
+void PreprocessorTester::case0018()
+{
+    ParseOptions parseOpts;
+    parseOpts.setPredefinedMacros({ "N=4" });
+
+    // Without a TreatmentOfPreprocessing, the text is lexed as is.
+    auto tree = SyntaxTree::parseText(SourceText("int x = N ;"),
+                                      TextPreprocessingState::Unpreprocessed,
+                                      TextCompleteness::Fragment,
+                                      parseOpts);
+    PSY_EXPECT_EQ_INT(tree->tokenCount(), 7);
+    PSY_EXPECT_EQ_STR(tree->tokenAt(4).valueText(), "N");
+    PSY_EXPECT_FALSE(tree->tokenAt(4).isPPExpanded());
+}
+
+void PreprocessorTester::case0019()
+{
+    preprocess(R"(
+#define NULL ( ( void * ) 0 )
+#define __attribute__(a)
+int * p __attribute__((unused)) = NULL ;
+)",
+               "int * p = ( ( void * ) 0 ) ;");
+}
+
+void PreprocessorTester::case0100()
+{
+    preprocess(R"(
+#define S(a) #a
+const char * s = S(a  +  "b\n") ;
+)",
+               R"(const char * s = "a + \"b\\n\"" ;)");
+}
+
+void PreprocessorTester::case0101()
+{
+    preprocess(R"(
+#define CAT(a, b) a ## b
+int CAT(x, 1) = 0 ;
+)",
+               "int x1 = 0 ;");
+}
+
+void PreprocessorTester::case0102()
+{
+    preprocess(R"(
+#define N 1
+#define CAT(a, b) a ## b
+int CAT(N, N) ;
+)",
+               "int NN ;");
+}
+
+void PreprocessorTester::case0103()
+{
+    preprocess(R"(
+#define CAT(a, b) a ## b
+int CAT(, y) = CAT(1, ) ;
+)",
+               "int y = 1 ;");
+}
+
+void PreprocessorTester::case0104()
+{
+    preprocess(R"(
+#define P(fmt, ...) f(fmt, ## __VA_ARGS__)
+int x = P(1) + P(1, 2) ;
+)",
+               "int x = f ( 1 ) + f ( 1 , 2 ) ;");
+}
+
+void PreprocessorTester::case0105()
+{
+    preprocess(R"(
+#define CAT(a, b) a ## b
+int x = CAT(+, 1) ;
+)",
+               "int x = + 1 ;",
+               Expectation()
+                            .diagnostic(Expectation::ErrorOrWarn::Warn,
+                                        Preprocessor::DiagnosticsReporter::ID_of_InvalidTokenPasting));
+}
+
+void PreprocessorTester::case0106()
+{
+    preprocess(R"(
+#define S(a) #a
+#define XS(a) S(a)
+#define N 42
+const char * s = XS(N) , * t = S(N) ;
+)",
+               R"(const char * s = "42" , * t = "N" ;)");
+}
+
+void PreprocessorTester::case0107()
+{
+    preprocess(R"(
+#define AB 5
+#define CAT(a, b) a ## b
+int x = CAT(A, B) ;
+)",
+               "int x = 5 ;");
+}
+
+void PreprocessorTester::case0200()
+{
+    preprocess(R"(
+#if 1
+int x ;
+#else
+int y ;
+#endif
+)",
+               "int x ;");
+}
+
+void PreprocessorTester::case0201()
+{
+    preprocess(R"(
+#define A
+#ifdef A
+int x ;
+#endif
+#ifndef A
+int y ;
+#endif
+)",
+               "int x ;");
+}
+
+void PreprocessorTester::case0202()
+{
+    preprocess(R"(
+#define N 2
+#if N == 1
+int a ;
+#elif N == 2
+int b ;
+#elif N == 2
+int c ;
+#else
+int d ;
+#endif
+)",
+               "int b ;");
+}
+
+void PreprocessorTester::case0203()
+{
+    preprocess(R"(
+#if 0
+#if 1
+int a ;
+#else
+int b ;
+#endif
+#bogus
+#else
+int c ;
+#endif
+)",
+               "int c ;");
+}
+
+void PreprocessorTester::case0204()
+{
+    preprocess(R"(
+#define A
+#if defined(A) && !defined B
+int x ;
+#endif
+)",
+               "int x ;");
+}
+
+void PreprocessorTester::case0205()
+{
+    preprocess(R"(
+#if (1 << 4) == 16 && 7 / 2 == 3 && -1 < 0 && 10 % 4 == 2 && (2 ? 3 : 4) == 3
+int x ;
+#endif
+#if 0x10 == 020 && 0b11 == 3 && (~0 & 0xff) == 255 && (6 ^ 3 | 8) == 13
+int y ;
+#endif
+)",
+               "int x ; int y ;");
+}
+
+void PreprocessorTester::case0206()
+{
+    preprocess(R"(
+#if -1 > 0u
+int x ;
+#endif
+#if 'A' == 65 && '\n' == 10 && '\x41' == 65
+int y ;
+#endif
+)",
+               "int x ; int y ;");
+}
+
+void PreprocessorTester::case0207()
+{
+    preprocess(R"(
+#if UNDEFINED
+int x ;
+#else
+int y ;
+#endif
+)",
+               "int y ;");
+}
+
+void PreprocessorTester::case0208()
+{
+    preprocess(R"(
+#if 0 && 1 / 0
+int x ;
+#elif 1 || 1 / 0
+int y ;
+#endif
+)",
+               "int y ;");
+}
+
+void PreprocessorTester::case0209()
+{
+    preprocess(R"(
+#if 1 / 0
+int x ;
+#endif
+int y ;
+)",
+               "int y ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_InvalidConditionalExpression));
+}
+
+void PreprocessorTester::case0210()
+{
+    preprocess(R"(
+#if 1
+int x ;
+)",
+               "int x ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_UnterminatedConditional));
+}
+
+void PreprocessorTester::case0211()
+{
+    preprocess(R"(
+int x ;
+#endif
+#if 1
+#else
+#else
+#endif
+)",
+               "int x ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_UnmatchedConditional)
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_UnmatchedConditional));
+}
+
+void PreprocessorTester::case0300()
+{
+    preprocess(R"(
+#error oops , again
+int x ;
+)",
+               "int x ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_ErrorDirective));
+}
+
+void PreprocessorTester::case0301()
+{
+    preprocess(R"(
+#if 0
+#error no
+#endif
+#warning yes
+int x ;
+)",
+               "int x ;",
+               Expectation()
+                            .diagnostic(Expectation::ErrorOrWarn::Warn,
+                                        Preprocessor::DiagnosticsReporter::ID_of_WarningDirective));
+}
+
+void PreprocessorTester::case0302()
+{
+    preprocess(R"(
+#foo
+int x ;
+)",
+               "int x ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_InvalidDirective));
+}
+
+void PreprocessorTester::case0303()
+{
+    preprocess(R"(
+#include <stdio.h>
+#pragma once
+#
+int x ;
+)",
+               "int x ;");
+}
+
+void PreprocessorTester::case0304()
+{
+    preprocess(R"(int a = __LINE__ ;
+const char * b = __FILE__ ;
+#line 100 "f.c"
+int c = __LINE__ ;
+const char * d = __FILE__ ;
+)",
+               R"(int a = 1 ; const char * b = "<test>" ; int c = 100 ; const char * d = "f.c" ;)");
+}
+
+void PreprocessorTester::case0305()
+{
+    preprocess(R"(
+#if defined __STDC__ && __STDC_VERSION__ >= 201112L
+long x = __STDC_VERSION__ ;
+#endif
+)",
+               "long x = 201112L ;");
+}
+
+void PreprocessorTester::case0306()
+{
+    preprocess(R"(
+#define
+#define 1
+#define F(a, 1) a
+int x ;
+)",
+               "int x ;",
+               Expectation().ContinueTestDespiteOfErrors()
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_ExpectedMacroName)
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_ExpectedMacroName)
+                            .diagnostic(Expectation::ErrorOrWarn::Error,
+                                        Preprocessor::DiagnosticsReporter::ID_of_InvalidMacroParameterList));
+}
+
+void PreprocessorTester::case0400()
+{
+    preprocess(R"(
+#define N 10
+int x = N ;
+)",
+               "int x = 10 ;");
+
+    const SyntaxTree* tree = static_cast<InternalsTestSuite*>(suite_)->tree_.get();
+    const auto& intTk = tree->tokenAt(1);
+    PSY_EXPECT_FALSE(intTk.isPPExpanded());
+    PSY_EXPECT_FALSE(intTk.isPPGenerated());
+
+    const auto& tenTk = tree->tokenAt(4);
+    PSY_EXPECT_EQ_STR(tenTk.valueText(), "10");
+    PSY_EXPECT_TRUE(tenTk.isPPExpanded());
+    PSY_EXPECT_TRUE(tenTk.isPPGenerated());
+    PSY_EXPECT_EQ_INT(tenTk.span().start(), std::string("\n#define N 10\nint x = ").size());
+    PSY_EXPECT_EQ_INT(tenTk.span().end(), tenTk.span().start() + 1);
+    PSY_EXPECT_TRUE(tenTk.hasLeadingTrivia());
+}
+
+void PreprocessorTester::case0401()
+{
+    preprocess(R"(
+#define ID(a) ( a )
+int x = ID(y) ;
+)",
+               "int x = ( y ) ;");
+
+    const SyntaxTree* tree = static_cast<InternalsTestSuite*>(suite_)->tree_.get();
+    const auto& openParenTk = tree->tokenAt(4);
+    PSY_EXPECT_TRUE(openParenTk.isPPExpanded());
+    PSY_EXPECT_TRUE(openParenTk.isPPGenerated());
+
+    const auto& yTk = tree->tokenAt(5);
+    PSY_EXPECT_EQ_STR(yTk.valueText(), "y");
+    PSY_EXPECT_TRUE(yTk.isPPExpanded());
+    PSY_EXPECT_FALSE(yTk.isPPGenerated());
+    PSY_EXPECT_EQ_INT(yTk.span().start(), std::string("\n#define ID(a) ( a )\nint x = ID(").size());
+
+    const auto& semicolonTk = tree->tokenAt(7);
+    PSY_EXPECT_FALSE(semicolonTk.isPPExpanded());
+}
+
+void PreprocessorTester::case0402()
+{
+    preprocess(R"(int a ;
+#define N 10
+int x = N ;
+)",
+               "int a ; int x = 10 ;");
+
+    const SyntaxTree* tree = static_cast<InternalsTestSuite*>(suite_)->tree_.get();
+    const auto& xTk = tree->tokenAt(5);
+    const auto& tenTk = tree->tokenAt(7);
+    PSY_EXPECT_EQ_STR(tenTk.valueText(), "10");
+    PSY_EXPECT_EQ_INT(tenTk.location().lineSpan().span().start().line(),
+                      xTk.location().lineSpan().span().start().line());
+    PSY_EXPECT_EQ_INT(tenTk.location().lineSpan().span().start().character(),
+                      xTk.location().lineSpan().span().start().character() + 4);
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_PREPROCESSOR_TESTER_H__
+#define PSYCHE_C_PREPROCESSOR_TESTER_H__
+
+#include "Fwds.h"
+#include "TestSuite_Internals.h"
+#include "tests/Tester.h"
+
+#define TEST_PREPROCESSOR(Function) TestFunction { &PreprocessorTester::Function, #Function }
+
+namespace psy {
+namespace C {
+
+class PreprocessorTester final : public Tester
+{
+public:
+    PreprocessorTester(TestSuite* suite)
+        : Tester(suite)
+    {}
+
+    static const std::string Name;
+    virtual std::string name() const override { return Name; }
+
+    void testPreprocessor();
+
+    void preprocess(std::string text,
+                    std::string expectedText,
+                    Expectation X = Expectation(),
+                    ParseOptions parseOpts = ParseOptions());
+
+    using TestFunction = std::pair<std::function<void(PreprocessorTester*)>, const char*>;
+
+    /*
+        + 0000-0099 -> object-like and function-like macros
+        + 0100-0199 -> # and ## operators
+        + 0200-0299 -> conditional inclusion
+        + 0300-0399 -> other directives
+        + 0400-0499 -> tokens of expansions
+     */
+
+    void case0000();
+    void case0001();
+    void case0002();
+    void case0003();
+    void case0004();
+    void case0005();
+    void case0006();
+    void case0007();
+    void case0008();
+    void case0009();
+    void case0010();
+    void case0011();
+    void case0012();
+    void case0013();
+    void case0014();
+    void case0015();
+    void case0016();
+    void case0017();
+    void case0018();
+    void case0019();
+
+    void case0100();
+    void case0101();
+    void case0102();
+    void case0103();
+    void case0104();
+    void case0105();
+    void case0106();
+    void case0107();
+
+    void case0200();
+    void case0201();
+    void case0202();
+    void case0203();
+    void case0204();
+    void case0205();
+    void case0206();
+    void case0207();
+    void case0208();
+    void case0209();
+    void case0210();
+    void case0211();
+
+    void case0300();
+    void case0301();
+    void case0302();
+    void case0303();
+    void case0304();
+    void case0305();
+    void case0306();
+
+    void case0400();
+    void case0401();
+    void case0402();
+
+    std::vector<TestFunction> tests_
+    {
+        TEST_PREPROCESSOR(case0000),
+        TEST_PREPROCESSOR(case0001),
+        TEST_PREPROCESSOR(case0002),
+        TEST_PREPROCESSOR(case0003),
+        TEST_PREPROCESSOR(case0004),
+        TEST_PREPROCESSOR(case0005),
+        TEST_PREPROCESSOR(case0006),
+        TEST_PREPROCESSOR(case0007),
+        TEST_PREPROCESSOR(case0008),
+        TEST_PREPROCESSOR(case0009),
+        TEST_PREPROCESSOR(case0010),
+        TEST_PREPROCESSOR(case0011),
+        TEST_PREPROCESSOR(case0012),
+        TEST_PREPROCESSOR(case0013),
+        TEST_PREPROCESSOR(case0014),
+        TEST_PREPROCESSOR(case0015),
+        TEST_PREPROCESSOR(case0016),
+        TEST_PREPROCESSOR(case0017),
+        TEST_PREPROCESSOR(case0018),
+        TEST_PREPROCESSOR(case0019),
+
+        TEST_PREPROCESSOR(case0100),
+        TEST_PREPROCESSOR(case0101),
+        TEST_PREPROCESSOR(case0102),
+        TEST_PREPROCESSOR(case0103),
+        TEST_PREPROCESSOR(case0104),
+        TEST_PREPROCESSOR(case0105),
+        TEST_PREPROCESSOR(case0106),
+        TEST_PREPROCESSOR(case0107),
+
+        TEST_PREPROCESSOR(case0200),
+        TEST_PREPROCESSOR(case0201),
+        TEST_PREPROCESSOR(case0202),
+        TEST_PREPROCESSOR(case0203),
+        TEST_PREPROCESSOR(case0204),
+        TEST_PREPROCESSOR(case0205),
+        TEST_PREPROCESSOR(case0206),
+        TEST_PREPROCESSOR(case0207),
+        TEST_PREPROCESSOR(case0208),
+        TEST_PREPROCESSOR(case0209),
+        TEST_PREPROCESSOR(case0210),
+        TEST_PREPROCESSOR(case0211),
+
+        TEST_PREPROCESSOR(case0300),
+        TEST_PREPROCESSOR(case0301),
+        TEST_PREPROCESSOR(case0302),
+        TEST_PREPROCESSOR(case0303),
+        TEST_PREPROCESSOR(case0304),
+        TEST_PREPROCESSOR(case0305),
+        TEST_PREPROCESSOR(case0306),
+
+        TEST_PREPROCESSOR(case0400),
+        TEST_PREPROCESSOR(case0401),
+        TEST_PREPROCESSOR(case0402),
+    };
+};
+
+} // C
+} // psy
+
+#endif
@@ -163,7 +163,27 @@ void ReparserTester::case0016(){}
 void ReparserTester::case0017(){}
 void ReparserTester::case0018(){}
 void ReparserTester::case0019(){}
-void ReparserTester::case0020(){}
+void ReparserTester::case0020()
+{
+    auto s = R"(
+int _ ( )
+{
+    if ( x ) x ( y ) ;
+    return ;
+}
+)";
+
+    reparse_withSyntaxCorrelation(
+                s,
+                Expectation().AST(body({ IfStatement,
+                                         IdentifierName,
+                                         ExpressionStatement,
+                                         CallExpression,
+                                         IdentifierName,
+                                         IdentifierName,
+                                         ReturnStatement })));
+}
+
 void ReparserTester::case0021(){}
 void ReparserTester::case0022(){}
 void ReparserTester::case0023(){}
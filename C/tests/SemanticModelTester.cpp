@@ -22,7 +22,13 @@
 
 #include "TestSuite_API.h"
 
+#include "C/binder/Scope.h"
+#include "C/compilation/Assembly.h"
+#include "C/compilation/Compilation.h"
 #include "C/symbols/Symbol_ALL.h"
+#include "C/syntax/SyntaxLexeme_ALL.h"
+
+#include <algorithm>
 
 using namespace psy;
 using namespace C;
@@ -155,6 +161,147 @@ void SemanticModelTester::case0004()
     PSY_EXPECT_EQ_ENU(varSym2->type()->typeKind(), TypeKind::Named, TypeKind);
 }
 
+void SemanticModelTester::case0011()
+{
+    std::vector<std::unique_ptr<SyntaxTree>> trees;
+    for (auto text : { "int x ;", "double y ; int * z ;", "void f ( ) { }" }) {
+        trees.push_back(SyntaxTree::parseText(SourceText(text),
+                                              TextPreprocessingState::Preprocessed,
+                                              TextCompleteness::Fragment,
+                                              ParseOptions(),
+                                              "<test>"));
+    }
+
+    auto compilation = Compilation::create("<test>");
+    for (const auto& tree : trees)
+        compilation->addSyntaxTree(tree.get());
+
+    auto namesOf = [] (const Assembly* assembly) {
+        std::vector<std::string> names;
+        for (auto sym : assembly->symbols()) {
+            if (sym->asValue())
+                names.push_back(sym->asValue()->name()->text());
+            else if (sym->asFunction())
+                names.push_back(sym->asFunction()->name()->text());
+        }
+        return names;
+    };
+
+    // Run the tasks backwards: the merge must still follow the order of the trees.
+    compilation->bindAll([] (const std::vector<std::function<void ()>>& tasks) {
+        for (auto it = tasks.rbegin(); it != tasks.rend(); ++it)
+            (*it)();
+    });
+    std::vector<std::string> expected { "x", "y", "z", "f" };
+    PSY_EXPECT_TRUE(namesOf(static_cast<const Compilation*>(compilation.get())->assembly()) == expected);
+
+    for (const auto& tree : trees) {
+        auto semaModel = compilation->semanticModel(tree.get());
+        PSY_EXPECT_TRUE(semaModel);
+        PSY_EXPECT_TRUE(semaModel->declaredSymbol(tree->translationUnitRoot()));
+    }
+
+    compilation = Compilation::create("<test>");
+    for (const auto& tree : trees)
+        compilation->addSyntaxTree(tree.get());
+    compilation->bindAll();
+    PSY_EXPECT_TRUE(namesOf(static_cast<const Compilation*>(compilation.get())->assembly()) == expected);
+}
+
+void SemanticModelTester::case0012()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>(
+                "struct s * x ; typedef int t ; t w ; "
+                "void f ( ) { struct s * y ; t v ; } "
+                "void g ( ) { struct s { int m ; } * z ; struct u * a ; } "
+                "void h ( ) { struct u * b ; }");
+
+    auto declAt = [] (const SyntaxTree* tree, int idx) {
+        auto declIt = tree->translationUnitRoot()->declarations();
+        while (idx--)
+            declIt = declIt->next;
+        return declIt->value;
+    };
+    auto localTySymOf = [&] (const DeclarationSyntax* decl, int idx) {
+        auto stmtIt = decl->asFunctionDefinition()->body()->asCompoundStatement()->statements();
+        while (idx--)
+            stmtIt = stmtIt->next;
+        auto localDecl = stmtIt->value->asDeclarationStatement()->declaration()
+                ->asVariableAndOrFunctionDeclaration();
+        return semaModel->declaredSymbols(localDecl)[0]->asValue()->type();
+    };
+
+    auto tree = tree_.get();
+    const TypeSymbol* tySym_x = semaModel->declaredSymbols(varAndOrFunDecl)[0]->asValue()->type();
+    const TypeSymbol* tySym_w = semaModel->declaredSymbols(
+                declAt(tree, 2)->asVariableAndOrFunctionDeclaration())[0]->asValue()->type();
+    const TypeSymbol* tySym_y = localTySymOf(declAt(tree, 3), 0);
+    const TypeSymbol* tySym_v = localTySymOf(declAt(tree, 3), 1);
+    const TypeSymbol* tySym_z = localTySymOf(declAt(tree, 4), 0);
+    const TypeSymbol* tySym_a = localTySymOf(declAt(tree, 4), 1);
+    const TypeSymbol* tySym_b = localTySymOf(declAt(tree, 5), 0);
+    PSY_EXPECT_EQ_PTR(tySym_x, tySym_y);
+    PSY_EXPECT_EQ_PTR(tySym_w, tySym_v);
+    PSY_EXPECT_TRUE(tySym_x != tySym_z);
+    PSY_EXPECT_TRUE(tySym_a != tySym_b);
+}
+
+void SemanticModelTester::case0013()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>(
+                "typedef int t ; t w ; struct s { int m ; } ; struct s * z ; "
+                "t f ( t p ) { t x ; struct s * y ; return p ; }");
+
+    auto declAt = [] (const SyntaxTree* tree, int idx) {
+        auto declIt = tree->translationUnitRoot()->declarations();
+        while (idx--)
+            declIt = declIt->next;
+        return declIt->value;
+    };
+    auto localSymOf = [&] (const SyntaxTree* tree, int idx) {
+        auto stmtIt = declAt(tree, 4)->asFunctionDefinition()->body()->asCompoundStatement()->statements();
+        while (idx--)
+            stmtIt = stmtIt->next;
+        auto localDecl = stmtIt->value->asDeclarationStatement()->declaration()
+                ->asVariableAndOrFunctionDeclaration();
+        return semaModel->declaredSymbols(localDecl)[0]->asValue();
+    };
+
+    auto funcSym = semaModel->declaredSymbol(declAt(tree_.get(), 4)->asFunctionDefinition());
+    auto sym_x = localSymOf(tree_.get(), 0);
+    auto sym_y = localSymOf(tree_.get(), 1);
+    PSY_EXPECT_TRUE(funcSym);
+
+    auto newTree = SyntaxTree::parseText(SourceText(
+                "typedef long t ; t w ; struct s { int m ; } ; struct s * z ; "
+                "t f ( t p ) { t x ; struct s * y ; return p ; }"),
+                                         TextPreprocessingState::Preprocessed,
+                                         TextCompleteness::Fragment,
+                                         ParseOptions(),
+                                         "<test>");
+    compilation_->replaceSyntaxTree(tree_.get(), newTree.get());
+    tree_ = std::move(newTree);
+    semaModel = compilation_->semanticModel(tree_.get());
+
+    auto tySym_w_P = semaModel->declaredSymbols(
+                declAt(tree_.get(), 1)->asVariableAndOrFunctionDeclaration())[0]->asValue()->type();
+    auto tySym_z_P = semaModel->declaredSymbols(
+                declAt(tree_.get(), 3)->asVariableAndOrFunctionDeclaration())[0]->asValue()->type();
+    auto funcSym_P = semaModel->declaredSymbol(declAt(tree_.get(), 4)->asFunctionDefinition());
+    PSY_EXPECT_EQ_PTR(funcSym_P, funcSym);
+    PSY_EXPECT_EQ_PTR(localSymOf(tree_.get(), 0), sym_x);
+    PSY_EXPECT_EQ_PTR(localSymOf(tree_.get(), 1), sym_y);
+
+    PSY_EXPECT_EQ_PTR(sym_x->type(), tySym_w_P);
+    PSY_EXPECT_EQ_PTR(sym_y->type(), tySym_z_P);
+    PSY_EXPECT_EQ_PTR(sym_x->type()->scope(), funcSym_P->scope());
+    auto funcTySym = funcSym_P->type()->asFunctionType();
+    PSY_EXPECT_EQ_PTR(funcTySym->returnType(), tySym_w_P);
+    PSY_EXPECT_EQ_PTR(funcTySym->parameterTypes()[0], tySym_w_P);
+}
+
 void SemanticModelTester::case0090()
 {
     auto [varAndOrFunDecl, semaModel] =
@@ -230,7 +377,17 @@ void SemanticModelTester::case0092()
     PSY_EXPECT_EQ_ENU(funcSym2->type()->typeKind(), TypeKind::Function, TypeKind);
 }
 
-void SemanticModelTester::case0093(){}
+void SemanticModelTester::case0093()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>("int ( * x ) ( int ) ;");
+
+    auto syms = semaModel->declaredSymbols(varAndOrFunDecl);
+    PSY_EXPECT_EQ_INT(syms.size(), 1);
+    PSY_EXPECT_EQ_ENU(syms[0]->kind(), SymbolKind::Value, SymbolKind);
+    PSY_EXPECT_EQ_PTR(semaModel->declaredSymbol(varAndOrFunDecl->declarators()->value), syms[0]);
+}
+
 void SemanticModelTester::case0094(){}
 void SemanticModelTester::case0095(){}
 void SemanticModelTester::case0096(){}
@@ -238,12 +395,143 @@ void SemanticModelTester::case0097(){}
 void SemanticModelTester::case0098(){}
 void SemanticModelTester::case0099(){}
 
-void SemanticModelTester::case0005(){}
-void SemanticModelTester::case0006(){}
-void SemanticModelTester::case0007(){}
-void SemanticModelTester::case0008(){}
-void SemanticModelTester::case0009(){}
-void SemanticModelTester::case0010(){}
+void SemanticModelTester::case0005()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>("int x ;");
+
+    auto identDecltor = varAndOrFunDecl->declarators()->value->asIdentifierDeclarator();
+    auto ident = identDecltor->identifierToken().valueLexeme()->asIdentifier();
+    PSY_EXPECT_TRUE(ident);
+
+    const Symbol* sym = semaModel->declaredSymbol(identDecltor);
+    PSY_EXPECT_TRUE(sym);
+    PSY_EXPECT_TRUE(sym->scope());
+    PSY_EXPECT_EQ_ENU(sym->scope()->kind(), ScopeKind::File, ScopeKind);
+    PSY_EXPECT_EQ_PTR(sym->scope()->searchForDeclaration(ident, NameSpaceKind::Ordinary), sym);
+    PSY_EXPECT_EQ_PTR(sym->scope()->searchForDeclaration(ident, NameSpaceKind::Tags), nullptr);
+}
+
+void SemanticModelTester::case0006()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>("int x ;");
+
+    const Assembly* assembly = semaModel->compilation()->assembly();
+
+    auto syms = semaModel->declaredSymbols(varAndOrFunDecl);
+    PSY_EXPECT_EQ_INT(syms.size(), 1);
+    PSY_EXPECT_EQ_PTR(syms[0]->owningAssembly(), assembly);
+    PSY_EXPECT_EQ_PTR(syms[0]->asValue()->type()->owningAssembly(), assembly);
+
+    const auto& assemblySyms = assembly->symbols();
+    PSY_EXPECT_TRUE(std::find(assemblySyms.begin(), assemblySyms.end(), syms[0]) != assemblySyms.end());
+}
+
+void SemanticModelTester::case0007()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>("int x ; double y ;");
+    (void)varAndOrFunDecl;
+
+    const Assembly* assembly = semaModel->compilation()->assembly();
+    PSY_EXPECT_TRUE(!assembly->symbols().empty());
+
+    compilation_->removeSyntaxTree(tree_.get());
+    PSY_EXPECT_TRUE(assembly->symbols().empty());
+}
+
+void SemanticModelTester::case0008()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>("int * x ; int * y ; const int * z ;");
+
+    auto declIt = tree_->translationUnitRoot()->declarations();
+    auto varAndOrFunDecl_y = declIt->next->value->asVariableAndOrFunctionDeclaration();
+    auto varAndOrFunDecl_z = declIt->next->next->value->asVariableAndOrFunctionDeclaration();
+
+    auto syms_x = semaModel->declaredSymbols(varAndOrFunDecl);
+    auto syms_y = semaModel->declaredSymbols(varAndOrFunDecl_y);
+    auto syms_z = semaModel->declaredSymbols(varAndOrFunDecl_z);
+    PSY_EXPECT_EQ_INT(syms_x.size(), 1);
+    PSY_EXPECT_EQ_INT(syms_y.size(), 1);
+    PSY_EXPECT_EQ_INT(syms_z.size(), 1);
+
+    const TypeSymbol* tySym_x = syms_x[0]->asValue()->type();
+    const TypeSymbol* tySym_y = syms_y[0]->asValue()->type();
+    const TypeSymbol* tySym_z = syms_z[0]->asValue()->type();
+    PSY_EXPECT_EQ_PTR(tySym_x, tySym_y);
+    PSY_EXPECT_TRUE(tySym_x != tySym_z);
+    PSY_EXPECT_TRUE(tySym_x->asPointerType()->referencedType()
+                        != tySym_z->asPointerType()->referencedType());
+}
+
+void SemanticModelTester::case0009()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>("struct s * x ; struct s * y ; struct t * z ;");
+
+    auto declIt = tree_->translationUnitRoot()->declarations();
+    auto varAndOrFunDecl_y = declIt->next->value->asVariableAndOrFunctionDeclaration();
+    auto varAndOrFunDecl_z = declIt->next->next->value->asVariableAndOrFunctionDeclaration();
+
+    const TypeSymbol* tySym_x = semaModel->declaredSymbols(varAndOrFunDecl)[0]->asValue()->type();
+    const TypeSymbol* tySym_y = semaModel->declaredSymbols(varAndOrFunDecl_y)[0]->asValue()->type();
+    const TypeSymbol* tySym_z = semaModel->declaredSymbols(varAndOrFunDecl_z)[0]->asValue()->type();
+    PSY_EXPECT_EQ_PTR(tySym_x, tySym_y);
+    PSY_EXPECT_TRUE(tySym_x != tySym_z);
+}
+
+void SemanticModelTester::case0010()
+{
+    auto [varAndOrFunDecl, semaModel] =
+            declAndSemaModel<VariableAndOrFunctionDeclarationSyntax>("int g ; void f ( ) { int x ; }");
+
+    auto localDeclOf = [] (const SyntaxTree* tree) {
+        auto funcDef = tree->translationUnitRoot()->declarations()->next->value->asFunctionDefinition();
+        auto stmt = funcDef->body()->asCompoundStatement()->statements()->value;
+        auto decl = stmt->asDeclarationStatement()->declaration();
+        return std::make_pair(funcDef, decl->asVariableAndOrFunctionDeclaration());
+    };
+
+    auto [funcDef, localDecl] = localDeclOf(tree_.get());
+    auto sym_g = semaModel->declaredSymbols(varAndOrFunDecl)[0];
+    auto funcSym = semaModel->declaredSymbol(funcDef);
+    auto sym_x = semaModel->declaredSymbols(localDecl)[0];
+    PSY_EXPECT_TRUE(sym_g);
+    PSY_EXPECT_TRUE(funcSym);
+    PSY_EXPECT_TRUE(sym_x);
+
+    const Assembly* assembly = semaModel->compilation()->assembly();
+    auto symCnt = assembly->symbols().size();
+
+    auto newTree = SyntaxTree::parseText(SourceText("long g ; void f ( ) { int x ; }"),
+                                         TextPreprocessingState::Preprocessed,
+                                         TextCompleteness::Fragment,
+                                         ParseOptions(),
+                                         "<test>");
+    compilation_->replaceSyntaxTree(tree_.get(), newTree.get());
+    tree_ = std::move(newTree);
+    semaModel = compilation_->semanticModel(tree_.get());
+    PSY_EXPECT_EQ_INT(assembly->symbols().size(), symCnt);
+
+    auto varAndOrFunDecl_P = tree_->translationUnitRoot()->declarations()->value
+            ->asVariableAndOrFunctionDeclaration();
+    auto [funcDef_P, localDecl_P] = localDeclOf(tree_.get());
+    auto sym_g_P = semaModel->declaredSymbols(varAndOrFunDecl_P)[0];
+    auto funcSym_P = semaModel->declaredSymbol(funcDef_P);
+    auto sym_x_P = semaModel->declaredSymbols(localDecl_P)[0];
+    PSY_EXPECT_TRUE(sym_g_P != sym_g);
+    PSY_EXPECT_EQ_PTR(funcSym_P, funcSym);
+    PSY_EXPECT_EQ_PTR(sym_x_P, sym_x);
+
+    PSY_EXPECT_EQ_PTR(funcSym_P->containingSymbol(), semaModel->declaredSymbol(tree_->translationUnitRoot()));
+    PSY_EXPECT_EQ_PTR(funcSym_P->scope(), sym_g_P->scope());
+
+    auto ident_x = localDecl_P->declarators()->value->asIdentifierDeclarator()
+            ->identifierToken().valueLexeme()->asIdentifier();
+    PSY_EXPECT_EQ_PTR(sym_x_P->scope()->searchForDeclarationHere(ident_x, NameSpaceKind::Ordinary), sym_x_P);
+}
 
 void SemanticModelTester::case0101()
 {
@@ -310,7 +598,30 @@ void SemanticModelTester::case0151()
 {
 }
 
-void SemanticModelTester::case0152(){}
+void SemanticModelTester::case0152()
+{
+    auto [funcDef, semaModel] =
+            declAndSemaModel<FunctionDefinitionSyntax>("void x ( int y ) { }");
+
+    const FunctionSymbol* funcSym = semaModel->declaredSymbol(funcDef);
+    PSY_EXPECT_TRUE(funcSym);
+
+    auto arrOrFunDecltor = funcDef->declarator()->asArrayOrFunctionDeclarator();
+    auto funcIdent = arrOrFunDecltor->innerDeclarator()->asIdentifierDeclarator()
+            ->identifierToken().valueLexeme()->asIdentifier();
+    auto parmDecl0 = arrOrFunDecltor->suffix()->asParameterSuffix()->parameters()->value;
+    auto parmIdent = parmDecl0->declarator()->asIdentifierDeclarator()
+            ->identifierToken().valueLexeme()->asIdentifier();
+
+    const ParameterSymbol* parmSym = semaModel->declaredSymbol(parmDecl0);
+    PSY_EXPECT_TRUE(parmSym);
+    PSY_EXPECT_EQ_ENU(parmSym->scope()->kind(), ScopeKind::Block, ScopeKind);
+    PSY_EXPECT_EQ_PTR(parmSym->scope()->outerScope(), funcSym->scope());
+    PSY_EXPECT_EQ_PTR(parmSym->scope()->searchForDeclaration(parmIdent, NameSpaceKind::Ordinary), parmSym);
+    PSY_EXPECT_EQ_PTR(parmSym->scope()->searchForDeclaration(funcIdent, NameSpaceKind::Ordinary), funcSym);
+    PSY_EXPECT_EQ_PTR(funcSym->scope()->searchForDeclaration(parmIdent, NameSpaceKind::Ordinary), nullptr);
+}
+
 void SemanticModelTester::case0153(){}
 void SemanticModelTester::case0154(){}
 void SemanticModelTester::case0155(){}
@@ -485,7 +796,24 @@ struct x
 
 }
 
-void SemanticModelTester::case0305(){}
+void SemanticModelTester::case0305()
+{
+    auto [tyDecl, semaModel] =
+            declAndSemaModel<StructOrUnionDeclarationSyntax>("struct x { int y ; } ;");
+
+    const NamedTypeSymbol* namedTySym = semaModel->declaredSymbol(tyDecl);
+    PSY_EXPECT_TRUE(namedTySym);
+
+    auto tagIdent = tyDecl->typeSpecifier()->tagToken().valueLexeme()->asIdentifier();
+    PSY_EXPECT_EQ_PTR(namedTySym->scope()->searchForDeclaration(tagIdent, NameSpaceKind::Tags), namedTySym);
+    PSY_EXPECT_EQ_PTR(namedTySym->scope()->searchForDeclaration(tagIdent, NameSpaceKind::Ordinary), nullptr);
+
+    auto fldDecl = tyDecl->typeSpecifier()->declarations()->value->asFieldDeclaration();
+    auto fldIdent = fldDecl->declarators()->value->asIdentifierDeclarator()
+            ->identifierToken().valueLexeme()->asIdentifier();
+    PSY_EXPECT_EQ_PTR(namedTySym->scope()->searchForDeclaration(fldIdent, NameSpaceKind::Ordinary), nullptr);
+}
+
 void SemanticModelTester::case0306(){}
 void SemanticModelTester::case0307(){}
 void SemanticModelTester::case0308(){}
@@ -866,7 +1194,19 @@ void SemanticModelTester::case0455()
     PSY_EXPECT_EQ_ENU(enumtrSym1->type()->typeKind(), TypeKind::Named, TypeKind);
 }
 
-void SemanticModelTester::case0456(){}
+void SemanticModelTester::case0456()
+{
+    auto [tyDecl, semaModel] =
+            declAndSemaModel<EnumDeclarationSyntax>("enum x { y } ;");
+
+    auto enumtrDecl0 = tyDecl->typeSpecifier()->declarations()->value->asEnumeratorDeclaration();
+    auto enumtrIdent = enumtrDecl0->identifierToken().valueLexeme()->asIdentifier();
+
+    const EnumeratorSymbol* enumtrSym = semaModel->declaredSymbol(enumtrDecl0);
+    PSY_EXPECT_TRUE(enumtrSym);
+    PSY_EXPECT_EQ_PTR(enumtrSym->scope()->searchForDeclaration(enumtrIdent, NameSpaceKind::Ordinary), enumtrSym);
+}
+
 void SemanticModelTester::case0457(){}
 void SemanticModelTester::case0458(){}
 void SemanticModelTester::case0459(){}
@@ -81,6 +81,9 @@ public:
     void case0008();
     void case0009();
     void case0010();
+    void case0011();
+    void case0012();
+    void case0013();
     //...
     void case0090();
     void case0091();
@@ -361,6 +364,9 @@ public:
         TEST_SEMANTIC_MODEL(case0008),
         TEST_SEMANTIC_MODEL(case0009),
         TEST_SEMANTIC_MODEL(case0010),
+        TEST_SEMANTIC_MODEL(case0011),
+        TEST_SEMANTIC_MODEL(case0012),
+        TEST_SEMANTIC_MODEL(case0013),
         //...
         TEST_SEMANTIC_MODEL(case0090),
         TEST_SEMANTIC_MODEL(case0091),
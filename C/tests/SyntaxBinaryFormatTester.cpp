@@ -0,0 +1,464 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "SyntaxBinaryFormatTester.h"
+
+#include "TestSuite_API.h"
+
+#include "C/syntax/SyntaxDumper.h"
+#include "C/syntax/SyntaxFlatWriterBinaryFormat.h"
+#include "C/syntax/SyntaxFlatWriterJSONFormat.h"
+#include "C/syntax/SyntaxReaderBinaryFormat.h"
+#include "C/syntax/SyntaxWriterBinaryFormat.h"
+
+#include <cstdio>
+#include <sstream>
+
+using namespace psy;
+using namespace C;
+
+namespace {
+
+/*
+ * Describe the nodes and tokens of a tree, the latter with their locations.
+ */
+class Describer final : public SyntaxDumper
+{
+public:
+    Describer(SyntaxTree* tree, std::ostream& os)
+        : SyntaxDumper(tree)
+        , os_(os)
+    {}
+
+    void describe(const SyntaxNode* node) { nonterminal(node); }
+
+private:
+    std::ostream& os_;
+
+    virtual void terminal(const SyntaxToken& tk, const SyntaxNode*) override
+    {
+        if (!tk.isValid())
+            return;
+
+        const auto loc = tk.location();
+        const auto& lineSpan = loc.lineSpan();
+        os_ << "  " << tk.valueText()
+            << " " << to_string(tk.kind())
+            << " " << lineSpan.path()
+            << ":" << lineSpan.span().start().line()
+            << ":" << lineSpan.span().start().character()
+            << " " << tk.span().start() << "\n";
+    }
+
+    virtual void nonterminal(const SyntaxNode* node) override
+    {
+        if (!node)
+            return;
+
+        os_ << to_string(node->kind()) << "\n";
+        SyntaxDumper::nonterminal(node);
+    }
+};
+
+std::uint32_t readU32(const std::string& s, std::size_t pos)
+{
+    std::uint32_t v = 0;
+    for (auto i = 0; i < 4; ++i)
+        v |= static_cast<std::uint32_t>(static_cast<unsigned char>(s[pos + i])) << (8 * i);
+    return v;
+}
+
+std::uint16_t readU16(const std::string& s, std::size_t pos)
+{
+    return static_cast<unsigned char>(s[pos])
+            | (static_cast<unsigned char>(s[pos + 1]) << 8);
+}
+
+} // anonymous
+
+const std::string SyntaxBinaryFormatTester::Name = "SYNTAX BINARY FORMAT";
+
+APITestSuite* SyntaxBinaryFormatTester::suite()
+{
+    return static_cast<APITestSuite*>(suite_);
+}
+
+void SyntaxBinaryFormatTester::setUp()
+{
+}
+
+void SyntaxBinaryFormatTester::tearDown()
+{
+}
+
+std::unique_ptr<SyntaxTree> SyntaxBinaryFormatTester::parse(const std::string& s,
+                                                            SyntaxTree::SyntaxCategory syntaxCat)
+{
+    return SyntaxTree::parseText(SourceText(s),
+                                 TextPreprocessingState::Preprocessed,
+                                 TextCompleteness::Fragment,
+                                 ParseOptions(),
+                                 "<test>",
+                                 syntaxCat);
+}
+
+std::string SyntaxBinaryFormatTester::write(const SyntaxTree* tree)
+{
+    std::ostringstream oss;
+    SyntaxWriterBinaryFormat writer(oss);
+    writer.write(tree);
+    return oss.str();
+}
+
+std::string SyntaxBinaryFormatTester::describe(SyntaxTree* tree)
+{
+    std::ostringstream oss;
+    Describer describer(tree, oss);
+    describer.describe(tree->root());
+    for (const auto& diag : tree->diagnostics())
+        oss << diag << "\n";
+    return oss.str();
+}
+
+std::unique_ptr<SyntaxTree> SyntaxBinaryFormatTester::roundTrip(const SyntaxTree* tree)
+{
+    auto data = write(tree);
+    SyntaxReaderBinaryFormat reader(data);
+    auto readTree = reader.read();
+    PSY_EXPECT_TRUE(readTree);
+    PSY_EXPECT_EQ_STR(write(readTree.get()), data);
+    return readTree;
+}
+
+void SyntaxBinaryFormatTester::check(const std::string& s, SyntaxTree::SyntaxCategory syntaxCat)
+{
+    auto tree = parse(s, syntaxCat);
+    auto readTree = roundTrip(tree.get());
+    PSY_EXPECT_EQ_STR(describe(readTree.get()), describe(tree.get()));
+}
+
+void SyntaxBinaryFormatTester::testSyntaxBinaryFormat()
+{
+    return run<SyntaxBinaryFormatTester>(tests_);
+}
+
+void SyntaxBinaryFormatTester::case0000()
+{
+    check("int x ;");
+}
+
+void SyntaxBinaryFormatTester::case0001()
+{
+    check("int f ( int p , ... )\n"
+          "{\n"
+          "    int x = p > 1 ? ( int ) 2.0 : 'c' ;\n"
+          "    if ( x ) x ++ ; else goto end ;\n"
+          "    while ( x -- ) { continue ; }\n"
+          "    for ( int i = 0 ; i < 10 ; ++ i ) break ;\n"
+          "    switch ( x ) { case 1 : default : ; }\n"
+          "end :\n"
+          "    return __builtin_va_arg ( p , int ) ;\n"
+          "}\n");
+}
+
+void SyntaxBinaryFormatTester::case0002()
+{
+    // Ambiguities, whose alternatives share nodes.
+    check("void f ( )\n"
+          "{\n"
+          "    x * y ;\n"
+          "    ( x ) * y ;\n"
+          "    ( x ) - y ;\n"
+          "    sizeof ( x ) ;\n"
+          "}\n");
+}
+
+void SyntaxBinaryFormatTester::case0003()
+{
+    check("struct S { int b : 2 __attribute__ ( ( packed ) ) ; } ;\n"
+          "const char * s = \"a\" \"b\" \"c\" ;\n"
+          "void f ( int foo , int bar )\n"
+          "{\n"
+          "    asm volatile ( \"addl %0, %1\" : \"+r\" ( foo ) : \"g\" ( bar ) : \"memory\" ) ;\n"
+          "}\n");
+}
+
+void SyntaxBinaryFormatTester::case0004()
+{
+    auto tree = parse("int x = ; int y");
+    PSY_EXPECT_FALSE(tree->diagnostics().empty());
+
+    auto readTree = roundTrip(tree.get());
+    PSY_EXPECT_EQ_INT(readTree->diagnostics().size(), tree->diagnostics().size());
+    PSY_EXPECT_EQ_STR(describe(readTree.get()), describe(tree.get()));
+}
+
+void SyntaxBinaryFormatTester::case0005()
+{
+    check("x + y * f ( 1 , 2 ) [ 3 ] . z", SyntaxTree::SyntaxCategory::Expressions);
+}
+
+void SyntaxBinaryFormatTester::case0006()
+{
+    check("int x ;\n"
+          "# 10 \"x.h\"\n"
+          "int y ;\n"
+          "# 20 \"y.h\"\n"
+          "int z ;\n");
+}
+
+void SyntaxBinaryFormatTester::case0007()
+{
+    auto tree = parse("int x ;");
+    auto readTree = roundTrip(tree.get());
+    PSY_EXPECT_EQ_STR(readTree->filePath(), tree->filePath());
+    PSY_EXPECT_EQ_STR(readTree->text().rawText(), tree->text().rawText());
+    PSY_EXPECT_TRUE(readTree->translationUnitRoot());
+}
+
+void SyntaxBinaryFormatTester::case0008()
+{
+    auto tree = parse("int x ; int y ;");
+    auto readTree = roundTrip(tree.get());
+
+    // The tokens of the read tree have their lexemes in that tree.
+    auto TU = readTree->translationUnitRoot();
+    auto decl = TU->declarations()->value->asVariableAndOrFunctionDeclaration();
+    PSY_EXPECT_TRUE(decl);
+    auto decltor = decl->declarators()->value->asIdentifierDeclarator();
+    PSY_EXPECT_TRUE(decltor);
+    PSY_EXPECT_EQ_STR(decltor->identifierToken().valueText(), "x");
+    PSY_EXPECT_EQ_INT(decltor->identifierToken().location().lineSpan().span().start().character(), 4);
+}
+
+void SyntaxBinaryFormatTester::case0009()
+{
+    std::string s;
+    for (auto i = 0; i < 1000; ++i) {
+        s += "int f" + std::to_string(i) + " ( int p ) ";
+        s += "{ return p * " + std::to_string(i) + " + f" + std::to_string(i) + " ( p - 1 ) ; }\n";
+    }
+    check(s);
+}
+
+void SyntaxBinaryFormatTester::case0050()
+{
+    PSY_EXPECT_FALSE(SyntaxReaderBinaryFormat("").read());
+    PSY_EXPECT_FALSE(SyntaxReaderBinaryFormat("PSYAS").read());
+    PSY_EXPECT_FALSE(SyntaxReaderBinaryFormat("NOTAST\x01").read());
+
+    auto data = write(parse("int x ;").get());
+    data[6] = static_cast<char>(SyntaxWriterBinaryFormat::version() + 1);
+    PSY_EXPECT_FALSE(SyntaxReaderBinaryFormat(data).read());
+}
+
+void SyntaxBinaryFormatTester::case0051()
+{
+    auto data = write(parse("int x = 1 ; void f ( ) { x ++ ; }").get());
+    for (std::size_t size = 0; size < data.size(); ++size)
+        PSY_EXPECT_FALSE(SyntaxReaderBinaryFormat(data.data(), size).read());
+    PSY_EXPECT_TRUE(SyntaxReaderBinaryFormat(data.data(), data.size()).read());
+}
+
+void SyntaxBinaryFormatTester::case0052()
+{
+    auto data = write(parse("int x ;").get());
+    PSY_EXPECT_FALSE(SyntaxReaderBinaryFormat(data + '\0').read());
+}
+
+void SyntaxBinaryFormatTester::case0053()
+{
+    // Corrupted data is either rejected or read as a well-formed tree.
+    auto data = write(parse("int x = 1 ; void f ( ) { x ++ ; }").get());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        auto corrupted = data;
+        corrupted[i] = static_cast<char>(~corrupted[i]);
+        SyntaxReaderBinaryFormat(corrupted).read();
+    }
+}
+
+void SyntaxBinaryFormatTester::case0100()
+{
+    auto tree = parse("int f ( int p ) { return p ; }");
+
+    std::ostringstream oss;
+    {
+        SyntaxFlatWriterJSONFormat writer(tree.get(), oss);
+        writer.write(tree->root());
+        PSY_EXPECT_FALSE(writer.hasError());
+    }
+
+    PSY_EXPECT_EQ_STR(oss.str(),
+R"({"type":"tree","file":"<test>"}
+{"type":"node","id":0,"kind":"BuiltinTypeSpecifier","children":[],"span":[0,3],"start":[1,0],"end":[1,2]}
+{"type":"node","id":1,"kind":"IdentifierDeclarator","children":[],"span":[4,5],"start":[1,4],"end":[1,4]}
+{"type":"node","id":2,"kind":"BuiltinTypeSpecifier","children":[],"span":[8,11],"start":[1,8],"end":[1,10]}
+{"type":"node","id":3,"kind":"IdentifierDeclarator","children":[],"span":[12,13],"start":[1,12],"end":[1,12]}
+{"type":"node","id":4,"kind":"ParameterDeclaration","children":[2,3],"span":[8,13],"start":[1,8],"end":[1,12]}
+{"type":"node","id":5,"kind":"ParameterSuffix","children":[4],"span":[6,15],"start":[1,6],"end":[1,14]}
+{"type":"node","id":6,"kind":"FunctionDeclarator","children":[1,5],"span":[4,15],"start":[1,4],"end":[1,14]}
+{"type":"node","id":7,"kind":"IdentifierName","children":[],"span":[25,26],"start":[1,25],"end":[1,25]}
+{"type":"node","id":8,"kind":"ReturnStatement","children":[7],"span":[18,28],"start":[1,18],"end":[1,27]}
+{"type":"node","id":9,"kind":"CompoundStatement","children":[8],"span":[16,30],"start":[1,16],"end":[1,29]}
+{"type":"node","id":10,"kind":"FunctionDefinition","children":[0,6,9],"span":[0,30],"start":[1,0],"end":[1,29]}
+{"type":"node","id":11,"kind":"TranslationUnit","children":[10],"span":[0,30],"start":[1,0],"end":[1,29]}
+{"type":"end","nodes":12}
+)");
+}
+
+void SyntaxBinaryFormatTester::case0101()
+{
+    auto tree = parse("int x ;\nint y ;");
+
+    std::ostringstream oss;
+    {
+        SyntaxFlatWriterBinaryFormat writer(tree.get(), oss);
+        writer.write(tree->root());
+    }
+    auto out = oss.str();
+
+    PSY_EXPECT_EQ_STR(out.substr(0, 6), "PSYFLT");
+    PSY_EXPECT_EQ_INT(out[6], SyntaxFlatWriterBinaryFormat::version());
+    PSY_EXPECT_EQ_INT(readU32(out, 7), 6);
+    PSY_EXPECT_EQ_STR(out.substr(11, 6), "<test>");
+
+    const auto kRecSize = SyntaxFlatWriterBinaryFormat::recordSize();
+    std::size_t pos = 17;
+    PSY_EXPECT_EQ_INT(out.size(), pos + 8 * kRecSize);
+
+    // The second declaration: `int y ;'.
+    auto rec = pos + 5 * kRecSize;
+    PSY_EXPECT_EQ_INT(readU16(out, rec), VariableAndOrFunctionDeclaration);
+    PSY_EXPECT_EQ_INT(readU16(out, rec + 2), SyntaxFlatWriterBinaryFormat::hasTokensFlag());
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 4), 2);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 8), 4);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 12), 2);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 16), 8);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 20), 15);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 24), 2);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 28), 8);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 32), 2);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 36), 14);
+
+    // Its children: `y' and, before it, `int'.
+    rec = pos + 4 * kRecSize;
+    PSY_EXPECT_EQ_INT(readU16(out, rec), IdentifierDeclarator);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 4), 0);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 8), SyntaxFlatWriter::noNode());
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 12), 3);
+    rec = pos + 3 * kRecSize;
+    PSY_EXPECT_EQ_INT(readU16(out, rec), BuiltinTypeSpecifier);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 12), SyntaxFlatWriter::noNode());
+
+    // The root: the children are the declarations.
+    rec = pos + 6 * kRecSize;
+    PSY_EXPECT_EQ_INT(readU16(out, rec), TranslationUnit);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 4), 2);
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 8), 5);
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 5 * kRecSize + 12), 2);
+    PSY_EXPECT_EQ_INT(readU32(out, pos + 2 * kRecSize + 12), SyntaxFlatWriter::noNode());
+
+    rec = pos + 7 * kRecSize;
+    PSY_EXPECT_EQ_INT(readU16(out, rec), SyntaxFlatWriterBinaryFormat::noKind());
+    PSY_EXPECT_EQ_INT(readU32(out, rec + 4), 7);
+}
+
+void SyntaxBinaryFormatTester::case0102()
+{
+    // Ambiguities, whose alternatives share nodes: those are written for each parent.
+    auto tree = parse("void f ( )\n"
+                      "{\n"
+                      "    x * y ;\n"
+                      "    ( x ) * y ;\n"
+                      "    ( x ) - y ;\n"
+                      "}\n");
+
+    std::ostringstream oss;
+    {
+        SyntaxFlatWriterJSONFormat writer(tree.get(), oss);
+        writer.write(tree->root());
+    }
+    auto out = oss.str();
+
+    auto desc = describe(tree.get());
+    auto nodeCnt = 0U;
+    for (std::size_t pos = 0; pos < desc.size(); pos = desc.find('\n', pos) + 1) {
+        if (desc[pos] != ' ')
+            ++nodeCnt;
+    }
+
+    auto lineCnt = 0U;
+    for (std::size_t pos = 0; (pos = out.find('\n', pos)) != std::string::npos; ++pos)
+        ++lineCnt;
+    PSY_EXPECT_EQ_INT(lineCnt, nodeCnt + 2);
+    PSY_EXPECT_TRUE(out.find("{\"type\":\"end\",\"nodes\":" + std::to_string(nodeCnt) + "}") != std::string::npos);
+    PSY_EXPECT_TRUE(out.find("\"kind\":\"AmbiguousCallOrVariableDeclaration\"") != std::string::npos);
+    PSY_EXPECT_TRUE(out.find("\"kind\":\"AmbiguousCastOrBinaryExpression\"") != std::string::npos);
+}
+
+void SyntaxBinaryFormatTester::case0103()
+{
+    std::string s;
+    for (auto i = 0; i < 1000; ++i) {
+        s += "int f" + std::to_string(i) + " ( int p ) ";
+        s += "{ return p * " + std::to_string(i) + " + f" + std::to_string(i) + " ( p - 1 ) ; }\n";
+    }
+    auto tree = parse(s);
+
+    std::ostringstream oss;
+    {
+        SyntaxFlatWriterBinaryFormat writer(tree.get(), oss);
+        writer.write(tree->root());
+        writer.write(tree->root());
+    }
+
+    std::string file;
+    auto f = std::tmpfile();
+    PSY_EXPECT_TRUE(f);
+    {
+        SyntaxFlatWriterBinaryFormat writer(tree.get(), fileno(f));
+        writer.write(tree->root());
+        writer.write(tree->root());
+        writer.flush();
+        PSY_EXPECT_FALSE(writer.hasError());
+    }
+    std::rewind(f);
+    char buf[4096];
+    std::size_t cnt;
+    while ((cnt = std::fread(buf, 1, sizeof(buf), f)) > 0)
+        file.append(buf, cnt);
+    std::fclose(f);
+
+    PSY_EXPECT_TRUE(oss.str().size() > (1 << 16));
+    PSY_EXPECT_TRUE(file == oss.str());
+
+    // The magic and version are written once, and the records of each tree end with the last one.
+    auto out = oss.str();
+    const auto kRecSize = SyntaxFlatWriterBinaryFormat::recordSize();
+    auto treeSize = (out.size() - 7) / 2;
+    PSY_EXPECT_EQ_INT((treeSize - 10) % kRecSize, 0);
+    auto nodeCnt = (treeSize - 10) / kRecSize - 1;
+    auto end = 7 + 10 + nodeCnt * kRecSize;
+    PSY_EXPECT_EQ_INT(readU16(out, end), SyntaxFlatWriterBinaryFormat::noKind());
+    PSY_EXPECT_EQ_INT(readU32(out, end + 4), nodeCnt);
+    PSY_EXPECT_EQ_INT(readU16(out, end - kRecSize), TranslationUnit);
+    PSY_EXPECT_EQ_INT(readU32(out, end - kRecSize + 4), 1000);
+    PSY_EXPECT_EQ_STR(out.substr(end + kRecSize + 4, 6), "<test>");
+}
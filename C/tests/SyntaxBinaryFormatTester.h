@@ -0,0 +1,121 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef PSYCHE_C_SYNTAX_BINARY_FORMAT_TESTER_H__
+#define PSYCHE_C_SYNTAX_BINARY_FORMAT_TESTER_H__
+
+#include "Fwds.h"
+#include "tests/Tester.h"
+
+#include "C/SyntaxTree.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define TEST_SYNTAX_BINARY_FORMAT(Function) TestFunction { &SyntaxBinaryFormatTester::Function, #Function }
+
+namespace psy {
+namespace C {
+
+class APITestSuite;
+
+class SyntaxBinaryFormatTester final : public Tester
+{
+public:
+    SyntaxBinaryFormatTester(TestSuite* suite) : Tester(suite) {}
+
+    APITestSuite* suite();
+
+    static const std::string Name;
+    virtual std::string name() const override { return Name; }
+    virtual void setUp() override;
+    virtual void tearDown() override;
+
+    static std::unique_ptr<SyntaxTree> parse(const std::string& s,
+                                             SyntaxTree::SyntaxCategory syntaxCat = SyntaxTree::SyntaxCategory::UNSPECIFIED);
+    static std::string write(const SyntaxTree* tree);
+    static std::string describe(SyntaxTree* tree);
+    std::unique_ptr<SyntaxTree> roundTrip(const SyntaxTree* tree);
+    void check(const std::string& s,
+               SyntaxTree::SyntaxCategory syntaxCat = SyntaxTree::SyntaxCategory::UNSPECIFIED);
+
+    void testSyntaxBinaryFormat();
+
+    using TestFunction = std::pair<std::function<void(SyntaxBinaryFormatTester*)>, const char*>;
+
+    /*
+        + 0000-0049 -> round trip
+        + 0050-0099 -> malformed data
+        + 0100-0149 -> flat export (JSON Lines and binary)
+     */
+
+    void case0000();
+    void case0001();
+    void case0002();
+    void case0003();
+    void case0004();
+    void case0005();
+    void case0006();
+    void case0007();
+    void case0008();
+    void case0009();
+
+    void case0050();
+    void case0051();
+    void case0052();
+    void case0053();
+
+    void case0100();
+    void case0101();
+    void case0102();
+    void case0103();
+
+    std::vector<TestFunction> tests_
+    {
+        TEST_SYNTAX_BINARY_FORMAT(case0000),
+        TEST_SYNTAX_BINARY_FORMAT(case0001),
+        TEST_SYNTAX_BINARY_FORMAT(case0002),
+        TEST_SYNTAX_BINARY_FORMAT(case0003),
+        TEST_SYNTAX_BINARY_FORMAT(case0004),
+        TEST_SYNTAX_BINARY_FORMAT(case0005),
+        TEST_SYNTAX_BINARY_FORMAT(case0006),
+        TEST_SYNTAX_BINARY_FORMAT(case0007),
+        TEST_SYNTAX_BINARY_FORMAT(case0008),
+        TEST_SYNTAX_BINARY_FORMAT(case0009),
+
+        TEST_SYNTAX_BINARY_FORMAT(case0050),
+        TEST_SYNTAX_BINARY_FORMAT(case0051),
+        TEST_SYNTAX_BINARY_FORMAT(case0052),
+        TEST_SYNTAX_BINARY_FORMAT(case0053),
+
+        TEST_SYNTAX_BINARY_FORMAT(case0100),
+        TEST_SYNTAX_BINARY_FORMAT(case0101),
+        TEST_SYNTAX_BINARY_FORMAT(case0102),
+        TEST_SYNTAX_BINARY_FORMAT(case0103),
+    };
+};
+
+} // C
+} // psy
+
+#endif
@@ -20,7 +20,10 @@
 
 #include "TestSuite_API.h"
 
+#include "CallGraphTester.h"
+#include "ControlFlowGraphTester.h"
 #include "SemanticModelTester.h"
+#include "SyntaxBinaryFormatTester.h"
 
 using namespace psy;
 using namespace C;
@@ -33,10 +36,28 @@ std::tuple<int, int> APITestSuite::testAll()
     auto SM = std::make_unique<SemanticModelTester>(this);
     SM->testSemanticModel();
 
-    auto res = std::make_tuple(SM->totalPassed(),
-                               SM->totalFailed());
+    auto CFG = std::make_unique<ControlFlowGraphTester>(this);
+    CFG->testControlFlowGraph();
+
+    auto CG = std::make_unique<CallGraphTester>(this);
+    CG->testCallGraph();
+
+    auto SBF = std::make_unique<SyntaxBinaryFormatTester>(this);
+    SBF->testSyntaxBinaryFormat();
+
+    auto res = std::make_tuple(SM->totalPassed()
+                                    + CFG->totalPassed()
+                                    + CG->totalPassed()
+                                    + SBF->totalPassed(),
+                               SM->totalFailed()
+                                    + CFG->totalFailed()
+                                    + CG->totalFailed()
+                                    + SBF->totalFailed());
 
     testers_.emplace_back(SM.release());
+    testers_.emplace_back(CFG.release());
+    testers_.emplace_back(CG.release());
+    testers_.emplace_back(SBF.release());
 
     return res;
 }
@@ -41,6 +41,9 @@ namespace C {
 class APITestSuite : public TestSuite
 {
     friend class SemanticModelTester;
+    friend class ControlFlowGraphTester;
+    friend class CallGraphTester;
+    friend class SyntaxBinaryFormatTester;
 
 public:
     virtual ~APITestSuite();
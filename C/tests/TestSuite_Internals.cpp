@@ -32,6 +32,7 @@
 
 #include "BinderTester.h"
 #include "ParserTester.h"
+#include "PreprocessorTester.h"
 #include "ReparserTester.h"
 
 #include <algorithm>
@@ -65,16 +66,22 @@ std::tuple<int, int> InternalsTestSuite::testAll()
     auto C = std::make_unique<BinderTester>(this);
     C->testBinder();
 
+    auto D = std::make_unique<PreprocessorTester>(this);
+    D->testPreprocessor();
+
     auto res = std::make_tuple(P->totalPassed()
                                     + B->totalPassed()
-                                    + C->totalPassed(),
+                                    + C->totalPassed()
+                                    + D->totalPassed(),
                                P->totalFailed()
                                     + B->totalFailed()
-                                    + C->totalFailed());
+                                    + C->totalFailed()
+                                    + D->totalFailed());
 
     testers_.emplace_back(P.release());
     testers_.emplace_back(B.release());
     testers_.emplace_back(C.release());
+    testers_.emplace_back(D.release());
 
     return res;
 }
@@ -261,6 +268,141 @@ void InternalsTestSuite::parse(std::string source,
     PSY_EXPECT_EQ_STR(namesP, names);
 }
 
+void InternalsTestSuite::changeText(std::string source, TextChange change)
+{
+    tree_ = SyntaxTree::parseText(source,
+                                  TextPreprocessingState::Unknown,
+                                  TextCompleteness::Fragment);
+    auto treeP = tree_->withChangedText(change);
+
+    auto text = source;
+    text.replace(change.span().start(),
+                 change.span().end() - change.span().start(),
+                 change.newText());
+    PSY_EXPECT_EQ_STR(treeP->text().rawText(), text);
+
+    // The SyntaxTree with the changed text must be like one parsed anew.
+    auto expectedTree = SyntaxTree::parseText(text,
+                                              TextPreprocessingState::Unknown,
+                                              TextCompleteness::Fragment);
+
+    PSY_EXPECT_EQ_INT(treeP->tokenCount(), expectedTree->tokenCount());
+    for (LexedTokens::IndexType tkIdx = 1; tkIdx < expectedTree->tokenCount(); ++tkIdx) {
+        const auto& tk = treeP->tokenAt(tkIdx);
+        const auto& expectedTk = expectedTree->tokenAt(tkIdx);
+        PSY_EXPECT_EQ_ENU(tk.kind(), expectedTk.kind(), SyntaxKind);
+        PSY_EXPECT_EQ_STR(tk.valueText(), expectedTk.valueText());
+        PSY_EXPECT_TRUE(tk.span() == expectedTk.span());
+        PSY_EXPECT_TRUE(tk.location() == expectedTk.location());
+        PSY_EXPECT_EQ_INT(tk.isAtStartOfLine(), expectedTk.isAtStartOfLine());
+        PSY_EXPECT_EQ_INT(tk.hasLeadingTrivia(), expectedTk.hasLeadingTrivia());
+        if (tk.kind() == IdentifierToken) {
+            PSY_EXPECT_EQ_PTR(tk.valueLexeme(),
+                              treeP->identifier(tk.valueText_c_str(), tk.valueText().size()));
+        }
+    }
+    PSY_EXPECT_EQ_INT(treeP->diagnostics().size(), expectedTree->diagnostics().size());
+
+    std::ostringstream ossTree;
+    SyntaxNamePrinter printer(treeP.get());
+    printer.print(treeP->root(), SyntaxNamePrinter::Style::Plain, ossTree);
+
+    std::ostringstream ossExpectedTree;
+    SyntaxNamePrinter expectedPrinter(expectedTree.get());
+    expectedPrinter.print(expectedTree->root(), SyntaxNamePrinter::Style::Plain, ossExpectedTree);
+
+    PSY_EXPECT_EQ_STR(ossTree.str(), ossExpectedTree.str());
+
+    std::ostringstream ossText;
+    Unparser unparser(treeP.get());
+    unparser.unparse(treeP->root(), ossText);
+
+    std::ostringstream ossExpectedText;
+    Unparser expectedUnparser(expectedTree.get());
+    expectedUnparser.unparse(expectedTree->root(), ossExpectedText);
+
+    PSY_EXPECT_EQ_STR(ossText.str(), ossExpectedText.str());
+
+    // The nodes, including those adopted from the original SyntaxTree, must
+    // belong to the SyntaxTree with the changed text.
+    class NodeOwnershipChecker : public SyntaxVisitor
+    {
+    public:
+        NodeOwnershipChecker(const SyntaxTree* tree)
+            : SyntaxVisitor(tree)
+            , foreignNodeCnt_(0)
+        {}
+
+        bool preVisit(const SyntaxNode* node) override
+        {
+            if (node->syntaxTree() != tree_)
+                ++foreignNodeCnt_;
+            return true;
+        }
+
+        int foreignNodeCnt_;
+    };
+    NodeOwnershipChecker checker(treeP.get());
+    checker.visit(treeP->root());
+    PSY_EXPECT_EQ_INT(checker.foreignNodeCnt_, 0);
+}
+
+void InternalsTestSuite::parseFunctionBodiesInParallel(std::string text)
+{
+    ParseOptions parseOpts;
+    parseOpts.setTreatmentOfFunctionBodies(ParseOptions::TreatmentOfFunctionBodies::Parallel);
+    tree_ = SyntaxTree::parseText(text,
+                                  TextPreprocessingState::Unknown,
+                                  TextCompleteness::Fragment,
+                                  parseOpts);
+
+    // The SyntaxTree must be like one whose function bodies are parsed sequentially.
+    auto expectedTree = SyntaxTree::parseText(text,
+                                              TextPreprocessingState::Unknown,
+                                              TextCompleteness::Fragment);
+
+    PSY_EXPECT_EQ_INT(tree_->diagnostics().size(), expectedTree->diagnostics().size());
+    PSY_EXPECT_EQ_INT(tree_->nodeCount(), expectedTree->nodeCount());
+
+    std::ostringstream ossTree;
+    SyntaxNamePrinter printer(tree_.get());
+    printer.print(tree_->root(), SyntaxNamePrinter::Style::Plain, ossTree);
+
+    std::ostringstream ossExpectedTree;
+    SyntaxNamePrinter expectedPrinter(expectedTree.get());
+    expectedPrinter.print(expectedTree->root(), SyntaxNamePrinter::Style::Plain, ossExpectedTree);
+
+    PSY_EXPECT_EQ_STR(ossTree.str(), ossExpectedTree.str());
+
+    std::ostringstream ossText;
+    Unparser unparser(tree_.get());
+    unparser.unparse(tree_->root(), ossText);
+
+    std::ostringstream ossExpectedText;
+    Unparser expectedUnparser(expectedTree.get());
+    expectedUnparser.unparse(expectedTree->root(), ossExpectedText);
+
+    PSY_EXPECT_EQ_STR(ossText.str(), ossExpectedText.str());
+}
+
+void InternalsTestSuite::locateDiagnostic(std::string text,
+                                          unsigned line,
+                                          unsigned character,
+                                          std::string snippet)
+{
+    tree_ = SyntaxTree::parseText(text,
+                                  TextPreprocessingState::Preprocessed,
+                                  TextCompleteness::Fragment);
+
+    // The first diagnostic must be located at, and quote, the given line.
+    PSY_EXPECT_TRUE(!tree_->diagnostics().empty());
+    const auto diag = tree_->diagnostics().front();
+    const auto& lineSpan = diag.location().lineSpan();
+    PSY_EXPECT_EQ_INT(lineSpan.span().start().line(), line);
+    PSY_EXPECT_EQ_INT(lineSpan.span().start().character(), character);
+    PSY_EXPECT_EQ_STR(diag.snippet().substr(0, diag.snippet().find('\n')), snippet);
+}
+
 void InternalsTestSuite::reparse(std::string source,
                                  Expectation X,
                                  Reparser::DisambiguationStrategy strategy)
@@ -635,10 +777,8 @@ bool typeMatchesBinding(const TypeSymbol* tySym, const DeclSummary& decl)
     return true;
 }
 
-bool symbolMatchesBinding(const std::unique_ptr<Symbol>& sym, const DeclSummary& summary)
+bool symbolMatchesBinding(const Symbol* candSym, const DeclSummary& summary)
 {
-    const Symbol* candSym = sym.get();
-
     if (candSym->kind() != summary.symK_)
         return REJECT_CANDIDATE(candSym, "symbol kind mismatch");
 
@@ -684,13 +824,12 @@ void InternalsTestSuite::bind(std::string text, Expectation X)
     if (!checkErrorAndWarn(X))
         return;
 
-    auto sym = compilation->assembly()->findSymDEF(
-                [] (const auto& sym) {
-                    return sym->kind() == SymbolKind::Library;
-                });
-    if (sym == nullptr)
+    auto assembly = compilation->assembly();
+    if (assembly->findSymDEFs(SymbolKind::Library).empty())
         PSY__internals__FAIL("link unit not found");
 
+    PSY_EXPECT_EQ_INT(assembly->findSymDEFs(tree_.get()).size(), assembly->symbols().size());
+
     for (const auto& binding : X.bindings_) {
 #ifdef DEBUG_BINDING_SEARCH
         std::cout << "\n\t\t...";
@@ -698,9 +837,10 @@ void InternalsTestSuite::bind(std::string text, Expectation X)
         using namespace std::placeholders;
 
         auto pred = std::bind(symbolMatchesBinding, _1, binding);
-        auto sym = compilation->assembly()->findSymDEF(pred);
+        const auto& candSyms = assembly->findSymDEFs(binding.name_);
+        auto it = std::find_if(candSyms.begin(), candSyms.end(), pred);
 
-        if (sym == nullptr) {
+        if (it == candSyms.end()) {
             auto s = "no symbol matches the expectation: "
                     + binding.name_ + " " + to_string(binding.symK_);
             PSY__internals__FAIL(s);
@@ -712,3 +852,43 @@ void InternalsTestSuite::bind(std::string text, Expectation X)
 
     }
 }
+
+void InternalsTestSuite::preprocess(std::string text,
+                                    std::string expectedText,
+                                    Expectation X,
+                                    ParseOptions parseOpts)
+{
+#ifdef DEBUG_DIAGNOSTICS
+    if (X.numW_ > 0 || X.numE_ > 0) {
+        std::cout << std::endl;
+        if (X.numW_ > 0)
+            std::cout << "\t\t[expect (preprocessor) WARNING]\n";
+        if (X.numE_ > 0)
+            std::cout << "\t\t[expect (preprocessor) ERROR]\n";
+    }
+#endif
+
+    if (parseOpts.treatmentOfPreprocessing() == ParseOptions::TreatmentOfPreprocessing::None)
+        parseOpts.setTreatmentOfPreprocessing(ParseOptions::TreatmentOfPreprocessing::Preprocess);
+
+    tree_ = SyntaxTree::parseText(text,
+                                  TextPreprocessingState::Unpreprocessed,
+                                  TextCompleteness::Fragment,
+                                  parseOpts,
+                                  "<test>");
+
+    if (!checkErrorAndWarn(X))
+        return;
+
+    std::string textP;
+    for (LexedTokens::IndexType tkIdx = 1; tkIdx < tree_->tokenCount(); ++tkIdx) {
+        const auto& tk = tree_->tokenAt(tkIdx);
+        if (tk.kind() == EndOfFile)
+            break;
+        if (!textP.empty())
+            textP += ' ';
+        textP += tk.valueText();
+    }
+
+    PSY_EXPECT_EQ_STR(textP, expectedText);
+}
@@ -43,6 +43,7 @@ class InternalsTestSuite : public TestSuite
     friend class ParserTester;
     friend class ReparserTester;
     friend class BinderTester;
+    friend class PreprocessorTester;
 
 public:
     virtual ~InternalsTestSuite();
@@ -61,6 +62,9 @@ private:
     void parse(std::string text,
                Expectation X = Expectation(),
                SyntaxTree::SyntaxCategory synCat = SyntaxTree::SyntaxCategory::UNSPECIFIED);
+    void changeText(std::string text, TextChange change);
+    void parseFunctionBodiesInParallel(std::string text);
+    void locateDiagnostic(std::string text, unsigned line, unsigned character, std::string snippet);
 
     void reparse_withSyntaxCorrelation(std::string text, Expectation X = Expectation());
     void reparse_withTypeSynonymVerification(std::string text, Expectation X = Expectation());
@@ -71,6 +75,11 @@ private:
 
     void bind(std::string text, Expectation X = Expectation());
 
+    void preprocess(std::string text,
+                    std::string expectedText,
+                    Expectation X = Expectation(),
+                    ParseOptions parseOpts = ParseOptions());
+
     std::unique_ptr<SyntaxTree> tree_;
     std::unique_ptr<Compilation> compilation_;
     std::vector<std::unique_ptr<Tester>> testers_;
@@ -0,0 +1,97 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "BackgroundFileWriter.h"
+
+#include "IO.h"
+
+using namespace cnip;
+
+BackgroundFileWriter::BackgroundFileWriter(std::size_t maxPendingCnt)
+    : maxPendingCnt_(maxPendingCnt ? maxPendingCnt : 1)
+    , isWriting_(false)
+    , isStopped_(false)
+    , failureCnt_(0)
+{}
+
+BackgroundFileWriter::~BackgroundFileWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopped_ = true;
+    }
+    cond_.notify_all();
+
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void BackgroundFileWriter::write(std::string filePath, std::string content)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!thread_.joinable())
+            thread_ = std::thread(&BackgroundFileWriter::work, this);
+        cond_.wait(lock, [this] () { return pending_.size() < maxPendingCnt_; });
+        pending_.emplace_back(std::move(filePath), std::move(content));
+    }
+    cond_.notify_all();
+}
+
+int BackgroundFileWriter::wait(std::ostream& err)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] () { return pending_.empty() && !isWriting_; });
+
+    err << err_.str();
+    err_.str("");
+    auto failureCnt = failureCnt_;
+    failureCnt_ = 0;
+    return failureCnt;
+}
+
+void BackgroundFileWriter::work()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this] () { return !pending_.empty() || isStopped_; });
+
+        // Pending writes are completed even if the writer is stopped.
+        if (pending_.empty())
+            return;
+
+        auto file = std::move(pending_.front());
+        pending_.pop_front();
+        isWriting_ = true;
+        lock.unlock();
+        cond_.notify_all();
+
+        std::ostringstream err;
+        auto exit = psy::writeFile(file.first, file.second, err);
+
+        lock.lock();
+        isWriting_ = false;
+        if (exit != 0) {
+            ++failureCnt_;
+            err_ << err.str();
+        }
+        cond_.notify_all();
+    }
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef CNIPPET_BACKGROUND_FILE_WRITER_H__
+#define CNIPPET_BACKGROUND_FILE_WRITER_H__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace cnip {
+
+/*!
+ * \brief The BackgroundFileWriter class.
+ *
+ * A writer of files on a background thread, so that whoever produces their
+ * content doesn't wait for the (possibly slow) file system. The thread is
+ * started by the first write. At most a given number of writes are pending;
+ * beyond that, a write blocks until the thread catches up.
+ *
+ * \note
+ * The writer may be shared by threads.
+ */
+class BackgroundFileWriter final
+{
+public:
+    explicit BackgroundFileWriter(std::size_t maxPendingCnt = 16);
+    ~BackgroundFileWriter();
+
+    BackgroundFileWriter(const BackgroundFileWriter&) = delete;
+    BackgroundFileWriter& operator=(const BackgroundFileWriter&) = delete;
+
+    /*!
+     * Schedule the writing of \p content to the file \p filePath, first
+     * waiting for room if the maximum number of writes is pending.
+     */
+    void write(std::string filePath, std::string content);
+
+    /*!
+     * Wait for the scheduled writes to complete, reporting the failed ones
+     * to \p err; return the number of failures since the last call.
+     */
+    int wait(std::ostream& err);
+
+private:
+    void work();
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::pair<std::string, std::string>> pending_;
+    std::size_t maxPendingCnt_;
+    bool isWriting_;
+    bool isStopped_;
+    int failureCnt_;
+    std::ostringstream err_;
+    std::thread thread_;
+};
+
+} // cnip
+
+#endif
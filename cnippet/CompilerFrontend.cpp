@@ -29,3 +29,8 @@ CompilerFrontend::~CompilerFrontend()
 
 CompilerFrontend::CompilerFrontend()
 {}
+
+int CompilerFrontend::finish(std::ostream&)
+{
+    return 0;
+}
@@ -27,10 +27,17 @@
 
 #include "cxxopts.hpp"
 
+#include <ostream>
 #include <string>
 
 namespace cnip {
 
+/*!
+ * The name of a source text that isn't read from a file (e.g., one in a
+ * request to the Server); nothing is written to the file system for it.
+ */
+const char* const kBufferName = "<buffer>";
+
 /*!
  * \brief The CompilerFrontend class.
  */
@@ -39,7 +46,25 @@ class CompilerFrontend
 public:
     virtual ~CompilerFrontend();
 
-    virtual int run(const std::string& srcText, const psy::FileInfo& fi) = 0;
+    /*!
+     * Run the frontend on the source text \p srcText of the file \p fi,
+     * writing output (e.g., dumps) to \p out and diagnostics to \p err.
+     *
+     * \note
+     * A frontend keeps no per-file state between runs (only caches that are
+     * synchronized), so a single one may be shared by threads that run on
+     * different files with distinct streams.
+     */
+    virtual int run(const std::string& srcText,
+                    const psy::FileInfo& fi,
+                    std::ostream& out,
+                    std::ostream& err) = 0;
+
+    /*!
+     * Complete the work left running in the background (e.g., the writing of
+     * files), reporting failures to \p err.
+     */
+    virtual int finish(std::ostream& err);
 
 protected:
     CompilerFrontend();
@@ -22,12 +22,21 @@
 
 #include "FileInfo.h"
 #include "GnuCompilerFacade.h"
-#include "IO.h"
+#include "HeaderPrefixCache.h"
 #include "Plugin.h"
+#include "analysis/ControlFlowGraph.h"
+#include "analysis/ControlFlowGraphWriterBinaryFormat.h"
+#include "analysis/ControlFlowGraphWriterJSONFormat.h"
 #include "compilation/Compilation.h"
 #include "plugin-api/SourceInspector.h"
+#include "syntax/SyntaxFlatWriterBinaryFormat.h"
+#include "syntax/SyntaxFlatWriterJSONFormat.h"
 #include "syntax/SyntaxNamePrinter.h"
 
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
 using namespace cnip;
 using namespace psy;
 using namespace C;
@@ -38,6 +47,36 @@ bool globalDebugEnabled = false;
 
 namespace {
 const char* const kInclude = "#include";
+
+// Plugins aren't required to be thread-safe.
+std::mutex pluginMutex;
+
+// Turn the `#define NAME[(PARAMS)] BODY' lines of a preprocessor's `-dM' into `NAME[(PARAMS)]=BODY'.
+std::vector<std::string> predefinedMacrosFromDefinitions(const std::string& macroDefs) {
+    static const std::string kDefine = "#define ";
+
+    std::vector<std::string> macros;
+    std::string::size_type pos = 0;
+    while (pos < macroDefs.size()) {
+        auto end = macroDefs.find('\n', pos);
+        if (end == std::string::npos) end = macroDefs.size();
+        auto line = macroDefs.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (line.compare(0, kDefine.size(), kDefine) != 0) continue;
+        line.erase(0, kDefine.size());
+        auto nameEnd = line.find_first_of(" (");
+        if (nameEnd != std::string::npos && line[nameEnd] == '(') {
+            nameEnd = line.find(')', nameEnd);
+            if (nameEnd != std::string::npos) ++nameEnd;
+        }
+        if (nameEnd == std::string::npos)
+            macros.push_back(line + '=');
+        else
+            macros.push_back(line.substr(0, nameEnd) + '=' + (nameEnd < line.size() ? line.substr(nameEnd + 1) : ""));
+    }
+    return macros;
+}
 }
 
 constexpr int CCompilerFrontend::ERROR_PreprocessorInvocationFailure;
@@ -46,17 +85,27 @@ constexpr int CCompilerFrontend::ERROR_UnsuccessfulParsing;
 constexpr int CCompilerFrontend::ERROR_InvalidSyntaxTree;
 
 CCompilerFrontend::CCompilerFrontend(const cxxopts::ParseResult& parsedCmdLine)
-    : CompilerFrontend(), config_(new ConfigurationForC(parsedCmdLine)) {}
+    : CompilerFrontend(),
+      config_(new ConfigurationForC(parsedCmdLine)),
+      parseResultCache_(config_->parseCacheDir) {}
 
 CCompilerFrontend::~CCompilerFrontend() {}
 
-int CCompilerFrontend::run(const std::string& srcText, const FileInfo& fi) {
+int CCompilerFrontend::run(const std::string& srcText, const FileInfo& fi, std::ostream& out, std::ostream& err) {
     if (srcText.empty()) return 0;
 
-    return config_->inferMissingTypes ? extendWithStdLibHeaders(srcText, fi) : preprocess(srcText, fi);
+    Output output{out, err};
+    return config_->inferMissingTypes ? extendWithStdLibHeaders(srcText, fi, output) : preprocess(srcText, fi, output);
+}
+
+int CCompilerFrontend::finish(std::ostream& err) {
+    if (preprocessedFileWriter_.wait(err) == 0) return 0;
+
+    err << kCnip << "preprocessed file write failure" << std::endl;
+    return ERROR_PreprocessedFileWritingFailure;
 }
 
-int CCompilerFrontend::extendWithStdLibHeaders(const std::string& srcText, const psy::FileInfo& fi) {
+int CCompilerFrontend::extendWithStdLibHeaders(const std::string& srcText, const psy::FileInfo& fi, Output& output) {
     if (!Plugin::isLoaded()) return 1;
 
     std::istringstream iss(srcText);
@@ -67,9 +116,13 @@ int CCompilerFrontend::extendWithStdLibHeaders(const std::string& srcText, const
         if (line.find(kInclude) == 0) existingHeaders += line + '\n';
     }
 
-    SourceInspector* inspector = Plugin::createInspector();
-    auto stdLibHeaders = inspector->detectRequiredHeaders(srcText);
-    if (stdLibHeaders.empty()) return preprocess(srcText, fi);
+    std::vector<std::string> stdLibHeaders;
+    {
+        std::lock_guard<std::mutex> lock(pluginMutex);
+        SourceInspector* inspector = Plugin::createInspector();
+        stdLibHeaders = inspector->detectRequiredHeaders(srcText);
+    }
+    if (stdLibHeaders.empty()) return preprocess(srcText, fi, output);
 
     std::string srcText_P;
     srcText_P += "\n/* CNIPPET: Start of #include section */\n";
@@ -81,37 +134,152 @@ int CCompilerFrontend::extendWithStdLibHeaders(const std::string& srcText, const
     srcText_P += "\n/* End of #include section */\n\n";
     srcText_P += srcText;
 
-    return preprocess(srcText_P, fi);
+    return preprocess(srcText_P, fi, output);
 }
 
-int CCompilerFrontend::preprocess(const std::string& srcText, const psy::FileInfo& fi) {
+int CCompilerFrontend::preprocess(const std::string& srcText, const psy::FileInfo& fi, Output& output) {
+    // Without the expansion of `#include' directives, the text is preprocessed by the parser itself.
+    if (!config_->expandIncludes)
+        return constructSyntaxTree(srcText, fi, TextPreprocessingState::Unpreprocessed, output);
+
+    auto prefixLen = HeaderPrefixCache::headerPrefixLength(srcText);
+    if (prefixLen) return preprocessWithHeaderPrefixCache(srcText, prefixLen, fi, output);
+
     GnuCompilerFacade cc(config_->hostCompiler, to_string(config_->langStd), config_->macrosToDefine,
                          config_->macrosToUndef);
 
     std::string srcText_P;
     int exit;
-    if (config_->expandIncludes) {
-        std::tie(exit, srcText_P) = cc.preprocess(srcText);
-        if (exit != 0) {
-            std::cerr << kCnip << "preprocessor invocation failed" << std::endl;
-            return ERROR_PreprocessorInvocationFailure;
-        }
+    std::tie(exit, srcText_P) = cc.preprocess(srcText);
+    output.err << cc.error();
+    if (exit != 0) {
+        output.err << kCnip << "preprocessor invocation failed" << std::endl;
+        return ERROR_PreprocessorInvocationFailure;
+    }
 
-        exit = writeFile(fi.fullFileBaseName() + ".i", srcText_P);
-        if (exit != 0) {
-            std::cerr << kCnip << "preprocessed file write failure" << std::endl;
-            return ERROR_PreprocessedFileWritingFailure;
-        }
-    } else {
-        std::tie(exit, srcText_P) = cc.preprocess_IgnoreIncludes(srcText);
+    writePreprocessedFile(srcText_P, fi);
+
+    return constructSyntaxTree(std::move(srcText_P), fi, TextPreprocessingState::Preprocessed, output);
+}
+
+int CCompilerFrontend::preprocessWithHeaderPrefixCache(const std::string& srcText, std::string::size_type prefixLen,
+                                                       const psy::FileInfo& fi, Output& output) {
+    auto prefix = srcText.substr(0, prefixLen);
+
+    auto key = hostCompilerOptionsKey() + prefix;
+
+    auto entry = headerPrefixCache_.lookup(key, [this, &prefix]() {
+        GnuCompilerFacade cc(config_->hostCompiler, to_string(config_->langStd), config_->macrosToDefine,
+                             config_->macrosToUndef);
+
+        HeaderPrefixCache::Entry entry;
+        std::tie(entry.exit, entry.srcText_P) = cc.preprocess(prefix);
+        entry.error = cc.error();
+        if (entry.exit != 0) return entry;
+        if (!entry.srcText_P.empty() && entry.srcText_P.back() != '\n') entry.srcText_P += '\n';
+
+        // The macros predefined by the host compiler are shared by every prefix (with the same options).
+        auto predefs = hostCompilerPredefinedMacros();
+        entry.exit = predefs->exit;
+        entry.error += predefs->error;
+        if (entry.exit != 0) return entry;
+
+        std::string macroDefs;
+        std::tie(entry.exit, macroDefs) = cc.preprocess_MacroDefinitions(prefix);
+        entry.error += cc.error();
+        entry.macroDefs = HeaderPrefixCache::macroDefinitionsDelta(macroDefs, predefs->macroDefs);
+        return entry;
+    });
+
+    output.err << entry->error;
+    if (entry->exit != 0) {
+        output.err << kCnip << "preprocessor invocation failed" << std::endl;
+        return ERROR_PreprocessorInvocationFailure;
+    }
+
+    // The remainder is preprocessed by the host compiler as well (one invocation per file), after the macros
+    // defined by the prefix; only the reading of the headers is saved.
+    auto lineMarker = "# " + std::to_string(std::count(prefix.begin(), prefix.end(), '\n') + 1) + " \"<stdin>\"\n";
+    GnuCompilerFacade cc(config_->hostCompiler, to_string(config_->langStd), config_->macrosToDefine,
+                         config_->macrosToUndef);
+    std::string remainder_P;
+    int exit;
+    std::tie(exit, remainder_P) = cc.preprocess(entry->macroDefs + lineMarker + srcText.substr(prefixLen));
+    output.err << cc.error();
+    if (exit != 0) {
+        output.err << kCnip << "preprocessor invocation failed" << std::endl;
+        return ERROR_PreprocessorInvocationFailure;
     }
 
-    return constructSyntaxTree(srcText_P, fi);
+    // What precedes the remainder (e.g., the implicitly included headers) is already in the preprocessed prefix.
+    auto pos = remainder_P.find('\n' + lineMarker);
+    auto srcText_P = entry->srcText_P + (pos == std::string::npos ? remainder_P : remainder_P.substr(pos + 1));
+
+    writePreprocessedFile(srcText_P, fi);
+
+    return constructSyntaxTree(std::move(srcText_P), fi, TextPreprocessingState::Preprocessed, output);
+}
+
+std::string CCompilerFrontend::hostCompilerOptionsKey() const {
+    std::string key = config_->hostCompiler + '\0' + to_string(config_->langStd) + '\0';
+    for (const auto& macro : config_->macrosToDefine) key += "-D" + macro + '\0';
+    for (const auto& macro : config_->macrosToUndef) key += "-U" + macro + '\0';
+    return key;
 }
 
-int CCompilerFrontend::constructSyntaxTree(const std::string& srcText, const psy::FileInfo& fi) {
+std::shared_ptr<const HeaderPrefixCache::Entry> CCompilerFrontend::hostCompilerPredefinedMacros() {
+    // The host compiler is invoked only once (per compiler, standard, and macros to define/undefine).
+    return headerPrefixCache_.lookup(hostCompilerOptionsKey(), [this]() {
+        GnuCompilerFacade cc(config_->hostCompiler, to_string(config_->langStd), config_->macrosToDefine,
+                             config_->macrosToUndef);
+        HeaderPrefixCache::Entry entry;
+        std::tie(entry.exit, entry.macroDefs) = cc.preprocess_MacroDefinitions("");
+        entry.error = cc.error();
+        return entry;
+    });
+}
+
+void CCompilerFrontend::writePreprocessedFile(const std::string& srcText_P, const psy::FileInfo& fi) {
+    // The preprocessed text stays in memory for the parser; a copy of it is written only if requested.
+    // A text that isn't read from a file (e.g., that of a server request) has no `.i' counterpart.
+    if (config_->writePreprocessedFiles && fi.fullFileName() != kBufferName)
+        preprocessedFileWriter_.write(fi.fullFileBaseName() + ".i", srcText_P);
+}
+
+int CCompilerFrontend::constructSyntaxTree(std::string srcText, const psy::FileInfo& fi,
+                                           TextPreprocessingState textPPState, Output& output) {
     ParseOptions parseOpts;
 
+    if (textPPState == TextPreprocessingState::Unpreprocessed) {
+        std::vector<std::string> macros;
+        if (config_->importHostMacros) {
+            // The macros predefined by the host compiler already account for the macros to define/undefine.
+            auto predefs = hostCompilerPredefinedMacros();
+            if (predefs->exit != 0) {
+                output.err << predefs->error;
+                output.err << kCnip << "preprocessor invocation failed" << std::endl;
+                return ERROR_PreprocessorInvocationFailure;
+            }
+            parseOpts.setTreatmentOfPreprocessing(ParseOptions::TreatmentOfPreprocessing::PreprocessWithoutBuiltinMacros);
+            macros = predefinedMacrosFromDefinitions(predefs->macroDefs);
+        } else if (config_->macrosToUndef.empty()) {
+            parseOpts.setTreatmentOfPreprocessing(ParseOptions::TreatmentOfPreprocessing::Preprocess);
+            macros = config_->macrosToDefine;
+        } else {
+            // A built-in macro may be undefined too, so the built-in ones are predefined explicitly.
+            parseOpts.setTreatmentOfPreprocessing(ParseOptions::TreatmentOfPreprocessing::PreprocessWithoutBuiltinMacros);
+            auto isUndefined = [this](const std::string& macro) {
+                auto name = macro.substr(0, macro.find('='));
+                return std::find(config_->macrosToUndef.begin(), config_->macrosToUndef.end(), name) !=
+                       config_->macrosToUndef.end();
+            };
+            macros = ParseOptions::builtinPredefinedMacros();
+            macros.insert(macros.end(), config_->macrosToDefine.begin(), config_->macrosToDefine.end());
+            macros.erase(std::remove_if(macros.begin(), macros.end(), isUndefined), macros.end());
+        }
+        parseOpts.setPredefinedMacros(std::move(macros));
+    }
+
     // TODO: Move to driver/config.
     if (!config_->ParseOptions_TreatmentOfAmbiguities.empty()) {
         if (config_->ParseOptions_TreatmentOfAmbiguities == "None")
@@ -126,49 +294,93 @@ int CCompilerFrontend::constructSyntaxTree(const std::string& srcText, const psy
         else if (config_->ParseOptions_TreatmentOfAmbiguities == "DisambiguateHeuristically")
             parseOpts.setTreatmentOfAmbiguities(ParseOptions::TreatmentOfAmbiguities::DisambiguateHeuristically);
         else {
-            std::cerr << "unrecognized --C-ParseOptions-TreatmentOfAmbiguities" << std::endl;
+            output.err << "unrecognized --C-ParseOptions-TreatmentOfAmbiguities" << std::endl;
             return 1;
         }
     }
 
-    auto tree = SyntaxTree::parseText(srcText, TextPreprocessingState::Preprocessed, TextCompleteness::Fragment,
-                                      parseOpts, fi.fileName());
+    if (!config_->ParseOptions_TreatmentOfFunctionBodies.empty()) {
+        if (config_->ParseOptions_TreatmentOfFunctionBodies == "Sequential")
+            parseOpts.setTreatmentOfFunctionBodies(ParseOptions::TreatmentOfFunctionBodies::Sequential);
+        else if (config_->ParseOptions_TreatmentOfFunctionBodies == "Parallel")
+            parseOpts.setTreatmentOfFunctionBodies(ParseOptions::TreatmentOfFunctionBodies::Parallel);
+        else {
+            output.err << "unrecognized --C-ParseOptions-TreatmentOfFunctionBodies" << std::endl;
+            return 1;
+        }
+    }
+
+    // A cached SyntaxTree (with its diagnostics) is reused if its text and everything else that affects it is unchanged.
+    std::unique_ptr<SyntaxTree> tree;
+    std::string key;
+    if (parseResultCache_.isEnabled()) {
+        key = ParseResultCache::keyOf(srcText, textPPState, fi.fileName(), parseOpts);
+        tree = parseResultCache_.load(key, srcText, parseOpts);
+    }
+    if (!tree) {
+        tree = SyntaxTree::parseText(SourceText(std::move(srcText)), textPPState, TextCompleteness::Fragment,
+                                     parseOpts, fi.fileName());
+        if (tree && parseResultCache_.isEnabled()) parseResultCache_.store(key, tree.get());
+    }
 
     if (!tree) {
-        std::cerr << "unsuccessful parsing" << std::endl;
+        output.err << "unsuccessful parsing" << std::endl;
         return ERROR_UnsuccessfulParsing;
     }
 
     TranslationUnitSyntax* TU = tree->translationUnitRoot();
     if (!TU) {
-        std::cerr << "invalid syntax tree" << std::endl;
+        output.err << "invalid syntax tree" << std::endl;
         return ERROR_InvalidSyntaxTree;
     }
 
     if (!tree->diagnostics().empty()) {
         auto c = tree->diagnostics();
-        std::copy(c.begin(), c.end(), std::ostream_iterator<Diagnostic>(std::cerr));
-        std::cerr << std::endl;
+        std::copy(c.begin(), c.end(), std::ostream_iterator<Diagnostic>(output.err));
+        output.err << std::endl;
     }
 
     if (config_->dumpCFG) {
-        std::cout << "CFG is ready to dump ~" << std::endl;
-        SyntaxNamePrinter transformer(tree.get());
-        transformer.getCFG(TU);
-        transformer.printCFG();
+        std::unique_ptr<ControlFlowGraphWriter> writer;
+        if (config_->dumpCFGFormat == "JSON")
+            writer.reset(new ControlFlowGraphWriterJSONFormat(output.out));
+        else if (config_->dumpCFGFormat == "Binary")
+            writer.reset(new ControlFlowGraphWriterBinaryFormat(output.out));
+        else if (config_->dumpCFGFormat != "Text") {
+            output.err << "unrecognized --dump-CFG-format" << std::endl;
+            return 1;
+        }
+
+        auto cfgs = ControlFlowGraph::buildAll(TU);
+        for (const auto& cfg : cfgs) {
+            if (writer)
+                writer->write(*cfg);
+            else
+                output.out << *cfg << std::endl;
+        }
     }
 
     if (config_->dumpAst) {
-        std::ostringstream ossTree;
-        SyntaxNamePrinter printer(tree.get());
-        printer.print(TU, SyntaxNamePrinter::Style::Decorated, ossTree);
-        std::cout << ossTree.str() << std::endl;
+        if (config_->dumpAstFormat == "JSON") {
+            SyntaxFlatWriterJSONFormat writer(tree.get(), output.out);
+            writer.write(TU);
+        } else if (config_->dumpAstFormat == "Binary") {
+            SyntaxFlatWriterBinaryFormat writer(tree.get(), output.out);
+            writer.write(TU);
+        } else if (config_->dumpAstFormat == "Text") {
+            SyntaxNamePrinter printer(tree.get());
+            printer.print(TU, SyntaxNamePrinter::Style::Decorated, output.out);
+            output.out << std::endl;
+        } else {
+            output.err << "unrecognized --dump-AST-format" << std::endl;
+            return 1;
+        }
     }
 
-    return config_->WIP_ ? computeSemanticModel(std::move(tree)) : 0;
+    return config_->WIP_ ? computeSemanticModel(std::move(tree), output) : 0;
 }
 
-int CCompilerFrontend::computeSemanticModel(std::unique_ptr<SyntaxTree> tree) {
+int CCompilerFrontend::computeSemanticModel(std::unique_ptr<SyntaxTree> tree, Output& output) {
     auto compilation = Compilation::create(tree->filePath());
     compilation->addSyntaxTrees({tree.get()});
     /*auto semaModel = */ compilation->semanticModel(tree.get());
@@ -176,8 +388,8 @@ int CCompilerFrontend::computeSemanticModel(std::unique_ptr<SyntaxTree> tree) {
     // show only not yet shown
     if (!tree->diagnostics().empty()) {
         auto c = tree->diagnostics();
-        std::copy(c.begin(), c.end(), std::ostream_iterator<Diagnostic>(std::cerr));
-        std::cerr << std::endl;
+        std::copy(c.begin(), c.end(), std::ostream_iterator<Diagnostic>(output.err));
+        output.err << std::endl;
     }
 
     return 0;
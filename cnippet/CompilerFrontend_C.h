@@ -23,8 +23,11 @@
 
 #include "Driver.h"
 
+#include "BackgroundFileWriter.h"
 #include "CompilerFrontend.h"
 #include "Configuration_C.h"
+#include "HeaderPrefixCache.h"
+#include "ParseResultCache.h"
 
 #include "C/SyntaxTree.h"
 
@@ -42,14 +45,33 @@ public:
     CCompilerFrontend(const cxxopts::ParseResult& parsedCmdLine);
     virtual ~CCompilerFrontend();
 
-    int run(const std::string& srcText, const psy::FileInfo& fi) override;
+    int run(const std::string& srcText,
+            const psy::FileInfo& fi,
+            std::ostream& out,
+            std::ostream& err) override;
+    int finish(std::ostream& err) override;
 
 private:
+    struct Output
+    {
+        std::ostream& out;
+        std::ostream& err;
+    };
 
-    int extendWithStdLibHeaders(const std::string& srcText, const psy::FileInfo& fi);
-    int preprocess(const std::string& srcText, const psy::FileInfo& fi);
-    int constructSyntaxTree(const std::string& srcText, const psy::FileInfo& fi);
-    int computeSemanticModel(std::unique_ptr<psy::C::SyntaxTree> tree);
+    int extendWithStdLibHeaders(const std::string& srcText, const psy::FileInfo& fi, Output& output);
+    int preprocess(const std::string& srcText, const psy::FileInfo& fi, Output& output);
+    int preprocessWithHeaderPrefixCache(const std::string& srcText,
+                                        std::string::size_type prefixLen,
+                                        const psy::FileInfo& fi,
+                                        Output& output);
+    std::string hostCompilerOptionsKey() const;
+    std::shared_ptr<const HeaderPrefixCache::Entry> hostCompilerPredefinedMacros();
+    void writePreprocessedFile(const std::string& srcText_P, const psy::FileInfo& fi);
+    int constructSyntaxTree(std::string srcText,
+                            const psy::FileInfo& fi,
+                            psy::C::TextPreprocessingState textPPState,
+                            Output& output);
+    int computeSemanticModel(std::unique_ptr<psy::C::SyntaxTree> tree, Output& output);
 
     static constexpr int ERROR_PreprocessorInvocationFailure = 100;
     static constexpr int ERROR_PreprocessedFileWritingFailure = 101;
@@ -57,6 +79,9 @@ private:
     static constexpr int ERROR_InvalidSyntaxTree = 103;
 
     std::unique_ptr<ConfigurationForC> config_;
+    HeaderPrefixCache headerPrefixCache_;
+    BackgroundFileWriter preprocessedFileWriter_;
+    ParseResultCache parseResultCache_;
 };
 
 } // cnip
@@ -27,6 +27,8 @@ Configuration::~Configuration()
 
 Configuration::Configuration(const cxxopts::ParseResult& parsedCmdLine)
     : dumpAst(parsedCmdLine.count("dump-AST"))
+    , dumpAstFormat(parsedCmdLine["dump-AST-format"].as<std::string>())
     , dumpCFG(parsedCmdLine.count("dump-CFG"))
+    , dumpCFGFormat(parsedCmdLine["dump-CFG-format"].as<std::string>())
     , WIP_(parsedCmdLine.count("WIP"))
 {}
@@ -23,6 +23,8 @@
 
 #include "cxxopts.hpp"
 
+#include <string>
+
 namespace cnip {
 
 /*!
@@ -35,7 +37,9 @@ public:
 
     // TODO: API
     bool dumpAst;
+    std::string dumpAstFormat;
     bool dumpCFG;
+    std::string dumpCFGFormat;
     bool WIP_;
 
 protected:
@@ -26,7 +26,10 @@ const char* const kHostCCompiler = "host-cc";
 const char* const kExpandCPPIncludeDirectives = "cpp-includes";
 const char* const kDefineCPPMacro = "cpp-D";
 const char* const KUndefineCPPMacro = "cpp-U";
+const char* const kImportHostCPPMacros = "cpp-host-macros";
 const char* const kAddDirToCPPSearchPath = "cpp-I";
+const char* const kWritePreprocessedFiles = "cpp-write-i";
+const char* const kParseCacheDir = "cache-dir";
 }
 
 using namespace cnip;
@@ -49,6 +52,9 @@ void ConfigurationForC::extend(cxxopts::Options& cmdLineOpts)
             (kExpandCPPIncludeDirectives,
                 "Expand `#include' directives of the C preprocessor.",
                 cxxopts::value<bool>()->default_value("false"))
+            (kWritePreprocessedFiles,
+                "Write the preprocessed text of each file to a `.i' file (in the background).",
+                cxxopts::value<bool>()->default_value("false"))
 
             // https://gcc.gnu.org/onlinedocs/gcc/Directory-Options.html
             (kAddDirToCPPSearchPath,
@@ -65,6 +71,15 @@ void ConfigurationForC::extend(cxxopts::Options& cmdLineOpts)
                 "Undefine a C preprocessor macro.",
                 cxxopts::value<std::vector<std::string>>(),
                 "<name>")
+            (kImportHostCPPMacros,
+                "Predefine the macros of the host C compiler instead of the built-in ones (without `#include' expansion).",
+                cxxopts::value<bool>()->default_value("false"))
+
+        /* Cache */
+            (kParseCacheDir,
+                "Cache the results of parsing in a directory, to reuse them for unchanged files.",
+                cxxopts::value<std::string>()->default_value(""),
+                "path")
 
         /* Ambiguity */
             ("C-ParseOptions-TreatmentOfAmbiguities",
@@ -73,6 +88,13 @@ void ConfigurationForC::extend(cxxopts::Options& cmdLineOpts)
                     ->default_value("DisambiguateAlgorithmicallyOrHeuristically"),
                 "<None|Diagnose|DisambiguateAlgorithmically|DisambiguateAlgorithmicallyOrHeuristically|DisambiguateHeuristically>")
 
+        /* Function bodies */
+            ("C-ParseOptions-TreatmentOfFunctionBodies",
+                "Treatment of function bodies.",
+                cxxopts::value<std::string>()
+                    ->default_value("Sequential"),
+                "<Sequential|Parallel>")
+
         /* Type inference */
             ("C-infer", "Infer the definition of missing types.")
             ("o,output", "Specify output file",
@@ -99,15 +121,21 @@ ConfigurationForC::ConfigurationForC(const cxxopts::ParseResult& parsedCmdLine)
     hostCompiler = parsedCmdLine[kHostCCompiler].as<std::string>();
 
     expandIncludes = parsedCmdLine[kExpandCPPIncludeDirectives].as<bool>();
+    writePreprocessedFiles = parsedCmdLine[kWritePreprocessedFiles].as<bool>();
     if (parsedCmdLine.count(kDefineCPPMacro))
         macrosToDefine = parsedCmdLine[kDefineCPPMacro].as<std::vector<std::string>>();
     if (parsedCmdLine.count(KUndefineCPPMacro))
         macrosToUndef = parsedCmdLine[KUndefineCPPMacro].as<std::vector<std::string>>();
 
+    importHostMacros = parsedCmdLine[kImportHostCPPMacros].as<bool>();
+
     if (parsedCmdLine.count(kAddDirToCPPSearchPath))
         headerSearchPaths = parsedCmdLine[kAddDirToCPPSearchPath].as<std::vector<std::string>>();
 
+    parseCacheDir = parsedCmdLine[kParseCacheDir].as<std::string>();
+
     ParseOptions_TreatmentOfAmbiguities = parsedCmdLine["C-ParseOptions-TreatmentOfAmbiguities"].as<std::string>();
+    ParseOptions_TreatmentOfFunctionBodies = parsedCmdLine["C-ParseOptions-TreatmentOfFunctionBodies"].as<std::string>();
 
     inferMissingTypes = parsedCmdLine.count("infer");
 }
@@ -51,10 +51,15 @@ public:
     std::vector<std::string> macrosToUndef;
     std::vector<std::string> headerSearchPaths;
 
+    std::string parseCacheDir;
+
     std::string ParseOptions_TreatmentOfAmbiguities;
+    std::string ParseOptions_TreatmentOfFunctionBodies;
 
     // TODO: Bit fields.
     bool expandIncludes;
+    bool importHostMacros;
+    bool writePreprocessedFiles;
     bool inferMissingTypes;
 };
 
@@ -27,11 +27,17 @@
 #include "FileInfo.h"
 #include "IO.h"
 #include "Plugin.h"
+#include "Server.h"
+#include "infra/HardwareThreads.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <iterator>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <cstring>
 
 using namespace psy;
@@ -44,6 +50,8 @@ constexpr int Driver::ERROR_NoInputFile;
 constexpr int Driver::ERROR_UnrecognizedCmdLineOption;
 constexpr int Driver::ERROR_CannotLoadPluging;
 constexpr int Driver::ERROR_LanguageNotRecognized;
+constexpr int Driver::ERROR_CannotServe;
+constexpr int Driver::ERROR_MalformedRequest;
 
 Driver::Driver()
 {}
@@ -51,9 +59,8 @@ Driver::Driver()
 Driver::~Driver()
 {}
 
-int Driver::execute(int argc, char* argv[])
+void Driver::defineOptions(cxxopts::Options& cmdLineOpts)
 {
-    cxxopts::Options cmdLineOpts(argv[0], "cnippet");
     cmdLineOpts
         .positional_help("file")
         .add_options()
@@ -66,8 +73,28 @@ int Driver::execute(int argc, char* argv[])
                 "<C>")
             ("z,dump-AST",
                 "Dump the program's AST to the console.")
+            ("dump-AST-format",
+                "Specify the format of the dumped AST.",
+                cxxopts::value<std::string>()->default_value("Text"),
+                "<Text|JSON|Binary>")
             ("c,dump-CFG",
                 "Dump the program's CFG to the console.")
+            ("dump-CFG-format",
+                "Specify the format of the dumped CFG.",
+                cxxopts::value<std::string>()->default_value("Text"),
+                "<Text|JSON|Binary>")
+            ("j,jobs",
+                "Process the input files on N threads (0 for as many as the hardware supports).",
+                cxxopts::value<unsigned>()->default_value("1"),
+                "N")
+            ("k,keep-going",
+                "Continue processing the input files after one of them fails.")
+            ("server",
+                "Serve requests, as JSON lines, from stdin (or from the socket given by --socket).")
+            ("socket",
+                "Serve requests over the Unix domain socket at the given path.",
+                cxxopts::value<std::string>(),
+                "<path>")
             ("d,debug",
                 "Enable debugging.",
                 cxxopts::value<bool>(DEBUG::globalDebugEnabled))
@@ -81,9 +108,21 @@ int Driver::execute(int argc, char* argv[])
     ;
 
     ConfigurationForC::extend(cmdLineOpts);
+}
+
+int Driver::execute(int argc, char* argv[])
+{
+    std::vector<std::string> args(argv, argv + argc);
+
+    cxxopts::Options cmdLineOpts(argv[0], "cnippet");
+    defineOptions(cmdLineOpts);
 
     std::unique_ptr<CompilerFrontend> FE;
     std::vector<std::string> filesPaths;
+    unsigned jobs;
+    bool keepGoing;
+    bool serve;
+    std::string socketPath;
     try {
         cmdLineOpts.parse_positional(std::vector<std::string>{"file"});
         auto parsedCmdLine = cmdLineOpts.parse(argc, argv);
@@ -102,9 +141,13 @@ int Driver::execute(int argc, char* argv[])
             }
         }
 
+        serve = parsedCmdLine.count("server") || parsedCmdLine.count("socket");
+        if (parsedCmdLine.count("socket"))
+            socketPath = parsedCmdLine["socket"].as<std::string>();
+
         if (parsedCmdLine.count("file"))
             filesPaths = parsedCmdLine["file"].as<std::vector<std::string>>();
-        else {
+        else if (!serve) {
             std::cerr << kCnip << "no input file(s)" << std::endl;
             return ERROR_NoInputFile;
         }
@@ -115,31 +158,154 @@ int Driver::execute(int argc, char* argv[])
             return ERROR_LanguageNotRecognized;
         }
 
-        FE.reset(new CCompilerFrontend(parsedCmdLine));
+        // A server processes requests concurrently, unless told otherwise.
+        jobs = parsedCmdLine["jobs"].as<unsigned>();
+        if (jobs == 0 || (serve && !parsedCmdLine.count("jobs")))
+            jobs = std::max(std::thread::hardware_concurrency(), 1u);
+        keepGoing = parsedCmdLine.count("keep-going");
+
+        if (!serve)
+            FE.reset(new CCompilerFrontend(parsedCmdLine));
     }
     catch (...) {
         std::cerr << kCnip << "unrecognized command-line option" << std::endl;
         return ERROR_UnrecognizedCmdLineOption;
     }
 
-    for (auto filePath : filesPaths) {
-        auto [exit, srcText] = readFile(filePath);
-        if (exit != 0)
-            return ERROR_FileNotFound;
+    // The files (or requests) already run on threads of their own.
+    if (jobs > 1 && (serve || filesPaths.size() > 1))
+        limitHardwareThreads(1);
+
+    if (serve) {
+        // The server creates the frontends, as per the options of the requests.
+        Server server(this, std::move(args), jobs);
+        return socketPath.empty() ? server.serve(std::cin, std::cout) : server.serve(socketPath);
+    }
+
+    int exit;
+    if (jobs == 1 || filesPaths.size() == 1)
+        exit = runSerially(*FE, filesPaths, keepGoing);
+    else
+        exit = runInParallel(*FE, filesPaths, jobs, keepGoing);
 
-        FileInfo fi(filePath);
+    auto finishExit = FE->finish(std::cerr);
+    return exit != SUCCESS ? exit : finishExit;
+}
 
+int Driver::runSerially(CompilerFrontend& FE, const std::vector<std::string>& filesPaths, bool keepGoing)
+{
+    int firstExit = SUCCESS;
+    for (const auto& filePath : filesPaths) {
+        int exit;
         try {
-            exit = FE->run(srcText, fi);
+            exit = runOnFile(FE, filePath, std::cout, std::cerr);
         }
         catch (...) {
             Plugin::unload();
-            return Driver::ERROR;
+            return ERROR;
         }
 
-        if (exit != 0)
+        if (exit == SUCCESS)
+            continue;
+        if (!keepGoing)
             return exit;
+        if (firstExit == SUCCESS)
+            firstExit = exit;
+    }
+
+    return firstExit;
+}
+
+int Driver::runInParallel(CompilerFrontend& FE,
+                          const std::vector<std::string>& filesPaths,
+                          unsigned jobs,
+                          bool keepGoing)
+{
+    /*
+     * The workers take the files in order, and buffer the output of each one;
+     * the calling thread writes the buffers in that same order, as soon as they
+     * are complete. Without keep-going, the files after the first one that
+     * fails are skipped (those before it are still processed, as they would be
+     * serially).
+     */
+    struct Outcome
+    {
+        bool done = false;
+        int exit = SUCCESS;
+        std::ostringstream out;
+        std::ostringstream err;
+    };
+    std::vector<Outcome> outcomes(filesPaths.size());
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::atomic<std::size_t> nextFile { 0 };
+    std::atomic<std::size_t> firstFailedFile { filesPaths.size() };
+    std::atomic<bool> threw { false };
+
+    auto work = [&] () {
+        for (auto i = nextFile++; i < filesPaths.size(); i = nextFile++) {
+            auto& outcome = outcomes[i];
+            if (keepGoing || i < firstFailedFile) {
+                try {
+                    outcome.exit = runOnFile(FE, filesPaths[i], outcome.out, outcome.err);
+                }
+                catch (...) {
+                    outcome.exit = ERROR;
+                    threw = true;
+                }
+                if (outcome.exit != SUCCESS) {
+                    auto failedFile = firstFailedFile.load();
+                    while (i < failedFile && !firstFailedFile.compare_exchange_weak(failedFile, i))
+                        ;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            outcome.done = true;
+            cond.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    jobs = std::min<std::size_t>(jobs, filesPaths.size());
+    for (unsigned i = 0; i < jobs; ++i)
+        workers.emplace_back(work);
+
+    int firstExit = SUCCESS;
+    for (auto& outcome : outcomes) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&outcome] () { return outcome.done; });
+        }
+        std::cout << outcome.out.str() << std::flush;
+        std::cerr << outcome.err.str() << std::flush;
+
+        if (outcome.exit == SUCCESS)
+            continue;
+        if (firstExit == SUCCESS)
+            firstExit = outcome.exit;
+        if (!keepGoing)
+            break;
     }
 
-    return SUCCESS;
+    for (auto& worker : workers)
+        worker.join();
+
+    if (threw)
+        Plugin::unload();
+
+    return firstExit;
+}
+
+int Driver::runOnFile(CompilerFrontend& FE,
+                      const std::string& filePath,
+                      std::ostream& out,
+                      std::ostream& err)
+{
+    auto [exit, srcText] = readFile(filePath, err);
+    if (exit != 0)
+        return ERROR_FileNotFound;
+
+    FileInfo fi(filePath);
+    return FE.run(srcText, fi, out, err);
 }
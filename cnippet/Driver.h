@@ -21,10 +21,18 @@
 #ifndef CNIPPET_DRIVER_H__
 #define CNIPPET_DRIVER_H__
 
+#include <ostream>
+#include <string>
+#include <vector>
+
 const char* const kCnip = "cnip: ";
 
+namespace cxxopts { class Options; }
+
 namespace cnip {
 
+class CompilerFrontend;
+
 /*!
  * \brief The Driver class.
  */
@@ -39,6 +47,19 @@ public:
 private:
     friend class FrontEnd;
     friend class CCompilerFrontEnd;
+    friend class Server;
+
+    static void defineOptions(cxxopts::Options& cmdLineOpts);
+
+    int runSerially(CompilerFrontend& FE, const std::vector<std::string>& filesPaths, bool keepGoing);
+    int runInParallel(CompilerFrontend& FE,
+                      const std::vector<std::string>& filesPaths,
+                      unsigned jobs,
+                      bool keepGoing);
+    int runOnFile(CompilerFrontend& FE,
+                  const std::string& filePath,
+                  std::ostream& out,
+                  std::ostream& err);
 
     static constexpr int SUCCESS = 0;
 
@@ -48,6 +69,8 @@ private:
     static constexpr int ERROR_FileNotFound = 4;
     static constexpr int ERROR_CannotLoadPluging = 5;
     static constexpr int ERROR_LanguageNotRecognized = 6;
+    static constexpr int ERROR_CannotServe = 7;
+    static constexpr int ERROR_MalformedRequest = 8;
 };
 
 } // cnip
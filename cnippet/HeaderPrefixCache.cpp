@@ -0,0 +1,169 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "HeaderPrefixCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <initializer_list>
+#include <map>
+#include <sstream>
+
+namespace
+{
+/*
+ * Whether the \p line is a directive with one of the \p names: a \c # (or
+ * \c %:), optional whitespace, and then the name, as the lexer reads it.
+ */
+bool isDirective(const std::string& line, std::initializer_list<const char*> names)
+{
+    std::string::size_type pos;
+    if (line.compare(0, 1, "#") == 0)
+        pos = 1;
+    else if (line.compare(0, 2, "%:") == 0)
+        pos = 2;
+    else
+        return false;
+
+    pos = line.find_first_not_of(" \t", pos);
+    if (pos == std::string::npos)
+        return false;
+
+    auto end = pos;
+    while (end < line.size() && (std::isalnum(static_cast<unsigned char>(line[end])) || line[end] == '_'))
+        ++end;
+    auto name = line.substr(pos, end - pos);
+    return std::any_of(names.begin(), names.end(), [&name](const char* s) { return name == s; });
+}
+
+bool isInclude(const std::string& line)
+{
+    return isDirective(line, {"include", "include_next", "import"});
+}
+
+bool startsWith(const std::string& line, const char* s)
+{
+    return line.compare(0, std::char_traits<char>::length(s), s) == 0;
+}
+
+/*
+ * The macro definitions in the output of a preprocessor's \c -dM, by name.
+ */
+std::map<std::string, std::string> macroDefinitions(const std::string& defs)
+{
+    std::map<std::string, std::string> macros;
+    std::istringstream iss(defs);
+    std::string line;
+    while (std::getline(iss, line)) {
+        if (!startsWith(line, "#define "))
+            continue;
+        auto nameEnd = line.find_first_of(" (", 8);
+        macros.emplace(line.substr(8, nameEnd - 8), line);
+    }
+    return macros;
+}
+}
+
+using namespace cnip;
+
+std::string::size_type HeaderPrefixCache::headerPrefixLength(const std::string& srcText)
+{
+    std::string::size_type prefixLen = 0;
+    bool isPrefixDone = false;
+    bool hasInclude = false;
+    bool isContinued = false;
+    std::istringstream iss(srcText);
+    std::string line;
+    while (std::getline(iss, line)) {
+        auto lineLen = line.size() + 1;
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+
+        if (isInclude(line)) {
+            // An `#include' directive past the prefix may be conditional, or depend on its context.
+            if (isPrefixDone)
+                return 0;
+            hasInclude = true;
+        }
+
+        isPrefixDone = isPrefixDone
+                || !(isContinued
+                        || line.empty()
+                        || isInclude(line)
+                        || isDirective(line, {"define", "undef"})
+                        || startsWith(line, "//")
+                        || (startsWith(line, "/*") && line.find("*/", 2) == line.size() - 2));
+        if (isPrefixDone) {
+            // These may depend on more than the macros of the prefix (e.g., on the state of pragmas).
+            if (line.find("__has_include") != std::string::npos || line.find("_Pragma") != std::string::npos)
+                return 0;
+            continue;
+        }
+
+        isContinued = !line.empty() && line.back() == '\\';
+        prefixLen = std::min(prefixLen + lineLen, srcText.size());
+    }
+
+    return hasInclude ? prefixLen : 0;
+}
+
+std::string HeaderPrefixCache::macroDefinitionsDelta(const std::string& defs, const std::string& predefs)
+{
+    auto macros = macroDefinitions(defs);
+    auto predefMacros = macroDefinitions(predefs);
+
+    std::string delta;
+    for (const auto& predef : predefMacros) {
+        if (!macros.count(predef.first))
+            delta += "#undef " + predef.first + '\n';
+    }
+    for (const auto& macro : macros) {
+        auto it = predefMacros.find(macro.first);
+        if (it == predefMacros.end())
+            delta += macro.second + '\n';
+        else if (it->second != macro.second)
+            delta += "#undef " + macro.first + '\n' + macro.second + '\n';
+    }
+    return delta;
+}
+
+std::shared_ptr<const HeaderPrefixCache::Entry> HeaderPrefixCache::lookup(const std::string& key,
+                                                                          std::function<Entry()> compute)
+{
+    std::promise<std::shared_ptr<const Entry>> promise;
+    std::shared_future<std::shared_ptr<const Entry>> future;
+    bool isComputedHere = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            future = it->second;
+        } else {
+            future = promise.get_future().share();
+            entries_.emplace(key, future);
+            isComputedHere = true;
+        }
+    }
+
+    if (isComputedHere)
+        promise.set_value(std::make_shared<const Entry>(compute()));
+
+    return future.get();
+}
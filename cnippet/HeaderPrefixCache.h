@@ -0,0 +1,105 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef CNIPPET_HEADER_PREFIX_CACHE_H__
+#define CNIPPET_HEADER_PREFIX_CACHE_H__
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cnip {
+
+/*!
+ * \brief The HeaderPrefixCache class.
+ *
+ * A cache of the preprocessing of the header prefixes of source texts: the
+ * leading lines with `#include' (and `#define'/`#undef') directives, which
+ * many files have in common. An entry is keyed by the content of the prefix
+ * together with everything else that affects its preprocessing (the host
+ * compiler, the standard, and the macros to define/undefine).
+ *
+ * The remainder of a source text is still preprocessed by the host compiler,
+ * but after the (cached) definitions of the macros of the prefix instead of
+ * the prefix itself, so that the headers aren't read again.
+ *
+ * What's saved is the reading and preprocessing of the headers only: the host
+ * compiler is still invoked once per file (for the remainder), and the
+ * preprocessed prefix is still lexed and parsed as part of each file's text.
+ *
+ * \note
+ * The cache may be shared by threads: an entry is computed only once, and a
+ * thread that looks it up meanwhile waits for it.
+ */
+class HeaderPrefixCache final
+{
+public:
+    struct Entry
+    {
+        int exit;
+
+        /*
+         * The preprocessed prefix.
+         */
+        std::string srcText_P;
+
+        /*
+         * The directives that turn the macros predefined by the host compiler
+         * into those defined at the end of the prefix.
+         */
+        std::string macroDefs;
+
+        /*
+         * The standard error of the preprocessing.
+         */
+        std::string error;
+    };
+
+    /*!
+     * Split the source text \p srcText into a header prefix and a remainder;
+     * return the prefix's length, or 0 if there's no `#include' directive in
+     * the prefix, or if the remainder has one (which may be conditional, or
+     * depend on its context) or uses \c __has_include or \c _Pragma.
+     */
+    static std::string::size_type headerPrefixLength(const std::string& srcText);
+
+    /*!
+     * The \c #define and \c #undef directives that turn the macros defined as
+     * in \p predefs into those defined as in \p defs (each one the output of
+     * a preprocessor's \c -dM).
+     */
+    static std::string macroDefinitionsDelta(const std::string& defs, const std::string& predefs);
+
+    /*!
+     * The entry of the \p key, computed with \p compute if it isn't cached.
+     */
+    std::shared_ptr<const Entry> lookup(const std::string& key, std::function<Entry()> compute);
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const Entry>>> entries_;
+};
+
+} // cnip
+
+#endif
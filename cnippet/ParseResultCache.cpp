@@ -0,0 +1,219 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ParseResultCache.h"
+
+#include "syntax/SyntaxReaderBinaryFormat.h"
+#include "syntax/SyntaxWriterBinaryFormat.h"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+const char* const kMagic = "cnip-parse-result";
+
+/*
+ * The 64-bit FNV-1a hash of the \p s, from the offset \p h; two of them, from
+ * distinct offsets, name an entry.
+ */
+std::uint64_t hash(const std::string& s, std::uint64_t h)
+{
+    for (auto c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/*
+ * The identity (size and modification time) of the file of the executable or
+ * shared library that contains \p addr; it changes with each build.
+ */
+std::string fileIdOf(const void* addr)
+{
+    Dl_info info;
+    struct stat st;
+    if (!dladdr(addr, &info) || !info.dli_fname || ::stat(info.dli_fname, &st) != 0)
+        return "?";
+    return std::to_string(st.st_size) + '-' + std::to_string(st.st_mtime);
+}
+
+std::atomic<unsigned> tmpFileCnt { 0 };
+}
+
+using namespace cnip;
+using namespace psy;
+using namespace C;
+
+const char* const ParseResultCache::Version = "3";
+
+ParseResultCache::ParseResultCache(std::string dirPath)
+    : dirPath_(std::move(dirPath))
+    , buildId_(fileIdOf(reinterpret_cast<const void*>(&fileIdOf))
+                   + ':' + fileIdOf(reinterpret_cast<const void*>(&psy::C::SyntaxTree::parseText)))
+{
+    if (!dirPath_.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(dirPath_, ec);
+    }
+}
+
+std::string ParseResultCache::keyOf(const std::string& text,
+                                    TextPreprocessingState textPPState,
+                                    const std::string& filePath,
+                                    const ParseOptions& parseOpts)
+{
+    std::ostringstream oss;
+    oss << Version << ' ' << static_cast<int>(SyntaxWriterBinaryFormat::version())
+        << ' ' << static_cast<int>(textPPState)
+        << ' ' << filePath.size() << ' ' << filePath;
+
+    const auto& exts = parseOpts.extensions();
+    const auto& transls = exts.translations();
+    oss << ' ' << static_cast<int>(parseOpts.dialect().std()) << ' ';
+    for (auto enabled : { exts.isEnabled_ExtGNU_AlternateKeywords(),
+                          exts.isEnabled_ExtGNU_AttributeSpecifiers(),
+                          exts.isEnabled_ExtGNU_Alignment(),
+                          exts.isEnabled_ExtGNU_CompoundLiterals(),
+                          exts.isEnabled_ExtGNU_Conditionals(),
+                          exts.isEnabled_ExtGNU_DesignatedInitializers(),
+                          exts.isEnabled_ExtGNU_FunctionNames(),
+                          exts.isEnabled_ExtGNU_Complex(),
+                          exts.isEnabled_ExtGNU_StatementExpressions(),
+                          exts.isEnabled_ExtGNU_Asm(),
+                          exts.isEnabled_ExtGNU_InternalBuiltins(),
+                          exts.isEnabled_ExtGNU_AttributeSpecifiersLLVM(),
+                          exts.isEnabled_CPP_nullptr(),
+                          exts.isEnabled_NativeBooleans(),
+                          exts.isEnabled_NULLAsBuiltin(),
+                          exts.isEnabled_ExtPSY_Generics(),
+                          transls.isEnabled_Translate_static_assert_AsKeyword(),
+                          transls.isEnabled_Translate_complex_AsKeyword(),
+                          transls.isEnabled_Translate_operatorNames(),
+                          transls.isEnabled_Translate_alignas_AsKeyword(),
+                          transls.isEnabled_Translate_alignof_AsKeyword(),
+                          transls.isEnabled_Translate_va_arg_AsKeyword(),
+                          transls.isEnabled_Translate_offsetof_AsKeyword(),
+                          transls.isEnabled_Translate_bool_AsKeyword(),
+                          transls.isEnabled_Translate_thread_local_AsKeyword() }) {
+        oss << (enabled ? '1' : '0');
+    }
+    oss << ' ' << static_cast<int>(parseOpts.treatmentOfIdentifiers())
+        << ' ' << static_cast<int>(parseOpts.treatmentOfComments())
+        << ' ' << static_cast<int>(parseOpts.treatmentOfAmbiguities())
+        << ' ' << static_cast<int>(parseOpts.treatmentOfFunctionBodies())
+        << ' ' << static_cast<int>(parseOpts.treatmentOfPreprocessing())
+        << ' ' << parseOpts.predefinedMacros().size();
+    for (const auto& macro : parseOpts.predefinedMacros())
+        oss << ' ' << macro.size() << ' ' << macro;
+
+    oss << ' ' << text.size() << ' ' << std::hex << std::setfill('0')
+        << std::setw(16) << hash(text, 0xcbf29ce484222325ULL)
+        << std::setw(16) << hash(text, 0x84222325cbf29ce4ULL);
+    return oss.str();
+}
+
+std::string ParseResultCache::entryPath(const std::string& key) const
+{
+    std::ostringstream oss;
+    oss << dirPath_ << '/' << std::hex << std::setfill('0')
+        << std::setw(16) << hash(key, hash(buildId_, 0xcbf29ce484222325ULL))
+        << std::setw(16) << hash(key, hash(buildId_, 0x84222325cbf29ce4ULL));
+    return oss.str();
+}
+
+std::unique_ptr<SyntaxTree> ParseResultCache::load(const std::string& key,
+                                                   const std::string& text,
+                                                   ParseOptions parseOpts) const
+{
+    std::ifstream ifs(entryPath(key), std::ios::binary);
+    if (!ifs)
+        return nullptr;
+
+    std::string magic;
+    std::string version;
+    std::string buildId;
+    std::size_t keyLen;
+    std::size_t imageLen;
+    ifs >> magic >> version >> buildId >> keyLen >> imageLen;
+    if (!ifs
+            || magic != kMagic
+            || version != Version
+            || buildId != buildId_
+            || keyLen != key.size()
+            || ifs.get() != '\n') {
+        return nullptr;
+    }
+
+    std::string storedKey(keyLen, '\0');
+    ifs.read(&storedKey[0], keyLen);
+    if (!ifs || storedKey != key)
+        return nullptr;
+
+    std::string image(imageLen, '\0');
+    ifs.read(&image[0], imageLen);
+    if (!ifs || ifs.peek() != std::char_traits<char>::eof())
+        return nullptr;
+
+    SyntaxReaderBinaryFormat reader(image);
+    auto tree = reader.read(std::move(parseOpts));
+    if (!tree || tree->text().rawText() != text)
+        return nullptr;
+    return tree;
+}
+
+void ParseResultCache::store(const std::string& key, const SyntaxTree* tree) const
+{
+    std::ostringstream image;
+    SyntaxWriterBinaryFormat writer(image);
+    writer.write(tree);
+
+    auto path = entryPath(key);
+    auto tmpPath = path + ".tmp" + std::to_string(::getpid()) + '-' + std::to_string(tmpFileCnt++);
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary);
+        if (!ofs)
+            return;
+
+        const auto& data = image.str();
+        ofs << kMagic << ' ' << Version << ' ' << buildId_ << ' ' << key.size() << ' '
+            << data.size() << '\n'
+            << key << data;
+        if (!ofs) {
+            ofs.close();
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+
+    // A failure to cache the result isn't an error (the result is just computed again).
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+        std::remove(tmpPath.c_str());
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef CNIPPET_PARSE_RESULT_CACHE_H__
+#define CNIPPET_PARSE_RESULT_CACHE_H__
+
+#include "C/SyntaxTree.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cnip {
+
+/*!
+ * \brief The ParseResultCache class.
+ *
+ * A persistent cache, in a directory, of the SyntaxTrees of source texts (in
+ * the format of a SyntaxWriterBinaryFormat, which includes the diagnostics),
+ * so that a file that hasn't changed since a previous run needn't be parsed
+ * again. An entry is a file named after a hash of its key, which comprises a
+ * hash of the (preprocessed) text and everything else that affects the parse:
+ * the TextPreprocessingState, the file path, the ParseOptions, the cache and
+ * format versions, and the build of the executable and of the parser library.
+ * The key itself is stored in the entry too, and compared on a load, as is
+ * the text of the SyntaxTree, so a collision of hashes is just a miss.
+ *
+ * \note
+ * The cache may be shared by threads, and by processes: an entry is written
+ * to a temporary file that is then renamed.
+ */
+class ParseResultCache final
+{
+public:
+    /*!
+     * The version of the format of an entry.
+     */
+    static const char* const Version;
+
+    ParseResultCache(std::string dirPath);
+
+    /*!
+     * Whether the cache is enabled (i.e., has a directory).
+     */
+    bool isEnabled() const { return !dirPath_.empty(); }
+
+    /*!
+     * The key of the parse of the text \p text, in the TextPreprocessingState
+     * \p textPPState, of the file \p filePath, with the ParseOptions \p parseOpts.
+     */
+    static std::string keyOf(const std::string& text,
+                             psy::C::TextPreprocessingState textPPState,
+                             const std::string& filePath,
+                             const psy::C::ParseOptions& parseOpts);
+
+    /*!
+     * Load the SyntaxTree of the \p key, whose text must be \p text, and give it
+     * the ParseOptions \p parseOpts; return \c nullptr if it isn't cached.
+     */
+    std::unique_ptr<psy::C::SyntaxTree> load(const std::string& key,
+                                             const std::string& text,
+                                             psy::C::ParseOptions parseOpts) const;
+
+    /*!
+     * Store the SyntaxTree \p tree of the \p key.
+     */
+    void store(const std::string& key, const psy::C::SyntaxTree* tree) const;
+
+private:
+    std::string entryPath(const std::string& key) const;
+
+    std::string dirPath_;
+    std::string buildId_;
+};
+
+} // cnip
+
+#endif
@@ -0,0 +1,810 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "Server.h"
+
+#include "CompilerFrontend.h"
+#include "CompilerFrontend_C.h"
+#include "Configuration_C.h"
+#include "Driver.h"
+#include "FileInfo.h"
+
+#include "common/text/JSONString.h"
+
+#include "cxxopts.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace psy;
+using namespace cnip;
+
+namespace
+{
+/*
+ * Where available, a send to a client that has gone fails (instead of raising
+ * SIGPIPE) per call; elsewhere, per socket, through SO_NOSIGPIPE.
+ */
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+/*
+ * A reader of the JSON value of a request (an object whose members are
+ * strings, booleans, arrays of strings, or any value to be kept verbatim).
+ */
+class JsonReader
+{
+public:
+    JsonReader(const std::string& s) : s_(s), pos_(0) {}
+
+    bool consume(char c)
+    {
+        skipWhitespace();
+        if (pos_ < s_.size() && s_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool atEnd()
+    {
+        skipWhitespace();
+        return pos_ == s_.size();
+    }
+
+    bool readString(std::string& value)
+    {
+        if (!consume('"'))
+            return false;
+
+        value.clear();
+        while (pos_ < s_.size()) {
+            auto c = s_[pos_++];
+            if (c == '"')
+                return true;
+            if (static_cast<unsigned char>(c) < 0x20)
+                return false;
+            if (c != '\\') {
+                value += c;
+                continue;
+            }
+            if (pos_ == s_.size())
+                return false;
+            switch (s_[pos_++]) {
+                case '"': value += '"'; break;
+                case '\\': value += '\\'; break;
+                case '/': value += '/'; break;
+                case 'b': value += '\b'; break;
+                case 'f': value += '\f'; break;
+                case 'n': value += '\n'; break;
+                case 'r': value += '\r'; break;
+                case 't': value += '\t'; break;
+                case 'u': {
+                    unsigned cp;
+                    if (!readHex4(cp))
+                        return false;
+                    if (cp >= 0xD800 && cp < 0xDC00) {
+                        unsigned low;
+                        if (s_.compare(pos_, 2, "\\u") != 0)
+                            return false;
+                        pos_ += 2;
+                        if (!readHex4(low) || low < 0xDC00 || low >= 0xE000)
+                            return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(value, cp);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    bool readBool(bool& value)
+    {
+        skipWhitespace();
+        if (s_.compare(pos_, 4, "true") == 0) {
+            pos_ += 4;
+            value = true;
+            return true;
+        }
+        if (s_.compare(pos_, 5, "false") == 0) {
+            pos_ += 5;
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool readStrings(std::vector<std::string>& values)
+    {
+        if (!consume('['))
+            return false;
+        if (consume(']'))
+            return true;
+        do {
+            values.emplace_back();
+            if (!readString(values.back()))
+                return false;
+        } while (consume(','));
+        return consume(']');
+    }
+
+    /*
+     * Read any value, as is.
+     */
+    bool readRaw(std::string& value)
+    {
+        skipWhitespace();
+        auto start = pos_;
+        if (!skipValue(0))
+            return false;
+        value = s_.substr(start, pos_ - start);
+        return true;
+    }
+
+private:
+    void skipWhitespace()
+    {
+        while (pos_ < s_.size()
+                   && (s_[pos_] == ' ' || s_[pos_] == '\t' || s_[pos_] == '\r' || s_[pos_] == '\n')) {
+            ++pos_;
+        }
+    }
+
+    bool skipValue(int depth)
+    {
+        skipWhitespace();
+        if (pos_ == s_.size() || depth > kMaxDepth)
+            return false;
+
+        std::string s;
+        switch (s_[pos_]) {
+            case '"':
+                return readString(s);
+
+            case '{':
+                ++pos_;
+                if (consume('}'))
+                    return true;
+                do {
+                    if (!readString(s) || !consume(':') || !skipValue(depth + 1))
+                        return false;
+                } while (consume(','));
+                return consume('}');
+
+            case '[':
+                ++pos_;
+                if (consume(']'))
+                    return true;
+                do {
+                    if (!skipValue(depth + 1))
+                        return false;
+                } while (consume(','));
+                return consume(']');
+
+            default: {
+                // A number, or true, false, or null.
+                auto start = pos_;
+                while (pos_ < s_.size()
+                           && (std::isalnum(static_cast<unsigned char>(s_[pos_]))
+                                || s_[pos_] == '+' || s_[pos_] == '-' || s_[pos_] == '.')) {
+                    ++pos_;
+                }
+                return pos_ > start;
+            }
+        }
+    }
+
+    bool readHex4(unsigned& cp)
+    {
+        if (pos_ + 4 > s_.size())
+            return false;
+        cp = 0;
+        for (auto i = 0; i < 4; ++i) {
+            auto c = s_[pos_++];
+            cp <<= 4;
+            if (c >= '0' && c <= '9')
+                cp |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                cp |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                cp |= c - 'A' + 10;
+            else
+                return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& s, unsigned cp)
+    {
+        if (cp < 0x80) {
+            s += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            s += static_cast<char>(0xC0 | (cp >> 6));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            s += static_cast<char>(0xE0 | (cp >> 12));
+            s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            s += static_cast<char>(0xF0 | (cp >> 18));
+            s += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    static constexpr int kMaxDepth = 64;
+
+    const std::string& s_;
+    std::string::size_type pos_;
+};
+
+/*
+ * A request longer than this, on a connection, closes the connection.
+ */
+constexpr std::string::size_type kMaxRequestLength = 64 << 20;
+
+/*
+ * The frontends of distinct sets of command-line options kept at most.
+ */
+constexpr std::size_t kMaxFrontends = 16;
+
+/*
+ * Whether the command-line options \p args may be set by a request: those of
+ * the output and of parsing may, but not those that choose a program to run,
+ * load a plugin, write files, or affect the server itself.
+ */
+bool areRequestOptions(const std::vector<std::string>& args, std::string& rejectedArg)
+{
+    static const std::set<std::string> kOptions {
+        "lang",
+        "dump-AST",
+        "dump-AST-format",
+        "dump-CFG",
+        "dump-CFG-format",
+        "WIP",
+        "c-std",
+        "cpp-includes",
+        "cpp-I",
+        "cpp-D",
+        "cpp-U",
+        "cpp-host-macros",
+        "C-ParseOptions-TreatmentOfAmbiguities",
+        "C-ParseOptions-TreatmentOfFunctionBodies"
+    };
+    static const std::map<char, std::string> kShortOptions {
+        { 'l', "lang" },
+        { 'z', "dump-AST" },
+        { 'c', "dump-CFG" },
+        { 'w', "WIP" }
+    };
+
+    for (const auto& arg : args) {
+        if (arg.size() < 2 || arg[0] != '-')
+            continue;
+        if (arg[1] == '-') {
+            if (kOptions.count(arg.substr(2, arg.find('=') - 2)))
+                continue;
+        } else if (std::all_of(arg.begin() + 1, arg.end(),
+                               [] (char c) { return kShortOptions.count(c) != 0; })) {
+            continue;
+        }
+        rejectedArg = arg;
+        return false;
+    }
+    return true;
+}
+
+std::string response(const std::string& id, int exit, const std::string& out, const std::string& err)
+{
+    std::string json = "{\"id\":" + id + ",\"exit\":" + std::to_string(exit) + ",\"out\":";
+    psy::appendJSONString(json, out);
+    json += ",\"err\":";
+    psy::appendJSONString(json, err);
+    json += "}\n";
+    return json;
+}
+}
+
+struct Server::Request
+{
+    std::string id = "null";
+    std::string file;
+    std::string text;
+    bool hasText = false;
+    std::vector<std::string> args;
+    bool shutdown = false;
+
+    bool parse(const std::string& line)
+    {
+        JsonReader reader(line);
+        if (!reader.consume('{'))
+            return false;
+        if (reader.consume('}'))
+            return reader.atEnd();
+
+        do {
+            std::string name;
+            if (!reader.readString(name) || !reader.consume(':'))
+                return false;
+
+            bool ok;
+            if (name == "id")
+                ok = reader.readRaw(id);
+            else if (name == "file")
+                ok = reader.readString(file);
+            else if (name == "text")
+                ok = hasText = reader.readString(text);
+            else if (name == "args")
+                ok = reader.readStrings(args);
+            else if (name == "shutdown")
+                ok = reader.readBool(shutdown);
+            else {
+                std::string ignored;
+                ok = reader.readRaw(ignored);
+            }
+            if (!ok)
+                return false;
+        } while (reader.consume(','));
+
+        return reader.consume('}') && reader.atEnd();
+    }
+};
+
+/*!
+ * \brief The Server::Channel class.
+ *
+ * Where the responses (each one a line, written atomically) go.
+ */
+class Server::Channel
+{
+public:
+    virtual ~Channel() {}
+
+    void respond(const std::string& line)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        write(line);
+    }
+
+protected:
+    virtual void write(const std::string& line) = 0;
+
+    std::mutex mutex_;
+};
+
+class Server::StreamChannel final : public Server::Channel
+{
+public:
+    StreamChannel(std::ostream& os) : os_(os) {}
+
+private:
+    void write(const std::string& line) override
+    {
+        os_ << line << std::flush;
+    }
+
+    std::ostream& os_;
+};
+
+class Server::SocketChannel final : public Server::Channel
+{
+public:
+    SocketChannel(int fd) : fd_(fd) {}
+    ~SocketChannel() { ::close(fd_); }
+
+    int fd() const { return fd_; }
+
+private:
+    void write(const std::string& line) override
+    {
+        // A response to a client that has gone is dropped.
+        std::string::size_type written = 0;
+        while (written < line.size()) {
+            auto n = ::send(fd_, line.data() + written, line.size() - written, kSendFlags);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return;
+            written += n;
+        }
+    }
+
+    int fd_;
+};
+
+Server::Server(Driver* driver, std::vector<std::string> args, unsigned jobs)
+    : driver_(driver)
+    , args_(std::move(args))
+    , jobs_(std::max(jobs, 1u))
+    , frontendUseCnt_(0)
+    , evictedFrontendsExit_(Driver::SUCCESS)
+    , closed_(false)
+    , stopping_(false)
+    , wakeFds_{ -1, -1 }
+    , connectionCnt_(0)
+{}
+
+Server::~Server()
+{
+    stopWorkers();
+}
+
+int Server::serve(std::istream& in, std::ostream& out)
+{
+    startWorkers();
+
+    auto channel = std::make_shared<StreamChannel>(out);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!handle(line, channel))
+            break;
+    }
+
+    stopWorkers();
+    return finish();
+}
+
+int Server::serve(const std::string& socketPath)
+{
+    sockaddr_un addr {};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << kCnip << "invalid socket path " << socketPath << std::endl;
+        return Driver::ERROR_CannotServe;
+    }
+    std::strcpy(addr.sun_path, socketPath.c_str());
+
+    // A socket left by a previous server is replaced (but not any other file).
+    struct stat st;
+    if (::lstat(socketPath.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+        ::unlink(socketPath.c_str());
+
+    /*
+     * A shutdown request, handled by another thread, wakes the loop that
+     * accepts connections through a pipe (a self-pipe).
+     */
+    auto listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0
+            || ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+            || ::listen(listenFd, SOMAXCONN) != 0
+            || ::pipe(wakeFds_) != 0) {
+        std::cerr << kCnip << "cannot serve on socket " << socketPath
+                  << ": " << std::strerror(errno) << std::endl;
+        if (listenFd >= 0)
+            ::close(listenFd);
+        return Driver::ERROR_CannotServe;
+    }
+
+    for (auto fd : { listenFd, wakeFds_[0], wakeFds_[1] })
+        ::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC);
+
+    startWorkers();
+
+    while (!stopping_) {
+        pollfd pfds[2] = { { listenFd, POLLIN, 0 }, { wakeFds_[0], POLLIN, 0 } };
+        if (::poll(pfds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (pfds[1].revents)
+            break;
+        if (!pfds[0].revents)
+            continue;
+
+        auto fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            break;
+        }
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+        auto channel = std::make_shared<SocketChannel>(fd);
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex_);
+            connectionFds_.insert(fd);
+            ++connectionCnt_;
+        }
+        std::thread(&Server::readConnection, this, std::move(channel)).detach();
+    }
+
+    // Stop reading from the connections; their pending requests still get a response.
+    {
+        std::unique_lock<std::mutex> lock(connectionsMutex_);
+        for (auto fd : connectionFds_)
+            ::shutdown(fd, SHUT_RD);
+        connectionsCond_.wait(lock, [this] () { return connectionCnt_ == 0; });
+    }
+
+    stopWorkers();
+    ::close(listenFd);
+    for (auto& fd : wakeFds_) {
+        ::close(fd);
+        fd = -1;
+    }
+    ::unlink(socketPath.c_str());
+
+    return finish();
+}
+
+void Server::readConnection(std::shared_ptr<SocketChannel> channel)
+{
+    // A request that is too long is responded to (without an id), and the connection is closed.
+    auto respondTooLong = [] (SocketChannel& channel) {
+        channel.respond(response("null",
+                                 Driver::ERROR_MalformedRequest,
+                                 "",
+                                 std::string(kCnip) + "request too long\n"));
+    };
+
+    std::string buf;
+    char chunk[1 << 16];
+    bool reading = true;
+    while (reading) {
+        auto n = ::recv(channel->fd(), chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+
+        buf.append(chunk, n);
+        std::string::size_type start = 0;
+        for (auto end = buf.find('\n'); end != std::string::npos; end = buf.find('\n', start)) {
+            if (end - start > kMaxRequestLength) {
+                respondTooLong(*channel);
+                reading = false;
+                break;
+            }
+            if (!handle(buf.substr(start, end - start), channel)) {
+                reading = false;
+                break;
+            }
+            start = end + 1;
+        }
+        buf.erase(0, start);
+
+        if (reading && buf.size() > kMaxRequestLength) {
+            respondTooLong(*channel);
+            reading = false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    connectionFds_.erase(channel->fd());
+    channel.reset();
+    --connectionCnt_;
+    connectionsCond_.notify_all();
+}
+
+/*
+ * Handle the request in the \p line, which is responded to in \p channel,
+ * and return whether to continue serving.
+ */
+bool Server::handle(const std::string& line, const std::shared_ptr<Channel>& channel)
+{
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+        return true;
+
+    auto request = std::make_shared<Request>();
+    if (!request->parse(line)) {
+        channel->respond(response(request->id,
+                                  Driver::ERROR_MalformedRequest,
+                                  "",
+                                  std::string(kCnip) + "malformed request\n"));
+        return true;
+    }
+
+    if (request->shutdown) {
+        stopping_ = true;
+        if (wakeFds_[1] >= 0) {
+            char c = 0;
+            while (::write(wakeFds_[1], &c, 1) < 0 && errno == EINTR)
+                ;
+        }
+        channel->respond(response(request->id, Driver::SUCCESS, "", ""));
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        pendingJobs_.push_back(Job { std::move(request), channel });
+    }
+    jobsCond_.notify_one();
+    return !stopping_;
+}
+
+void Server::process(const Request& request, Channel& channel)
+{
+    std::ostringstream out;
+    std::ostringstream err;
+    int exit;
+
+    auto FE = frontend(request.args, err);
+    if (!FE) {
+        exit = Driver::ERROR_UnrecognizedCmdLineOption;
+    } else if (!request.hasText && request.file.empty()) {
+        err << kCnip << "no input file(s)" << std::endl;
+        exit = Driver::ERROR_NoInputFile;
+    } else {
+        try {
+            if (request.hasText)
+                exit = FE->run(request.text, FileInfo(request.file.empty() ? kBufferName : request.file), out, err);
+            else
+                exit = driver_->runOnFile(*FE, request.file, out, err);
+        }
+        catch (...) {
+            exit = Driver::ERROR;
+        }
+    }
+
+    channel.respond(response(request.id, exit, out.str(), err.str()));
+}
+
+/*
+ * The frontend for the command-line options of the server extended with
+ * \p args, which is created on the first request with them.
+ */
+std::shared_ptr<CompilerFrontend> Server::frontend(const std::vector<std::string>& args, std::ostream& err)
+{
+    std::string rejectedArg;
+    if (!areRequestOptions(args, rejectedArg)) {
+        err << kCnip << "option " << rejectedArg << " can't be set by a request" << std::endl;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(frontendsMutex_);
+
+    auto it = frontends_.find(args);
+    if (it != frontends_.end()) {
+        it->second.lastUse = ++frontendUseCnt_;
+        return it->second.FE;
+    }
+
+    auto allArgs = args_;
+    allArgs.insert(allArgs.end(), args.begin(), args.end());
+    std::vector<char*> argv;
+    for (auto& arg : allArgs)
+        argv.push_back(&arg[0]);
+    auto argc = static_cast<int>(argv.size());
+    auto argvData = argv.data();
+
+    std::shared_ptr<CompilerFrontend> FE;
+    try {
+        cxxopts::Options cmdLineOpts(allArgs[0], "cnippet");
+        Driver::defineOptions(cmdLineOpts);
+        cmdLineOpts.parse_positional(std::vector<std::string>{"file"});
+        auto parsedCmdLine = cmdLineOpts.parse(argc, argvData);
+
+        auto lang = parsedCmdLine["lang"].as<std::string>();
+        if (lang != "C") {
+            err << kCnip << "language " << lang << " not recognized" << std::endl;
+            return nullptr;
+        }
+
+        // The output of a response is a JSON string, which can't hold binary data.
+        if (parsedCmdLine["dump-AST-format"].as<std::string>() == "Binary"
+                || parsedCmdLine["dump-CFG-format"].as<std::string>() == "Binary") {
+            err << kCnip << "the Binary dump formats aren't served" << std::endl;
+            return nullptr;
+        }
+
+        FE.reset(new CCompilerFrontend(parsedCmdLine));
+    }
+    catch (...) {
+        err << kCnip << "unrecognized command-line option" << std::endl;
+        return nullptr;
+    }
+
+    /*
+     * A frontend that is dropped is finished first; one that is in use by
+     * a worker (not only referenced here) isn't dropped.
+     */
+    while (frontends_.size() >= kMaxFrontends) {
+        auto lruIt = frontends_.end();
+        for (auto it = frontends_.begin(); it != frontends_.end(); ++it) {
+            if (it->second.FE.use_count() == 1
+                    && (lruIt == frontends_.end() || it->second.lastUse < lruIt->second.lastUse)) {
+                lruIt = it;
+            }
+        }
+        if (lruIt == frontends_.end())
+            break;
+        auto finishExit = lruIt->second.FE->finish(std::cerr);
+        if (evictedFrontendsExit_ == Driver::SUCCESS)
+            evictedFrontendsExit_ = finishExit;
+        frontends_.erase(lruIt);
+    }
+
+    frontends_[args] = CachedFrontend { FE, ++frontendUseCnt_ };
+    return FE;
+}
+
+void Server::startWorkers()
+{
+    closed_ = false;
+    for (unsigned i = 0; i < jobs_; ++i)
+        workers_.emplace_back(&Server::work, this);
+}
+
+void Server::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        closed_ = true;
+    }
+    jobsCond_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+    workers_.clear();
+}
+
+void Server::work()
+{
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex_);
+            jobsCond_.wait(lock, [this] () { return closed_ || !pendingJobs_.empty(); });
+            if (pendingJobs_.empty())
+                return;
+            job = std::move(pendingJobs_.front());
+            pendingJobs_.pop_front();
+        }
+        process(*job.request, *job.channel);
+    }
+}
+
+int Server::finish()
+{
+    int exit = evictedFrontendsExit_;
+    for (auto& p : frontends_) {
+        auto finishExit = p.second.FE->finish(std::cerr);
+        if (exit == Driver::SUCCESS)
+            exit = finishExit;
+    }
+    return exit;
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2022 Leandro T. C. Melo <ltcmelo@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef CNIPPET_SERVER_H__
+#define CNIPPET_SERVER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cnip {
+
+class CompilerFrontend;
+class Driver;
+
+/*!
+ * \brief The Server class.
+ *
+ * A long-running cnip, which serves requests to run the frontend, so that
+ * the startup (e.g., the loading of a plugin) is paid once and the caches of
+ * the frontends stay warm across requests. The requests, and the responses,
+ * are JSON lines, read from stdin (and written to stdout) or exchanged over
+ * connections to a Unix domain socket. A request is an object with members:
+ *
+ *   - \c "id": any value, echoed in the response;
+ *   - \c "file": the path of the input file;
+ *   - \c "text": the input text, if it isn't to be read from \c "file"
+ *     (which then only names it);
+ *   - \c "args": the command-line options of the request (an array of
+ *     strings), in addition to those of the server; only those of the output
+ *     and of parsing are accepted;
+ *   - \c "shutdown": whether to stop serving (after the pending requests).
+ *
+ * A response is an object with the members \c "id", \c "exit" (the exit
+ * code), \c "out" (the output), and \c "err" (the diagnostics). Since the
+ * output is a JSON string, the \c Binary formats of dumps aren't served.
+ *
+ * \note
+ * The requests are processed concurrently, by a pool of workers, so the
+ * responses may come in a different order than the requests. The frontend
+ * of every distinct set of command-line options is created once, and shared
+ * by the workers; the least recently used ones that are idle are dropped
+ * once there are too many of them.
+ */
+class Server final
+{
+public:
+    Server(Driver* driver, std::vector<std::string> args, unsigned jobs);
+    ~Server();
+
+    /*!
+     * Serve the requests read from \p in, writing the responses to \p out,
+     * until the end of \p in or until a shutdown request.
+     */
+    int serve(std::istream& in, std::ostream& out);
+
+    /*!
+     * Serve the requests of the connections to the Unix domain socket at
+     * \p socketPath, until a shutdown request.
+     */
+    int serve(const std::string& socketPath);
+
+private:
+    struct Request;
+    class Channel;
+    class StreamChannel;
+    class SocketChannel;
+
+    struct Job
+    {
+        std::shared_ptr<Request> request;
+        std::shared_ptr<Channel> channel;
+    };
+
+    bool handle(const std::string& line, const std::shared_ptr<Channel>& channel);
+    void process(const Request& request, Channel& channel);
+    std::shared_ptr<CompilerFrontend> frontend(const std::vector<std::string>& args, std::ostream& err);
+
+    void startWorkers();
+    void stopWorkers();
+    void work();
+
+    void readConnection(std::shared_ptr<SocketChannel> channel);
+
+    int finish();
+
+    Driver* driver_;
+    std::vector<std::string> args_;
+    unsigned jobs_;
+
+    struct CachedFrontend
+    {
+        std::shared_ptr<CompilerFrontend> FE;
+        std::size_t lastUse;
+    };
+    std::mutex frontendsMutex_;
+    std::map<std::vector<std::string>, CachedFrontend> frontends_;
+    std::size_t frontendUseCnt_;
+    int evictedFrontendsExit_;
+
+    std::mutex jobsMutex_;
+    std::condition_variable jobsCond_;
+    std::deque<Job> pendingJobs_;
+    bool closed_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<bool> stopping_;
+    int wakeFds_[2];
+    std::mutex connectionsMutex_;
+    std::condition_variable connectionsCond_;
+    std::set<int> connectionFds_;
+    std::size_t connectionCnt_;
+};
+
+} // cnip
+
+#endif
@@ -22,7 +22,6 @@
 
 #include "Process.h"
 
-#include <iostream>
 #include <sstream>
 
 namespace
@@ -44,15 +43,16 @@ GnuCompilerFacade::GnuCompilerFacade(const std::string& compilerName,
 
 std::pair<int, std::string> GnuCompilerFacade::preprocess(const std::string& srcText)
 {
-    std::string in = "cat << 'EOF' | ";
-    in += compilerName_;
-    in += assembleMacroCmd();
-    in += " ";
-    in += "-std=" + std_ + " ";
-    in += "-E -x c -CC -";
-    in += "\n" + srcText + "\nEOF";
-
-    return Process().execute(in);
+    std::vector<std::string> args { compilerName_ };
+    assembleMacroArgs(args);
+    args.push_back("-std=" + std_);
+    args.insert(args.end(), { "-E", "-x", "c", "-CC", "-" });
+
+    Process process;
+    auto res = process.execute(args, srcText);
+    err_ = process.error();
+
+    return res;
 }
 
 std::pair<int, std::string> GnuCompilerFacade::preprocess_IgnoreIncludes(const std::string& srcText)
@@ -74,12 +74,28 @@ std::pair<int, std::string> GnuCompilerFacade::preprocess_IgnoreIncludes(const s
     return preprocess(srcText_P);
 }
 
-std::string GnuCompilerFacade::assembleMacroCmd() const
+std::pair<int, std::string> GnuCompilerFacade::preprocess_MacroDefinitions(const std::string& srcText)
 {
-    std::string s;
-    for (const auto& d : D_)
-        s += " -D " + d;
-    for (const auto& u : U_)
-        s += " -U " + u;
-    return s;
+    std::vector<std::string> args { compilerName_ };
+    assembleMacroArgs(args);
+    args.push_back("-std=" + std_);
+    args.insert(args.end(), { "-E", "-dM", "-x", "c", "-" });
+
+    Process process;
+    auto res = process.execute(args, srcText);
+    err_ = process.error();
+
+    return res;
+}
+
+void GnuCompilerFacade::assembleMacroArgs(std::vector<std::string>& args) const
+{
+    for (const auto& d : D_) {
+        args.push_back("-D");
+        args.push_back(d);
+    }
+    for (const auto& u : U_) {
+        args.push_back("-U");
+        args.push_back(u);
+    }
 }
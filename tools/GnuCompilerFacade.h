@@ -38,13 +38,25 @@ public:
     std::pair<int, std::string> preprocess(const std::string& srcText);
     std::pair<int, std::string> preprocess_IgnoreIncludes(const std::string& srcText);
 
+    /*
+     * The `#define' directives of the macros that are defined at the end of
+     * the source text \p srcText (including the compiler's predefined ones).
+     */
+    std::pair<int, std::string> preprocess_MacroDefinitions(const std::string& srcText);
+
+    /*
+     * The standard error of the last preprocessor invocation.
+     */
+    const std::string& error() const { return err_; }
+
 private:
-    std::string assembleMacroCmd() const;
+    void assembleMacroArgs(std::vector<std::string>& args) const;
 
     std::string compilerName_;
     std::string std_;
     std::vector<std::string> D_;
     std::vector<std::string> U_;
+    std::string err_;
 };
 
 } // psy
@@ -26,11 +26,11 @@
 
 namespace psy {
 
-std::pair<int, std::string> readFile(const std::string& fileName)
+std::pair<int, std::string> readFile(const std::string& fileName, std::ostream& err)
 {
     std::ifstream ifs(fileName);
     if (!ifs) {
-        std::cerr << "file input error: " << fileName << std::endl;
+        err << "file input error: " << fileName << std::endl;
         return std::make_pair(1, "");
     }
 
@@ -40,11 +40,11 @@ std::pair<int, std::string> readFile(const std::string& fileName)
     return std::make_pair(0, ss.str());
 }
 
-int writeFile(const std::string& fileName, const std::string& content)
+int writeFile(const std::string& fileName, const std::string& content, std::ostream& err)
 {
     std::ofstream ofs(fileName);
     if (!ofs) {
-        std::cerr << "file output error: " << fileName << std::endl;
+        err << "file output error: " << fileName << std::endl;
         return 1;
     }
 
@@ -20,38 +20,193 @@
 
 #include "Process.h"
 
-#include <array>
-#include <cstdio> // Using POSIX's `popen'.
-#include <iostream>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
 
 using namespace psy;
 
 namespace {
 
-std::pair<int, std::string> executeCore(const char* cmd)
+constexpr std::size_t kReadSize = 1 << 16;
+
+/*
+ * The ends kept by this process must not leak into other children, so they
+ * are opened close-on-exec atomically (a child may be spawned concurrently).
+ */
+bool openPipe(int fds[2])
 {
-    FILE* pipe = popen(cmd, "r");
-    if (!pipe)
-        return std::make_pair(1, "");
+#if __APPLE__
+    if (pipe(fds) != 0)
+        return false;
+    for (auto i = 0; i < 2; ++i)
+        fcntl(fds[i], F_SETFD, fcntl(fds[i], F_GETFD) | FD_CLOEXEC);
+    return true;
+#else
+    return pipe2(fds, O_CLOEXEC) == 0;
+#endif
+}
 
-    std::string all;
-    while (!feof(pipe)) {
-        std::array<char, 512> buf;
-        if (fgets(buf.data(), 512, pipe))
-            all += buf.data();
+void closeFd(int& fd)
+{
+    if (fd != -1) {
+        close(fd);
+        fd = -1;
     }
+}
 
-    return std::make_pair(pclose(pipe), all);
+/*
+ * Read what's available from \p fd, at most kReadSize bytes, and append it
+ * to the string \p s; return false on EOF.
+ */
+bool readInto(int fd, std::string& s)
+{
+    char buf[kReadSize];
+    auto cnt = read(fd, buf, kReadSize);
+    if (cnt > 0)
+        s.append(buf, cnt);
+    return cnt > 0 || (cnt == -1 && (errno == EINTR || errno == EAGAIN));
 }
 
 } // anonymous
 
 std::pair<int, std::string> Process::execute(std::string&& s)
 {
-    return executeCore(s.c_str());
+    return execute(std::vector<std::string>{ "/bin/sh", "-c", s }, std::string());
 }
 
 std::pair<int, std::string> Process::execute(const std::string &s)
 {
-    return executeCore(s.c_str());
+    return execute(std::vector<std::string>{ "/bin/sh", "-c", s }, std::string());
+}
+
+std::pair<int, std::string> Process::execute(const std::vector<std::string>& argv, const std::string& in)
+{
+    err_.clear();
+    if (argv.empty())
+        return std::make_pair(1, "");
+
+    int inFds[2] = { -1, -1 };
+    int outFds[2] = { -1, -1 };
+    int errFds[2] = { -1, -1 };
+    if (!openPipe(inFds) || !openPipe(outFds) || !openPipe(errFds)) {
+        for (auto fd : { inFds, outFds, errFds }) {
+            closeFd(fd[0]);
+            closeFd(fd[1]);
+        }
+        return std::make_pair(1, "");
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, inFds[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, outFds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, errFds[1], STDERR_FILENO);
+
+    std::vector<char*> args;
+    args.reserve(argv.size() + 1);
+    for (const auto& arg : argv)
+        args.push_back(const_cast<char*>(arg.c_str()));
+    args.push_back(nullptr);
+
+    pid_t pid;
+    auto spawnErr = posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+
+    closeFd(inFds[0]);
+    closeFd(outFds[1]);
+    closeFd(errFds[1]);
+    if (spawnErr != 0) {
+        closeFd(inFds[1]);
+        closeFd(outFds[0]);
+        closeFd(errFds[0]);
+        err_ = argv[0] + ": " + std::strerror(spawnErr) + "\n";
+        return std::make_pair(127, "");
+    }
+
+    /*
+     * A program that exits before consuming its input would raise SIGPIPE
+     * on a write; the signal is blocked (in this thread) while the pipes are
+     * serviced, and a pending one is discarded.
+     */
+    sigset_t pipeSet;
+    sigset_t oldSet;
+    sigemptyset(&pipeSet);
+    sigaddset(&pipeSet, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSet, &oldSet);
+
+    /*
+     * The input is written while the output is read, otherwise a program
+     * that fills its output pipe before consuming all input would block.
+     */
+    for (auto fd : { inFds[1], outFds[0], errFds[0] })
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    if (in.empty())
+        closeFd(inFds[1]);
+
+    std::string out;
+    std::size_t written = 0;
+    while (inFds[1] != -1 || outFds[0] != -1 || errFds[0] != -1) {
+        struct pollfd pfds[3];
+        nfds_t cnt = 0;
+        if (inFds[1] != -1)
+            pfds[cnt++] = { inFds[1], POLLOUT, 0 };
+        if (outFds[0] != -1)
+            pfds[cnt++] = { outFds[0], POLLIN, 0 };
+        if (errFds[0] != -1)
+            pfds[cnt++] = { errFds[0], POLLIN, 0 };
+
+        if (poll(pfds, cnt, -1) == -1) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (nfds_t i = 0; i < cnt; ++i) {
+            if (!pfds[i].revents)
+                continue;
+
+            if (pfds[i].fd == inFds[1]) {
+                auto n = write(inFds[1], in.data() + written, in.size() - written);
+                if (n > 0)
+                    written += n;
+                if ((n == -1 && errno != EINTR && errno != EAGAIN) || written == in.size())
+                    closeFd(inFds[1]);
+            } else if (pfds[i].fd == outFds[0]) {
+                if (!readInto(outFds[0], out))
+                    closeFd(outFds[0]);
+            } else if (!readInto(errFds[0], err_)) {
+                closeFd(errFds[0]);
+            }
+        }
+    }
+    closeFd(inFds[1]);
+    closeFd(outFds[0]);
+    closeFd(errFds[0]);
+
+    sigset_t pendingSet;
+    sigpending(&pendingSet);
+    if (sigismember(&pendingSet, SIGPIPE)) {
+        int sig;
+        sigwait(&pipeSet, &sig);
+    }
+    pthread_sigmask(SIG_SETMASK, &oldSet, nullptr);
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+        ;
+
+    int exit = WIFEXITED(status)
+            ? WEXITSTATUS(status)
+            : (WIFSIGNALED(status) ? 128 + WTERMSIG(status) : 1);
+    return std::make_pair(exit, std::move(out));
 }
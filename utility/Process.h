@@ -23,14 +23,37 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace psy {
 
 class Process final
 {
 public:
+    /**
+     * Execute the shell command \p cmd and return its exit status and its output.
+     */
     std::pair<int, std::string> execute(const std::string& cmd);
     std::pair<int, std::string> execute(std::string&& cmd);
+
+    /**
+     * Execute the program \p argv[0] (searched in \c PATH), with arguments
+     * \p argv, writing \p in to its standard input; return its exit status
+     * and its standard output.
+     *
+     * \remark The program is spawned directly (not through a shell) and
+     * its standard streams are connected to pipes: its standard error is
+     * available, afterwards, through Process::error.
+     */
+    std::pair<int, std::string> execute(const std::vector<std::string>& argv, const std::string& in);
+
+    /**
+     * The standard error of the last program executed.
+     */
+    const std::string& error() const { return err_; }
+
+private:
+    std::string err_;
 };
 
 } // psy